@@ -39,6 +39,7 @@
 #include "core/math/geometry_2d.h"
 #include "core/math/geometry_3d.h"
 #include "core/os/keyboard.h"
+#include "core/os/small_block_allocator.h"
 #include "core/os/thread_safe.h"
 #include "core/variant/typed_array.h"
 
@@ -596,6 +597,29 @@ Dictionary OS::get_memory_info() const {
 	return ::OS::get_singleton()->get_memory_info();
 }
 
+TypedArray<Dictionary> OS::get_small_block_allocator_stats() const {
+#ifndef SMALL_BLOCK_ALLOCATOR_ENABLED
+	WARN_PRINT_ONCE("The small block allocator isn't used by this build of the engine (compiled without `small_block_allocator=yes`).");
+	return TypedArray<Dictionary>();
+#else
+	SmallBlockAllocator::SizeClassStats stats[SmallBlockAllocator::SIZE_CLASS_COUNT];
+	SmallBlockAllocator::get_stats(stats);
+
+	TypedArray<Dictionary> ret;
+	for (const SmallBlockAllocator::SizeClassStats &size_class : stats) {
+		Dictionary d;
+		d["block_size"] = size_class.block_size;
+		d["blocks_used"] = size_class.blocks_used;
+		d["blocks_reserved"] = size_class.blocks_reserved;
+		d["slabs"] = size_class.slabs;
+		d["allocations"] = size_class.allocations;
+		d["remote_frees"] = size_class.remote_frees;
+		ret.push_back(d);
+	}
+	return ret;
+#endif // SMALL_BLOCK_ALLOCATOR_ENABLED
+}
+
 /** This method uses a signed argument for better error reporting as it's used from the scripting API. */
 void OS::delay_usec(int p_usec) const {
 	ERR_FAIL_COND_MSG(
@@ -816,6 +840,7 @@ void OS::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_static_memory_usage"), &OS::get_static_memory_usage);
 	ClassDB::bind_method(D_METHOD("get_static_memory_peak_usage"), &OS::get_static_memory_peak_usage);
 	ClassDB::bind_method(D_METHOD("get_memory_info"), &OS::get_memory_info);
+	ClassDB::bind_method(D_METHOD("get_small_block_allocator_stats"), &OS::get_small_block_allocator_stats);
 
 	ClassDB::bind_method(D_METHOD("move_to_trash", "path"), &OS::move_to_trash);
 	ClassDB::bind_method(D_METHOD("get_user_data_dir"), &OS::get_user_data_dir);
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  frame_benchmark.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_benchmark.h"
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+
+SafeFlag FrameBenchmark::active;
+thread_local uint32_t FrameBenchmark::scope_depth[CATEGORY_MAX] = {};
+
+SafeNumeric<uint64_t> FrameBenchmark::frame_usec[CATEGORY_MAX];
+LocalVector<uint64_t> FrameBenchmark::samples[CATEGORY_MAX];
+LocalVector<uint64_t> FrameBenchmark::frame_samples;
+uint64_t FrameBenchmark::frame_begin_usec = 0;
+
+static Dictionary _get_percentiles(const LocalVector<uint64_t> &p_samples) {
+	Dictionary result;
+	if (p_samples.is_empty()) {
+		return result;
+	}
+
+	LocalVector<uint64_t> sorted = p_samples;
+	sorted.sort();
+
+	uint64_t total = 0;
+	for (uint64_t sample : sorted) {
+		total += sample;
+	}
+
+	// Nearest-rank percentiles.
+	auto percentile = [&](uint32_t p_percent) {
+		const uint32_t rank = (p_percent * sorted.size() + 99) / 100;
+		return sorted[MAX(rank, 1u) - 1];
+	};
+
+	result["mean_usec"] = double(total) / sorted.size();
+	result["p50_usec"] = percentile(50);
+	result["p90_usec"] = percentile(90);
+	result["p95_usec"] = percentile(95);
+	result["p99_usec"] = percentile(99);
+	result["max_usec"] = sorted[sorted.size() - 1];
+	result["total_usec"] = total;
+	return result;
+}
+
+uint64_t FrameBenchmark::get_ticks_usec() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+const char *FrameBenchmark::get_category_name(Category p_category) {
+	static const char *names[CATEGORY_MAX] = {
+		"process",
+		"physics_process",
+		"physics",
+		"navigation",
+		"animation",
+		"scripts",
+		"culling",
+		"rendering",
+	};
+	ERR_FAIL_INDEX_V(p_category, CATEGORY_MAX, "");
+	return names[p_category];
+}
+
+void FrameBenchmark::add_time(Category p_category, uint64_t p_usec) {
+	if (active.is_set()) {
+		frame_usec[p_category].add(p_usec);
+	}
+}
+
+void FrameBenchmark::begin_frame() {
+	if (!active.is_set()) {
+		for (int i = 0; i < CATEGORY_MAX; i++) {
+			frame_usec[i].set(0);
+		}
+		active.set();
+	}
+	frame_begin_usec = get_ticks_usec();
+}
+
+void FrameBenchmark::end_frame() {
+	ERR_FAIL_COND(!active.is_set());
+
+	frame_samples.push_back(get_ticks_usec() - frame_begin_usec);
+	for (int i = 0; i < CATEGORY_MAX; i++) {
+		// Other threads may still be adding to the frame, keep their time for the next one.
+		const uint64_t usec = frame_usec[i].get();
+		frame_usec[i].sub(usec);
+		samples[i].push_back(usec);
+	}
+}
+
+void FrameBenchmark::stop() {
+	active.clear();
+}
+
+void FrameBenchmark::clear() {
+	ERR_FAIL_COND(active.is_set());
+
+	frame_samples.clear();
+	for (int i = 0; i < CATEGORY_MAX; i++) {
+		samples[i].clear();
+	}
+}
+
+Dictionary FrameBenchmark::get_results() {
+	Dictionary results;
+	results["frame"] = _get_percentiles(frame_samples);
+	for (int i = 0; i < CATEGORY_MAX; i++) {
+		results[get_category_name(Category(i))] = _get_percentiles(samples[i]);
+	}
+	return results;
+}
+
+Error FrameBenchmark::save_json(const String &p_path, const Dictionary &p_info) {
+	Dictionary report = p_info.duplicate();
+	report["frames"] = frame_samples.size();
+	report["subsystems"] = get_results();
+
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Cannot write the frame benchmark results to \"%s\".", p_path));
+	file->store_string(JSON::stringify(report, "\t", false));
+	file->store_string("\n");
+	return OK;
+}
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  frame_benchmark.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/dictionary.h"
+
+// Per-frame time spent in each engine subsystem, collected while running a
+// scene with --frame-benchmark and reported as percentiles over all frames.
+//
+// Categories can overlap: scripts and animations also count towards the
+// process step they run in. Scripts only cover the `_process()` and
+// `_physics_process()` callbacks, so that other script calls aren't slowed down.
+class FrameBenchmark {
+public:
+	enum Category {
+		CATEGORY_PROCESS,
+		CATEGORY_PHYSICS_PROCESS,
+		CATEGORY_PHYSICS,
+		CATEGORY_NAVIGATION,
+		CATEGORY_ANIMATION,
+		CATEGORY_SCRIPTS,
+		CATEGORY_CULLING,
+		CATEGORY_RENDERING,
+		CATEGORY_MAX,
+	};
+
+	// Adds the time spent in its scope to a category. Nested scopes of the same
+	// category on one thread only count once.
+	class Scope {
+		Category category;
+		bool entered = false;
+		uint64_t begin_usec = 0;
+
+	public:
+		_FORCE_INLINE_ explicit Scope(Category p_category) :
+				category(p_category) {
+			if (unlikely(active.is_set())) {
+				entered = true;
+				if (scope_depth[category]++ == 0) {
+					begin_usec = get_ticks_usec();
+				}
+			}
+		}
+
+		_FORCE_INLINE_ ~Scope() {
+			if (unlikely(entered)) {
+				if (--scope_depth[category] == 0) {
+					add_time(category, get_ticks_usec() - begin_usec);
+				}
+			}
+		}
+	};
+
+private:
+	static SafeFlag active;
+	static thread_local uint32_t scope_depth[CATEGORY_MAX];
+
+	static SafeNumeric<uint64_t> frame_usec[CATEGORY_MAX];
+	static LocalVector<uint64_t> samples[CATEGORY_MAX];
+	static LocalVector<uint64_t> frame_samples;
+	static uint64_t frame_begin_usec;
+
+	static uint64_t get_ticks_usec();
+
+public:
+	static const char *get_category_name(Category p_category);
+
+	_FORCE_INLINE_ static bool is_active() { return active.is_set(); }
+	static void add_time(Category p_category, uint64_t p_usec);
+
+	// The first call starts the benchmark.
+	static void begin_frame();
+	static void end_frame();
+	static void stop();
+	static void clear();
+
+	static uint32_t get_frame_count() { return frame_samples.size(); }
+	// Mean, percentiles and maximum in microseconds, per category and for whole frames.
+	static Dictionary get_results();
+	static Error save_json(const String &p_path, const Dictionary &p_info);
+};
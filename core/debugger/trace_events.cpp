@@ -0,0 +1,171 @@
+/**************************************************************************/
+/*  trace_events.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "trace_events.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+SafeFlag TraceEvents::capturing;
+std::atomic<TraceEvents::ThreadBuffer *> TraceEvents::buffers = nullptr;
+thread_local TraceEvents::ThreadBuffer *TraceEvents::thread_buffer = nullptr;
+
+uint64_t TraceEvents::capture_begin_usec = 0;
+uint64_t TraceEvents::capture_end_usec = 0;
+
+String TraceEvents::capture_path;
+int TraceEvents::capture_frames_left = 0;
+
+TraceEvents::ThreadBuffer *TraceEvents::_create_thread_buffer() {
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->thread_id = Thread::get_caller_id();
+
+	// Buffers live until the process exits, as each thread keeps a pointer to its own.
+	// Since they're only ever added, a plain compare-and-swap push is enough.
+	ThreadBuffer *head = buffers.load(std::memory_order_relaxed);
+	do {
+		buffer->next = head;
+	} while (!buffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+
+	thread_buffer = buffer;
+	return buffer;
+}
+
+uint64_t TraceEvents::get_ticks_usec() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void TraceEvents::record(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec) {
+	if (!capturing.is_set()) {
+		return;
+	}
+
+	ThreadBuffer *buffer = thread_buffer;
+	if (unlikely(!buffer)) {
+		buffer = _create_thread_buffer();
+	}
+
+	// Only this thread writes into its buffer, the count publishes the event.
+	const uint64_t index = buffer->count.get();
+	Event &event = buffer->events[index % BUFFER_SIZE];
+	event.name = p_name;
+	event.begin_usec = p_begin_usec;
+	event.end_usec = p_end_usec;
+	buffer->count.set(index + 1);
+}
+
+void TraceEvents::begin_capture() {
+	ERR_FAIL_COND_MSG(capturing.is_set(), "A trace capture is already running.");
+	capture_begin_usec = get_ticks_usec();
+	capture_end_usec = 0;
+	capturing.set();
+}
+
+void TraceEvents::end_capture() {
+	ERR_FAIL_COND_MSG(!capturing.is_set(), "No trace capture is running.");
+	capturing.clear();
+	capture_end_usec = get_ticks_usec();
+}
+
+Error TraceEvents::save_json(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(capturing.is_set(), ERR_BUSY, "The trace capture must be ended before saving it.");
+
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Cannot write trace events to \"%s\".", p_path));
+
+	const uint64_t pid = OS::get_singleton()->get_process_id();
+	bool first = true;
+	auto write_event = [&](const String &p_event) {
+		file->store_string(first ? "\n" : ",\n");
+		file->store_string(p_event);
+		first = false;
+	};
+
+	file->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	for (ThreadBuffer *buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+		const String thread_name = buffer->thread_id == Thread::get_main_id() ? String("Main Thread") : vformat("Thread %d", buffer->thread_id);
+		write_event(vformat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", pid, buffer->thread_id, thread_name));
+
+		// The slot after the newest event may be written over while reading.
+		const uint64_t count = buffer->count.get();
+		const uint64_t first_index = count > BUFFER_SIZE ? count - BUFFER_SIZE + 1 : 0;
+		for (uint64_t i = first_index; i < count; i++) {
+			const Event &event = buffer->events[i % BUFFER_SIZE];
+			// Buffers also hold events from earlier captures.
+			if (event.begin_usec < capture_begin_usec || event.end_usec > capture_end_usec) {
+				continue;
+			}
+			write_event(vformat("{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%d,\"dur\":%d}", String(event.name).json_escape(), pid, buffer->thread_id, event.begin_usec - capture_begin_usec, event.end_usec - event.begin_usec));
+		}
+	}
+
+	file->store_string("\n]}\n");
+	return OK;
+}
+
+void TraceEvents::request_capture(const String &p_path, int p_frames) {
+	capture_path = p_path;
+	capture_frames_left = MAX(p_frames, 1);
+}
+
+void TraceEvents::frame() {
+	if (capture_path.is_empty()) {
+		return;
+	}
+
+	if (!capturing.is_set()) {
+		begin_capture();
+		return;
+	}
+
+	capture_frames_left--;
+	if (capture_frames_left > 0) {
+		return;
+	}
+
+	end_capture();
+	if (save_json(capture_path) == OK) {
+		print_line(vformat("Trace events written to \"%s\".", capture_path));
+	}
+	capture_path = String();
+}
+
+void TraceEvents::finish() {
+	if (capturing.is_set()) {
+		end_capture();
+		if (!capture_path.is_empty() && save_json(capture_path) == OK) {
+			print_line(vformat("Trace events written to \"%s\" (capture ended early).", capture_path));
+		}
+	}
+	capture_path = String();
+}
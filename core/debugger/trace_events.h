@@ -0,0 +1,117 @@
+/**************************************************************************/
+/*  trace_events.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/safe_refcount.h"
+
+// Timeline of scoped zones across threads, written as Chrome trace events (JSON),
+// which chrome://tracing and the Perfetto UI open directly.
+//
+// Zones are only compiled in with the `trace_events=yes` build option, and only
+// recorded while a capture runs. Each thread records into its own ring buffer
+// without locking, overwriting its oldest events when the buffer is full.
+class TraceEvents {
+public:
+	struct Event {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+		uint64_t end_usec = 0;
+	};
+
+	class Zone {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+
+	public:
+		_FORCE_INLINE_ explicit Zone(const char *p_name) :
+				name(p_name) {
+			if (unlikely(capturing.is_set())) {
+				begin_usec = get_ticks_usec();
+			}
+		}
+
+		_FORCE_INLINE_ ~Zone() {
+			if (unlikely(begin_usec != 0)) {
+				record(name, begin_usec, get_ticks_usec());
+			}
+		}
+	};
+
+private:
+	static constexpr uint32_t BUFFER_SIZE = 1 << 15;
+
+	struct ThreadBuffer {
+		Thread::ID thread_id = 0;
+		SafeNumeric<uint64_t> count; // Events ever written, the last BUFFER_SIZE ones are kept.
+		ThreadBuffer *next = nullptr;
+		Event events[BUFFER_SIZE];
+	};
+
+	static SafeFlag capturing;
+	static std::atomic<ThreadBuffer *> buffers;
+	static thread_local ThreadBuffer *thread_buffer;
+
+	static uint64_t capture_begin_usec;
+	static uint64_t capture_end_usec;
+
+	// Capture requested from the command line.
+	static String capture_path;
+	static int capture_frames_left;
+
+	static ThreadBuffer *_create_thread_buffer();
+
+public:
+	_FORCE_INLINE_ static bool is_capturing() { return capturing.is_set(); }
+	static uint64_t get_ticks_usec();
+	static void record(const char *p_name, uint64_t p_begin_usec, uint64_t p_end_usec);
+
+	static void begin_capture();
+	static void end_capture();
+	static Error save_json(const String &p_path);
+
+	// Captures the next `p_frames` frames and writes them to `p_path`.
+	static void request_capture(const String &p_path, int p_frames);
+	// Called at the start of every main loop iteration.
+	static void frame();
+	// Ends and saves a capture cut short by quitting.
+	static void finish();
+};
+
+#ifdef TRACE_EVENTS_ENABLED
+#define _TRACE_ZONE_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _TRACE_ZONE_CONCAT(m_a, m_b) _TRACE_ZONE_CONCAT_IMPL(m_a, m_b)
+// Records the enclosing scope as a zone named `m_name`, which must be a string literal.
+#define TRACE_ZONE(m_name) TraceEvents::Zone _TRACE_ZONE_CONCAT(_trace_zone_, __LINE__)(m_name)
+#else
+#define TRACE_ZONE(m_name)
+#endif
@@ -35,6 +35,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
 #include "core/string/ustring.h"
+#include "core/templates/span.h"
 #include "core/typedefs.h"
 
 /**
@@ -185,6 +186,10 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	// Returns the whole contents of the file as read-only memory, without copying, if the implementation
+	// can provide it (e.g., by memory-mapping the file). It stays valid for as long as the file is open.
+	// Returns an empty span otherwise, in which case the contents must be read with get_buffer().
+	virtual Span<uint8_t> get_mapped_data() const { return Span<uint8_t>(); }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -31,11 +31,15 @@
 #include "file_access_pack.h"
 
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
+#include <zstd.h>
+
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	pack_order++;
 	for (int i = 0; i < sources.size(); i++) {
 		if (sources[i]->try_open_pack(p_path, p_replace_files, p_offset)) {
 			return OK;
@@ -45,66 +49,101 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_compressed, uint64_t p_stored_size) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
-	PathMD5 pmd5(simplified_path.md5_buffer());
+	Vector<uint8_t> path_md5 = simplified_path.md5_buffer();
+	PathMD5 pmd5(path_md5);
 
-	bool exists = files.has(pmd5);
+	PackedFile indexed_file;
+	bool exists = _find_file(path_md5.ptr(), indexed_file) != nullptr;
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
+	pf.stored_size = p_stored_size;
 	for (int i = 0; i < 16; i++) {
 		pf.md5[i] = p_md5[i];
 	}
 	pf.src = p_src;
+	pf.pack_order = pack_order;
+	pf.replace = p_replace_files;
 
 	if (!exists || p_replace_files) {
 		files[pmd5] = pf;
 	}
 
 	if (!exists) {
-		// Search for directory.
-		PackedDir *cd = root;
-
-		if (simplified_path.contains_char('/')) { // In a subdirectory.
-			Vector<String> ds = simplified_path.get_base_dir().split("/");
-
-			for (int j = 0; j < ds.size(); j++) {
-				if (!cd->subdirs.has(ds[j])) {
-					PackedDir *pd = memnew(PackedDir);
-					pd->name = ds[j];
-					pd->parent = cd;
-					cd->subdirs[pd->name] = pd;
-					cd = pd;
-				} else {
-					cd = cd->subdirs[ds[j]];
-				}
+		_add_to_dirs(simplified_path);
+	}
+}
+
+void PackedData::_add_to_dirs(const String &p_simplified_path) {
+	// Search for directory.
+	PackedDir *cd = root;
+
+	if (p_simplified_path.contains_char('/')) { // In a subdirectory.
+		Vector<String> ds = p_simplified_path.get_base_dir().split("/");
+
+		for (int j = 0; j < ds.size(); j++) {
+			if (!cd->subdirs.has(ds[j])) {
+				PackedDir *pd = memnew(PackedDir);
+				pd->name = ds[j];
+				pd->parent = cd;
+				cd->subdirs[pd->name] = pd;
+				cd = pd;
+			} else {
+				cd = cd->subdirs[ds[j]];
 			}
 		}
-		String filename = simplified_path.get_file();
-		// Don't add as a file if the path points to a directory.
-		if (!filename.is_empty()) {
-			cd->files.insert(filename);
-		}
+	}
+	String filename = p_simplified_path.get_file();
+	// Don't add as a file if the path points to a directory.
+	if (!filename.is_empty()) {
+		cd->files.insert(filename);
 	}
 }
 
 void PackedData::remove_path(const String &p_path) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	if (!files.has(pmd5)) {
-		return;
+	Vector<uint8_t> path_md5 = simplified_path.md5_buffer();
+	PathMD5 pmd5(path_md5);
+
+	if (indexed_packs.is_empty()) {
+		if (!files.has(pmd5)) {
+			return;
+		}
+		files.erase(pmd5);
+	} else {
+		PackedFile indexed_file;
+		if (!_find_file(path_md5.ptr(), indexed_file)) {
+			return;
+		}
+
+		// Files in indexed packs can't be erased, so keep track of the removal instead.
+		PackedFile pf;
+		pf.offset = 0;
+		pf.size = 0;
+		memset(pf.md5, 0, 16);
+		pf.encrypted = false;
+		pf.bundle = false;
+		pf.pack_order = pack_order;
+		pf.removed = true;
+		files[pmd5] = pf;
 	}
 
+	_remove_from_dirs(simplified_path);
+}
+
+void PackedData::_remove_from_dirs(const String &p_simplified_path) {
 	// Search for directory.
 	PackedDir *cd = root;
 
-	if (simplified_path.contains_char('/')) { // In a subdirectory.
-		Vector<String> ds = simplified_path.get_base_dir().split("/");
+	if (p_simplified_path.contains_char('/')) { // In a subdirectory.
+		Vector<String> ds = p_simplified_path.get_base_dir().split("/");
 
 		for (int j = 0; j < ds.size(); j++) {
 			if (!cd->subdirs.has(ds[j])) {
@@ -115,9 +154,142 @@ void PackedData::remove_path(const String &p_path) {
 		}
 	}
 
-	cd->files.erase(simplified_path.get_file());
+	cd->files.erase(p_simplified_path.get_file());
+}
+
+const uint8_t *PackedData::IndexedPack::find(const uint8_t *p_path_md5) const {
+	uint32_t low = 0;
+	uint32_t high = count;
+	while (low < high) {
+		const uint32_t middle = low + (high - low) / 2;
+		const uint8_t *entry = entries + uint64_t(middle) * PACK_INDEX_ENTRY_SIZE;
+		const int cmp = memcmp(entry, p_path_md5, 16);
+		if (cmp == 0) {
+			return entry;
+		} else if (cmp < 0) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return nullptr;
+}
 
-	files.erase(pmd5);
+void PackedData::add_indexed_pack(const String &p_pkg_path, const uint8_t *p_entries, uint32_t p_count, const uint8_t *p_strings, uint32_t p_strings_size, const Vector<uint8_t> &p_data, uint64_t p_file_base, PackSource *p_src, bool p_replace_files, bool p_bundle) {
+	IndexedPack *ip = memnew(IndexedPack);
+	ip->pack = p_pkg_path;
+	ip->src = p_src;
+	ip->data = p_data; // Shares the buffer, so pointers into it stay valid.
+	ip->entries = p_entries;
+	ip->count = p_count;
+	ip->strings = p_strings;
+	ip->strings_size = p_strings_size;
+	ip->file_base = p_file_base;
+	ip->pack_order = pack_order;
+	ip->replace_files = p_replace_files;
+	ip->bundle = p_bundle;
+	indexed_packs.push_back(ip);
+
+	indexed_dirs_pending.set();
+}
+
+const PackedData::PackedFile *PackedData::_find_file(const uint8_t *p_path_md5, PackedFile &r_indexed_file, const uint8_t **r_index_entry) {
+	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(PathMD5(p_path_md5));
+	if (indexed_packs.is_empty()) {
+		return E ? &E->value : nullptr;
+	}
+
+	// Go through the packs in the order they were loaded, with the same rules as add_path() and remove_path().
+	// Files from packs that were not indexed count as a single pack, loaded along with the file that's in `files`.
+	const PackedFile *hashed = E ? &E->value : nullptr;
+	const PackedFile *found = nullptr;
+	for (uint32_t i = 0; i <= indexed_packs.size(); i++) {
+		if (hashed && (i == indexed_packs.size() || hashed->pack_order < indexed_packs[i]->pack_order)) {
+			if (hashed->removed) {
+				found = nullptr;
+			} else if (!found || hashed->replace) {
+				found = hashed;
+			}
+			hashed = nullptr;
+		}
+		if (i == indexed_packs.size()) {
+			break;
+		}
+
+		const IndexedPack *ip = indexed_packs[i];
+		const uint8_t *entry = ip->find(p_path_md5);
+		if (!entry) {
+			continue;
+		}
+
+		const uint32_t flags = decode_uint32(entry + 56);
+		if (flags & PACK_FILE_REMOVAL) {
+			found = nullptr;
+			continue;
+		}
+		if (found && !ip->replace_files) {
+			continue;
+		}
+
+		r_indexed_file.pack = ip->pack;
+		r_indexed_file.offset = ip->file_base + decode_uint64(entry + 16);
+		r_indexed_file.size = decode_uint64(entry + 24);
+		r_indexed_file.stored_size = decode_uint64(entry + 32);
+		memcpy(r_indexed_file.md5, entry + 40, 16);
+		r_indexed_file.src = ip->src;
+		r_indexed_file.encrypted = flags & PACK_FILE_ENCRYPTED;
+		r_indexed_file.compressed = flags & PACK_FILE_COMPRESSED;
+		r_indexed_file.bundle = ip->bundle;
+		r_indexed_file.pack_order = ip->pack_order;
+		r_indexed_file.replace = ip->replace_files;
+		found = &r_indexed_file;
+		if (r_index_entry) {
+			*r_index_entry = entry;
+		}
+	}
+
+	return found;
+}
+
+void PackedData::_add_indexed_dirs() {
+	if (!indexed_dirs_pending.is_set()) {
+		return;
+	}
+
+	MutexLock lock(indexed_dirs_mutex);
+	if (!indexed_dirs_pending.is_set()) {
+		return;
+	}
+
+	for (IndexedPack *ip : indexed_packs) {
+		if (ip->dirs_added) {
+			continue;
+		}
+
+		for (uint32_t i = 0; i < ip->count; i++) {
+			const uint8_t *entry = ip->entries + uint64_t(i) * PACK_INDEX_ENTRY_SIZE;
+			const uint32_t string_ofs = decode_uint32(entry + 60);
+			ERR_CONTINUE(string_ofs >= ip->strings_size);
+			const char *path = (const char *)ip->strings + string_ofs;
+			const String simplified_path = String::utf8(path, strnlen(path, ip->strings_size - string_ofs));
+
+			// Only list the file if no other pack removed or hid it.
+			PackedFile indexed_file;
+			if (_find_file(entry, indexed_file)) {
+				_add_to_dirs(simplified_path);
+			} else {
+				_remove_from_dirs(simplified_path);
+			}
+		}
+		ip->dirs_added = true;
+	}
+
+	indexed_dirs_pending.clear();
+}
+
+PackedData::PackedDir *PackedData::_get_root() {
+	_add_indexed_dirs();
+	return root;
 }
 
 void PackedData::add_pack_source(PackSource *p_source) {
@@ -128,18 +300,23 @@ void PackedData::add_pack_source(PackSource *p_source) {
 
 uint8_t *PackedData::get_file_hash(const String &p_path) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
-	if (!E) {
+	PackedFile indexed_file;
+	const uint8_t *index_entry = nullptr;
+	const PackedFile *pf = _find_file(simplified_path.md5_buffer().ptr(), indexed_file, &index_entry);
+	if (!pf) {
 		return nullptr;
 	}
 
-	return E->value.md5;
+	if (pf == &indexed_file) {
+		return const_cast<uint8_t *>(index_entry + 40);
+	}
+	return const_cast<uint8_t *>(pf->md5);
 }
 
 HashSet<String> PackedData::get_file_paths() const {
 	HashSet<String> file_paths;
-	_get_file_paths(root, root->name, file_paths);
+	PackedDir *dir = const_cast<PackedData *>(this)->_get_root();
+	_get_file_paths(dir, dir->name, file_paths);
 	return file_paths;
 }
 
@@ -155,6 +332,11 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 
 void PackedData::clear() {
 	files.clear();
+	for (IndexedPack *ip : indexed_packs) {
+		memdelete(ip);
+	}
+	indexed_packs.clear();
+	indexed_dirs_pending.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
 }
@@ -181,11 +363,44 @@ PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
+	for (IndexedPack *ip : indexed_packs) {
+		memdelete(ip);
+	}
 	_free_packed_dirs(root);
 }
 
 //////////////////////////////////////////////////////////////////
 
+bool PackedSourcePCK::_is_index_valid(const uint8_t *p_entries, uint32_t p_count, const uint8_t *p_strings, uint32_t p_strings_size, uint64_t p_file_base, uint64_t p_pack_size, bool p_bundle) {
+	// Paths are NUL-terminated, so the terminator of the last one ends the string table.
+	if (p_count > 0 && (p_strings_size == 0 || p_strings[p_strings_size - 1] != 0)) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		const uint8_t *entry = p_entries + uint64_t(i) * PACK_INDEX_ENTRY_SIZE;
+		// Lookups are binary searches, which need the path hashes sorted and unique.
+		if (i > 0 && memcmp(entry - PACK_INDEX_ENTRY_SIZE, entry, 16) >= 0) {
+			return false;
+		}
+		if (decode_uint32(entry + 60) >= p_strings_size) {
+			return false;
+		}
+
+		// Sparse bundles keep the files outside of the pack, and encrypted files start with a header of their own.
+		const uint32_t flags = decode_uint32(entry + 56);
+		if (p_bundle || (flags & (PACK_FILE_REMOVAL | PACK_FILE_ENCRYPTED))) {
+			continue;
+		}
+		const uint64_t offset = decode_uint64(entry + 16);
+		const uint64_t stored_size = (flags & PACK_FILE_COMPRESSED) ? decode_uint64(entry + 32) : decode_uint64(entry + 24);
+		if (offset > p_pack_size || stored_size > p_pack_size || p_file_base + offset + stored_size > p_pack_size) {
+			return false;
+		}
+	}
+	return true;
+}
+
 bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
 	if (f.is_null()) {
@@ -263,23 +478,87 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
-	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3 and V4.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3) {
+	uint64_t dir_offset = 0;
+	uint64_t index_offset = 0;
+	uint64_t dictionary_offset = 0;
+	uint32_t dictionary_size = 0;
+	PackInfo pack_info;
+
+	if (version >= PACK_FORMAT_VERSION_V3) {
 		// V3: Read directory offset and skip reserved part of the header.
-		uint64_t dir_offset = f->get_64() + pck_start_pos;
-		f->seek(dir_offset);
+		dir_offset = f->get_64();
+		if (version == PACK_FORMAT_VERSION_V4) {
+			// V4: Read index and compression dictionary offsets, then the compression block size.
+			index_offset = f->get_64();
+			dictionary_offset = f->get_64();
+			dictionary_size = f->get_32();
+			pack_info.compression_block_size = f->get_32();
+		}
+	}
+
+	if (!sparse_bundle) {
+		Ref<FileAccess> mapped_f = FileAccess::open(p_path, FileAccess::READ);
+		if (mapped_f.is_valid() && !mapped_f->get_mapped_data().is_empty()) {
+			pack_info.mapped_pack = mapped_f;
+		}
+	}
+
+	if (dictionary_size > 0) {
+		Vector<uint8_t> dictionary;
+		dictionary.resize(dictionary_size);
+		f->seek(pck_start_pos + dictionary_offset);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(dictionary.ptrw(), dictionary_size) != dictionary_size, false, "Can't read pack compression dictionary.");
+		ZSTD_DDict *ddict = ZSTD_createDDict(dictionary.ptr(), dictionary_size);
+		ERR_FAIL_NULL_V_MSG(ddict, false, "Invalid pack compression dictionary.");
+		dictionaries.push_back(ddict);
+		pack_info.dictionary = ddict;
+	}
+
+	{
+		RWLockWrite lock(packs_lock);
+		packs[p_path] = pack_info;
+	}
+
+	if (index_offset != 0) {
+		// V4: Look files up in the sorted index, from the mapping when available.
+		f->seek(pck_start_pos + index_offset);
+		uint32_t file_count = f->get_32();
+		uint32_t strings_size = f->get_32();
+		uint64_t entries_size = uint64_t(file_count) * PACK_INDEX_ENTRY_SIZE;
+
+		Vector<uint8_t> index_data;
+		const uint8_t *entries = nullptr;
+		Span<uint8_t> mapped_data = pack_info.mapped_pack.is_valid() ? pack_info.mapped_pack->get_mapped_data() : Span<uint8_t>();
+		uint64_t entries_offset = pck_start_pos + index_offset + 8;
+		ERR_FAIL_COND_V_MSG(entries_offset + entries_size + strings_size > f->get_length(), false, "Pack index is out of bounds, the pack is corrupted.");
+		if (entries_offset + entries_size + strings_size <= mapped_data.size()) {
+			entries = mapped_data.ptr() + entries_offset;
+		} else {
+			index_data.resize(entries_size + strings_size);
+			ERR_FAIL_COND_V_MSG(f->get_buffer(index_data.ptrw(), index_data.size()) != uint64_t(index_data.size()), false, "Can't read pack index.");
+			entries = index_data.ptr();
+		}
+
+		ERR_FAIL_COND_V_MSG(!_is_index_valid(entries, file_count, entries + entries_size, strings_size, file_base, f->get_length(), sparse_bundle), false, "Invalid pack index, the pack is corrupted.");
+		PackedData::get_singleton()->add_indexed_pack(p_path, entries, file_count, entries + entries_size, strings_size, index_data, file_base, this, p_replace_files, sparse_bundle);
+		return true;
+	}
+
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		f->seek(dir_offset + pck_start_pos);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
 		// V2: Directory directly after the header.
 		for (int i = 0; i < 16; i++) {
@@ -318,11 +597,15 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
+		uint64_t stored_size = 0;
+		if (version == PACK_FORMAT_VERSION_V4) {
+			stored_size = f->get_64();
+		}
 
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle);
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_COMPRESSED), stored_size);
 		}
 	}
 
@@ -330,7 +613,21 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	return memnew(FileAccessPack(p_path, *p_file));
+	PackInfo pack_info;
+	{
+		RWLockRead lock(packs_lock);
+		const PackInfo *info = packs.getptr(p_file->pack);
+		if (info) {
+			pack_info = *info;
+		}
+	}
+	return memnew(FileAccessPack(p_path, *p_file, &pack_info));
+}
+
+PackedSourcePCK::~PackedSourcePCK() {
+	for (ZSTD_DDict *ddict : dictionaries) {
+		ZSTD_freeDDict(ddict);
+	}
 }
 
 //////////////////////////////////////////////////////////////////
@@ -373,13 +670,57 @@ void PackedSourceDirectory::add_directory(const String &p_path, bool p_replace_f
 
 //////////////////////////////////////////////////////////////////
 
+// Decompression contexts are big, so keep one per thread rather than one per file.
+static ZSTD_DCtx *_get_thread_zstd_dctx() {
+	struct ThreadContext {
+		ZSTD_DCtx *dctx = ZSTD_createDCtx();
+		~ThreadContext() { ZSTD_freeDCtx(dctx); }
+	};
+	static thread_local ThreadContext context;
+	return context.dctx;
+}
+
+bool FileAccessPack::_load_block(uint64_t p_block) const {
+	if (current_block == (int64_t)p_block) {
+		return true;
+	}
+
+	const uint64_t block_start = block_offsets[p_block];
+	const uint64_t compressed_size = block_offsets[p_block + 1] - block_start;
+	const uint8_t *src = nullptr;
+	if (mapped_data) {
+		src = mapped_data + block_start;
+	} else {
+		compressed_buffer.resize(compressed_size);
+		f->seek(off + block_start);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(compressed_buffer.ptr(), compressed_size) != compressed_size, false, vformat("Can't read compressed pack-referenced file '%s'.", String(pf.pack)));
+		src = compressed_buffer.ptr();
+	}
+
+	const uint64_t block_length = MIN((uint64_t)block_size, pf.size - p_block * block_size);
+	block_buffer.resize(block_size);
+	ZSTD_DCtx *dctx = _get_thread_zstd_dctx();
+	size_t ret;
+	if (dictionary) {
+		ret = ZSTD_decompress_usingDDict(dctx, block_buffer.ptr(), block_length, src, compressed_size, dictionary);
+	} else {
+		ret = ZSTD_decompressDCtx(dctx, block_buffer.ptr(), block_length, src, compressed_size);
+	}
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(ret) || ret != block_length, false, vformat("Can't decompress pack-referenced file '%s', it is corrupted.", String(pf.pack)));
+
+	current_block = p_block;
+	return true;
+}
+
 Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 	ERR_PRINT("Can't open pack-referenced file.");
 	return ERR_UNAVAILABLE;
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped_data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -387,7 +728,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped_data && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -395,7 +736,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped_data && !block_size) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -416,7 +759,7 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!mapped_data && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -429,21 +772,55 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	const uint64_t read_pos = pos;
 	pos += to_read;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (block_size) {
+		uint64_t done = 0;
+		while (done < (uint64_t)to_read) {
+			const uint64_t block = (read_pos + done) / block_size;
+			if (!_load_block(block)) {
+				return done;
+			}
+			const uint64_t block_pos = read_pos + done - block * block_size;
+			const uint64_t block_length = MIN((uint64_t)block_size, pf.size - block * block_size);
+			const uint64_t n = MIN((uint64_t)to_read - done, block_length - block_pos);
+			memcpy(p_dst + done, block_buffer.ptr() + block_pos, n);
+			done += n;
+		}
+	} else if (mapped_data) {
+		memcpy(p_dst, mapped_data + read_pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+Span<uint8_t> FileAccessPack::get_mapped_data() const {
+	if (block_size) {
+		return Span<uint8_t>(); // Compressed.
+	}
+	if (mapped_data) {
+		return Span<uint8_t>(mapped_data, pf.size);
+	}
+	if (pf.bundle && !pf.encrypted && f.is_valid()) {
+		// Sparse bundles keep every file separately on disk.
+		return f->get_mapped_data();
+	}
+	return Span<uint8_t>();
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped_data && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -467,10 +844,58 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped_data = nullptr;
+	block_offsets.clear();
+	block_buffer.clear();
+	compressed_buffer.clear();
+	current_block = -1;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const PackedSourcePCK::PackInfo *p_pack_info) {
 	pf = p_file;
+	pos = 0;
+	eof = false;
+
+	const uint64_t stored_size = pf.compressed ? pf.stored_size : pf.size;
+	if (p_pack_info && p_pack_info->mapped_pack.is_valid() && !pf.bundle && !pf.encrypted) {
+		Span<uint8_t> pack_data = p_pack_info->mapped_pack->get_mapped_data();
+		if (pf.offset + stored_size <= pack_data.size()) {
+			mapped_pack = p_pack_info->mapped_pack;
+			mapped_data = pack_data.ptr() + pf.offset;
+			off = pf.offset;
+		}
+	}
+
+	if (!mapped_data) {
+		_open_pack_file(p_path);
+		ERR_FAIL_COND(f.is_null());
+	}
+
+	if (pf.compressed) {
+		ERR_FAIL_COND_MSG(!p_pack_info || p_pack_info->compression_block_size == 0, vformat("Can't open compressed pack-referenced file '%s', it is corrupted.", String(pf.pack)));
+		dictionary = p_pack_info->dictionary;
+
+		// Read the seek table, which holds the compressed size of each block.
+		const uint32_t compression_block_size = p_pack_info->compression_block_size;
+		const uint64_t block_count = (pf.size + compression_block_size - 1) / compression_block_size;
+		block_offsets.resize(block_count + 1);
+		block_offsets[0] = block_count * 4;
+		const bool valid = block_offsets[0] <= stored_size;
+		for (uint64_t i = 0; valid && i < block_count; i++) {
+			const uint32_t compressed_size = mapped_data ? decode_uint32(mapped_data + i * 4) : f->get_32();
+			block_offsets[i + 1] = block_offsets[i] + compressed_size;
+		}
+		if (!valid || block_offsets[block_count] > stored_size) {
+			block_offsets.clear();
+			close();
+			ERR_FAIL_MSG(vformat("Can't open compressed pack-referenced file '%s', it is corrupted.", String(pf.pack)));
+		}
+		block_size = compression_block_size;
+	}
+}
+
+void FileAccessPack::_open_pack_file(const String &p_path) {
 	if (pf.bundle) {
 		String simplified_path = p_path.simplify_path();
 		f = FileAccess::open(simplified_path, FileAccess::READ | FileAccess::SKIP_PACK);
@@ -499,8 +924,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -589,7 +1012,7 @@ PackedData::PackedDir *DirAccessPack::_find_dir(const String &p_dir) {
 	PackedData::PackedDir *pd;
 
 	if (absolute) {
-		pd = PackedData::get_singleton()->root;
+		pd = PackedData::get_singleton()->_get_root();
 	} else {
 		pd = current;
 	}
@@ -668,5 +1091,5 @@ String DirAccessPack::get_filesystem_type() const {
 }
 
 DirAccessPack::DirAccessPack() {
-	current = PackedData::get_singleton()->root;
+	current = PackedData::get_singleton()->_get_root();
 }
@@ -32,15 +32,21 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/rw_lock.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+// V4 adds per-file compression and a sorted index, which replaces the directory unless it's encrypted.
+#define PACK_FORMAT_VERSION_V4 4
 
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
@@ -54,8 +60,16 @@ enum PackFlags {
 enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
+	PACK_FILE_COMPRESSED = 1 << 2, // V4: Zstandard blocks, preceded by a table of their sizes.
 };
 
+// V4: Size of the blocks compressed files are split into, so they can be read at random.
+#define PACK_COMPRESSION_BLOCK_SIZE (64 * 1024)
+
+// V4: Index entries, sorted by the MD5 of their path:
+// path MD5 (16), offset (8), size (8), stored size (8), file MD5 (16), flags (4), path offset in the string table (4).
+#define PACK_INDEX_ENTRY_SIZE 64
+
 class PackSource;
 
 class PackedData {
@@ -68,10 +82,34 @@ public:
 		String pack;
 		uint64_t offset; //if offset is ZERO, the file was ERASED
 		uint64_t size;
+		uint64_t stored_size = 0; // Size of the data in the pack, if the file is compressed.
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
 		bool bundle;
+		bool compressed = false;
+
+		// Used to resolve files against the ones in indexed packs.
+		uint32_t pack_order = 0;
+		bool replace = true;
+		bool removed = false;
+	};
+
+	struct IndexedPack {
+		String pack;
+		PackSource *src = nullptr;
+		const uint8_t *entries = nullptr; // In the pack's memory mapping, or in `data`.
+		const uint8_t *strings = nullptr;
+		uint32_t count = 0;
+		uint32_t strings_size = 0;
+		uint64_t file_base = 0;
+		Vector<uint8_t> data;
+		uint32_t pack_order = 0;
+		bool replace_files = false;
+		bool bundle = false;
+		bool dirs_added = false;
+
+		const uint8_t *find(const uint8_t *p_path_md5) const;
 	};
 
 private:
@@ -100,10 +138,23 @@ private:
 			a = *((uint64_t *)&p_buf[0]);
 			b = *((uint64_t *)&p_buf[8]);
 		}
+
+		explicit PathMD5(const uint8_t *p_buf) {
+			memcpy(&a, p_buf, 8);
+			memcpy(&b, p_buf + 8, 8);
+		}
 	};
 
 	HashMap<PathMD5, PackedFile, PathMD5> files;
 
+	// Packs whose files are looked up in their index rather than being added to `files`,
+	// so loading them doesn't depend on the number of files they contain.
+	// Their paths are only added to the directory tree once it's needed.
+	LocalVector<IndexedPack *> indexed_packs;
+	SafeFlag indexed_dirs_pending;
+	BinaryMutex indexed_dirs_mutex;
+	uint32_t pack_order = 0;
+
 	Vector<PackSource *> sources;
 
 	PackedDir *root = nullptr;
@@ -113,11 +164,19 @@ private:
 
 	void _free_packed_dirs(PackedDir *p_dir);
 	void _get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const;
+	void _add_to_dirs(const String &p_simplified_path);
+	void _remove_from_dirs(const String &p_simplified_path);
+	void _add_indexed_dirs();
+	PackedDir *_get_root();
+
+	const PackedFile *_find_file(const uint8_t *p_path_md5, PackedFile &r_indexed_file, const uint8_t **r_index_entry = nullptr);
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_compressed = false, uint64_t p_stored_size = 0); // for PackSource
 	void remove_path(const String &p_path);
+	// For PackSource. p_entries must remain valid while the pack is loaded, unless it points to p_data.
+	void add_indexed_pack(const String &p_pkg_path, const uint8_t *p_entries, uint32_t p_count, const uint8_t *p_strings, uint32_t p_strings_size, const Vector<uint8_t> &p_data, uint64_t p_file_base, PackSource *p_src, bool p_replace_files, bool p_bundle);
 	uint8_t *get_file_hash(const String &p_path);
 	HashSet<String> get_file_paths() const;
 
@@ -148,10 +207,30 @@ public:
 	virtual ~PackSource() {}
 };
 
+struct ZSTD_DDict_s;
+
 class PackedSourcePCK : public PackSource {
+public:
+	struct PackInfo {
+		// Set if the platform could memory-map the pack. It's kept open so the files inside it
+		// can be read from the shared mapping, instead of reopening the pack for each of them.
+		Ref<FileAccess> mapped_pack;
+		const ZSTD_DDict_s *dictionary = nullptr;
+		uint32_t compression_block_size = 0;
+	};
+
+private:
+	RWLock packs_lock;
+	HashMap<String, PackInfo> packs;
+	LocalVector<ZSTD_DDict_s *> dictionaries;
+
+	static bool _is_index_valid(const uint8_t *p_entries, uint32_t p_count, const uint8_t *p_strings, uint32_t p_strings_size, uint64_t p_file_base, uint64_t p_pack_size, bool p_bundle);
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+
+	~PackedSourcePCK();
 };
 
 class PackedSourceDirectory : public PackSource {
@@ -171,6 +250,22 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+
+	// Set instead of `f` when reading from a memory-mapped pack.
+	Ref<FileAccess> mapped_pack;
+	const uint8_t *mapped_data = nullptr;
+
+	// For compressed files.
+	const ZSTD_DDict_s *dictionary = nullptr;
+	uint32_t block_size = 0;
+	LocalVector<uint64_t> block_offsets; // Relative to the seek table, plus the end of the last block.
+	mutable LocalVector<uint8_t> block_buffer;
+	mutable LocalVector<uint8_t> compressed_buffer;
+	mutable int64_t current_block = -1;
+
+	void _open_pack_file(const String &p_path);
+	bool _load_block(uint64_t p_block) const;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -194,6 +289,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_mapped_data() const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -207,35 +303,36 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const PackedSourcePCK::PackInfo *p_pack_info = nullptr);
 };
 
 int64_t PackedData::get_size(const String &p_path) {
 	String simplified_path = p_path.simplify_path();
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
-	if (!E) {
+	PackedFile indexed_file;
+	const PackedFile *pf = _find_file(simplified_path.md5_buffer().ptr(), indexed_file);
+	if (!pf) {
 		return -1; // File not found.
 	}
-	if (E->value.offset == 0) {
+	if (pf->offset == 0) {
 		return -1; // File was erased.
 	}
-	return E->value.size;
+	return pf->size;
 }
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
-	PathMD5 pmd5(simplified_path.md5_buffer());
-	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
-	if (!E) {
+	PackedFile indexed_file;
+	const PackedFile *pf = _find_file(simplified_path.md5_buffer().ptr(), indexed_file);
+	if (!pf) {
 		return nullptr; // Not found.
 	}
 
-	return E->value.src->get_file(p_path, &E->value);
+	return pf->src->get_file(p_path, const_cast<PackedFile *>(pf));
 }
 
 bool PackedData::has_path(const String &p_path) {
-	return files.has(PathMD5(p_path.simplify_path().trim_prefix("res://").md5_buffer()));
+	PackedFile indexed_file;
+	return _find_file(p_path.simplify_path().trim_prefix("res://").md5_buffer().ptr(), indexed_file) != nullptr;
 }
 
 bool PackedData::has_directory(const String &p_path) {
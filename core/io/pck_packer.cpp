@@ -34,8 +34,12 @@
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/marshalls.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 
+#include <zstd.h>
+
 static int _get_pad(int p_alignment, int p_n) {
 	int rest = p_n % p_alignment;
 	int pad = 0;
@@ -51,6 +55,98 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
+	ClassDB::bind_method(D_METHOD("set_compression_level", "level"), &PCKPacker::set_compression_level);
+	ClassDB::bind_method(D_METHOD("get_compression_level"), &PCKPacker::get_compression_level);
+	ClassDB::bind_method(D_METHOD("set_compression_dictionary", "dictionary"), &PCKPacker::set_compression_dictionary);
+	ClassDB::bind_method(D_METHOD("get_compression_dictionary"), &PCKPacker::get_compression_dictionary);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compression_enabled"), "set_compression_enabled", "is_compression_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_level", PROPERTY_HINT_RANGE, "1,22,1"), "set_compression_level", "get_compression_level");
+}
+
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compression_enabled = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression_enabled;
+}
+
+void PCKPacker::set_compression_level(int p_level) {
+	ERR_FAIL_COND_MSG(p_level < 1 || p_level > ZSTD_maxCLevel(), vformat("Invalid compression level, must be between 1 and %d.", ZSTD_maxCLevel()));
+	compression_level = p_level;
+	_free_compression_state();
+}
+
+int PCKPacker::get_compression_level() const {
+	return compression_level;
+}
+
+Error PCKPacker::set_compression_dictionary(const Vector<uint8_t> &p_dictionary) {
+	for (const File &pf : files) {
+		ERR_FAIL_COND_V_MSG(pf.compressed, ERR_ALREADY_IN_USE, "Can't change the compression dictionary after compressed files have been added.");
+	}
+	ERR_FAIL_COND_V_MSG(p_dictionary.size() > INT32_MAX, ERR_INVALID_PARAMETER, "Compression dictionary is too large.");
+
+	compression_dictionary = p_dictionary;
+	_free_compression_state();
+	return OK;
+}
+
+Vector<uint8_t> PCKPacker::get_compression_dictionary() const {
+	return compression_dictionary;
+}
+
+void PCKPacker::_free_compression_state() {
+	if (zstd_cdict) {
+		ZSTD_freeCDict(zstd_cdict);
+		zstd_cdict = nullptr;
+	}
+	if (zstd_cctx) {
+		ZSTD_freeCCtx(zstd_cctx);
+		zstd_cctx = nullptr;
+	}
+}
+
+Error PCKPacker::_compress(const Vector<uint8_t> &p_data, Vector<uint8_t> &r_compressed) {
+	if (!zstd_cctx) {
+		zstd_cctx = ZSTD_createCCtx();
+		ERR_FAIL_NULL_V(zstd_cctx, ERR_OUT_OF_MEMORY);
+	}
+	if (!zstd_cdict && !compression_dictionary.is_empty()) {
+		zstd_cdict = ZSTD_createCDict(compression_dictionary.ptr(), compression_dictionary.size(), compression_level);
+		ERR_FAIL_NULL_V_MSG(zstd_cdict, ERR_INVALID_DATA, "Invalid compression dictionary.");
+	}
+
+	// Blocks are compressed independently, preceded by a table of their compressed sizes,
+	// so they can be located and decompressed when seeking.
+	const uint64_t size = p_data.size();
+	const uint64_t block_count = (size + PACK_COMPRESSION_BLOCK_SIZE - 1) / PACK_COMPRESSION_BLOCK_SIZE;
+	const uint64_t block_bound = ZSTD_compressBound(PACK_COMPRESSION_BLOCK_SIZE);
+
+	r_compressed.resize(block_count * 4 + block_count * block_bound);
+	uint8_t *w = r_compressed.ptrw();
+	uint64_t compressed_size = block_count * 4;
+	for (uint64_t i = 0; i < block_count; i++) {
+		const uint64_t block_start = i * PACK_COMPRESSION_BLOCK_SIZE;
+		const uint64_t block_length = MIN((uint64_t)PACK_COMPRESSION_BLOCK_SIZE, size - block_start);
+		size_t ret;
+		if (zstd_cdict) {
+			ret = ZSTD_compress_usingCDict(zstd_cctx, w + compressed_size, block_bound, p_data.ptr() + block_start, block_length, zstd_cdict);
+		} else {
+			ret = ZSTD_compressCCtx(zstd_cctx, w + compressed_size, block_bound, p_data.ptr() + block_start, block_length, compression_level);
+		}
+		ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), ERR_CANT_CREATE, vformat("Can't compress file: %s.", ZSTD_getErrorName(ret)));
+
+		encode_uint32(ret, w + i * 4);
+		compressed_size += ret;
+	}
+
+	r_compressed.resize(compressed_size);
+	return OK;
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -90,7 +186,8 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
-	file->store_32(PACK_FORMAT_VERSION);
+	version_ofs = file->get_position();
+	file->store_32(PACK_FORMAT_VERSION); // Raised to V4 on flush if needed.
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
 	file->store_32(GODOT_VERSION_PATCH);
@@ -107,7 +204,14 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	dir_base_ofs = file->get_position();
 	file->store_64(0); // Directory offset.
 
-	for (int i = 0; i < 16; i++) {
+	// V4 header fields, reserved in V3.
+	index_base_ofs = file->get_position();
+	file->store_64(0); // Index offset.
+	file->store_64(0); // Compression dictionary offset.
+	file->store_32(0); // Compression dictionary size.
+	file->store_32(0); // Compression block size.
+
+	for (int i = 0; i < 10; i++) {
 		file->store_32(0); // Reserved.
 	}
 
@@ -172,6 +276,18 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	}
 	pf.encrypted = p_encrypt;
 
+	// Encrypted files are stored as is, as encryption would undo most of the gains of compressing them first.
+	if (compression_enabled && !p_encrypt && !data.is_empty()) {
+		Vector<uint8_t> compressed;
+		Error err = _compress(data, compressed);
+		ERR_FAIL_COND_V(err != OK, err);
+		if (compressed.size() < data.size()) {
+			pf.compressed = true;
+			data = compressed;
+		}
+	}
+	pf.stored_size = data.size();
+
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
@@ -204,12 +320,50 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
-	int dir_padding = _get_pad(alignment, file->get_position());
-	for (int i = 0; i < dir_padding; i++) {
+	_pad_to_alignment();
+
+	// Only packs using compression need V4, others stay readable by engines which only know V3.
+	bool use_v4 = compression_enabled;
+	for (int i = 0; i < files.size() && !use_v4; i++) {
+		use_v4 = files[i].compressed;
+	}
+	const uint32_t version = use_v4 ? PACK_FORMAT_VERSION_V4 : PACK_FORMAT_VERSION;
+	if (version == PACK_FORMAT_VERSION_V4) {
+		const uint64_t end = file->get_position();
+		file->seek(version_ofs);
+		file->store_32(version);
+		file->seek(index_base_ofs + 20);
+		file->store_32(PACK_COMPRESSION_BLOCK_SIZE);
+		file->seek(end);
+	}
+
+	if (version == PACK_FORMAT_VERSION_V4 && !compression_dictionary.is_empty()) {
+		uint64_t dictionary_offset = file->get_position();
+		file->store_buffer(compression_dictionary);
+		file->seek(index_base_ofs + 8);
+		file->store_64(dictionary_offset);
+		file->store_32(uint32_t(compression_dictionary.size()));
+		file->seek(dictionary_offset + compression_dictionary.size());
+
+		_pad_to_alignment();
+	}
+
+	// The sorted index is only written to V4 packs, and can't be encrypted.
+	Error err = (version == PACK_FORMAT_VERSION_V4 && !enc_dir) ? _write_index(p_verbose) : _write_directory(version, p_verbose);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	file.unref();
+	return OK;
+}
+
+void PCKPacker::_pad_to_alignment() {
+	int pad = _get_pad(alignment, file->get_position());
+	for (int i = 0; i < pad; i++) {
 		file->store_8(0);
 	}
+}
 
-	// Write directory.
+Error PCKPacker::_write_directory(uint32_t p_version, bool p_verbose) {
 	uint64_t dir_offset = file->get_position();
 	file->seek(dir_base_ofs);
 	file->store_64(dir_offset);
@@ -245,15 +399,10 @@ Error PCKPacker::flush(bool p_verbose) {
 		fhead->store_64(files[i].ofs - file_base);
 		fhead->store_64(files[i].size);
 		fhead->store_buffer(files[i].md5.ptr(), 16);
-
-		uint32_t flags = 0;
-		if (files[i].encrypted) {
-			flags |= PACK_FILE_ENCRYPTED;
+		fhead->store_32(_get_flags(files[i]));
+		if (p_version == PACK_FORMAT_VERSION_V4) {
+			fhead->store_64(files[i].stored_size);
 		}
-		if (files[i].removal) {
-			flags |= PACK_FILE_REMOVAL;
-		}
-		fhead->store_32(flags);
 
 		if (p_verbose) {
 			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", i, file_num, float(i) / file_num * 100, files[i].src_path, files[i].path));
@@ -265,12 +414,99 @@ Error PCKPacker::flush(bool p_verbose) {
 		fae.unref();
 	}
 
-	file.unref();
 	return OK;
 }
 
+Error PCKPacker::_write_index(bool p_verbose) {
+	struct IndexEntry {
+		uint8_t path_md5[16];
+		int file_idx = 0;
+	};
+
+	struct IndexEntryComparator {
+		_FORCE_INLINE_ bool operator()(const IndexEntry &p_a, const IndexEntry &p_b) const {
+			int cmp = memcmp(p_a.path_md5, p_b.path_md5, 16);
+			// Keep insertion order for duplicated paths, so the last one added wins below.
+			return cmp < 0 || (cmp == 0 && p_a.file_idx < p_b.file_idx);
+		}
+	};
+
+	const int file_num = files.size();
+	LocalVector<IndexEntry> sorted;
+	sorted.reserve(file_num);
+	for (int i = 0; i < file_num; i++) {
+		IndexEntry entry;
+		memcpy(entry.path_md5, files[i].path.md5_buffer().ptr(), 16);
+		entry.file_idx = i;
+		sorted.push_back(entry);
+	}
+	sorted.sort_custom<IndexEntryComparator>();
+
+	LocalVector<IndexEntry> unique;
+	unique.reserve(sorted.size());
+	for (uint32_t i = 0; i < sorted.size(); i++) {
+		if (i + 1 < sorted.size() && memcmp(sorted[i].path_md5, sorted[i + 1].path_md5, 16) == 0) {
+			continue;
+		}
+		unique.push_back(sorted[i]);
+	}
+
+	Vector<uint8_t> entries;
+	entries.resize_initialized(unique.size() * PACK_INDEX_ENTRY_SIZE);
+	Vector<uint8_t> strings;
+	for (uint32_t i = 0; i < unique.size(); i++) {
+		const File &pf = files[unique[i].file_idx];
+		uint8_t *w = entries.ptrw() + i * PACK_INDEX_ENTRY_SIZE;
+
+		memcpy(w, unique[i].path_md5, 16);
+		encode_uint64(pf.ofs - file_base, w + 16);
+		encode_uint64(pf.size, w + 24);
+		encode_uint64(pf.stored_size, w + 32);
+		memcpy(w + 40, pf.md5.ptr(), 16);
+		encode_uint32(_get_flags(pf), w + 56);
+		encode_uint32(uint32_t(strings.size()), w + 60);
+
+		CharString utf8_string = pf.path.utf8();
+		const int64_t string_ofs = strings.size();
+		strings.resize(string_ofs + utf8_string.length() + 1);
+		memcpy(strings.ptrw() + string_ofs, utf8_string.get_data(), utf8_string.length() + 1);
+
+		if (p_verbose) {
+			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", i, unique.size(), float(i) / unique.size() * 100, pf.src_path, pf.path));
+		}
+	}
+	ERR_FAIL_COND_V_MSG(strings.size() > UINT32_MAX, ERR_OUT_OF_MEMORY, "Pack index string table is too large.");
+
+	uint64_t index_offset = file->get_position();
+	file->seek(index_base_ofs);
+	file->store_64(index_offset);
+	file->seek(index_offset);
+
+	file->store_32(unique.size());
+	file->store_32(uint32_t(strings.size()));
+	file->store_buffer(entries);
+	file->store_buffer(strings);
+
+	return OK;
+}
+
+uint32_t PCKPacker::_get_flags(const File &p_file) {
+	uint32_t flags = 0;
+	if (p_file.encrypted) {
+		flags |= PACK_FILE_ENCRYPTED;
+	}
+	if (p_file.removal) {
+		flags |= PACK_FILE_REMOVAL;
+	}
+	if (p_file.compressed) {
+		flags |= PACK_FILE_COMPRESSED;
+	}
+	return flags;
+}
+
 PCKPacker::~PCKPacker() {
 	if (file.is_valid()) {
 		flush();
 	}
+	_free_compression_state();
 }
@@ -33,6 +33,8 @@
 #include "core/object/ref_counted.h"
 
 class FileAccess;
+struct ZSTD_CCtx_s;
+struct ZSTD_CDict_s;
 
 class PCKPacker : public RefCounted {
 	GDCLASS(PCKPacker, RefCounted);
@@ -43,29 +45,54 @@ class PCKPacker : public RefCounted {
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
+	uint64_t version_ofs = 0;
 	uint64_t file_base = 0;
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
+	uint64_t index_base_ofs = 0;
+
+	bool compression_enabled = false;
+	int compression_level = 3;
+	Vector<uint8_t> compression_dictionary;
+	ZSTD_CCtx_s *zstd_cctx = nullptr;
+	ZSTD_CDict_s *zstd_cdict = nullptr;
 
 	static void _bind_methods();
 
+	Error _compress(const Vector<uint8_t> &p_data, Vector<uint8_t> &r_compressed);
+	void _free_compression_state();
+
 	struct File {
 		String path;
 		String src_path;
 		uint64_t ofs = 0;
 		uint64_t size = 0;
+		uint64_t stored_size = 0;
 		bool encrypted = false;
 		bool removal = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
 
+	static uint32_t _get_flags(const File &p_file);
+	void _pad_to_alignment();
+	Error _write_directory(uint32_t p_version, bool p_verbose);
+	Error _write_index(bool p_verbose);
+
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
 	Error flush(bool p_verbose = false);
 
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+	void set_compression_level(int p_level);
+	int get_compression_level() const;
+	Error set_compression_dictionary(const Vector<uint8_t> &p_dictionary);
+	Vector<uint8_t> get_compression_dictionary() const;
+
 	PCKPacker() {}
 	~PCKPacker();
 };
@@ -53,6 +53,7 @@
 #include "bvh_tree.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 
 #define BVHTREE_CLASS BVH_Tree<T, NUM_TREES, 2, MAX_ITEMS, USER_PAIR_TEST_FUNCTION, USER_CULL_TEST_FUNCTION, USE_PAIRS, BOUNDS, POINT>
@@ -89,6 +90,14 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// When enabled, the tree queries for pairing are spread over the WorkerThreadPool
+	// once enough items have changed. Pair and unpair callbacks are still made on the
+	// calling thread, in the same order as the single threaded path.
+	void params_set_threaded_pairing(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		_threaded_pairing = p_enable;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -399,6 +408,44 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Unlocked versions of cull_aabb() and cull_segment(), which several threads can call at once
+	// as long as the tree isn't modified meanwhile. Each thread passes its own r_hits as scratch space.
+	int cull_aabb_concurrent(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, LocalVector<uint32_t> &r_hits, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) const {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tree_collision_mask = p_tree_collision_mask;
+		params.abb.from(p_aabb);
+		params.tester = p_tester;
+
+		tree.cull_aabb_ref_ids(params, r_hits);
+		tree.cull_translate_ref_ids(params, r_hits);
+
+		return params.result_count_overall;
+	}
+
+	int cull_segment_concurrent(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, LocalVector<uint32_t> &r_hits, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) const {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tester = p_tester;
+		params.tree_collision_mask = p_tree_collision_mask;
+
+		params.segment.from = p_from;
+		params.segment.to = p_to;
+
+		tree.cull_segment_ref_ids(params, r_hits);
+		tree.cull_translate_ref_ids(params, r_hits);
+
+		return params.result_count_overall;
+	}
+
 	int cull_convex(const Vector<Plane> &p_convex, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF) {
 		BVH_LOCKED_FUNCTION
 		if (!p_convex.size()) {
@@ -443,6 +490,11 @@ private:
 		params.result_array = nullptr;
 		params.subindex_array = nullptr;
 
+		if (_threaded_pairing && changed_items.size() >= THREADED_PAIRING_MIN_ITEMS) {
+			_check_for_collisions_threaded(params, p_full_check);
+			return;
+		}
+
 		for (const BVHHandle &h : changed_items) {
 			// use the expanded aabb for pairing
 			const BOUNDS &expanded_aabb = tree._pairs[h.id()].expanded_aabb;
@@ -479,6 +531,52 @@ private:
 		_reset();
 	}
 
+	// The tree isn't modified while pairing, so the culls for each changed item can run
+	// in parallel, each into its own hit list. The leavers and enterers are then processed
+	// serially in changed_items order, so callbacks are identical to the loop above.
+	void _check_for_collisions_threaded(const typename BVHTREE_CLASS::CullParams &p_params, bool p_full_check) {
+		uint32_t num_changed = changed_items.size();
+		if (_changed_item_hits.size() < num_changed) {
+			_changed_item_hits.resize(num_changed);
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_changed_item, &p_params, num_changed, -1, true, SNAME("BVHPairCull"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t n = 0; n < num_changed; n++) {
+			const BVHHandle &h = changed_items[n];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+
+			_find_leavers(h, abb, p_full_check);
+
+			uint32_t changed_item_ref_id = h.id();
+
+			for (const uint32_t ref_id : _changed_item_hits[n]) {
+				if (ref_id == changed_item_ref_id) {
+					continue;
+				}
+
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
+	void _cull_changed_item(uint32_t p_index, const typename BVHTREE_CLASS::CullParams *p_params) {
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params = *p_params;
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb_ref_ids(params, _changed_item_hits[p_index]);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -772,6 +870,12 @@ private:
 	LocalVector<BVHHandle> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// Per changed item cull results for threaded pairing, kept between updates
+	// to avoid reallocating.
+	static const uint32_t THREADED_PAIRING_MIN_ITEMS = 128;
+	bool _threaded_pairing = false;
+	LocalVector<LocalVector<uint32_t>> _changed_item_hits;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
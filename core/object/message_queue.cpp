@@ -34,37 +34,119 @@
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
 
+#include <atomic>
 #include <cstdio>
 
-#ifdef DEV_ENABLED
-// Includes safety checks to ensure that a queue set as a thread singleton override
-// is only ever called from the thread it was set for.
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		DEV_ASSERT(!is_current_thread_override);  \
-		mutex.lock();                             \
-	} else {                                      \
-		DEV_ASSERT(is_current_thread_override);   \
-	}
-#else
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.lock();                             \
+void CallQueue::_lock(Lane &p_lane) {
+	if (this == MessageQueue::thread_singleton) {
+		DEV_ASSERT(&p_lane != &main_lane || is_current_thread_override);
+		return;
+	}
+	// Includes safety checks to ensure that a queue set as a thread singleton override
+	// is only ever called from the thread it was set for.
+	DEV_ASSERT(&p_lane != &main_lane || !is_current_thread_override);
+	p_lane.mutex->lock();
+}
+
+void CallQueue::_unlock(Lane &p_lane) {
+	if (this != MessageQueue::thread_singleton) {
+		p_lane.mutex->unlock();
+	}
+}
+
+// Slots of the threads that currently own thread lanes, one bit per slot.
+static std::atomic<uint64_t> thread_lane_slots_used = { 0 };
+
+// Claims the lowest free slot for the calling thread and gives it back when the thread exits.
+struct ThreadLaneSlot {
+	static constexpr uint32_t NONE = UINT32_MAX;
+	uint32_t index = NONE;
+
+	ThreadLaneSlot(uint32_t p_max_slots) {
+		uint64_t used = thread_lane_slots_used.load(std::memory_order_relaxed);
+		while (true) {
+			uint32_t free_index = NONE;
+			for (uint32_t i = 0; i < p_max_slots; i++) {
+				if (!(used & (uint64_t(1) << i))) {
+					free_index = i;
+					break;
+				}
+			}
+			if (free_index == NONE) {
+				return;
+			}
+			if (thread_lane_slots_used.compare_exchange_weak(used, used | (uint64_t(1) << free_index), std::memory_order_acquire, std::memory_order_relaxed)) {
+				index = free_index;
+				return;
+			}
+		}
 	}
-#endif
 
-#define UNLOCK_MUTEX                              \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.unlock();                           \
+	~ThreadLaneSlot() {
+		if (index != NONE) {
+			thread_lane_slots_used.fetch_and(~(uint64_t(1) << index), std::memory_order_release);
+		}
 	}
+};
+
+CallQueue::ThreadLane *CallQueue::_get_thread_lane() {
+	static_assert(MAX_THREAD_LANES <= 64, "Thread lane slots are tracked in a 64-bit mask.");
+
+	struct ThreadLaneCache {
+		uint64_t queue_id = 0;
+		ThreadLane *lane = nullptr;
+	};
+	static thread_local ThreadLaneCache cache;
+
+	if (likely(cache.queue_id == queue_id)) {
+		return cache.lane;
+	}
+
+	// Without a slot (more than MAX_THREAD_LANES threads pushing at once), the main lane is used.
+	static thread_local ThreadLaneSlot slot(MAX_THREAD_LANES);
+	ThreadLane *lane = nullptr;
+
+	if (slot.index != ThreadLaneSlot::NONE) {
+		MutexLock lock(thread_lanes_mutex);
+
+		lane = slot_lanes[slot.index];
+		if (!lane) {
+			// Pages, and any calls left by the previous thread of this slot, are kept.
+			lane = memnew(ThreadLane);
+			lane->mutex = &lane->lane_mutex;
+			slot_lanes[slot.index] = lane;
+			thread_lanes[thread_lane_count.get()] = lane;
+			// Publish the lane after it's fully set up, so the flush can read it without locking.
+			thread_lane_count.increment();
+		}
+	}
+
+	cache.queue_id = queue_id;
+	cache.lane = lane;
+	return lane;
+}
+
+CallQueue::Lane *CallQueue::_lock_lane() {
+	if (thread_lanes_enabled && this != MessageQueue::thread_singleton && Thread::get_caller_id() != Thread::get_main_id()) {
+		ThreadLane *lane = _get_thread_lane();
+		if (lane) {
+			_lock(*lane);
+			return lane;
+		}
+	}
+	_lock(main_lane);
+	return &main_lane;
+}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+void CallQueue::_add_page(Lane &p_lane) {
+	if (p_lane.pages_used == p_lane.page_bytes.size()) {
+		p_lane.pages.push_back(allocator->alloc());
+		p_lane.page_bytes.push_back(0);
+		pages_allocated.increment();
+		page_allocations.increment();
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+	p_lane.page_bytes[p_lane.pages_used] = 0;
+	p_lane.pages_used++;
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -88,23 +170,23 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
+	Lane *lane = _lock_lane();
 
-	_ensure_first_page();
+	_ensure_first_page(*lane);
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((lane->page_bytes[lane->pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (lane->pages_used == max_pages) {
 			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+			_unlock(*lane);
 			statistics();
-			UNLOCK_MUTEX;
 			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
+		_add_page(*lane);
 	}
 
-	Page *page = pages[pages_used - 1];
+	Page *page = lane->pages[lane->pages_used - 1];
 
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+	uint8_t *buffer_end = &page->data[lane->page_bytes[lane->pages_used - 1]];
 
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
@@ -126,36 +208,35 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
+	lane->page_bytes[lane->pages_used - 1] += room_needed;
 
-	UNLOCK_MUTEX;
+	_unlock(*lane);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
+	Lane *lane = _lock_lane();
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
+	_ensure_first_page(*lane);
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((lane->page_bytes[lane->pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (lane->pages_used == max_pages) {
 			String type;
 			if (ObjectDB::get_instance(p_id)) {
 				type = ObjectDB::get_instance(p_id)->get_class();
 			}
 			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+			_unlock(*lane);
 			statistics();
-
-			UNLOCK_MUTEX;
 			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
+		_add_page(*lane);
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+	Page *page = lane->pages[lane->pages_used - 1];
+	uint8_t *buffer_end = &page->data[lane->page_bytes[lane->pages_used - 1]];
 
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
@@ -167,31 +248,31 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	lane->page_bytes[lane->pages_used - 1] += room_needed;
+	_unlock(*lane);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
+	Lane *lane = _lock_lane();
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
+	_ensure_first_page(*lane);
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((lane->page_bytes[lane->pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (lane->pages_used == max_pages) {
 			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+			_unlock(*lane);
 			statistics();
-			UNLOCK_MUTEX;
 			return ERR_OUT_OF_MEMORY;
 		}
-		_add_page();
+		_add_page(*lane);
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+	Page *page = lane->pages[lane->pages_used - 1];
+	uint8_t *buffer_end = &page->data[lane->page_bytes[lane->pages_used - 1]];
 
 	Message *msg = memnew_placement(buffer_end, Message);
 
@@ -200,8 +281,8 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	lane->page_bytes[lane->pages_used - 1] += room_needed;
+	_unlock(*lane);
 
 	return OK;
 }
@@ -223,27 +304,21 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
-Error CallQueue::flush() {
-	LOCK_MUTEX;
+uint32_t CallQueue::_flush_lane(Lane &p_lane) {
+	_lock(p_lane);
 
-	if (pages.is_empty()) {
+	if (p_lane.pages.is_empty()) {
 		// Never allocated
-		UNLOCK_MUTEX;
-		return OK; // Do nothing.
-	}
-
-	if (flushing) {
-		UNLOCK_MUTEX;
-		return ERR_BUSY;
+		_unlock(p_lane);
+		return 0;
 	}
 
-	flushing = true;
-
 	uint32_t i = 0;
 	uint32_t offset = 0;
+	uint32_t message_count = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	while (i < p_lane.pages_used && offset < p_lane.page_bytes[i]) {
+		Page *page = p_lane.pages[i];
 
 		//lock on each iteration, so a call can re-add itself to the message queue
 
@@ -256,10 +331,11 @@ Error CallQueue::flush() {
 
 		//pre-advance so this function is reentrant
 		offset += advance;
+		message_count++;
 
 		Object *target = message->callable.get_object();
 
-		UNLOCK_MUTEX;
+		_unlock(p_lane);
 
 		switch (message->type & FLAG_MASK) {
 			case TYPE_CALL: {
@@ -290,33 +366,72 @@ Error CallQueue::flush() {
 
 		message->~Message();
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
+		_lock(p_lane);
+		if (offset == p_lane.page_bytes[i]) {
 			i++;
 			offset = 0;
 		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	p_lane.page_bytes[0] = 0;
+	p_lane.pages_used = 1;
+
+	_unlock(p_lane);
+	return message_count;
+}
+
+Error CallQueue::flush() {
+	_lock(main_lane);
+
+	if (main_lane.pages.is_empty() && thread_lane_count.get() == 0) {
+		// Never allocated
+		_unlock(main_lane);
+		return OK; // Do nothing.
+	}
+
+	if (flushing) {
+		_unlock(main_lane);
+		return ERR_BUSY;
+	}
+
+	flushing = true;
+	_unlock(main_lane);
 
+	uint32_t message_count = _flush_lane(main_lane);
+
+	// Thread lanes are merged after the main lane, in the order they were created. Messages they push
+	// to the main lane while being called are flushed right after, as the main lane is reentrant too.
+	uint32_t thread_message_count = 0;
+	const uint32_t lane_count = thread_lane_count.get();
+	for (uint32_t i = 0; i < lane_count; i++) {
+		if (_lane_has_messages(*thread_lanes[i])) {
+			thread_message_count += _flush_lane(*thread_lanes[i]);
+		}
+	}
+	if (thread_message_count > 0) {
+		message_count += thread_message_count + _flush_lane(main_lane);
+	}
+
+	_lock(main_lane);
+	last_flush_messages = message_count;
+	max_flush_messages = MAX(max_flush_messages, message_count);
 	flushing = false;
-	UNLOCK_MUTEX;
+	_unlock(main_lane);
 	return OK;
 }
 
-void CallQueue::clear() {
-	LOCK_MUTEX;
+void CallQueue::_clear_lane(Lane &p_lane) {
+	_lock(p_lane);
 
-	if (pages.is_empty()) {
-		UNLOCK_MUTEX;
+	if (p_lane.pages.is_empty()) {
+		_unlock(p_lane);
 		return; // Nothing to clear.
 	}
 
-	for (uint32_t i = 0; i < pages_used; i++) {
+	for (uint32_t i = 0; i < p_lane.pages_used; i++) {
 		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+		while (offset < p_lane.page_bytes[i]) {
+			Page *page = p_lane.pages[i];
 
 			//lock on each iteration, so a call can re-add itself to the message queue
 
@@ -340,90 +455,110 @@ void CallQueue::clear() {
 		}
 	}
 
-	pages_used = 1;
-	page_bytes[0] = 0;
+	p_lane.pages_used = 1;
+	p_lane.page_bytes[0] = 0;
 
-	UNLOCK_MUTEX;
+	_unlock(p_lane);
+}
+
+void CallQueue::clear() {
+	_clear_lane(main_lane);
+	const uint32_t lane_count = thread_lane_count.get();
+	for (uint32_t i = 0; i < lane_count; i++) {
+		_clear_lane(*thread_lanes[i]);
+	}
 }
 
 void CallQueue::statistics() {
-	LOCK_MUTEX;
 	HashMap<StringName, int> set_count;
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
+	uint32_t pages_used = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+	const uint32_t lane_count = thread_lane_count.get();
+	for (uint32_t lane_idx = 0; lane_idx <= lane_count; lane_idx++) {
+		Lane &lane = lane_idx == 0 ? main_lane : *thread_lanes[lane_idx - 1];
+		_lock(lane);
+		pages_used += lane.pages_used;
 
-			//lock on each iteration, so a call can re-add itself to the message queue
+		for (uint32_t i = 0; i < lane.pages_used; i++) {
+			uint32_t offset = 0;
+			while (offset < lane.page_bytes[i]) {
+				Page *page = lane.pages[i];
 
-			Message *message = (Message *)&page->data[offset];
+				//lock on each iteration, so a call can re-add itself to the message queue
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+				Message *message = (Message *)&page->data[offset];
 
-			Object *target = message->callable.get_object();
+				uint32_t advance = sizeof(Message);
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+					advance += sizeof(Variant) * message->args;
+				}
 
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
-						}
+				Object *target = message->callable.get_object();
 
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
-						}
+				bool null_target = true;
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
 
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
+							call_count[message->callable]++;
+							null_target = false;
 						}
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
+
+							notify_count[message->notification]++;
+							null_target = false;
+						}
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
+
+							set_count[t]++;
+							null_target = false;
+						}
+					} break;
+				}
+				if (null_target) {
+					// Object was deleted.
+					fprintf(stdout, "Object was deleted while awaiting a callback.\n");
 
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				// Object was deleted.
-				fprintf(stdout, "Object was deleted while awaiting a callback.\n");
-
-				null_count++;
-			}
+					null_count++;
+				}
 
-			offset += advance;
+				offset += advance;
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+					Variant *args = (Variant *)(message + 1);
+					for (int k = 0; k < message->args; k++) {
+						args[k].~Variant();
+					}
 				}
-			}
 
-			message->~Message();
+				message->~Message();
+			}
 		}
+
+		_unlock(lane);
 	}
 
 	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "THREAD LANES: %d.\n", lane_count);
+	fprintf(stdout, "PAGES ALLOCATED: %d (%d bytes), %d allocations.\n", pages_allocated.get(), pages_allocated.get() * PAGE_SIZE_BYTES, (int)page_allocations.get());
+	fprintf(stdout, "MESSAGES IN LAST FLUSH: %d (max %d).\n", last_flush_messages, max_flush_messages);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -437,30 +572,60 @@ void CallQueue::statistics() {
 	for (const KeyValue<int, int> &E : notify_count) {
 		fprintf(stdout, "NOTIFY %d: %d.\n", E.key, E.value);
 	}
+}
 
-	UNLOCK_MUTEX;
+CallQueue::Stats CallQueue::get_stats() const {
+	Stats stats;
+	stats.thread_lanes = thread_lane_count.get();
+	stats.pages_allocated = pages_allocated.get();
+	stats.page_allocations = page_allocations.get();
+	stats.last_flush_messages = last_flush_messages;
+	stats.max_flush_messages = max_flush_messages;
+	return stats;
 }
 
 bool CallQueue::is_flushing() const {
 	return flushing;
 }
 
-bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
+bool CallQueue::_lane_has_messages(const Lane &p_lane) {
+	if (p_lane.pages_used == 0) {
 		return false;
 	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
+	if (p_lane.pages_used == 1 && p_lane.page_bytes[0] == 0) {
 		return false;
 	}
 
 	return true;
 }
 
+bool CallQueue::has_messages() const {
+	if (_lane_has_messages(main_lane)) {
+		return true;
+	}
+	const uint32_t lane_count = thread_lane_count.get();
+	for (uint32_t i = 0; i < lane_count; i++) {
+		if (_lane_has_messages(*thread_lanes[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return pages_allocated.get() * PAGE_SIZE_BYTES;
+}
+
+void CallQueue::set_thread_lanes_enabled(bool p_enabled) {
+	thread_lanes_enabled = p_enabled;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
+	static SafeNumeric<uint64_t> last_queue_id;
+	queue_id = last_queue_id.increment();
+	main_lane.mutex = &mutex;
+
 	if (p_custom_allocator) {
 		allocator = p_custom_allocator;
 		allocator_is_custom = true;
@@ -475,8 +640,15 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 CallQueue::~CallQueue() {
 	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	for (uint32_t i = 0; i < main_lane.pages.size(); i++) {
+		allocator->free(main_lane.pages[i]);
+	}
+	const uint32_t lane_count = thread_lane_count.get();
+	for (uint32_t i = 0; i < lane_count; i++) {
+		for (uint32_t j = 0; j < thread_lanes[i]->pages.size(); j++) {
+			allocator->free(thread_lanes[i]->pages[j]);
+		}
+		memdelete(thread_lanes[i]);
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
@@ -509,6 +681,7 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	set_thread_lanes_enabled(true);
 }
 
 MessageQueue::~MessageQueue() {
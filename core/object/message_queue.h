@@ -31,9 +31,11 @@
 #pragma once
 
 #include "core/object/object_id.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -65,17 +67,48 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
+	struct Lane {
+		Mutex *mutex = nullptr;
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		uint32_t pages_used = 0;
+	};
+
+	// Lane of a producer thread other than the flushing one. Each has its own lock,
+	// so producers only contend with the flush and not with each other.
+	// Lanes belong to a thread slot rather than to a thread: when a thread exits, its slot
+	// and the lanes of that slot in every queue are reused by the next thread that pushes.
+	struct ThreadLane : public Lane {
+		Mutex lane_mutex;
+	};
+
+	enum {
+		MAX_THREAD_LANES = 64,
+	};
+
 	Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	// Used by the flushing thread, by threads pushing through a thread singleton override,
+	// and by any thread when thread lanes are disabled or all taken.
+	Lane main_lane;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
 	bool flushing = false;
 
+	bool thread_lanes_enabled = false;
+	uint64_t queue_id = 0;
+	Mutex thread_lanes_mutex;
+	ThreadLane *thread_lanes[MAX_THREAD_LANES] = {}; // In creation order, for the flush.
+	ThreadLane *slot_lanes[MAX_THREAD_LANES] = {}; // By thread slot.
+	SafeNumeric<uint32_t> thread_lane_count;
+
+	SafeNumeric<uint32_t> pages_allocated;
+	SafeNumeric<uint64_t> page_allocations;
+	uint32_t last_flush_messages = 0;
+	uint32_t max_flush_messages = 0;
+
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
@@ -89,15 +122,26 @@ private:
 		};
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
+	_FORCE_INLINE_ void _ensure_first_page(Lane &p_lane) {
+		if (unlikely(p_lane.pages.is_empty())) {
+			p_lane.pages.push_back(allocator->alloc());
+			p_lane.page_bytes.push_back(0);
+			p_lane.pages_used = 1;
+			pages_allocated.increment();
+			page_allocations.increment();
 		}
 	}
 
-	void _add_page();
+	void _add_page(Lane &p_lane);
+
+	ThreadLane *_get_thread_lane();
+	Lane *_lock_lane();
+	void _lock(Lane &p_lane);
+	void _unlock(Lane &p_lane);
+
+	uint32_t _flush_lane(Lane &p_lane);
+	void _clear_lane(Lane &p_lane);
+	static bool _lane_has_messages(const Lane &p_lane);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -143,15 +187,28 @@ public:
 	Error push_notification(Object *p_object, int p_notification);
 	Error push_set(Object *p_object, const StringName &p_prop, const Variant &p_value);
 
+	struct Stats {
+		uint32_t thread_lanes = 0;
+		uint32_t pages_allocated = 0;
+		uint64_t page_allocations = 0;
+		uint32_t last_flush_messages = 0;
+		uint32_t max_flush_messages = 0;
+	};
+
 	Error flush();
 	void clear();
 	void statistics();
+	Stats get_stats() const;
 
 	bool has_messages() const;
 
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	// When enabled, threads other than the main one push to their own lane.
+	// Flushing processes the main lane first, then the thread lanes in the order they were created.
+	void set_thread_lanes_enabled(bool p_enabled);
+
 	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
@@ -42,21 +42,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1207,19 +1192,43 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+Object::SignalData::SlotSnapshot *Object::SignalData::acquire_snapshot() {
+	if (!snapshot) {
+		snapshot = memnew(SlotSnapshot);
+		snapshot->refcount.init();
+		snapshot->callables.reserve(slot_map.size());
+		snapshot->flags.reserve(slot_map.size());
+		for (const KeyValue<Callable, Slot> &slot_kv : slot_map) {
+			snapshot->callables.push_back(slot_kv.value.conn.callable);
+			snapshot->flags.push_back(slot_kv.value.conn.flags);
+			snapshot->has_one_shot = snapshot->has_one_shot || (slot_kv.value.conn.flags & CONNECT_ONE_SHOT);
+		}
+	}
+	snapshot->refcount.ref();
+	return snapshot;
+}
+
+void Object::SignalData::release_snapshot(SlotSnapshot *p_snapshot) {
+	if (p_snapshot->refcount.unref()) {
+		memdelete(p_snapshot);
+	}
+}
+
+void Object::SignalData::invalidate_snapshot() {
+	if (snapshot) {
+		release_snapshot(snapshot);
+		snapshot = nullptr;
+	}
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	// Connecting or disconnecting replaces the snapshot instead of modifying it,
+	// so it can be iterated without holding the lock.
+	SignalData::SlotSnapshot *snapshot = nullptr;
 
 	{
 		OBJ_SIGNAL_LOCK
@@ -1239,32 +1248,21 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		// which is needed in certain edge cases; e.g., https://github.com/godotengine/godot/issues/73889.
 		Ref<RefCounted> rc = Ref<RefCounted>(Object::cast_to<RefCounted>(this));
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
-		}
-
-		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		snapshot = s->acquire_snapshot();
 
 		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		if (snapshot->has_one_shot) {
+			for (uint32_t i = 0; i < snapshot->callables.size(); ++i) {
+				bool disconnect = snapshot->flags[i] & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-				disconnect = false;
-			}
+				if (disconnect && (snapshot->flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+					// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+					disconnect = false;
+				}
 #endif
-			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+				if (disconnect) {
+					_disconnect(p_name, snapshot->callables[i]);
+				}
 			}
 		}
 	}
@@ -1273,9 +1271,10 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
+	const uint32_t slot_count = snapshot->callables.size();
 	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+		const Callable &callable = snapshot->callables[i];
+		const uint32_t &flags = snapshot->flags[i];
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1311,14 +1310,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
+	SignalData::release_snapshot(snapshot);
 
 	return err;
 }
@@ -1545,6 +1537,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->invalidate_snapshot();
 
 	return OK;
 }
@@ -1625,6 +1618,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->invalidate_snapshot();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
@@ -39,6 +39,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/callable_bind.h"
@@ -617,9 +618,37 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// Immutable copy of the connections, shared by emissions until they change,
+		// so that emitting doesn't need to copy callables nor allocate.
+		struct SlotSnapshot {
+			SafeRefCount refcount;
+			LocalVector<Callable> callables;
+			LocalVector<uint32_t> flags;
+			bool has_one_shot = false;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		SlotSnapshot *snapshot = nullptr;
 		bool removable = false;
+
+		SlotSnapshot *acquire_snapshot();
+		static void release_snapshot(SlotSnapshot *p_snapshot);
+		void invalidate_snapshot();
+
+		SignalData() {}
+		SignalData(const SignalData &p_from) :
+				user(p_from.user), slot_map(p_from.slot_map), removable(p_from.removable) {}
+		SignalData &operator=(const SignalData &p_from) {
+			if (this != &p_from) {
+				invalidate_snapshot();
+				user = p_from.user;
+				slot_map = p_from.slot_map;
+				removable = p_from.removable;
+			}
+			return *this;
+		}
+		~SignalData() { invalidate_snapshot(); }
 	};
 	friend struct _ObjectSignalLock;
 	mutable Mutex *signal_mutex = nullptr;
@@ -1081,3 +1110,21 @@ public:
 	static void debug_objects(DebugFunc p_func);
 	static int get_object_count();
 };
+
+#ifdef DEBUG_ENABLED
+// Marks an object as being in a call, so it can't be freed from inside it.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+#endif
@@ -30,6 +30,7 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/debugger/trace_events.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
@@ -53,6 +54,8 @@ thread_local WorkerThreadPool::UnlockableLocks WorkerThreadPool::unlockable_lock
 #endif
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	TRACE_ZONE("WorkerThreadPool::_process_task");
+
 #ifdef THREADS_ENABLED
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
@@ -92,22 +95,28 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// Handling a group
 		bool do_post = false;
 
+		const uint32_t chunk_size = p_task->group->chunk_size;
 		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
+			// Claim a whole chunk at once to keep traffic on the shared counter low.
+			// Chunks are small enough that tasks finishing early take over the remaining ones.
+			uint32_t from = p_task->group->index.postadd(chunk_size);
 
-			if (work_index >= p_task->group->max) {
+			if (from >= p_task->group->max) {
 				break;
 			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
+			uint32_t to = MIN(from + chunk_size, p_task->group->max);
+			for (uint32_t work_index = from; work_index < to; work_index++) {
+				if (p_task->native_group_func) {
+					p_task->native_group_func(p_task->native_func_userdata, work_index);
+				} else if (p_task->template_userdata) {
+					p_task->template_userdata->callback_indexed(work_index);
+				} else {
+					p_task->callable.call(work_index);
+				}
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
+			uint32_t completed_amount = p_task->group->completed_index.add(to - from);
 
 			if (completed_amount == p_task->group->max) {
 				do_post = true;
@@ -121,6 +130,12 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		if (do_post) {
 			p_task->group->done_semaphore.post();
 			p_task->group->completed.set_to(true);
+
+			// The group can't be freed before this task is done with it, so it's safe to
+			// release its dependents here. Anyone registering later sees it completed.
+			task_mutex.lock();
+			_release_dependents(p_task->group->dependents, false);
+			task_mutex.unlock();
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -136,7 +151,12 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		task_allocator.free(p_task);
 	} else {
-		if (p_task->native_func) {
+		if (unlikely(p_task->cancelled)) {
+			// Only the cleanup is left to do.
+			if (p_task->template_userdata) {
+				memdelete(p_task->template_userdata);
+			}
+		} else if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
 		} else if (p_task->template_userdata) {
 			p_task->template_userdata->callback();
@@ -158,6 +178,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+		_release_dependents(p_task->dependents, p_task->cancelled);
 	}
 
 #ifdef THREADS_ENABLED
@@ -187,7 +208,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+
+		// Work posted by this same thread, or stealable from other threads, doesn't need the pool lock.
+		if (!thread_data->local_queue.pop(task_to_process)) {
+			task_to_process = thread_data->pool->_steal_task(thread_data);
+		}
+
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -200,17 +227,23 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				// Local queues are pushed to before the poster takes the lock to notify,
+				// so checking them again while holding it guarantees no wakeup is lost.
+				task_to_process = thread_data->pool->_steal_task(thread_data);
+				if (task_to_process) {
+					break;
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
 			}
 		}
 
@@ -239,15 +272,25 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 		control_cond_var.wait(p_lock);
 	}
 
+	_enqueue_tasks(p_tasks, p_count, p_high_priority, p_pump_task);
+}
+
+void WorkerThreadPool::_enqueue_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, bool p_pump_task) {
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// High-priority tasks posted from a pool thread (nested parallelism) go to its local queue,
+	// from which it pops them LIFO and the other threads steal them FIFO.
+	bool use_local_queue = p_high_priority && caller_pool_thread && !p_pump_task;
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			if (!use_local_queue || !caller_pool_thread->local_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -326,6 +369,28 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+// Must be called with task_mutex held.
+void WorkerThreadPool::_release_dependents(LocalVector<Task *> &p_dependents, bool p_cancel) {
+	for (Task *dependent : p_dependents) {
+		if (p_cancel) {
+			dependent->cancelled = true;
+		}
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies > 0) {
+			continue;
+		}
+		if (threads.is_empty()) {
+			task_mutex.unlock();
+			_process_task(dependent);
+			task_mutex.lock();
+		} else {
+			_enqueue_tasks(&dependent, 1, !dependent->low_priority, false);
+		}
+	}
+	p_dependents.clear();
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -338,11 +403,42 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(const ThreadData *p_thief) {
+	uint32_t thread_count = threads.size();
+	bool retry = true;
+	while (retry) {
+		retry = false;
+		for (uint32_t i = 1; i < thread_count; i++) {
+			ThreadData &victim = threads[(p_thief->index + i) % thread_count];
+			Task *task = nullptr;
+			if (victim.local_queue.steal(task)) {
+				return task;
+			}
+			if (!victim.local_queue.is_empty()) {
+				// Lost the race against another thief, but there's more left.
+				retry = true;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_are_local_queues_empty() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].local_queue.is_empty()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task, Span<TaskID> p_dependencies) {
+	DEV_ASSERT(!p_pump_task || p_dependencies.is_empty());
+
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
@@ -357,6 +453,33 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->is_pump_task = p_pump_task;
 	tasks.insert(id, task);
 
+	for (TaskID dependency_id : p_dependencies) {
+		Task **dependencyp = tasks.getptr(dependency_id);
+		if (dependencyp) {
+			Task *dependency = *dependencyp;
+			if (dependency->completed) {
+				if (dependency->cancelled) {
+					task->cancelled = true;
+				}
+			} else {
+				dependency->dependents.push_back(task);
+				task->pending_dependencies++;
+			}
+			continue;
+		}
+		Group **groupp = groups.getptr(dependency_id);
+		if (groupp && !(*groupp)->completed.is_set()) {
+			(*groupp)->dependents.push_back(task);
+			task->pending_dependencies++;
+		}
+	}
+
+	if (task->pending_dependencies) {
+		// Will be posted by whichever dependency completes last.
+		task->low_priority = !p_high_priority;
+		return id;
+	}
+
 #ifdef THREADS_ENABLED
 	if (p_pump_task) {
 		pump_task_count++;
@@ -400,6 +523,31 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task_bind(const Callable &p_actio
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_dependent_task(void (*p_func)(void *), void *p_userdata, Span<TaskID> p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_dependent_task(const Callable &p_action, const PackedInt64Array &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, false, p_dependencies);
+}
+
+bool WorkerThreadPool::cancel_task(TaskID p_task_id) {
+	MutexLock task_lock(task_mutex);
+	Task **taskp = tasks.getptr(p_task_id);
+	if (!taskp) {
+		ERR_FAIL_V_MSG(false, "Invalid Task ID.");
+	}
+	Task *task = *taskp;
+	if (task->completed || task->pool_thread_index != -1) {
+		// Too late.
+		return task->cancelled;
+	}
+	// It still has to go through the queue (or wait for its dependencies), but it will be
+	// completed without running, and so will be the tasks depending on it.
+	task->cancelled = true;
+	return true;
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -420,12 +568,13 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	Task *task = *taskp;
 
 	if (task->completed) {
+		Error err = task->cancelled ? ERR_SKIP : OK;
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
 			tasks.erase(p_task_id);
 			task_allocator.free(task);
 		}
 		task_mutex.unlock();
-		return OK;
+		return err;
 	}
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
@@ -451,10 +600,12 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 		task->waiting_user++;
 	}
 
+	Error err = OK;
 	if (caller_pool_thread) {
 		task_mutex.unlock();
 		_wait_collaboratively(caller_pool_thread, task);
 		task_mutex.lock();
+		err = task->cancelled ? ERR_SKIP : OK;
 		task->waiting_pool--;
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
 			tasks.erase(p_task_id);
@@ -464,6 +615,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 		task_mutex.unlock();
 		task->done_semaphore.wait();
 		task_mutex.lock();
+		err = task->cancelled ? ERR_SKIP : OK;
 		task->waiting_user--;
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
 			tasks.erase(p_task_id);
@@ -472,7 +624,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 
 	task_mutex.unlock();
-	return OK;
+	return err;
 }
 
 void WorkerThreadPool::_lock_unlockable_mutexes() {
@@ -528,7 +680,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !p_caller_pool_thread->local_queue.is_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -546,7 +698,11 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			// Own local tasks first, since they are likely what's being awaited.
+			// They are never pump tasks, so no need to check for that.
+			p_caller_pool_thread->local_queue.pop(task_to_process);
+
+			if (!task_to_process && p_caller_pool_thread->pool->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -556,6 +712,10 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
+			if (!task_to_process) {
+				task_to_process = _steal_task(p_caller_pool_thread);
+			}
+
 			if (!task_to_process) {
 				p_caller_pool_thread->awaited_task = p_task;
 
@@ -599,7 +759,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && _are_local_queues_empty()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -688,6 +848,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	} else {
 		group->tasks_used = p_tasks;
+		group->chunk_size = MAX(1u, (uint32_t)p_elements / (MAX(1u, (uint32_t)p_tasks) * GROUP_CHUNKS_PER_TASK));
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
 			Task *task = task_allocator.alloc();
@@ -914,6 +1075,8 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 	ClassDB::bind_method(D_METHOD("get_caller_task_id"), &WorkerThreadPool::get_caller_task_id);
+	ClassDB::bind_method(D_METHOD("add_dependent_task", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_dependent_task, DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("cancel_task", "task_id"), &WorkerThreadPool::cancel_task);
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
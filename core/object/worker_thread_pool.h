@@ -39,6 +39,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_queue.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -64,10 +65,12 @@ private:
 		SafeNumeric<uint32_t> index;
 		SafeNumeric<uint32_t> completed_index;
 		uint32_t max = 0;
+		uint32_t chunk_size = 1; // Elements claimed at once by a task, so idle tasks can take over the rest.
 		Semaphore done_semaphore;
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		LocalVector<Task *> dependents; // Guarded by task_mutex.
 	};
 
 	struct Task {
@@ -81,6 +84,7 @@ private:
 		bool completed : 1;
 		bool pending_notify_yield_over : 1;
 		bool is_pump_task : 1;
+		bool cancelled : 1;
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
 		uint32_t waiting_pool = 0;
@@ -88,17 +92,24 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		// Tasks and groups this one waits for. It's only posted once this reaches zero.
+		uint32_t pending_dependencies = 0;
+		// Tasks waiting for this one. Guarded by task_mutex.
+		LocalVector<Task *> dependents;
 
 		void free_template_userdata();
 		Task() :
 				completed(false),
 				pending_notify_yield_over(false),
 				is_pump_task(false),
+				cancelled(false),
 				task_elem(this) {}
 	};
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
+	static const uint32_t GROUP_CHUNKS_PER_TASK = 4;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -122,6 +133,9 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		// High-priority tasks posted from this thread. Only this thread pushes and pops;
+		// the others steal from it without needing the pool lock.
+		WorkStealingQueue<Task *, LOCAL_QUEUE_SIZE> local_queue;
 
 		ThreadData() :
 				signaled(false),
@@ -178,10 +192,15 @@ private:
 	void _process_task(Task *task);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task);
+	void _enqueue_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, bool p_pump_task);
+	void _release_dependents(LocalVector<Task *> &p_dependents, bool p_cancel);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
 
+	Task *_steal_task(const ThreadData *p_thief);
+	bool _are_local_queues_empty() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -193,7 +212,7 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task = false, Span<TaskID> p_dependencies = Span<TaskID>());
 	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
 
 	template <typename C, typename M, typename U>
@@ -245,6 +264,22 @@ public:
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String(), bool p_pump_task = false);
 	TaskID add_task_bind(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Dependent tasks are only posted once all the tasks and groups in p_dependencies have completed,
+	// so no thread has to be parked waiting in between. IDs no longer known to the pool (e.g., already
+	// awaited) are considered completed. If any dependency was cancelled, the dependent task is cancelled too.
+	template <typename C, typename M, typename U>
+	TaskID add_template_dependent_task(C *p_instance, M p_method, U p_userdata, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, false, p_dependencies);
+	}
+	TaskID add_native_dependent_task(void (*p_func)(void *), void *p_userdata, Span<TaskID> p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_dependent_task(const Callable &p_action, const PackedInt64Array &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	bool cancel_task(TaskID p_task_id);
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
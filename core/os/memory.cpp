@@ -30,6 +30,7 @@
 
 #include "memory.h"
 
+#include "core/os/small_block_allocator.h"
 #include "core/templates/safe_refcount.h"
 
 #include <cstdlib>
@@ -59,6 +60,7 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+SafeNumeric<uint64_t> Memory::total_allocated;
 #endif
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
@@ -101,11 +103,24 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem;
-	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
-	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+	void *mem = nullptr;
+#ifdef SMALL_BLOCK_ALLOCATOR_ENABLED
+	if (p_bytes + (prepad ? DATA_OFFSET : 0) <= SmallBlockAllocator::MAX_SIZE) {
+		mem = SmallBlockAllocator::alloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+		if constexpr (p_ensure_zero) {
+			if (mem) {
+				memset(mem, 0, p_bytes + (prepad ? DATA_OFFSET : 0));
+			}
+		}
+	}
+	if (!mem)
+#endif
+	{
+		if constexpr (p_ensure_zero) {
+			mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
+		} else {
+			mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+		}
 	}
 
 	ERR_FAIL_NULL_V(mem, nullptr);
@@ -119,6 +134,7 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
+		total_allocated.add(p_bytes);
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
@@ -129,6 +145,44 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 template void *Memory::alloc_static<true>(size_t p_bytes, bool p_pad_align);
 template void *Memory::alloc_static<false>(size_t p_bytes, bool p_pad_align);
 
+#ifdef SMALL_BLOCK_ALLOCATOR_ENABLED
+// Like realloc(), for blocks that may come from the small block allocator.
+static void *_realloc_system_or_small(void *p_mem, size_t p_bytes) {
+	if (!SmallBlockAllocator::owns(p_mem)) {
+		return realloc(p_mem, p_bytes);
+	}
+	size_t block_size = SmallBlockAllocator::get_block_size(p_mem);
+	if (p_bytes <= block_size && p_bytes > block_size / 2) {
+		// Still fits and doesn't waste too much.
+		return p_mem;
+	}
+	void *new_mem = SmallBlockAllocator::alloc(p_bytes);
+	if (!new_mem) {
+		new_mem = malloc(p_bytes);
+		if (!new_mem) {
+			return nullptr;
+		}
+	}
+	memcpy(new_mem, p_mem, MIN(p_bytes, block_size));
+	SmallBlockAllocator::free(p_mem);
+	return new_mem;
+}
+
+static void _free_system_or_small(void *p_mem) {
+	if (SmallBlockAllocator::owns(p_mem)) {
+		SmallBlockAllocator::free(p_mem);
+	} else {
+		free(p_mem);
+	}
+}
+
+#define MEMORY_REALLOC(m_mem, m_bytes) _realloc_system_or_small(m_mem, m_bytes)
+#define MEMORY_FREE(m_mem) _free_system_or_small(m_mem)
+#else
+#define MEMORY_REALLOC(m_mem, m_bytes) realloc(m_mem, m_bytes)
+#define MEMORY_FREE(m_mem) free(m_mem)
+#endif
+
 void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (p_memory == nullptr) {
 		return alloc_static(p_bytes, p_pad_align);
@@ -150,18 +204,19 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		if (p_bytes > *s) {
 			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
 			max_usage.exchange_if_greater(new_mem_usage);
+			total_allocated.add(p_bytes - *s);
 		} else {
 			mem_usage.sub(*s - p_bytes);
 		}
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			MEMORY_FREE(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)MEMORY_REALLOC(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
@@ -171,7 +226,14 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 			return mem + DATA_OFFSET;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+#ifdef SMALL_BLOCK_ALLOCATOR_ENABLED
+		if (p_bytes == 0) {
+			// realloc() would free it, so keep that behavior.
+			MEMORY_FREE(mem);
+			return nullptr;
+		}
+#endif
+		mem = (uint8_t *)MEMORY_REALLOC(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 
@@ -198,12 +260,15 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 		mem_usage.sub(*s);
 #endif
 
-		free(mem);
+		MEMORY_FREE(mem);
 	} else {
-		free(mem);
+		MEMORY_FREE(mem);
 	}
 }
 
+#undef MEMORY_REALLOC
+#undef MEMORY_FREE
+
 uint64_t Memory::get_mem_available() {
 	return -1; // 0xFFFF...
 }
@@ -224,6 +289,14 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_mem_total_allocated() {
+#ifdef DEBUG_ENABLED
+	return total_allocated.get();
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -40,6 +40,7 @@ class Memory {
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
+	static SafeNumeric<uint64_t> total_allocated;
 #endif
 
 public:
@@ -87,6 +88,8 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	// Sum of all the bytes ever allocated (including reallocation growth), to count allocations over a span of code.
+	static uint64_t get_mem_total_allocated();
 };
 
 class DefaultAllocator {
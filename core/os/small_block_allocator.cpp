@@ -0,0 +1,487 @@
+/**************************************************************************/
+/*  small_block_allocator.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_block_allocator.h"
+
+#include "core/os/memory.h"
+#include "core/os/spin_lock.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+
+constexpr uint32_t SLAB_SHIFT = 16;
+constexpr size_t SLAB_SIZE = size_t(1) << SLAB_SHIFT;
+constexpr uintptr_t SLAB_MASK = ~uintptr_t(SLAB_SIZE - 1);
+constexpr uint32_t SLABS_PER_SUPERBLOCK = 16;
+
+// Two-level map from slab address to slab, covering 48-bit address spaces.
+// Lets free() tell apart blocks from this allocator and any others without touching the memory.
+constexpr uint32_t PAGEMAP_BITS = 48 - SLAB_SHIFT;
+constexpr uint32_t PAGEMAP_LEAF_BITS = 16;
+constexpr uint32_t PAGEMAP_ROOT_BITS = PAGEMAP_BITS - PAGEMAP_LEAF_BITS;
+constexpr uint64_t PAGEMAP_LEAF_MASK = (uint64_t(1) << PAGEMAP_LEAF_BITS) - 1;
+
+constexpr uint32_t BLOCK_SIZES[SmallBlockAllocator::SIZE_CLASS_COUNT] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512 };
+static_assert(BLOCK_SIZES[SmallBlockAllocator::SIZE_CLASS_COUNT - 1] == SmallBlockAllocator::MAX_SIZE);
+
+constexpr uint32_t GRANULE_SHIFT = 4;
+constexpr uint32_t GRANULE_COUNT = (SmallBlockAllocator::MAX_SIZE >> GRANULE_SHIFT) + 1;
+
+struct SizeClassTable {
+	uint8_t size_class[GRANULE_COUNT] = {};
+	constexpr SizeClassTable() {
+		for (uint32_t i = 0; i < GRANULE_COUNT; i++) {
+			uint32_t c = 0;
+			while (BLOCK_SIZES[c] < (i << GRANULE_SHIFT)) {
+				c++;
+			}
+			size_class[i] = c;
+		}
+	}
+};
+constexpr SizeClassTable SIZE_CLASS_TABLE;
+
+struct Block {
+	Block *next;
+};
+
+struct Heap;
+
+// Lives at the start of its own slab. Everything but the atomics is only touched by the owner thread
+// (or under the global lock, while the slab has no owner).
+struct alignas(64) Slab {
+	Block *local_free = nullptr;
+	uint8_t *blocks = nullptr;
+	Slab *prev = nullptr;
+	Slab *next = nullptr;
+	uint32_t size_class = 0;
+	uint32_t block_size = 0;
+	uint32_t capacity = 0;
+	uint32_t carved = 0; // Blocks handed out from the never used area so far.
+	uint32_t used = 0; // Blocks handed out and not yet returned (freed remotely counts only once collected).
+
+	std::atomic<Heap *> owner = nullptr;
+	// Written by other threads, so keep it away from what the owner uses all the time.
+	alignas(64) std::atomic<Block *> remote_free = nullptr;
+};
+
+constexpr size_t SLAB_HEADER_SIZE = sizeof(Slab);
+static_assert(SLAB_HEADER_SIZE % 16 == 0);
+
+// Per-thread cache. Counters are only written by the owner thread; atomics just make reading
+// them from elsewhere well-defined.
+struct Heap {
+	Slab *current[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+	Slab *slabs[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+	std::atomic<int64_t> used[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+	std::atomic<uint64_t> allocations[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+	std::atomic<uint64_t> remote_frees[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+	Heap *registry_prev = nullptr;
+	Heap *registry_next = nullptr;
+};
+
+template <typename T>
+_FORCE_INLINE_ void owner_add(std::atomic<T> &p_counter, T p_value) {
+	p_counter.store(p_counter.load(std::memory_order_relaxed) + p_value, std::memory_order_relaxed);
+}
+
+// Global state, guarded by global_lock unless atomic.
+SpinLock global_lock;
+Slab *free_slabs = nullptr; // Empty slabs, not bound to any size class.
+Slab *abandoned_slabs[SmallBlockAllocator::SIZE_CLASS_COUNT] = {}; // Left behind by exited threads.
+Heap *heaps = nullptr;
+int64_t retired_used[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+uint64_t retired_allocations[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+uint64_t retired_remote_frees[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+std::atomic<uint64_t> slab_count[SmallBlockAllocator::SIZE_CLASS_COUNT] = {};
+std::atomic<uint64_t> reserved_bytes = 0;
+std::atomic<std::atomic<Slab *> *> pagemap[size_t(1) << PAGEMAP_ROOT_BITS] = {};
+
+_FORCE_INLINE_ Slab *pagemap_get(const void *p_ptr) {
+	uint64_t index = uint64_t(uintptr_t(p_ptr)) >> SLAB_SHIFT;
+	if (unlikely(index >> PAGEMAP_BITS)) {
+		return nullptr;
+	}
+	std::atomic<Slab *> *leaf = pagemap[index >> PAGEMAP_LEAF_BITS].load(std::memory_order_acquire);
+	if (!leaf) {
+		return nullptr;
+	}
+	return leaf[index & PAGEMAP_LEAF_MASK].load(std::memory_order_acquire);
+}
+
+// Must be called with global_lock held.
+bool pagemap_set(Slab *p_slab) {
+	uint64_t index = uint64_t(uintptr_t(p_slab)) >> SLAB_SHIFT;
+	if (index >> PAGEMAP_BITS) {
+		return false;
+	}
+	std::atomic<Slab *> *leaf = pagemap[index >> PAGEMAP_LEAF_BITS].load(std::memory_order_relaxed);
+	if (!leaf) {
+		leaf = (std::atomic<Slab *> *)calloc(size_t(1) << PAGEMAP_LEAF_BITS, sizeof(std::atomic<Slab *>));
+		if (!leaf) {
+			return false;
+		}
+		pagemap[index >> PAGEMAP_LEAF_BITS].store(leaf, std::memory_order_release);
+	}
+	leaf[index & PAGEMAP_LEAF_MASK].store(p_slab, std::memory_order_release);
+	return true;
+}
+
+// Must be called with global_lock held.
+Slab *acquire_slab_locked() {
+	if (!free_slabs) {
+		uint8_t *superblock = (uint8_t *)Memory::alloc_aligned_static(SLAB_SIZE * SLABS_PER_SUPERBLOCK, SLAB_SIZE);
+		if (!superblock) {
+			return nullptr;
+		}
+		if (uint64_t(uintptr_t(superblock + SLAB_SIZE * SLABS_PER_SUPERBLOCK)) >> (PAGEMAP_BITS + SLAB_SHIFT)) {
+			// Outside the range the map covers. Let the caller fall back to another allocator.
+			Memory::free_aligned_static(superblock);
+			return nullptr;
+		}
+		for (uint32_t i = 0; i < SLABS_PER_SUPERBLOCK; i++) {
+			Slab *slab = memnew_placement(superblock + i * SLAB_SIZE, Slab);
+			if (!pagemap_set(slab)) {
+				// Only the slabs already registered are usable; the rest of the superblock is wasted.
+				break;
+			}
+			slab->next = free_slabs;
+			free_slabs = slab;
+			reserved_bytes.fetch_add(SLAB_SIZE, std::memory_order_relaxed);
+		}
+		if (!free_slabs) {
+			return nullptr;
+		}
+	}
+	Slab *slab = free_slabs;
+	free_slabs = slab->next;
+	return slab;
+}
+
+void slab_init(Slab *p_slab, uint32_t p_size_class) {
+	p_slab->local_free = nullptr;
+	p_slab->blocks = (uint8_t *)p_slab + SLAB_HEADER_SIZE;
+	p_slab->prev = nullptr;
+	p_slab->next = nullptr;
+	p_slab->size_class = p_size_class;
+	p_slab->block_size = BLOCK_SIZES[p_size_class];
+	p_slab->capacity = (SLAB_SIZE - SLAB_HEADER_SIZE) / p_slab->block_size;
+	p_slab->carved = 0;
+	p_slab->used = 0;
+	p_slab->remote_free.store(nullptr, std::memory_order_relaxed);
+}
+
+_FORCE_INLINE_ bool slab_has_room(const Slab *p_slab) {
+	return p_slab->local_free || p_slab->carved < p_slab->capacity || p_slab->remote_free.load(std::memory_order_relaxed);
+}
+
+// Owner only.
+_FORCE_INLINE_ Block *slab_pop(Slab *p_slab, Heap *p_heap) {
+	Block *block = p_slab->local_free;
+	if (likely(block)) {
+		p_slab->local_free = block->next;
+	} else if (p_slab->carved < p_slab->capacity) {
+		block = (Block *)(p_slab->blocks + size_t(p_slab->carved) * p_slab->block_size);
+		p_slab->carved++;
+	} else if (p_slab->remote_free.load(std::memory_order_relaxed)) {
+		// Take over everything other threads have returned so far.
+		block = p_slab->remote_free.exchange(nullptr, std::memory_order_acquire);
+		uint32_t count = 0;
+		for (Block *b = block; b; b = b->next) {
+			count++;
+		}
+		p_slab->used -= count;
+		owner_add(p_heap->used[p_slab->size_class], -int64_t(count));
+		owner_add(p_heap->remote_frees[p_slab->size_class], uint64_t(count));
+		p_slab->local_free = block->next;
+	} else {
+		return nullptr;
+	}
+	p_slab->used++;
+	return block;
+}
+
+void heap_link_slab(Heap *p_heap, Slab *p_slab) {
+	Slab *&head = p_heap->slabs[p_slab->size_class];
+	p_slab->prev = nullptr;
+	p_slab->next = head;
+	if (head) {
+		head->prev = p_slab;
+	}
+	head = p_slab;
+}
+
+void heap_unlink_slab(Heap *p_heap, Slab *p_slab) {
+	if (p_slab->prev) {
+		p_slab->prev->next = p_slab->next;
+	} else {
+		p_heap->slabs[p_slab->size_class] = p_slab->next;
+	}
+	if (p_slab->next) {
+		p_slab->next->prev = p_slab->prev;
+	}
+	p_slab->prev = nullptr;
+	p_slab->next = nullptr;
+}
+
+Slab *heap_refill(Heap *p_heap, uint32_t p_size_class) {
+	for (Slab *slab = p_heap->slabs[p_size_class]; slab; slab = slab->next) {
+		if (slab != p_heap->current[p_size_class] && slab_has_room(slab)) {
+			p_heap->current[p_size_class] = slab;
+			return slab;
+		}
+	}
+
+	Slab *slab = nullptr;
+	{
+		global_lock.lock();
+		slab = abandoned_slabs[p_size_class];
+		if (slab) {
+			abandoned_slabs[p_size_class] = slab->next;
+			slab->next = nullptr;
+		} else {
+			slab = acquire_slab_locked();
+			if (slab) {
+				slab_init(slab, p_size_class);
+				slab_count[p_size_class].fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		global_lock.unlock();
+	}
+	if (!slab) {
+		return nullptr;
+	}
+
+	slab->owner.store(p_heap, std::memory_order_release);
+	heap_link_slab(p_heap, slab);
+	p_heap->current[p_size_class] = slab;
+	return slab;
+}
+
+// Owner only. The slab is known to have no blocks out, so nobody else can be touching it.
+void heap_release_slab(Heap *p_heap, Slab *p_slab) {
+	heap_unlink_slab(p_heap, p_slab);
+	p_slab->owner.store(nullptr, std::memory_order_relaxed);
+	slab_count[p_slab->size_class].fetch_sub(1, std::memory_order_relaxed);
+
+	global_lock.lock();
+	p_slab->next = free_slabs;
+	free_slabs = p_slab;
+	global_lock.unlock();
+}
+
+thread_local Heap *tl_heap = nullptr;
+thread_local bool tl_heap_retired = false;
+
+struct HeapRetirer {
+	bool active = false;
+
+	~HeapRetirer() {
+		Heap *heap = tl_heap;
+		if (!heap) {
+			return;
+		}
+		// From now on, allocations from this thread go elsewhere, and its frees take the remote path.
+		tl_heap = nullptr;
+		tl_heap_retired = true;
+
+		global_lock.lock();
+		for (uint32_t c = 0; c < SmallBlockAllocator::SIZE_CLASS_COUNT; c++) {
+			Slab *slab = heap->slabs[c];
+			while (slab) {
+				Slab *next = slab->next;
+				slab->owner.store(nullptr, std::memory_order_release);
+				slab->prev = nullptr;
+				if (slab->used == 0) {
+					slab->next = free_slabs;
+					free_slabs = slab;
+					slab_count[c].fetch_sub(1, std::memory_order_relaxed);
+				} else {
+					slab->next = abandoned_slabs[c];
+					abandoned_slabs[c] = slab;
+				}
+				slab = next;
+			}
+			retired_used[c] += heap->used[c].load(std::memory_order_relaxed);
+			retired_allocations[c] += heap->allocations[c].load(std::memory_order_relaxed);
+			retired_remote_frees[c] += heap->remote_frees[c].load(std::memory_order_relaxed);
+		}
+		if (heap->registry_prev) {
+			heap->registry_prev->registry_next = heap->registry_next;
+		} else {
+			heaps = heap->registry_next;
+		}
+		if (heap->registry_next) {
+			heap->registry_next->registry_prev = heap->registry_prev;
+		}
+		global_lock.unlock();
+
+		heap->~Heap();
+		::free(heap);
+	}
+};
+
+thread_local HeapRetirer tl_heap_retirer;
+
+_FORCE_INLINE_ Heap *get_heap() {
+	Heap *heap = tl_heap;
+	if (likely(heap)) {
+		return heap;
+	}
+	if (tl_heap_retired) {
+		return nullptr;
+	}
+
+	void *mem = ::malloc(sizeof(Heap));
+	if (!mem) {
+		return nullptr;
+	}
+	heap = memnew_placement(mem, Heap);
+
+	global_lock.lock();
+	heap->registry_next = heaps;
+	if (heaps) {
+		heaps->registry_prev = heap;
+	}
+	heaps = heap;
+	global_lock.unlock();
+
+	tl_heap = heap;
+	// Touching it makes sure its destructor runs when the thread exits.
+	tl_heap_retirer.active = true;
+	return heap;
+}
+
+} // namespace
+
+void *SmallBlockAllocator::alloc(size_t p_bytes) {
+	if (unlikely(p_bytes > MAX_SIZE)) {
+		return nullptr;
+	}
+	Heap *heap = get_heap();
+	if (unlikely(!heap)) {
+		return nullptr;
+	}
+
+	uint32_t size_class = SIZE_CLASS_TABLE.size_class[(p_bytes + (1 << GRANULE_SHIFT) - 1) >> GRANULE_SHIFT];
+	Slab *slab = heap->current[size_class];
+	Block *block = slab ? slab_pop(slab, heap) : nullptr;
+	while (unlikely(!block)) {
+		slab = heap_refill(heap, size_class);
+		if (!slab) {
+			return nullptr;
+		}
+		block = slab_pop(slab, heap);
+	}
+
+	owner_add(heap->used[size_class], int64_t(1));
+	owner_add(heap->allocations[size_class], uint64_t(1));
+	return block;
+}
+
+void SmallBlockAllocator::free(void *p_ptr) {
+	Slab *slab = (Slab *)(uintptr_t(p_ptr) & SLAB_MASK);
+	Block *block = (Block *)p_ptr;
+	Heap *heap = tl_heap;
+
+	if (likely(heap && slab->owner.load(std::memory_order_relaxed) == heap)) {
+		block->next = slab->local_free;
+		slab->local_free = block;
+		slab->used--;
+		owner_add(heap->used[slab->size_class], int64_t(-1));
+		if (unlikely(slab->used == 0) && slab != heap->current[slab->size_class]) {
+			heap_release_slab(heap, slab);
+		}
+		return;
+	}
+
+	// Freed from a thread other than the owner. Leave it for the owner to collect.
+	Block *head = slab->remote_free.load(std::memory_order_relaxed);
+	do {
+		block->next = head;
+	} while (!slab->remote_free.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+}
+
+bool SmallBlockAllocator::owns(const void *p_ptr) {
+	return pagemap_get(p_ptr) != nullptr;
+}
+
+size_t SmallBlockAllocator::get_block_size(const void *p_ptr) {
+	const Slab *slab = (const Slab *)(uintptr_t(p_ptr) & SLAB_MASK);
+	return slab->block_size;
+}
+
+uint32_t SmallBlockAllocator::get_size_class_block_size(uint32_t p_size_class) {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_size_class, SIZE_CLASS_COUNT, 0);
+	return BLOCK_SIZES[p_size_class];
+}
+
+void SmallBlockAllocator::get_stats(SizeClassStats r_stats[SIZE_CLASS_COUNT]) {
+	int64_t used[SIZE_CLASS_COUNT];
+	global_lock.lock();
+	for (uint32_t c = 0; c < SIZE_CLASS_COUNT; c++) {
+		used[c] = retired_used[c];
+		r_stats[c].allocations = retired_allocations[c];
+		r_stats[c].remote_frees = retired_remote_frees[c];
+	}
+	for (const Heap *heap = heaps; heap; heap = heap->registry_next) {
+		for (uint32_t c = 0; c < SIZE_CLASS_COUNT; c++) {
+			used[c] += heap->used[c].load(std::memory_order_relaxed);
+			r_stats[c].allocations += heap->allocations[c].load(std::memory_order_relaxed);
+			r_stats[c].remote_frees += heap->remote_frees[c].load(std::memory_order_relaxed);
+		}
+	}
+	global_lock.unlock();
+
+	for (uint32_t c = 0; c < SIZE_CLASS_COUNT; c++) {
+		r_stats[c].block_size = BLOCK_SIZES[c];
+		// Blocks freed remotely but not collected yet still count as used. Snapshots of
+		// different threads aren't taken at once, so clamp transient negative sums.
+		r_stats[c].blocks_used = used[c] > 0 ? uint64_t(used[c]) : 0;
+		r_stats[c].slabs = slab_count[c].load(std::memory_order_relaxed);
+		r_stats[c].blocks_reserved = r_stats[c].slabs * ((SLAB_SIZE - SLAB_HEADER_SIZE) / BLOCK_SIZES[c]);
+	}
+}
+
+uint64_t SmallBlockAllocator::get_total_used_bytes() {
+	SizeClassStats stats[SIZE_CLASS_COUNT];
+	get_stats(stats);
+	uint64_t total = 0;
+	for (uint32_t c = 0; c < SIZE_CLASS_COUNT; c++) {
+		total += stats[c].blocks_used * stats[c].block_size;
+	}
+	return total;
+}
+
+uint64_t SmallBlockAllocator::get_total_reserved_bytes() {
+	return reserved_bytes.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*  small_block_allocator.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Allocator for the small blocks the engine churns through constantly (Variant internals,
+// CowData, HashMap elements, Callables, etc.), built to avoid contention between threads.
+// - Requests are rounded up to one of a few size classes, and served from 64 KiB slabs
+//   holding blocks of a single class.
+// - Every thread owns its slabs, so allocating and freeing from the owning thread takes
+//   no locks and no atomic read-modify-write operations.
+// - Blocks freed by other threads are pushed to a lock-free list in their slab, which the
+//   owner takes over in one go once it runs out of local blocks.
+// - Slabs left behind by exited threads are adopted by threads needing more of the same class.
+// Memory routes allocations through this when built with `small_block_allocator=yes`
+// (SMALL_BLOCK_ALLOCATOR_ENABLED). It can also be used directly, regardless of that setting.
+
+class SmallBlockAllocator {
+public:
+	static constexpr uint32_t SIZE_CLASS_COUNT = 16;
+	static constexpr size_t MAX_SIZE = 512;
+
+	struct SizeClassStats {
+		uint32_t block_size = 0;
+		uint64_t blocks_used = 0;
+		uint64_t blocks_reserved = 0;
+		uint64_t slabs = 0;
+		uint64_t allocations = 0;
+		uint64_t remote_frees = 0;
+	};
+
+	// Returns nullptr if the size is too big, or the calling thread can't have a cache anymore
+	// (e.g., it's exiting). Callers must be ready to fall back to another allocator.
+	static void *alloc(size_t p_bytes);
+	// Only valid for blocks for which owns() is true.
+	static void free(void *p_ptr);
+	static bool owns(const void *p_ptr);
+	// Usable size of a block for which owns() is true.
+	static size_t get_block_size(const void *p_ptr);
+
+	static uint32_t get_size_class_block_size(uint32_t p_size_class);
+	static void get_stats(SizeClassStats r_stats[SIZE_CLASS_COUNT]);
+	static uint64_t get_total_used_bytes();
+	static uint64_t get_total_reserved_bytes();
+};
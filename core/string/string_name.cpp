@@ -32,6 +32,7 @@
 
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 
 struct StringName::Table {
@@ -39,9 +40,24 @@ struct StringName::Table {
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
+	// The table is split into shards, each owning a contiguous range of buckets,
+	// so threads interning or releasing unrelated names don't contend for one lock.
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	constexpr static uint32_t SHARD_PAGE_SIZE = 256;
+
+	struct Shard {
+		BinaryMutex mutex;
+		PagedAllocator<_Data, false, SHARD_PAGE_SIZE> allocator;
+		char padding[Thread::CACHE_LINE_BYTES];
+	};
+
 	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	static inline Shard shards[SHARD_COUNT];
+
+	_FORCE_INLINE_ static Shard &get_shard(uint32_t p_idx) {
+		return shards[p_idx >> (TABLE_BITS - SHARD_BITS)];
+	}
 };
 
 void StringName::setup() {
@@ -53,8 +69,6 @@ void StringName::setup() {
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
-
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
@@ -86,6 +100,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
+		Table::Shard &shard = Table::get_shard(i);
+		MutexLock lock(shard.mutex);
 		while (Table::table[i]) {
 			_Data *d = Table::table[i];
 			if (d->static_count.get() != d->refcount.get()) {
@@ -97,7 +113,7 @@ void StringName::cleanup() {
 			}
 
 			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+			shard.allocator.free(d);
 		}
 	}
 	if (lost_strings) {
@@ -110,7 +126,9 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		const uint32_t idx = _data->hash & Table::TABLE_MASK;
+		Table::Shard &shard = Table::get_shard(idx);
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
@@ -118,14 +136,13 @@ void StringName::unref() {
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
 			Table::table[idx] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
-		Table::allocator.free(_data);
+		shard.allocator.free(_data);
 	}
 
 	_data = nullptr;
@@ -213,7 +230,8 @@ StringName::StringName(const char *p_name, bool p_static) {
 	const uint32_t hash = String::hash(p_name);
 	const uint32_t idx = hash & Table::TABLE_MASK;
 
-	MutexLock lock(Table::mutex);
+	Table::Shard &shard = Table::get_shard(idx);
+	MutexLock lock(shard.mutex);
 	_data = Table::table[idx];
 
 	while (_data) {
@@ -237,7 +255,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return;
 	}
 
-	_data = Table::allocator.alloc();
+	_data = shard.allocator.alloc();
 	_data->name = p_name;
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
@@ -270,7 +288,8 @@ StringName::StringName(const String &p_name, bool p_static) {
 	const uint32_t hash = p_name.hash();
 	const uint32_t idx = hash & Table::TABLE_MASK;
 
-	MutexLock lock(Table::mutex);
+	Table::Shard &shard = Table::get_shard(idx);
+	MutexLock lock(shard.mutex);
 	_data = Table::table[idx];
 
 	while (_data) {
@@ -293,7 +312,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	_data = Table::allocator.alloc();
+	_data = shard.allocator.alloc();
 	_data->name = p_name;
 	_data->refcount.init();
 	_data->static_count.set(p_static ? 1 : 0);
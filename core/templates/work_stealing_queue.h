@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  work_stealing_queue.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Bounded single-owner, multi-thief deque (Chase-Lev), as described in
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al., 2013).
+// - Only the owner thread may call push() and pop(). They operate on the bottom end (LIFO).
+// - Any thread may call steal(). It operates on the top end (FIFO).
+// - The capacity is fixed; push() fails when full, so the caller must have a fallback.
+// None of the operations block or allocate.
+
+template <typename T, uint32_t Capacity = 256>
+class WorkStealingQueue {
+	static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+	static_assert(std::atomic<T>::is_always_lock_free);
+	static constexpr int64_t MASK = Capacity - 1;
+
+	// Owner and thieves hammer different ends, so keep them in different cache lines.
+	// Padding is used instead of align attributes because instances may live in arrays
+	// that don't honor over-alignment.
+	std::atomic<int64_t> top = 0;
+	char top_padding[Thread::CACHE_LINE_BYTES];
+	std::atomic<int64_t> bottom = 0;
+	char bottom_padding[Thread::CACHE_LINE_BYTES];
+	std::atomic<T> buffer[Capacity];
+
+public:
+	// Owner only.
+	_FORCE_INLINE_ bool push(T p_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		if (b - t >= (int64_t)Capacity) {
+			return false;
+		}
+		buffer[b & MASK].store(p_value, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// Owner only.
+	_FORCE_INLINE_ bool pop(T &r_value) {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+		if (t > b) {
+			// Empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+		r_value = buffer[b & MASK].load(std::memory_order_relaxed);
+		if (t == b) {
+			// Last element; race against thieves for it.
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	// Any thread. A false return may also mean another thief won the race for the element,
+	// so callers that need certainty must check is_empty() afterwards.
+	_FORCE_INLINE_ bool steal(T &r_value) {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+		if (t >= b) {
+			return false;
+		}
+		T value = buffer[t & MASK].load(std::memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return false;
+		}
+		r_value = value;
+		return true;
+	}
+
+	// Any thread. Only a hint unless called by the owner.
+	_FORCE_INLINE_ bool is_empty() const {
+		return bottom.load(std::memory_order_acquire) <= top.load(std::memory_order_acquire);
+	}
+
+	_FORCE_INLINE_ uint32_t size() const {
+		int64_t s = bottom.load(std::memory_order_acquire) - top.load(std::memory_order_acquire);
+		return s > 0 ? (uint32_t)s : 0;
+	}
+
+	WorkStealingQueue() {
+		for (uint32_t i = 0; i < Capacity; i++) {
+			buffer[i].store(T(), std::memory_order_relaxed);
+		}
+	}
+};
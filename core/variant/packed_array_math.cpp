@@ -0,0 +1,547 @@
+/**************************************************************************/
+/*  packed_array_math.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "packed_array_math.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PACKED_ARRAY_MATH_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define PACKED_ARRAY_MATH_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// A batch wraps the widest register available for T. Kernels finish the
+// remainder of a buffer with the single lane version, which is also what Batch
+// falls back to on targets without SSE2 or NEON.
+template <typename T>
+struct ScalarBatch {
+	typedef T Reg;
+	static constexpr int64_t WIDTH = 1;
+
+	static _ALWAYS_INLINE_ Reg load(const T *p_src) { return *p_src; }
+	static _ALWAYS_INLINE_ void store(T *p_dst, Reg p_reg) { *p_dst = p_reg; }
+	static _ALWAYS_INLINE_ Reg splat(T p_value) { return p_value; }
+	static _ALWAYS_INLINE_ Reg add(Reg p_a, Reg p_b) { return p_a + p_b; }
+	static _ALWAYS_INLINE_ Reg sub(Reg p_a, Reg p_b) { return p_a - p_b; }
+	static _ALWAYS_INLINE_ Reg mul(Reg p_a, Reg p_b) { return p_a * p_b; }
+	static _ALWAYS_INLINE_ Reg min(Reg p_a, Reg p_b) { return p_a < p_b ? p_a : p_b; }
+	static _ALWAYS_INLINE_ Reg max(Reg p_a, Reg p_b) { return p_a > p_b ? p_a : p_b; }
+	static _ALWAYS_INLINE_ T reduce_add(Reg p_reg) { return p_reg; }
+	static _ALWAYS_INLINE_ T reduce_min(Reg p_reg) { return p_reg; }
+	static _ALWAYS_INLINE_ T reduce_max(Reg p_reg) { return p_reg; }
+};
+
+template <typename T>
+struct Batch : ScalarBatch<T> {};
+
+#if defined(PACKED_ARRAY_MATH_SSE2)
+
+template <>
+struct Batch<float> {
+	typedef __m128 Reg;
+	static constexpr int64_t WIDTH = 4;
+
+	static _ALWAYS_INLINE_ Reg load(const float *p_src) { return _mm_loadu_ps(p_src); }
+	static _ALWAYS_INLINE_ void store(float *p_dst, Reg p_reg) { _mm_storeu_ps(p_dst, p_reg); }
+	static _ALWAYS_INLINE_ Reg splat(float p_value) { return _mm_set1_ps(p_value); }
+	static _ALWAYS_INLINE_ Reg add(Reg p_a, Reg p_b) { return _mm_add_ps(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg sub(Reg p_a, Reg p_b) { return _mm_sub_ps(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg mul(Reg p_a, Reg p_b) { return _mm_mul_ps(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg min(Reg p_a, Reg p_b) { return _mm_min_ps(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg max(Reg p_a, Reg p_b) { return _mm_max_ps(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg swap_pairs(Reg p_reg) { return _mm_shuffle_ps(p_reg, p_reg, _MM_SHUFFLE(2, 3, 0, 1)); }
+	static _ALWAYS_INLINE_ Reg swap_halves(Reg p_reg) { return _mm_movehl_ps(p_reg, p_reg); }
+	static _ALWAYS_INLINE_ float reduce_add(Reg p_reg) {
+		p_reg = _mm_add_ps(p_reg, swap_halves(p_reg));
+		return _mm_cvtss_f32(_mm_add_ss(p_reg, swap_pairs(p_reg)));
+	}
+	static _ALWAYS_INLINE_ float reduce_min(Reg p_reg) {
+		p_reg = _mm_min_ps(p_reg, swap_halves(p_reg));
+		return _mm_cvtss_f32(_mm_min_ss(p_reg, swap_pairs(p_reg)));
+	}
+	static _ALWAYS_INLINE_ float reduce_max(Reg p_reg) {
+		p_reg = _mm_max_ps(p_reg, swap_halves(p_reg));
+		return _mm_cvtss_f32(_mm_max_ss(p_reg, swap_pairs(p_reg)));
+	}
+};
+
+template <>
+struct Batch<double> {
+	typedef __m128d Reg;
+	static constexpr int64_t WIDTH = 2;
+
+	static _ALWAYS_INLINE_ Reg load(const double *p_src) { return _mm_loadu_pd(p_src); }
+	static _ALWAYS_INLINE_ void store(double *p_dst, Reg p_reg) { _mm_storeu_pd(p_dst, p_reg); }
+	static _ALWAYS_INLINE_ Reg splat(double p_value) { return _mm_set1_pd(p_value); }
+	static _ALWAYS_INLINE_ Reg add(Reg p_a, Reg p_b) { return _mm_add_pd(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg sub(Reg p_a, Reg p_b) { return _mm_sub_pd(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg mul(Reg p_a, Reg p_b) { return _mm_mul_pd(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg min(Reg p_a, Reg p_b) { return _mm_min_pd(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg max(Reg p_a, Reg p_b) { return _mm_max_pd(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg high(Reg p_reg) { return _mm_unpackhi_pd(p_reg, p_reg); }
+	static _ALWAYS_INLINE_ double reduce_add(Reg p_reg) { return _mm_cvtsd_f64(_mm_add_sd(p_reg, high(p_reg))); }
+	static _ALWAYS_INLINE_ double reduce_min(Reg p_reg) { return _mm_cvtsd_f64(_mm_min_sd(p_reg, high(p_reg))); }
+	static _ALWAYS_INLINE_ double reduce_max(Reg p_reg) { return _mm_cvtsd_f64(_mm_max_sd(p_reg, high(p_reg))); }
+};
+
+#elif defined(PACKED_ARRAY_MATH_NEON)
+
+template <>
+struct Batch<float> {
+	typedef float32x4_t Reg;
+	static constexpr int64_t WIDTH = 4;
+
+	static _ALWAYS_INLINE_ Reg load(const float *p_src) { return vld1q_f32(p_src); }
+	static _ALWAYS_INLINE_ void store(float *p_dst, Reg p_reg) { vst1q_f32(p_dst, p_reg); }
+	static _ALWAYS_INLINE_ Reg splat(float p_value) { return vdupq_n_f32(p_value); }
+	static _ALWAYS_INLINE_ Reg add(Reg p_a, Reg p_b) { return vaddq_f32(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg sub(Reg p_a, Reg p_b) { return vsubq_f32(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg mul(Reg p_a, Reg p_b) { return vmulq_f32(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg min(Reg p_a, Reg p_b) { return vminq_f32(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg max(Reg p_a, Reg p_b) { return vmaxq_f32(p_a, p_b); }
+	static _ALWAYS_INLINE_ float reduce_add(Reg p_reg) {
+		float32x2_t r = vadd_f32(vget_low_f32(p_reg), vget_high_f32(p_reg));
+		return vget_lane_f32(vpadd_f32(r, r), 0);
+	}
+	static _ALWAYS_INLINE_ float reduce_min(Reg p_reg) {
+		float32x2_t r = vmin_f32(vget_low_f32(p_reg), vget_high_f32(p_reg));
+		return vget_lane_f32(vpmin_f32(r, r), 0);
+	}
+	static _ALWAYS_INLINE_ float reduce_max(Reg p_reg) {
+		float32x2_t r = vmax_f32(vget_low_f32(p_reg), vget_high_f32(p_reg));
+		return vget_lane_f32(vpmax_f32(r, r), 0);
+	}
+};
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+template <>
+struct Batch<double> {
+	typedef float64x2_t Reg;
+	static constexpr int64_t WIDTH = 2;
+
+	static _ALWAYS_INLINE_ Reg load(const double *p_src) { return vld1q_f64(p_src); }
+	static _ALWAYS_INLINE_ void store(double *p_dst, Reg p_reg) { vst1q_f64(p_dst, p_reg); }
+	static _ALWAYS_INLINE_ Reg splat(double p_value) { return vdupq_n_f64(p_value); }
+	static _ALWAYS_INLINE_ Reg add(Reg p_a, Reg p_b) { return vaddq_f64(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg sub(Reg p_a, Reg p_b) { return vsubq_f64(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg mul(Reg p_a, Reg p_b) { return vmulq_f64(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg min(Reg p_a, Reg p_b) { return vminq_f64(p_a, p_b); }
+	static _ALWAYS_INLINE_ Reg max(Reg p_a, Reg p_b) { return vmaxq_f64(p_a, p_b); }
+	static _ALWAYS_INLINE_ double reduce_add(Reg p_reg) { return vaddvq_f64(p_reg); }
+	static _ALWAYS_INLINE_ double reduce_min(Reg p_reg) { return vminvq_f64(p_reg); }
+	static _ALWAYS_INLINE_ double reduce_max(Reg p_reg) { return vmaxvq_f64(p_reg); }
+};
+#endif // __aarch64__ || _M_ARM64
+
+#endif // PACKED_ARRAY_MATH_SSE2
+
+template <typename T>
+void _add_scalar(T *p_dst, int64_t p_count, T p_value) {
+	typedef Batch<T> B;
+	const typename B::Reg v = B::splat(p_value);
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		B::store(p_dst + i, B::add(B::load(p_dst + i), v));
+	}
+	for (; i < p_count; i++) {
+		p_dst[i] += p_value;
+	}
+}
+
+template <typename T>
+void _multiply_scalar(T *p_dst, int64_t p_count, T p_value) {
+	typedef Batch<T> B;
+	const typename B::Reg v = B::splat(p_value);
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		B::store(p_dst + i, B::mul(B::load(p_dst + i), v));
+	}
+	for (; i < p_count; i++) {
+		p_dst[i] *= p_value;
+	}
+}
+
+template <typename T>
+void _multiply_add_scalar(T *p_dst, int64_t p_count, T p_multiplier, T p_addend) {
+	typedef Batch<T> B;
+	const typename B::Reg m = B::splat(p_multiplier);
+	const typename B::Reg a = B::splat(p_addend);
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		B::store(p_dst + i, B::add(B::mul(B::load(p_dst + i), m), a));
+	}
+	for (; i < p_count; i++) {
+		p_dst[i] = p_dst[i] * p_multiplier + p_addend;
+	}
+}
+
+template <typename T>
+void _add_array(T *p_dst, const T *p_src, int64_t p_count) {
+	typedef Batch<T> B;
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		B::store(p_dst + i, B::add(B::load(p_dst + i), B::load(p_src + i)));
+	}
+	for (; i < p_count; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+template <typename T>
+void _multiply_array(T *p_dst, const T *p_src, int64_t p_count) {
+	typedef Batch<T> B;
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		B::store(p_dst + i, B::mul(B::load(p_dst + i), B::load(p_src + i)));
+	}
+	for (; i < p_count; i++) {
+		p_dst[i] *= p_src[i];
+	}
+}
+
+template <typename T>
+void _multiply_add_array(T *p_dst, const T *p_multipliers, const T *p_addends, int64_t p_count) {
+	typedef Batch<T> B;
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		B::store(p_dst + i, B::add(B::mul(B::load(p_dst + i), B::load(p_multipliers + i)), B::load(p_addends + i)));
+	}
+	for (; i < p_count; i++) {
+		p_dst[i] = p_dst[i] * p_multipliers[i] + p_addends[i];
+	}
+}
+
+template <typename T>
+void _clamp(T *p_dst, int64_t p_count, T p_min, T p_max) {
+	typedef Batch<T> B;
+	typedef ScalarBatch<T> S;
+	const typename B::Reg lo = B::splat(p_min);
+	const typename B::Reg hi = B::splat(p_max);
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		B::store(p_dst + i, B::max(B::min(B::load(p_dst + i), hi), lo));
+	}
+	for (; i < p_count; i++) {
+		p_dst[i] = S::max(S::min(p_dst[i], p_max), p_min);
+	}
+}
+
+template <typename T>
+void _lerp(T *p_dst, const T *p_to, int64_t p_count, T p_weight) {
+	typedef Batch<T> B;
+	const typename B::Reg w = B::splat(p_weight);
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		const typename B::Reg from = B::load(p_dst + i);
+		B::store(p_dst + i, B::add(from, B::mul(B::sub(B::load(p_to + i), from), w)));
+	}
+	for (; i < p_count; i++) {
+		p_dst[i] += (p_to[i] - p_dst[i]) * p_weight;
+	}
+}
+
+template <typename T>
+T _sum(const T *p_src, int64_t p_count) {
+	typedef Batch<T> B;
+	typename B::Reg acc = B::splat(0);
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		acc = B::add(acc, B::load(p_src + i));
+	}
+	T r = B::reduce_add(acc);
+	for (; i < p_count; i++) {
+		r += p_src[i];
+	}
+	return r;
+}
+
+template <typename T>
+T _dot(const T *p_a, const T *p_b, int64_t p_count) {
+	typedef Batch<T> B;
+	typename B::Reg acc = B::splat(0);
+	int64_t i = 0;
+	for (; i + B::WIDTH <= p_count; i += B::WIDTH) {
+		acc = B::add(acc, B::mul(B::load(p_a + i), B::load(p_b + i)));
+	}
+	T r = B::reduce_add(acc);
+	for (; i < p_count; i++) {
+		r += p_a[i] * p_b[i];
+	}
+	return r;
+}
+
+template <typename T>
+T _min(const T *p_src, int64_t p_count) {
+	typedef Batch<T> B;
+	typedef ScalarBatch<T> S;
+	if (p_count <= 0) {
+		return 0;
+	}
+	T r = p_src[0];
+	int64_t i = 0;
+	if (p_count >= B::WIDTH) {
+		typename B::Reg acc = B::load(p_src);
+		for (i = B::WIDTH; i + B::WIDTH <= p_count; i += B::WIDTH) {
+			acc = B::min(acc, B::load(p_src + i));
+		}
+		r = B::reduce_min(acc);
+	}
+	for (; i < p_count; i++) {
+		r = S::min(r, p_src[i]);
+	}
+	return r;
+}
+
+template <typename T>
+T _max(const T *p_src, int64_t p_count) {
+	typedef Batch<T> B;
+	typedef ScalarBatch<T> S;
+	if (p_count <= 0) {
+		return 0;
+	}
+	T r = p_src[0];
+	int64_t i = 0;
+	if (p_count >= B::WIDTH) {
+		typename B::Reg acc = B::load(p_src);
+		for (i = B::WIDTH; i + B::WIDTH <= p_count; i += B::WIDTH) {
+			acc = B::max(acc, B::load(p_src + i));
+		}
+		r = B::reduce_max(acc);
+	}
+	for (; i < p_count; i++) {
+		r = S::max(r, p_src[i]);
+	}
+	return r;
+}
+
+} // namespace
+
+namespace PackedArrayMath {
+
+void add_scalar(float *p_dst, int64_t p_count, float p_value) {
+	_add_scalar(p_dst, p_count, p_value);
+}
+
+void add_scalar(double *p_dst, int64_t p_count, double p_value) {
+	_add_scalar(p_dst, p_count, p_value);
+}
+
+void multiply_scalar(float *p_dst, int64_t p_count, float p_value) {
+	_multiply_scalar(p_dst, p_count, p_value);
+}
+
+void multiply_scalar(double *p_dst, int64_t p_count, double p_value) {
+	_multiply_scalar(p_dst, p_count, p_value);
+}
+
+void multiply_add_scalar(float *p_dst, int64_t p_count, float p_multiplier, float p_addend) {
+	_multiply_add_scalar(p_dst, p_count, p_multiplier, p_addend);
+}
+
+void multiply_add_scalar(double *p_dst, int64_t p_count, double p_multiplier, double p_addend) {
+	_multiply_add_scalar(p_dst, p_count, p_multiplier, p_addend);
+}
+
+void add_array(float *p_dst, const float *p_src, int64_t p_count) {
+	_add_array(p_dst, p_src, p_count);
+}
+
+void add_array(double *p_dst, const double *p_src, int64_t p_count) {
+	_add_array(p_dst, p_src, p_count);
+}
+
+void multiply_array(float *p_dst, const float *p_src, int64_t p_count) {
+	_multiply_array(p_dst, p_src, p_count);
+}
+
+void multiply_array(double *p_dst, const double *p_src, int64_t p_count) {
+	_multiply_array(p_dst, p_src, p_count);
+}
+
+void multiply_add_array(float *p_dst, const float *p_multipliers, const float *p_addends, int64_t p_count) {
+	_multiply_add_array(p_dst, p_multipliers, p_addends, p_count);
+}
+
+void multiply_add_array(double *p_dst, const double *p_multipliers, const double *p_addends, int64_t p_count) {
+	_multiply_add_array(p_dst, p_multipliers, p_addends, p_count);
+}
+
+void clamp(float *p_dst, int64_t p_count, float p_min, float p_max) {
+	_clamp(p_dst, p_count, p_min, p_max);
+}
+
+void clamp(double *p_dst, int64_t p_count, double p_min, double p_max) {
+	_clamp(p_dst, p_count, p_min, p_max);
+}
+
+void lerp(float *p_dst, const float *p_to, int64_t p_count, float p_weight) {
+	_lerp(p_dst, p_to, p_count, p_weight);
+}
+
+void lerp(double *p_dst, const double *p_to, int64_t p_count, double p_weight) {
+	_lerp(p_dst, p_to, p_count, p_weight);
+}
+
+float sum(const float *p_src, int64_t p_count) {
+	return _sum(p_src, p_count);
+}
+
+double sum(const double *p_src, int64_t p_count) {
+	return _sum(p_src, p_count);
+}
+
+float min(const float *p_src, int64_t p_count) {
+	return _min(p_src, p_count);
+}
+
+double min(const double *p_src, int64_t p_count) {
+	return _min(p_src, p_count);
+}
+
+float max(const float *p_src, int64_t p_count) {
+	return _max(p_src, p_count);
+}
+
+double max(const double *p_src, int64_t p_count) {
+	return _max(p_src, p_count);
+}
+
+float dot(const float *p_a, const float *p_b, int64_t p_count) {
+	return _dot(p_a, p_b, p_count);
+}
+
+double dot(const double *p_a, const double *p_b, int64_t p_count) {
+	return _dot(p_a, p_b, p_count);
+}
+
+// Vector3 is three tightly packed reals, so a buffer of them can be handled
+// as a flat buffer three times as long.
+static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
+
+void add_array(Vector3 *p_dst, const Vector3 *p_src, int64_t p_count) {
+	_add_array((real_t *)p_dst, (const real_t *)p_src, p_count * 3);
+}
+
+void multiply_array(Vector3 *p_dst, const Vector3 *p_src, int64_t p_count) {
+	_multiply_array((real_t *)p_dst, (const real_t *)p_src, p_count * 3);
+}
+
+void multiply_scalar(Vector3 *p_dst, int64_t p_count, real_t p_value) {
+	_multiply_scalar((real_t *)p_dst, p_count * 3, p_value);
+}
+
+void lerp(Vector3 *p_dst, const Vector3 *p_to, int64_t p_count, real_t p_weight) {
+	_lerp((real_t *)p_dst, (const real_t *)p_to, p_count * 3, p_weight);
+}
+
+// The per-axis operations below stay on the interleaved layout. Swizzling to
+// lanes and back costs about as much as the arithmetic it would save, and the
+// plain loops are simple enough for the compiler to schedule well.
+
+void add_vector(Vector3 *p_dst, int64_t p_count, const Vector3 &p_value) {
+	for (int64_t i = 0; i < p_count; i++) {
+		p_dst[i] += p_value;
+	}
+}
+
+void clamp(Vector3 *p_dst, int64_t p_count, const Vector3 &p_min, const Vector3 &p_max) {
+	typedef ScalarBatch<real_t> S;
+	for (int64_t i = 0; i < p_count; i++) {
+		Vector3 &v = p_dst[i];
+		v.x = S::max(S::min(v.x, p_max.x), p_min.x);
+		v.y = S::max(S::min(v.y, p_max.y), p_min.y);
+		v.z = S::max(S::min(v.z, p_max.z), p_min.z);
+	}
+}
+
+void transform(Vector3 *p_dst, int64_t p_count, const Transform3D &p_transform) {
+	const Basis &b = p_transform.basis;
+	const Vector3 &o = p_transform.origin;
+	for (int64_t i = 0; i < p_count; i++) {
+		const Vector3 v = p_dst[i];
+		p_dst[i] = Vector3(
+				b.rows[0].x * v.x + b.rows[0].y * v.y + b.rows[0].z * v.z + o.x,
+				b.rows[1].x * v.x + b.rows[1].y * v.y + b.rows[1].z * v.z + o.y,
+				b.rows[2].x * v.x + b.rows[2].y * v.y + b.rows[2].z * v.z + o.z);
+	}
+}
+
+void normalize(Vector3 *p_dst, int64_t p_count) {
+	for (int64_t i = 0; i < p_count; i++) {
+		p_dst[i].normalize();
+	}
+}
+
+void lengths(const Vector3 *p_src, int64_t p_count, float *r_lengths) {
+	for (int64_t i = 0; i < p_count; i++) {
+		r_lengths[i] = p_src[i].length();
+	}
+}
+
+void dot(const Vector3 *p_src, int64_t p_count, const Vector3 &p_with, float *r_dots) {
+	for (int64_t i = 0; i < p_count; i++) {
+		r_dots[i] = p_src[i].dot(p_with);
+	}
+}
+
+Vector3 sum(const Vector3 *p_src, int64_t p_count) {
+	Vector3 r;
+	for (int64_t i = 0; i < p_count; i++) {
+		r += p_src[i];
+	}
+	return r;
+}
+
+Vector3 min(const Vector3 *p_src, int64_t p_count) {
+	if (p_count <= 0) {
+		return Vector3();
+	}
+	Vector3 r = p_src[0];
+	for (int64_t i = 1; i < p_count; i++) {
+		r = r.min(p_src[i]);
+	}
+	return r;
+}
+
+Vector3 max(const Vector3 *p_src, int64_t p_count) {
+	if (p_count <= 0) {
+		return Vector3();
+	}
+	Vector3 r = p_src[0];
+	for (int64_t i = 1; i < p_count; i++) {
+		r = r.max(p_src[i]);
+	}
+	return r;
+}
+
+} // namespace PackedArrayMath
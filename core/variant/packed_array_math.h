@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  packed_array_math.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/transform_3d.h"
+#include "core/math/vector3.h"
+
+// Bulk math kernels backing the packed array methods bound in variant_call.cpp.
+// Element-wise operations on float and double buffers use SSE2 or NEON when the
+// target provides them and fall back to plain loops otherwise.
+namespace PackedArrayMath {
+
+// p_dst[i] += p_value
+void add_scalar(float *p_dst, int64_t p_count, float p_value);
+void add_scalar(double *p_dst, int64_t p_count, double p_value);
+// p_dst[i] *= p_value
+void multiply_scalar(float *p_dst, int64_t p_count, float p_value);
+void multiply_scalar(double *p_dst, int64_t p_count, double p_value);
+// p_dst[i] = p_dst[i] * p_multiplier + p_addend
+void multiply_add_scalar(float *p_dst, int64_t p_count, float p_multiplier, float p_addend);
+void multiply_add_scalar(double *p_dst, int64_t p_count, double p_multiplier, double p_addend);
+
+// p_dst[i] += p_src[i]
+void add_array(float *p_dst, const float *p_src, int64_t p_count);
+void add_array(double *p_dst, const double *p_src, int64_t p_count);
+// p_dst[i] *= p_src[i]
+void multiply_array(float *p_dst, const float *p_src, int64_t p_count);
+void multiply_array(double *p_dst, const double *p_src, int64_t p_count);
+// p_dst[i] = p_dst[i] * p_multipliers[i] + p_addends[i]
+void multiply_add_array(float *p_dst, const float *p_multipliers, const float *p_addends, int64_t p_count);
+void multiply_add_array(double *p_dst, const double *p_multipliers, const double *p_addends, int64_t p_count);
+
+void clamp(float *p_dst, int64_t p_count, float p_min, float p_max);
+void clamp(double *p_dst, int64_t p_count, double p_min, double p_max);
+// p_dst[i] += (p_to[i] - p_dst[i]) * p_weight
+void lerp(float *p_dst, const float *p_to, int64_t p_count, float p_weight);
+void lerp(double *p_dst, const double *p_to, int64_t p_count, double p_weight);
+
+// Reductions accumulate in several lanes, so the result can differ from a
+// sequential loop in the last bits. min() and max() return 0 for empty input.
+float sum(const float *p_src, int64_t p_count);
+double sum(const double *p_src, int64_t p_count);
+float min(const float *p_src, int64_t p_count);
+double min(const double *p_src, int64_t p_count);
+float max(const float *p_src, int64_t p_count);
+double max(const double *p_src, int64_t p_count);
+float dot(const float *p_a, const float *p_b, int64_t p_count);
+double dot(const double *p_a, const double *p_b, int64_t p_count);
+
+// Vector3 buffers. Component-wise operations that don't depend on the axis go
+// through the flat kernels above on the underlying reals.
+void add_array(Vector3 *p_dst, const Vector3 *p_src, int64_t p_count);
+void multiply_array(Vector3 *p_dst, const Vector3 *p_src, int64_t p_count);
+void multiply_scalar(Vector3 *p_dst, int64_t p_count, real_t p_value);
+void lerp(Vector3 *p_dst, const Vector3 *p_to, int64_t p_count, real_t p_weight);
+void add_vector(Vector3 *p_dst, int64_t p_count, const Vector3 &p_value);
+void clamp(Vector3 *p_dst, int64_t p_count, const Vector3 &p_min, const Vector3 &p_max);
+void transform(Vector3 *p_dst, int64_t p_count, const Transform3D &p_transform);
+void normalize(Vector3 *p_dst, int64_t p_count);
+void lengths(const Vector3 *p_src, int64_t p_count, float *r_lengths);
+void dot(const Vector3 *p_src, int64_t p_count, const Vector3 &p_with, float *r_dots);
+Vector3 sum(const Vector3 *p_src, int64_t p_count);
+Vector3 min(const Vector3 *p_src, int64_t p_count);
+Vector3 max(const Vector3 *p_src, int64_t p_count);
+
+} // namespace PackedArrayMath
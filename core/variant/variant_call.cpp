@@ -38,6 +38,7 @@
 #include "core/os/os.h"
 #include "core/templates/a_hash_map.h"
 #include "core/templates/local_vector.h"
+#include "core/variant/packed_array_math.h"
 
 typedef void (*VariantFunc)(Variant &r_ret, Variant &p_self, const Variant **p_args);
 typedef void (*VariantConstructFunc)(Variant &r_ret, const Variant **p_args);
@@ -1167,6 +1168,136 @@ struct _VariantCall {
 		return ret;
 	}
 
+	// Bulk math on PackedFloat32Array and PackedFloat64Array, see packed_array_math.h.
+
+	template <typename T>
+	static void func_PackedFloatArray_add_scalar(Vector<T> *p_instance, double p_value) {
+		PackedArrayMath::add_scalar(p_instance->ptrw(), p_instance->size(), T(p_value));
+	}
+
+	template <typename T>
+	static void func_PackedFloatArray_multiply_scalar(Vector<T> *p_instance, double p_value) {
+		PackedArrayMath::multiply_scalar(p_instance->ptrw(), p_instance->size(), T(p_value));
+	}
+
+	template <typename T>
+	static void func_PackedFloatArray_multiply_add_scalar(Vector<T> *p_instance, double p_multiplier, double p_addend) {
+		PackedArrayMath::multiply_add_scalar(p_instance->ptrw(), p_instance->size(), T(p_multiplier), T(p_addend));
+	}
+
+	template <typename T>
+	static void func_PackedFloatArray_add_array(Vector<T> *p_instance, const Vector<T> &p_array) {
+		ERR_FAIL_COND_MSG(p_array.size() != p_instance->size(), "The array must have the same size as this array.");
+		PackedArrayMath::add_array(p_instance->ptrw(), p_array.ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static void func_PackedFloatArray_multiply_array(Vector<T> *p_instance, const Vector<T> &p_array) {
+		ERR_FAIL_COND_MSG(p_array.size() != p_instance->size(), "The array must have the same size as this array.");
+		PackedArrayMath::multiply_array(p_instance->ptrw(), p_array.ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static void func_PackedFloatArray_multiply_add_array(Vector<T> *p_instance, const Vector<T> &p_multipliers, const Vector<T> &p_addends) {
+		ERR_FAIL_COND_MSG(p_multipliers.size() != p_instance->size() || p_addends.size() != p_instance->size(), "The multipliers and addends must have the same size as this array.");
+		PackedArrayMath::multiply_add_array(p_instance->ptrw(), p_multipliers.ptr(), p_addends.ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static void func_PackedFloatArray_clamp(Vector<T> *p_instance, double p_min, double p_max) {
+		ERR_FAIL_COND_MSG(p_min > p_max, "The minimum must not be greater than the maximum.");
+		PackedArrayMath::clamp(p_instance->ptrw(), p_instance->size(), T(p_min), T(p_max));
+	}
+
+	template <typename T>
+	static void func_PackedFloatArray_lerp(Vector<T> *p_instance, const Vector<T> &p_to, double p_weight) {
+		ERR_FAIL_COND_MSG(p_to.size() != p_instance->size(), "The target array must have the same size as this array.");
+		PackedArrayMath::lerp(p_instance->ptrw(), p_to.ptr(), p_instance->size(), T(p_weight));
+	}
+
+	template <typename T>
+	static double func_PackedFloatArray_sum(Vector<T> *p_instance) {
+		return PackedArrayMath::sum(p_instance->ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static double func_PackedFloatArray_min(Vector<T> *p_instance) {
+		return PackedArrayMath::min(p_instance->ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static double func_PackedFloatArray_max(Vector<T> *p_instance) {
+		return PackedArrayMath::max(p_instance->ptr(), p_instance->size());
+	}
+
+	template <typename T>
+	static double func_PackedFloatArray_dot(Vector<T> *p_instance, const Vector<T> &p_array) {
+		ERR_FAIL_COND_V_MSG(p_array.size() != p_instance->size(), 0.0, "The array must have the same size as this array.");
+		return PackedArrayMath::dot(p_instance->ptr(), p_array.ptr(), p_instance->size());
+	}
+
+	static void func_PackedVector3Array_add_vector(PackedVector3Array *p_instance, const Vector3 &p_value) {
+		PackedArrayMath::add_vector(p_instance->ptrw(), p_instance->size(), p_value);
+	}
+
+	static void func_PackedVector3Array_multiply_scalar(PackedVector3Array *p_instance, double p_value) {
+		PackedArrayMath::multiply_scalar(p_instance->ptrw(), p_instance->size(), real_t(p_value));
+	}
+
+	static void func_PackedVector3Array_add_array(PackedVector3Array *p_instance, const PackedVector3Array &p_array) {
+		ERR_FAIL_COND_MSG(p_array.size() != p_instance->size(), "The array must have the same size as this array.");
+		PackedArrayMath::add_array(p_instance->ptrw(), p_array.ptr(), p_instance->size());
+	}
+
+	static void func_PackedVector3Array_multiply_array(PackedVector3Array *p_instance, const PackedVector3Array &p_array) {
+		ERR_FAIL_COND_MSG(p_array.size() != p_instance->size(), "The array must have the same size as this array.");
+		PackedArrayMath::multiply_array(p_instance->ptrw(), p_array.ptr(), p_instance->size());
+	}
+
+	static void func_PackedVector3Array_clamp(PackedVector3Array *p_instance, const Vector3 &p_min, const Vector3 &p_max) {
+		ERR_FAIL_COND_MSG(p_min.x > p_max.x || p_min.y > p_max.y || p_min.z > p_max.z, "The minimum must not be greater than the maximum on any axis.");
+		PackedArrayMath::clamp(p_instance->ptrw(), p_instance->size(), p_min, p_max);
+	}
+
+	static void func_PackedVector3Array_lerp(PackedVector3Array *p_instance, const PackedVector3Array &p_to, double p_weight) {
+		ERR_FAIL_COND_MSG(p_to.size() != p_instance->size(), "The target array must have the same size as this array.");
+		PackedArrayMath::lerp(p_instance->ptrw(), p_to.ptr(), p_instance->size(), real_t(p_weight));
+	}
+
+	static void func_PackedVector3Array_transform(PackedVector3Array *p_instance, const Transform3D &p_transform) {
+		PackedArrayMath::transform(p_instance->ptrw(), p_instance->size(), p_transform);
+	}
+
+	static void func_PackedVector3Array_normalize(PackedVector3Array *p_instance) {
+		PackedArrayMath::normalize(p_instance->ptrw(), p_instance->size());
+	}
+
+	static PackedFloat32Array func_PackedVector3Array_lengths(PackedVector3Array *p_instance) {
+		PackedFloat32Array ret;
+		ret.resize(p_instance->size());
+		PackedArrayMath::lengths(p_instance->ptr(), p_instance->size(), ret.ptrw());
+		return ret;
+	}
+
+	static PackedFloat32Array func_PackedVector3Array_dot(PackedVector3Array *p_instance, const Vector3 &p_with) {
+		PackedFloat32Array ret;
+		ret.resize(p_instance->size());
+		PackedArrayMath::dot(p_instance->ptr(), p_instance->size(), p_with, ret.ptrw());
+		return ret;
+	}
+
+	static Vector3 func_PackedVector3Array_sum(PackedVector3Array *p_instance) {
+		return PackedArrayMath::sum(p_instance->ptr(), p_instance->size());
+	}
+
+	static Vector3 func_PackedVector3Array_min(PackedVector3Array *p_instance) {
+		return PackedArrayMath::min(p_instance->ptr(), p_instance->size());
+	}
+
+	static Vector3 func_PackedVector3Array_max(PackedVector3Array *p_instance) {
+		return PackedArrayMath::max(p_instance->ptr(), p_instance->size());
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2712,6 +2843,19 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
 	bind_method(PackedFloat32Array, erase, sarray("value"), varray());
 
+	bind_functionnc(PackedFloat32Array, add_scalar, _VariantCall::func_PackedFloatArray_add_scalar<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_scalar, _VariantCall::func_PackedFloatArray_multiply_scalar<float>, sarray("value"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_add_scalar, _VariantCall::func_PackedFloatArray_multiply_add_scalar<float>, sarray("multiplier", "addend"), varray());
+	bind_functionnc(PackedFloat32Array, add_array, _VariantCall::func_PackedFloatArray_add_array<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_array, _VariantCall::func_PackedFloatArray_multiply_array<float>, sarray("array"), varray());
+	bind_functionnc(PackedFloat32Array, multiply_add_array, _VariantCall::func_PackedFloatArray_multiply_add_array<float>, sarray("multipliers", "addends"), varray());
+	bind_functionnc(PackedFloat32Array, clamp, _VariantCall::func_PackedFloatArray_clamp<float>, sarray("min", "max"), varray());
+	bind_functionnc(PackedFloat32Array, lerp, _VariantCall::func_PackedFloatArray_lerp<float>, sarray("to", "weight"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloatArray_sum<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloatArray_min<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloatArray_max<float>, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloatArray_dot<float>, sarray("array"), varray());
+
 	/* Float64 Array */
 
 	bind_method(PackedFloat64Array, size, sarray(), varray());
@@ -2736,6 +2880,19 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat64Array, count, sarray("value"), varray());
 	bind_method(PackedFloat64Array, erase, sarray("value"), varray());
 
+	bind_functionnc(PackedFloat64Array, add_scalar, _VariantCall::func_PackedFloatArray_add_scalar<double>, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_scalar, _VariantCall::func_PackedFloatArray_multiply_scalar<double>, sarray("value"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_add_scalar, _VariantCall::func_PackedFloatArray_multiply_add_scalar<double>, sarray("multiplier", "addend"), varray());
+	bind_functionnc(PackedFloat64Array, add_array, _VariantCall::func_PackedFloatArray_add_array<double>, sarray("array"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_array, _VariantCall::func_PackedFloatArray_multiply_array<double>, sarray("array"), varray());
+	bind_functionnc(PackedFloat64Array, multiply_add_array, _VariantCall::func_PackedFloatArray_multiply_add_array<double>, sarray("multipliers", "addends"), varray());
+	bind_functionnc(PackedFloat64Array, clamp, _VariantCall::func_PackedFloatArray_clamp<double>, sarray("min", "max"), varray());
+	bind_functionnc(PackedFloat64Array, lerp, _VariantCall::func_PackedFloatArray_lerp<double>, sarray("to", "weight"), varray());
+	bind_function(PackedFloat64Array, sum, _VariantCall::func_PackedFloatArray_sum<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, min, _VariantCall::func_PackedFloatArray_min<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, max, _VariantCall::func_PackedFloatArray_max<double>, sarray(), varray());
+	bind_function(PackedFloat64Array, dot, _VariantCall::func_PackedFloatArray_dot<double>, sarray("array"), varray());
+
 	/* String Array */
 
 	bind_method(PackedStringArray, size, sarray(), varray());
@@ -2808,6 +2965,20 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
 	bind_method(PackedVector3Array, erase, sarray("value"), varray());
 
+	bind_functionnc(PackedVector3Array, add_vector, _VariantCall::func_PackedVector3Array_add_vector, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, multiply_scalar, _VariantCall::func_PackedVector3Array_multiply_scalar, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, add_array, _VariantCall::func_PackedVector3Array_add_array, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, multiply_array, _VariantCall::func_PackedVector3Array_multiply_array, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, clamp, _VariantCall::func_PackedVector3Array_clamp, sarray("min", "max"), varray());
+	bind_functionnc(PackedVector3Array, lerp, _VariantCall::func_PackedVector3Array_lerp, sarray("to", "weight"), varray());
+	bind_functionnc(PackedVector3Array, transform, _VariantCall::func_PackedVector3Array_transform, sarray("transform"), varray());
+	bind_functionnc(PackedVector3Array, normalize, _VariantCall::func_PackedVector3Array_normalize, sarray(), varray());
+	bind_function(PackedVector3Array, lengths, _VariantCall::func_PackedVector3Array_lengths, sarray(), varray());
+	bind_function(PackedVector3Array, dot, _VariantCall::func_PackedVector3Array_dot, sarray("with"), varray());
+	bind_function(PackedVector3Array, sum, _VariantCall::func_PackedVector3Array_sum, sarray(), varray());
+	bind_function(PackedVector3Array, min, _VariantCall::func_PackedVector3Array_min, sarray(), varray());
+	bind_function(PackedVector3Array, max, _VariantCall::func_PackedVector3Array_max, sarray(), varray());
+
 	/* Color Array */
 
 	bind_method(PackedColorArray, size, sarray(), varray());
@@ -33,6 +33,12 @@
 #include "drivers/png/png_driver_common.h"
 
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
+	const Span<uint8_t> mapped_data = f->get_mapped_data();
+	if (!mapped_data.is_empty()) {
+		// Decode in place, without copying the file.
+		return PNGDriverCommon::png_to_image(mapped_data.ptr(), mapped_data.size(), p_flags & FLAG_FORCE_LINEAR, p_image);
+	}
+
 	const uint64_t buffer_size = f->get_length();
 	Vector<uint8_t> file_buffer;
 	Error err = file_buffer.resize(buffer_size);
@@ -36,6 +36,7 @@
 #include "core/string/print_string.h"
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -188,11 +189,55 @@ Error FileAccessUnix::open_internal(const String &p_path, int p_mode_flags) {
 	return OK;
 }
 
+bool FileAccessUnix::_map() const {
+	if (mapped_data) {
+		return true;
+	}
+	if (!f || flags != READ) {
+		return false;
+	}
+
+	struct stat st = {};
+	int fd = fileno(f);
+	if (fd == -1 || fstat(fd, &st) != 0 || st.st_size <= 0) {
+		return false;
+	}
+
+	int64_t pos = ftello(f);
+	if (pos < 0) {
+		return false;
+	}
+
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+
+	mapped_data = (uint8_t *)data;
+	mapped_size = st.st_size;
+	mapped_pos = pos;
+	mapped_eof = feof(f);
+	return true;
+}
+
+void FileAccessUnix::_unmap() {
+	if (!mapped_data) {
+		return;
+	}
+
+	munmap(mapped_data, mapped_size);
+	mapped_data = nullptr;
+	mapped_size = 0;
+	mapped_pos = 0;
+	mapped_eof = false;
+}
+
 void FileAccessUnix::_close() {
 	if (!f) {
 		return;
 	}
 
+	_unmap();
 	fclose(f);
 	f = nullptr;
 
@@ -247,6 +292,13 @@ String FileAccessUnix::get_real_path() const {
 void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped_data) {
+		mapped_pos = p_position;
+		mapped_eof = false;
+		last_error = OK;
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -255,6 +307,12 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped_data) {
+		ERR_FAIL_COND((int64_t)mapped_size + p_position < 0);
+		seek(mapped_size + p_position);
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -263,6 +321,10 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped_data) {
+		return mapped_pos;
+	}
+
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -274,6 +336,10 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped_data) {
+		return mapped_size;
+	}
+
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -285,6 +351,9 @@ uint64_t FileAccessUnix::get_length() const {
 }
 
 bool FileAccessUnix::eof_reached() const {
+	if (mapped_data) {
+		return mapped_eof;
+	}
 	return feof(f);
 }
 
@@ -292,12 +361,33 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
+	if (mapped_data) {
+		uint64_t read = 0;
+		if (mapped_pos < mapped_size) {
+			read = MIN(p_length, mapped_size - mapped_pos);
+			memcpy(p_dst, mapped_data + mapped_pos, read);
+			mapped_pos += read;
+		}
+		mapped_eof = read < p_length;
+		last_error = mapped_eof ? ERR_FILE_EOF : OK;
+		return read;
+	}
+
 	uint64_t read = fread(p_dst, 1, p_length, f);
 	check_errors();
 
 	return read;
 }
 
+Span<uint8_t> FileAccessUnix::get_mapped_data() const {
+	ERR_FAIL_NULL_V_MSG(f, Span<uint8_t>(), "File must be opened before use.");
+
+	if (!_map()) {
+		return Span<uint8_t>();
+	}
+	return Span<uint8_t>(mapped_data, mapped_size);
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
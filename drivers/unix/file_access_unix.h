@@ -47,6 +47,15 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Read-only mapping of the whole file, created on demand by get_mapped_data().
+	// Once it exists, reads are served from it instead of going through stdio.
+	mutable uint8_t *mapped_data = nullptr;
+	mutable uint64_t mapped_size = 0;
+	mutable uint64_t mapped_pos = 0;
+	mutable bool mapped_eof = false;
+
+	bool _map() const;
+	void _unmap();
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -71,6 +80,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_mapped_data() const override;
 
 	virtual Error get_error() const override; ///< get last error
 
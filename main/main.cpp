@@ -34,6 +34,8 @@
 #include "core/core_globals.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/frame_benchmark.h"
+#include "core/debugger/trace_events.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/extension/gdextension_interface_dump.gen.h"
 #include "core/extension/gdextension_manager.h"
@@ -275,6 +277,14 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static String frame_benchmark_path;
+static int frame_benchmark_frames = 1000;
+static uint64_t frame_benchmark_seed = 0;
+static String frame_benchmark_scene;
+#ifdef TRACE_EVENTS_ENABLED
+static String trace_events_path;
+static int trace_events_frames = 300;
+#endif
 #ifdef TOOLS_ENABLED
 static bool editor_pseudolocalization = false;
 static bool dump_gdextension_interface = false;
@@ -698,9 +708,19 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--benchmark", "Benchmark the run time and print it to console.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 	print_help_option("--benchmark-file <path>", "Benchmark the run time and save it to a given file in JSON format. The path should be absolute.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #endif // TOOLS_ENABLED
+	print_help_option("--frame-benchmark <path>", "Run the scene headless at a fixed timestep for a number of frames, then save the time spent per subsystem to a given file in JSON format.\n");
+	print_help_option("--frame-benchmark-frames <n>", "Set the number of frames run by --frame-benchmark (default: 1000).\n");
+	print_help_option("--frame-benchmark-seed <seed>", "Set the seed of the global random number generator for --frame-benchmark (default: 0).\n");
+#ifdef TRACE_EVENTS_ENABLED
+	print_help_option("--trace-events <path>", "Record trace events for the first frames and save them to a given file in Chrome trace event format (JSON), for chrome://tracing or the Perfetto UI.\n");
+	print_help_option("--trace-events-frames <n>", "Set the number of frames recorded by --trace-events (default: 300).\n");
+#endif // TRACE_EVENTS_ENABLED
 #ifdef TESTS_ENABLED
 	print_help_option("--test [--help]", "Run unit tests. Use --test --help for more information.\n");
 #endif // TESTS_ENABLED
+#ifdef BENCHMARKS_ENABLED
+	print_help_option("--test --benchmarks [--help]", "Run benchmarks. Use --test --benchmarks --help for more information.\n");
+#endif // BENCHMARKS_ENABLED
 	OS::get_singleton()->print("\n");
 }
 
@@ -1847,6 +1867,56 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing <path> argument for --benchmark-file <path>.\n");
 				goto error;
 			}
+		} else if (arg == "--frame-benchmark") {
+			if (N) {
+				frame_benchmark_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --frame-benchmark <path>.\n");
+				goto error;
+			}
+		} else if (arg == "--frame-benchmark-frames") {
+			if (N) {
+				frame_benchmark_frames = N->get().to_int();
+				if (frame_benchmark_frames <= 0) {
+					OS::get_singleton()->print("<n> argument for --frame-benchmark-frames <n> must be a positive integer.\n");
+					goto error;
+				}
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <n> argument for --frame-benchmark-frames <n>.\n");
+				goto error;
+			}
+		} else if (arg == "--frame-benchmark-seed") {
+			if (N) {
+				frame_benchmark_seed = N->get().to_int();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <seed> argument for --frame-benchmark-seed <seed>.\n");
+				goto error;
+			}
+#ifdef TRACE_EVENTS_ENABLED
+		} else if (arg == "--trace-events") {
+			if (N) {
+				trace_events_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --trace-events <path>.\n");
+				goto error;
+			}
+		} else if (arg == "--trace-events-frames") {
+			if (N) {
+				trace_events_frames = N->get().to_int();
+				if (trace_events_frames <= 0) {
+					OS::get_singleton()->print("<n> argument for --trace-events-frames <n> must be a positive integer.\n");
+					goto error;
+				}
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <n> argument for --trace-events-frames <n>.\n");
+				goto error;
+			}
+#endif // TRACE_EVENTS_ENABLED
 #if defined(TOOLS_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 		} else if (arg == "--lsp-port") {
 			if (N) {
@@ -1903,6 +1973,21 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		I = N;
 	}
 
+	if (!frame_benchmark_path.is_empty()) {
+		// Headless, with the dummy rasterizer and no audio output, unless another display driver was requested.
+		if (display_driver.is_empty()) {
+			display_driver = NULL_DISPLAY_DRIVER;
+		}
+		audio_driver = NULL_AUDIO_DRIVER;
+		quit_after = frame_benchmark_frames;
+	}
+
+#ifdef TRACE_EVENTS_ENABLED
+	if (!trace_events_path.is_empty()) {
+		TraceEvents::request_capture(trace_events_path, trace_events_frames);
+	}
+#endif
+
 #ifdef TOOLS_ENABLED
 	if (editor && project_manager) {
 		OS::get_singleton()->print(
@@ -4231,6 +4316,15 @@ int Main::start() {
 
 	OS::get_singleton()->set_main_loop(main_loop);
 
+	if (!frame_benchmark_path.is_empty()) {
+		// The scene tree randomizes the global generator when created.
+		Math::seed(frame_benchmark_seed);
+		if (fixed_fps == -1) {
+			// One physics step per frame.
+			fixed_fps = Engine::get_singleton()->get_physics_ticks_per_second();
+		}
+	}
+
 	SceneTree *sml = Object::cast_to<SceneTree>(main_loop);
 	if (sml) {
 #ifdef DEBUG_ENABLED
@@ -4559,6 +4653,7 @@ int Main::start() {
 
 				ERR_FAIL_NULL_V_MSG(scene, EXIT_FAILURE, "Failed loading scene: " + local_game_path + ".");
 				sml->add_current_scene(scene);
+				frame_benchmark_scene = local_game_path;
 
 #ifdef MACOS_ENABLED
 				String mac_icon_path = GLOBAL_GET("application/config/macos_native_icon");
@@ -4675,8 +4770,17 @@ static uint64_t navigation_process_max = 0;
 // will terminate the program. In case of failure, the OS exit code needs
 // to be set explicitly here (defaults to EXIT_SUCCESS).
 bool Main::iteration() {
+#ifdef TRACE_EVENTS_ENABLED
+	TraceEvents::frame();
+	TRACE_ZONE("Main::iteration");
+#endif
+
 	iterating++;
 
+	if (!frame_benchmark_path.is_empty()) {
+		FrameBenchmark::begin_frame();
+	}
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -4760,12 +4864,15 @@ bool Main::iteration() {
 #if !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
 		uint64_t navigation_begin = OS::get_singleton()->get_ticks_usec();
 
+		{
+			FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_NAVIGATION);
 #ifndef NAVIGATION_2D_DISABLED
-		NavigationServer2D::get_singleton()->physics_process(physics_step * time_scale);
+			NavigationServer2D::get_singleton()->physics_process(physics_step * time_scale);
 #endif // NAVIGATION_2D_DISABLED
 #ifndef NAVIGATION_3D_DISABLED
-		NavigationServer3D::get_singleton()->physics_process(physics_step * time_scale);
+			NavigationServer3D::get_singleton()->physics_process(physics_step * time_scale);
 #endif // NAVIGATION_3D_DISABLED
+		}
 
 		navigation_process_ticks = MAX(navigation_process_ticks, OS::get_singleton()->get_ticks_usec() - navigation_begin); // keep the largest one for reference
 		navigation_process_max = MAX(OS::get_singleton()->get_ticks_usec() - navigation_begin, navigation_process_max);
@@ -4773,15 +4880,18 @@ bool Main::iteration() {
 		message_queue->flush();
 #endif // !defined(NAVIGATION_2D_DISABLED) || !defined(NAVIGATION_3D_DISABLED)
 
+		{
+			FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_PHYSICS);
 #ifndef PHYSICS_3D_DISABLED
-		PhysicsServer3D::get_singleton()->end_sync();
-		PhysicsServer3D::get_singleton()->step(physics_step * time_scale);
+			PhysicsServer3D::get_singleton()->end_sync();
+			PhysicsServer3D::get_singleton()->step(physics_step * time_scale);
 #endif // PHYSICS_3D_DISABLED
 
 #ifndef PHYSICS_2D_DISABLED
-		PhysicsServer2D::get_singleton()->end_sync();
-		PhysicsServer2D::get_singleton()->step(physics_step * time_scale);
+			PhysicsServer2D::get_singleton()->end_sync();
+			PhysicsServer2D::get_singleton()->step(physics_step * time_scale);
 #endif // PHYSICS_2D_DISABLED
+		}
 
 		message_queue->flush();
 
@@ -4804,18 +4914,22 @@ bool Main::iteration() {
 	}
 	message_queue->flush();
 
+	{
+		FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_NAVIGATION);
 #ifndef NAVIGATION_2D_DISABLED
-	NavigationServer2D::get_singleton()->process(process_step * time_scale);
+		NavigationServer2D::get_singleton()->process(process_step * time_scale);
 #endif // NAVIGATION_2D_DISABLED
 #ifndef NAVIGATION_3D_DISABLED
-	NavigationServer3D::get_singleton()->process(process_step * time_scale);
+		NavigationServer3D::get_singleton()->process(process_step * time_scale);
 #endif // NAVIGATION_3D_DISABLED
+	}
 
 	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
 
 	const bool has_pending_resources_for_processing = RD::get_singleton() && RD::get_singleton()->has_pending_resources_for_processing();
 	bool wants_present = (DisplayServer::get_singleton()->can_any_window_draw() ||
-								 DisplayServer::get_singleton()->has_additional_outputs()) &&
+								 DisplayServer::get_singleton()->has_additional_outputs() ||
+								 FrameBenchmark::is_active()) &&
 			RenderingServer::get_singleton()->is_render_loop_enabled();
 
 	if (wants_present || has_pending_resources_for_processing) {
@@ -4848,6 +4962,10 @@ bool Main::iteration() {
 		EngineDebugger::get_singleton()->iteration(frame_time, process_ticks, physics_process_ticks, physics_step);
 	}
 
+	if (!frame_benchmark_path.is_empty()) {
+		FrameBenchmark::end_frame();
+	}
+
 	frames++;
 	Engine::get_singleton()->_process_frames++;
 
@@ -4950,6 +5068,24 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+#ifdef TRACE_EVENTS_ENABLED
+	TraceEvents::finish();
+#endif
+
+	if (FrameBenchmark::is_active()) {
+		FrameBenchmark::stop();
+
+		Dictionary info;
+		info["scene"] = frame_benchmark_scene;
+		info["fixed_fps"] = fixed_fps;
+		info["seed"] = frame_benchmark_seed;
+		info["rendering_method"] = RenderingServer::get_singleton()->get_current_rendering_method();
+		if (FrameBenchmark::save_json(frame_benchmark_path, info) == OK) {
+			print_line(vformat("Frame benchmark results for %d frames written to \"%s\".", FrameBenchmark::get_frame_count(), frame_benchmark_path));
+		}
+		FrameBenchmark::clear();
+	}
+
 #ifdef DEBUG_ENABLED
 	if (input) {
 		input->flush_frame_parsed_events();
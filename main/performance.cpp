@@ -31,6 +31,7 @@
 #include "performance.h"
 
 #include "core/os/os.h"
+#include "core/os/small_block_allocator.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
@@ -129,6 +130,9 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_BLOCKS_USED);
+	BIND_ENUM_CONSTANT(MEMORY_SMALL_BLOCKS_RESERVED);
+	BIND_ENUM_CONSTANT(OBJECT_MESSAGE_QUEUE_DEPTH);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -209,6 +213,9 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("memory/small_blocks_used"),
+		PNAME("memory/small_blocks_reserved"),
+		PNAME("object/message_queue_depth"),
 	};
 	static_assert(std::size(names) == MONITOR_MAX);
 
@@ -433,6 +440,13 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
 
+		case MEMORY_SMALL_BLOCKS_USED:
+			return SmallBlockAllocator::get_total_used_bytes();
+		case MEMORY_SMALL_BLOCKS_RESERVED:
+			return SmallBlockAllocator::get_total_reserved_bytes();
+		case OBJECT_MESSAGE_QUEUE_DEPTH:
+			return MessageQueue::get_main_singleton()->get_stats().last_flush_messages;
+
 		default: {
 		}
 	}
@@ -503,6 +517,9 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
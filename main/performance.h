@@ -125,6 +125,9 @@ public:
 		NAVIGATION_3D_EDGE_CONNECTION_COUNT,
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
+		MEMORY_SMALL_BLOCKS_USED,
+		MEMORY_SMALL_BLOCKS_RESERVED,
+		OBJECT_MESSAGE_QUEUE_DEPTH,
 		MONITOR_MAX
 	};
 
@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -597,6 +598,7 @@ bool GDScript::_update_exports(bool *r_err, bool p_recursive_call, PlaceHolderSc
 				}
 				valid = false; // to show error in the editor
 				base_cache->valid = false;
+				GDScriptFunction::invalidate_inline_caches();
 				base_cache->inheriters_cache.clear(); // to prevent future stackoverflows
 				base_cache.unref();
 				base.unref();
@@ -742,6 +744,22 @@ void GDScript::_restore_old_static_data() {
 
 #endif
 
+uint32_t GDScript::_get_source_hash() const {
+	if (!binary_tokens.is_empty()) {
+		return hash_djb2_buffer(binary_tokens.ptr(), binary_tokens.size());
+	}
+	return source.hash();
+}
+
+void GDScript::_attach_native_functions(uint32_t p_source_hash) {
+	for (KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		E.value->native_function = GDScriptNativeFunctions::get_function(fully_qualified_name, E.key, p_source_hash);
+	}
+	for (KeyValue<StringName, Ref<GDScript>> &E : subclasses) {
+		E.value->_attach_native_functions(p_source_hash);
+	}
+}
+
 Error GDScript::reload(bool p_keep_state) {
 	if (reloading) {
 		return OK;
@@ -789,13 +807,7 @@ Error GDScript::reload(bool p_keep_state) {
 				Error err = OK;
 				Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(source_path, GDScriptParserRef::EMPTY, err);
 				if (parser_ref.is_valid()) {
-					uint32_t source_hash;
-					if (!binary_tokens.is_empty()) {
-						source_hash = hash_djb2_buffer(binary_tokens.ptr(), binary_tokens.size());
-					} else {
-						source_hash = source.hash();
-					}
-					if (parser_ref->get_source_hash() != source_hash) {
+					if (parser_ref->get_source_hash() != _get_source_hash()) {
 						GDScriptCache::remove_parser(source_path);
 					}
 				}
@@ -812,6 +824,24 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+	GDScriptFunction::invalidate_inline_caches();
+
+	if (GDScriptBytecodeCache::load_script(this) == OK) {
+		// Classes and bytecode came from a previous run, nothing to parse or compile.
+		if (GDScriptNativeFunctions::has_functions()) {
+			_attach_native_functions(_get_source_hash());
+		}
+		if (ScriptServer::is_scripting_enabled() || is_tool()) {
+			Error err = _static_init();
+			if (err) {
+				reloading = false;
+				return err;
+			}
+		}
+		reloading = false;
+		return OK;
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -829,6 +859,13 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
+	// Parse the scripts this one depends on in parallel before the analyzer needs them one by one.
+	// They're kept alive until this script is compiled.
+	Vector<Ref<GDScriptParserRef>> dependency_parsers;
+	if (!path.is_empty() && !path.contains("::")) {
+		dependency_parsers = GDScriptCache::parse_dependencies(path, &parser);
+	}
+
 	GDScriptAnalyzer analyzer(&parser);
 	err = analyzer.analyze();
 
@@ -866,6 +903,12 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	GDScriptBytecodeCache::save_script(this, &parser);
+
+	if (GDScriptNativeFunctions::has_functions()) {
+		_attach_native_functions(_get_source_hash());
+	}
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -1539,6 +1582,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	GDScriptFunction::invalidate_inline_caches();
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
@@ -1652,6 +1696,9 @@ GDScript::~GDScript() {
 	}
 	destructing = true;
 
+	// The address of this script may be reused by another one.
+	GDScriptFunction::invalidate_inline_caches();
+
 	if (is_print_verbose_enabled()) {
 		MutexLock lock(func_ptrs_to_update_mutex);
 		if (!func_ptrs_to_update.is_empty()) {
@@ -2288,6 +2335,8 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+	GDScriptSamplingProfiler::handle_cmdline();
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2329,8 +2378,11 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	GDScriptSamplingProfiler::finish();
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
+	GDScriptBytecodeCache::clear();
 
 	// Clear dependencies between scripts, to ensure cyclic references are broken
 	// (to avoid leaks at exit).
@@ -2362,6 +2414,7 @@ void GDScriptLanguage::finish() {
 	}
 	script_list.clear();
 	function_list.clear();
+	GDScriptFunctionState::clear_frame_pool();
 
 	finishing = false;
 }
@@ -2959,6 +3012,7 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	bytecode_cache = GLOBAL_DEF_RST("application/run/gdscript_bytecode_cache", false);
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
@@ -31,6 +31,7 @@
 #pragma once
 
 #include "gdscript_function.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
@@ -84,6 +85,7 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -142,6 +144,9 @@ private:
 
 	void _recurse_replace_function_ptrs(const HashMap<GDScriptFunction *, GDScriptFunction *> &p_replacements) const;
 
+	uint32_t _get_source_hash() const;
+	void _attach_native_functions(uint32_t p_source_hash);
+
 #ifdef TOOLS_ENABLED
 	// For static data storage during hot-reloading.
 	HashMap<StringName, MemberInfo> old_static_variables_indices;
@@ -450,6 +455,7 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	bool track_call_stack = false;
 	bool track_locals = false;
+	bool bytecode_cache = false;
 
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
@@ -457,6 +463,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	void _remove_global(const StringName &p_name);
 
 	friend class GDScriptInstance;
+	friend class GDScriptSamplingProfiler;
 
 	Mutex mutex;
 
@@ -515,6 +522,12 @@ public:
 		call_level->ip = p_ip;
 		call_level->line = p_line;
 		_call_stack_size++;
+
+		if (_call_stack_size == 1) {
+			GDScriptSamplingProfiler::skip();
+		} else {
+			GDScriptSamplingProfiler::poll();
+		}
 	}
 
 	_FORCE_INLINE_ void exit_function() {
@@ -543,6 +556,8 @@ public:
 			return;
 		}
 
+		GDScriptSamplingProfiler::poll();
+
 		_call_stack_size--;
 		_call_stack = _call_stack->prev;
 	}
@@ -580,6 +595,7 @@ public:
 
 	_FORCE_INLINE_ bool should_track_call_stack() const { return track_call_stack; }
 	_FORCE_INLINE_ bool should_track_locals() const { return track_locals; }
+	_FORCE_INLINE_ bool is_bytecode_cache_enabled() const { return bytecode_cache; }
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
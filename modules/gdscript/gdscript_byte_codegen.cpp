@@ -31,6 +31,11 @@
 #include "gdscript_byte_codegen.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/templates/local_vector.h"
+
+#ifdef DEBUG_ENABLED
+bool GDScriptByteCodeGenerator::keep_unoptimized_code = false;
+#endif
 
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
 	function->_argument_count++;
@@ -144,11 +149,12 @@ void GDScriptByteCodeGenerator::pop_temporary() {
 	}
 	temporaries_pool[temporaries[slot_idx].type].push_back(slot_idx);
 	used_temporaries.pop_back();
+	temporary_releases.insert((uint64_t(opcodes.size()) << 32) | uint32_t(slot_idx));
 }
 
 void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
-		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
+		append_opcode(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
 	}
 }
@@ -175,6 +181,210 @@ void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName
 	function->_argument_count = 0;
 }
 
+void GDScriptByteCodeGenerator::optimize_bytecode() {
+	const int code_size = opcodes.size();
+	const int instruction_count = instruction_starts.size();
+	int *code = opcodes.ptrw();
+
+	LocalVector<bool> is_instruction_start;
+	is_instruction_start.resize_initialized(code_size + 1);
+	for (const int &start : instruction_starts) {
+		is_instruction_start[start] = true;
+	}
+
+	// Temporary slot each operand refers to, so their lifetime can be checked.
+	LocalVector<int> temporary_at;
+	temporary_at.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		temporary_at[i] = -1;
+	}
+	for (int i = 0; i < temporaries.size(); i++) {
+		for (const int &index : temporaries[i].bytecode_indices) {
+			temporary_at[index] = i;
+		}
+	}
+
+	// Jump threading: a jump landing on an unconditional jump goes straight to its destination.
+	for (const int &operand : jump_operands) {
+		int target = code[operand];
+		for (int hops = 0; hops < 8 && target < code_size && is_instruction_start[target] && code[target] == GDScriptFunction::OPCODE_JUMP; hops++) {
+			target = code[target + 1];
+		}
+		code[operand] = target;
+	}
+
+	LocalVector<bool> is_jump_target;
+	is_jump_target.resize_initialized(code_size + 1);
+	for (const int &operand : jump_operands) {
+		is_jump_target[code[operand]] = true;
+	}
+	for (const int &entry : function->default_arguments) {
+		is_jump_target[entry] = true;
+	}
+
+	LocalVector<bool> removed;
+	removed.resize_initialized(code_size);
+	bool any_removed = false;
+	auto remove_words = [&](int p_from, int p_to) {
+		for (int i = p_from; i < p_to; i++) {
+			removed[i] = true;
+		}
+		any_removed = any_removed || p_from < p_to;
+	};
+
+	Vector<Variant> constants;
+	auto get_constant = [&](int p_address) -> Variant {
+		if (constants.is_empty()) {
+			constants.resize(constant_map.size());
+			for (const KeyValue<Variant, int> &K : constant_map) {
+				constants.write[K.value] = K.key;
+			}
+		}
+		return constants[p_address & GDScriptFunction::ADDR_MASK];
+	};
+	auto is_constant = [](int p_address) {
+		return (p_address >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_CONSTANT;
+	};
+
+	// Line markers only matter to the debugger when nothing runs in between, and
+	// breakpoint statements only to the debugger.
+	const bool strip_debug_opcodes = !EngineDebugger::is_active();
+
+	for (int i = 0; i < instruction_count; i++) {
+		const int ip = instruction_starts[i];
+		if (removed[ip]) {
+			continue;
+		}
+		const int next = i + 1 < instruction_count ? instruction_starts[i + 1] : code_size;
+		const int next_opcode = next < code_size ? code[next] : -1;
+		int opcode = code[ip];
+
+		if (opcode == GDScriptFunction::OPCODE_LINE) {
+			if (strip_debug_opcodes && next_opcode == GDScriptFunction::OPCODE_LINE) {
+				remove_words(ip, next);
+			}
+			continue;
+		}
+
+		if (opcode == GDScriptFunction::OPCODE_BREAKPOINT) {
+			if (strip_debug_opcodes) {
+				remove_words(ip, next);
+			}
+			continue;
+		}
+
+		if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+			// Only the last adjust of the same address is visible.
+			if (next_opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && next_opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY && code[next + 1] == code[ip + 1]) {
+				remove_words(ip, next);
+			}
+			continue;
+		}
+
+		// Constant folding, for the operations the analyzer could not reduce.
+		if (opcode == GDScriptFunction::OPCODE_OPERATOR && is_constant(code[ip + 1]) && (is_constant(code[ip + 2]) || code[ip + 2] == GDScriptFunction::ADDR_NIL)) {
+			const Variant left = get_constant(code[ip + 1]);
+			const Variant right = code[ip + 2] == GDScriptFunction::ADDR_NIL ? Variant() : get_constant(code[ip + 2]);
+			Variant result;
+			bool valid = false;
+			Variant::evaluate(Variant::Operator(code[ip + 4]), left, right, result, valid);
+
+			// Reference types would be shared between calls, so they are still built at runtime.
+			if (valid && result.get_type() < Variant::OBJECT) {
+				code[ip] = GDScriptFunction::OPCODE_ASSIGN;
+				code[ip + 1] = code[ip + 3];
+				code[ip + 2] = get_constant_pos(result) | (GDScriptFunction::ADDR_TYPE_CONSTANT << GDScriptFunction::ADDR_BITS);
+				temporary_at[ip + 1] = temporary_at[ip + 3];
+				temporary_at[ip + 2] = -1;
+				remove_words(ip + 3, next);
+				opcode = GDScriptFunction::OPCODE_ASSIGN;
+			}
+		}
+
+		if (opcode == GDScriptFunction::OPCODE_ASSIGN && code[ip + 1] == code[ip + 2]) {
+			remove_words(ip, next);
+			continue;
+		}
+
+		// Copy propagation: a result written into a temporary that is only copied
+		// somewhere else and released is written to the final destination instead.
+		// Only untyped writes are retargeted, typed ones rely on the destination type.
+		if (opcode != GDScriptFunction::OPCODE_ASSIGN && opcode != GDScriptFunction::OPCODE_OPERATOR) {
+			continue;
+		}
+		if (next_opcode != GDScriptFunction::OPCODE_ASSIGN || is_jump_target[next]) {
+			continue;
+		}
+		const int dst_pos = opcode == GDScriptFunction::OPCODE_ASSIGN ? ip + 1 : ip + 3;
+		const int slot = temporary_at[dst_pos];
+		if (slot < 0 || temporary_at[next + 2] != slot || !temporary_releases.has((uint64_t(next + 3) << 32) | uint32_t(slot))) {
+			continue;
+		}
+		const int final_dst = code[next + 1];
+		if (final_dst == code[dst_pos] || (opcode == GDScriptFunction::OPCODE_OPERATOR && (final_dst == code[ip + 1] || final_dst == code[ip + 2]))) {
+			// The operator resets the destination before reading its operands.
+			continue;
+		}
+		code[dst_pos] = final_dst;
+		temporary_at[dst_pos] = temporary_at[next + 1];
+		remove_words(next, next + 3);
+	}
+
+	// Jumps over code that was all removed fall through instead.
+	for (int i = instruction_count - 1; i >= 0; i--) {
+		const int ip = instruction_starts[i];
+		if (removed[ip] || code[ip] != GDScriptFunction::OPCODE_JUMP || code[ip + 1] <= ip) {
+			continue;
+		}
+		bool skips_code = false;
+		for (int j = ip + 2; j < code[ip + 1]; j++) {
+			if (!removed[j]) {
+				skips_code = true;
+				break;
+			}
+		}
+		if (!skips_code) {
+			remove_words(ip, ip + 2);
+		}
+	}
+
+	if (!any_removed) {
+		return;
+	}
+
+	// Compact the code and relocate everything pointing into it. Removed
+	// instructions resolve to the next one that is kept.
+	LocalVector<int> new_position;
+	new_position.resize(code_size + 1);
+	int kept = 0;
+	for (int i = 0; i <= code_size; i++) {
+		new_position[i] = kept;
+		if (i < code_size && !removed[i]) {
+			kept++;
+		}
+	}
+
+	jump_operands.sort();
+	for (int i = 0; i < jump_operands.size(); i++) {
+		const int operand = jump_operands[i];
+		if ((i > 0 && jump_operands[i - 1] == operand) || removed[operand]) {
+			continue;
+		}
+		code[operand] = new_position[code[operand]];
+	}
+	for (int i = 0; i < function->default_arguments.size(); i++) {
+		function->default_arguments.write[i] = new_position[function->default_arguments[i]];
+	}
+
+	int write = 0;
+	for (int i = 0; i < code_size; i++) {
+		if (!removed[i]) {
+			code[write++] = code[i];
+		}
+	}
+	opcodes.resize(write);
+}
+
 GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #ifdef DEBUG_ENABLED
 	if (!used_temporaries.is_empty()) {
@@ -193,6 +403,13 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+#ifdef DEBUG_ENABLED
+	if (keep_unoptimized_code) {
+		function->unoptimized_code = opcodes;
+	}
+#endif
+	optimize_bytecode();
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -392,6 +609,11 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->inline_caches = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+	}
+	function->_inline_caches_count = inline_cache_count;
+
 	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
 		function->stack_debug = stack_debug;
 	}
@@ -581,6 +803,153 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+GDScriptFunction::Opcode GDScriptByteCodeGenerator::get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		// Integer division and modulo need the division by zero check of the validated evaluator.
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_MULTIPLY_INT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_EQUAL_INT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_NOT_EQUAL_INT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_LESS_INT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_LESS_EQUAL_INT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_GREATER_INT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_GREATER_EQUAL_INT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_MULTIPLY_FLOAT;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_DIVIDE_FLOAT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_EQUAL_FLOAT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_NOT_EQUAL_FLOAT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_LESS_FLOAT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_LESS_EQUAL_FLOAT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_GREATER_FLOAT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_GREATER_EQUAL_FLOAT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR2 && (p_right_type == Variant::VECTOR2 || p_right_type == Variant::FLOAT)) {
+		const bool by_float = p_right_type == Variant::FLOAT;
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return by_float ? GDScriptFunction::OPCODE_END : GDScriptFunction::OPCODE_ADD_VECTOR2;
+			case Variant::OP_SUBTRACT:
+				return by_float ? GDScriptFunction::OPCODE_END : GDScriptFunction::OPCODE_SUBTRACT_VECTOR2;
+			case Variant::OP_MULTIPLY:
+				return by_float ? GDScriptFunction::OPCODE_MULTIPLY_VECTOR2_FLOAT : GDScriptFunction::OPCODE_MULTIPLY_VECTOR2;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && (p_right_type == Variant::VECTOR3 || p_right_type == Variant::FLOAT)) {
+		const bool by_float = p_right_type == Variant::FLOAT;
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return by_float ? GDScriptFunction::OPCODE_END : GDScriptFunction::OPCODE_ADD_VECTOR3;
+			case Variant::OP_SUBTRACT:
+				return by_float ? GDScriptFunction::OPCODE_END : GDScriptFunction::OPCODE_SUBTRACT_VECTOR3;
+			case Variant::OP_MULTIPLY:
+				return by_float ? GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT : GDScriptFunction::OPCODE_MULTIPLY_VECTOR3;
+			default:
+				break;
+		}
+	}
+	return GDScriptFunction::OPCODE_END;
+}
+
+int GDScriptByteCodeGenerator::write_jump_if_not(const Address &p_condition) {
+	if (fusable_comparison_pos >= 0 && fusable_comparison_pos + 4 == opcodes.size() && p_condition.mode == Address::TEMPORARY && int(p_condition.address) == fusable_comparison_temporary) {
+		// The condition was computed by the instruction right before, so jump
+		// on the comparison itself. Only the operands are kept, the target
+		// slot becomes the jump destination.
+		const int pos = fusable_comparison_pos;
+		fusable_comparison_pos = -1;
+
+		GDScriptFunction::Opcode jump_opcode = GDScriptFunction::OPCODE_END;
+		switch (opcodes[pos]) {
+			case GDScriptFunction::OPCODE_EQUAL_INT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_EQUAL_INT;
+				break;
+			case GDScriptFunction::OPCODE_NOT_EQUAL_INT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_NOT_EQUAL_INT;
+				break;
+			case GDScriptFunction::OPCODE_LESS_INT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_LESS_INT;
+				break;
+			case GDScriptFunction::OPCODE_LESS_EQUAL_INT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_LESS_EQUAL_INT;
+				break;
+			case GDScriptFunction::OPCODE_GREATER_INT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_GREATER_INT;
+				break;
+			case GDScriptFunction::OPCODE_GREATER_EQUAL_INT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_GREATER_EQUAL_INT;
+				break;
+			case GDScriptFunction::OPCODE_EQUAL_FLOAT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_EQUAL_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_NOT_EQUAL_FLOAT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_NOT_EQUAL_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_LESS_FLOAT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_LESS_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_LESS_EQUAL_FLOAT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_LESS_EQUAL_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_GREATER_FLOAT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_GREATER_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_GREATER_EQUAL_FLOAT:
+				jump_opcode = GDScriptFunction::OPCODE_JUMP_UNLESS_GREATER_EQUAL_FLOAT;
+				break;
+			default:
+				break;
+		}
+
+		if (jump_opcode != GDScriptFunction::OPCODE_END) {
+			// The temporary slot address would be resolved into the jump destination otherwise.
+			Vector<int> &indices = temporaries.write[p_condition.address].bytecode_indices;
+			if (!indices.is_empty() && indices[indices.size() - 1] == pos + 3) {
+				indices.remove_at(indices.size() - 1);
+				opcodes.write[pos] = jump_opcode;
+				opcodes.write[pos + 3] = 0; // Jump destination, will be patched.
+				return pos + 3;
+			}
+		}
+	}
+
+	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
+	append(p_condition);
+	const int jump_pos = opcodes.size();
+	append(0); // Jump destination, will be patched.
+	return jump_pos;
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	bool valid = HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand);
 
@@ -610,6 +979,21 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Use an unboxed opcode for the common arithmetic and comparisons.
+		GDScriptFunction::Opcode typed_opcode = get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode != GDScriptFunction::OPCODE_END) {
+			const int pos = opcodes.size();
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			if (p_target.mode == Address::TEMPORARY && Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type) == Variant::BOOL) {
+				fusable_comparison_pos = pos;
+				fusable_comparison_temporary = p_target.address;
+			}
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -710,7 +1094,7 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 	append(p_target);
 	// Jump away from the fail condition.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + 3);
+	append_jump_address(opcodes.size() + 3);
 	// Here it means one of operands is false.
 	patch_jump(logic_op_jump_pos1.back()->get());
 	patch_jump(logic_op_jump_pos2.back()->get());
@@ -740,7 +1124,7 @@ void GDScriptByteCodeGenerator::write_end_or(const Address &p_target) {
 	append(p_target);
 	// Jump away from the success condition.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + 3);
+	append_jump_address(opcodes.size() + 3);
 	// Here it means one of operands is true.
 	patch_jump(logic_op_jump_pos1.back()->get());
 	patch_jump(logic_op_jump_pos2.back()->get());
@@ -755,10 +1139,7 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	ternary_jump_fail_pos.push_back(opcodes.size());
-	append(0); // Jump target, will be patched.
+	ternary_jump_fail_pos.push_back(write_jump_if_not(p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
@@ -859,6 +1240,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -877,6 +1259,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1021,6 +1404,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	fusable_comparison_pos = -1; // Default argument entry points are jump targets.
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
@@ -1091,6 +1475,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1116,6 +1501,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1350,6 +1736,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1363,6 +1750,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1376,6 +1764,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1510,10 +1899,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	if_jmp_addrs.push_back(opcodes.size());
-	append(0); // Jump destination, will be patched.
+	if_jmp_addrs.push_back(write_jump_if_not(p_condition));
 }
 
 void GDScriptByteCodeGenerator::write_else() {
@@ -1725,7 +2111,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	for_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(opcodes.size() + (p_is_range ? 7 : 6)); // Skip over 'continue' code.
+	append_jump_address(opcodes.size() + (p_is_range ? 7 : 6)); // Skip over 'continue' code.
 
 	// Next iteration.
 	int continue_addr = opcodes.size();
@@ -1753,7 +2139,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 	// Jump back to loop check.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_address(continue_addrs.back()->get());
 	continue_addrs.pop_back();
 
 	// Patch end jumps (two of them).
@@ -1782,20 +2168,18 @@ void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	fusable_comparison_pos = -1; // Loop start is a jump target.
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
-	while_jmp_addrs.push_back(opcodes.size());
-	append(0); // End of loop address, will be patched.
+	while_jmp_addrs.push_back(write_jump_if_not(p_condition)); // End of loop address, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_endwhile() {
 	// Jump back to loop check.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_address(continue_addrs.back()->get());
 	continue_addrs.pop_back();
 
 	// Patch end jump.
@@ -1817,7 +2201,7 @@ void GDScriptByteCodeGenerator::write_break() {
 
 void GDScriptByteCodeGenerator::write_continue() {
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_jump_address(continue_addrs.back()->get());
 }
 
 void GDScriptByteCodeGenerator::write_breakpoint() {
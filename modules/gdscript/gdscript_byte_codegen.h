@@ -97,6 +97,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -160,6 +161,19 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Start of the last typed comparison written into a temporary. If the next
+	// instruction is a conditional jump on that temporary, both are fused into
+	// a single OPCODE_JUMP_UNLESS_* and the temporary is never written.
+	int fusable_comparison_pos = -1;
+	int fusable_comparison_temporary = -1;
+
+	// Bookkeeping for the optimization pass in `write_end()`: where each instruction
+	// starts, which operands hold code addresses, and where temporaries were released
+	// (packed as `position << 32 | slot`).
+	Vector<int> instruction_starts;
+	Vector<int> jump_operands;
+	HashSet<uint64_t> temporary_releases;
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -376,10 +390,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 	void append_opcode(GDScriptFunction::Opcode p_code) {
+		instruction_starts.push_back(opcodes.size());
 		opcodes.push_back(p_code);
 	}
 
 	void append_opcode_and_argcount(GDScriptFunction::Opcode p_code, int p_argument_count) {
+		instruction_starts.push_back(opcodes.size());
 		opcodes.push_back(p_code);
 		opcodes.push_back(p_argument_count);
 		instr_args_max = MAX(instr_args_max, p_argument_count);
@@ -449,10 +465,26 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
+	void append_jump_address(int p_address) {
+		jump_operands.push_back(opcodes.size());
+		opcodes.push_back(p_address);
+	}
+
 	void patch_jump(int p_address) {
+		jump_operands.push_back(p_address);
 		opcodes.write[p_address] = opcodes.size();
+		// Something jumps right after the comparison, so it has to stay intact.
+		fusable_comparison_pos = -1;
 	}
 
+	static GDScriptFunction::Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type);
+	int write_jump_if_not(const Address &p_condition);
+	void optimize_bytecode();
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -474,6 +506,11 @@ public:
 	virtual void write_start(GDScript *p_script, const StringName &p_function_name, bool p_static, Variant p_rpc_config, const GDScriptDataType &p_return_type) override;
 	virtual GDScriptFunction *write_end() override;
 
+#ifdef DEBUG_ENABLED
+	// Keeps a copy of the code before optimization in the function, for `GDScriptFunction::disassemble_diff()`.
+	static bool keep_unoptimized_code;
+#endif
+
 #ifdef DEBUG_ENABLED
 	virtual void set_signature(const String &p_signature) override;
 #endif
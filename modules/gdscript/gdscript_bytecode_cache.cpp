@@ -0,0 +1,2156 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+Mutex GDScriptBytecodeCache::mutex;
+GDScriptBytecodeCache::PointerNames *GDScriptBytecodeCache::pointer_names = nullptr;
+HashMap<String, String> GDScriptBytecodeCache::source_hashes;
+String GDScriptBytecodeCache::environment_hash;
+
+enum BuildFlags {
+	BUILD_FLAG_DEBUG = 1 << 0,
+	BUILD_FLAG_TOOLS = 1 << 1,
+	BUILD_FLAG_DOUBLE = 1 << 2,
+	BUILD_FLAG_DEBUGGER = 1 << 3,
+};
+
+enum ValueTag {
+	VALUE_PLAIN,
+	VALUE_ARRAY,
+	VALUE_DICTIONARY,
+	VALUE_NULL_OBJECT,
+	VALUE_NATIVE_CLASS,
+	VALUE_SCRIPT,
+	VALUE_RESOURCE,
+};
+
+enum ScriptTag {
+	SCRIPT_NONE,
+	SCRIPT_GDSCRIPT,
+	SCRIPT_RESOURCE,
+};
+
+static uint32_t _get_build_flags() {
+	uint32_t flags = 0;
+#ifdef DEBUG_ENABLED
+	flags |= BUILD_FLAG_DEBUG;
+#endif
+#ifdef TOOLS_ENABLED
+	flags |= BUILD_FLAG_TOOLS;
+#endif
+#ifdef REAL_T_IS_DOUBLE
+	flags |= BUILD_FLAG_DOUBLE;
+#endif
+	// The bytecode optimizer keeps line markers and breakpoints only for the debugger.
+	if (EngineDebugger::is_active()) {
+		flags |= BUILD_FLAG_DEBUGGER;
+	}
+	return flags;
+}
+
+static String _get_build_id() {
+	return String(GODOT_VERSION_FULL_BUILD) + "." + String(GODOT_VERSION_HASH);
+}
+
+// Bytecode refers to builtin operators, accessors and utility functions through
+// raw function pointers, which differ between runs. They are stored by the key the
+// code generator looked them up with, and looked up again when loading.
+struct GDScriptBytecodeCache::PointerNames {
+	struct OperatorKey {
+		Variant::Operator op = Variant::OP_EQUAL;
+		Variant::Type type_a = Variant::NIL;
+		Variant::Type type_b = Variant::NIL;
+	};
+
+	struct MemberKey {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct ConstructorKey {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	RBMap<Variant::ValidatedOperatorEvaluator, OperatorKey> operators;
+	RBMap<Variant::ValidatedSetter, MemberKey> setters;
+	RBMap<Variant::ValidatedGetter, MemberKey> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, MemberKey> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, ConstructorKey> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	PointerNames() {
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			const Variant::Type type = Variant::Type(i);
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, { Variant::Operator(op), type, Variant::Type(j) });
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+				if (setter && !setters.has(setter)) {
+					setters.insert(setter, { type, member });
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+				if (getter && !getters.has(getter)) {
+					getters.insert(getter, { type, member });
+				}
+			}
+
+			if (Variant::is_keyed(type)) {
+				keyed_setters.insert(Variant::get_member_validated_keyed_setter(type), type);
+				keyed_getters.insert(Variant::get_member_validated_keyed_getter(type), type);
+			}
+			if (Variant::has_indexing(type)) {
+				indexed_setters.insert(Variant::get_member_validated_indexed_setter(type), type);
+				indexed_getters.insert(Variant::get_member_validated_indexed_getter(type), type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method);
+				if (builtin_method && !builtin_methods.has(builtin_method)) {
+					builtin_methods.insert(builtin_method, { type, method });
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+				if (constructor && !constructors.has(constructor)) {
+					constructors.insert(constructor, { type, j });
+				}
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			utilities.insert(Variant::get_validated_utility_function(function), function);
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			gds_utilities.insert(GDScriptUtilityFunctions::get_function(function), function);
+		}
+	}
+};
+
+/* WRITER */
+
+struct GDScriptBytecodeCache::Writer {
+	Vector<uint8_t> buffer;
+	const GDScript *root = nullptr;
+	const PointerNames *names = nullptr;
+	String error;
+
+	bool failed() const { return !error.is_empty(); }
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	void write_bytes(const uint8_t *p_data, int p_size) {
+		const int pos = buffer.size();
+		buffer.resize(pos + p_size);
+		memcpy(buffer.ptrw() + pos, p_data, p_size);
+	}
+
+	void write_uint32(uint32_t p_value) {
+		const int pos = buffer.size();
+		buffer.resize(pos + 4);
+		encode_uint32(p_value, buffer.ptrw() + pos);
+	}
+
+	void write_int(int p_value) { write_uint32(uint32_t(p_value)); }
+	void write_bool(bool p_value) { write_uint32(p_value ? 1 : 0); }
+
+	void write_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		write_uint32(utf8.length());
+		write_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	void write_script(const Script *p_script) {
+		if (p_script == nullptr) {
+			write_uint32(SCRIPT_NONE);
+			return;
+		}
+
+		const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+		if (gdscript) {
+			if (gdscript->path.is_empty() || gdscript->path.contains("::")) {
+				fail(vformat(R"(Reference to built-in script "%s".)", gdscript->fully_qualified_name));
+				return;
+			}
+			write_uint32(SCRIPT_GDSCRIPT);
+			write_string(gdscript->path);
+			write_string(gdscript->fully_qualified_name);
+			return;
+		}
+
+		if (p_script->get_path().is_empty() || p_script->is_built_in()) {
+			fail("Reference to a built-in script.");
+			return;
+		}
+		write_uint32(SCRIPT_RESOURCE);
+		write_string(p_script->get_path());
+	}
+
+	void write_value(const Variant &p_value) {
+		switch (p_value.get_type()) {
+			case Variant::OBJECT: {
+				Object *object = p_value.get_validated_object();
+				if (object == nullptr) {
+					write_uint32(VALUE_NULL_OBJECT);
+				} else if (GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object)) {
+					write_uint32(VALUE_NATIVE_CLASS);
+					write_string(native_class->get_name());
+				} else if (Script *script = Object::cast_to<Script>(object)) {
+					write_uint32(VALUE_SCRIPT);
+					write_script(script);
+				} else if (Resource *resource = Object::cast_to<Resource>(object)) {
+					if (resource->get_path().is_empty() || resource->is_built_in()) {
+						fail(vformat(R"(Constant holds a "%s" that isn't saved to its own file.)", resource->get_class()));
+						return;
+					}
+					write_uint32(VALUE_RESOURCE);
+					write_string(resource->get_path());
+				} else {
+					fail(vformat(R"(Constant holds a "%s" object.)", object->get_class()));
+				}
+			} break;
+			case Variant::ARRAY: {
+				const Array array = p_value;
+				write_uint32(VALUE_ARRAY);
+				write_uint32(array.get_typed_builtin());
+				write_string(array.get_typed_class_name());
+				write_value(array.get_typed_script());
+				write_bool(array.is_read_only());
+				write_int(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					write_value(array[i]);
+				}
+			} break;
+			case Variant::DICTIONARY: {
+				const Dictionary dictionary = p_value;
+				write_uint32(VALUE_DICTIONARY);
+				write_uint32(dictionary.get_typed_key_builtin());
+				write_string(dictionary.get_typed_key_class_name());
+				write_value(dictionary.get_typed_key_script());
+				write_uint32(dictionary.get_typed_value_builtin());
+				write_string(dictionary.get_typed_value_class_name());
+				write_value(dictionary.get_typed_value_script());
+				write_bool(dictionary.is_read_only());
+				write_int(dictionary.size());
+				for (const KeyValue<Variant, Variant> &E : dictionary) {
+					write_value(E.key);
+					write_value(E.value);
+				}
+			} break;
+			case Variant::CALLABLE:
+			case Variant::SIGNAL:
+			case Variant::RID: {
+				fail(vformat(R"(Constant of type "%s" can't be stored.)", Variant::get_type_name(p_value.get_type())));
+			} break;
+			default: {
+				int len = 0;
+				Error err = encode_variant(p_value, nullptr, len, false);
+				if (err != OK) {
+					fail(vformat(R"(Failed to encode a constant of type "%s".)", Variant::get_type_name(p_value.get_type())));
+					return;
+				}
+				write_uint32(VALUE_PLAIN);
+				const int pos = buffer.size();
+				buffer.resize(pos + len);
+				encode_variant(p_value, buffer.ptrw() + pos, len, false);
+			} break;
+		}
+	}
+
+	void write_data_type(const GDScriptDataType &p_type) {
+		write_bool(p_type.has_type);
+		write_uint32(p_type.kind);
+		write_uint32(p_type.builtin_type);
+		write_string(p_type.native_type);
+		write_script(p_type.script_type);
+		write_int(p_type.container_element_types.size());
+		for (const GDScriptDataType &element_type : p_type.container_element_types) {
+			write_data_type(element_type);
+		}
+	}
+
+	void write_property_info(const PropertyInfo &p_info) {
+		write_uint32(p_info.type);
+		write_string(p_info.name);
+		write_string(p_info.class_name);
+		write_uint32(p_info.hint);
+		write_string(p_info.hint_string);
+		write_uint32(p_info.usage);
+	}
+
+	void write_method_info(const MethodInfo &p_info) {
+		write_string(p_info.name);
+		write_property_info(p_info.return_val);
+		write_uint32(p_info.flags);
+		write_int(p_info.id);
+		write_int(p_info.arguments.size());
+		for (const PropertyInfo &argument : p_info.arguments) {
+			write_property_info(argument);
+		}
+		write_int(p_info.default_arguments.size());
+		for (const Variant &default_argument : p_info.default_arguments) {
+			write_value(default_argument);
+		}
+		write_int(p_info.return_val_metadata);
+		write_int(p_info.arguments_metadata.size());
+		for (int metadata : p_info.arguments_metadata) {
+			write_int(metadata);
+		}
+	}
+
+	void write_member_info(const GDScript::MemberInfo &p_info) {
+		write_int(p_info.index);
+		write_string(p_info.setter);
+		write_string(p_info.getter);
+		write_data_type(p_info.data_type);
+		write_property_info(p_info.property_info);
+	}
+
+	template <typename T, typename K>
+	bool write_pointer_key(const RBMap<T, K> &p_keys, const T &p_pointer, K &r_key) {
+		const typename RBMap<T, K>::Element *E = p_keys.find(p_pointer);
+		if (E == nullptr) {
+			fail("Bytecode refers to a builtin function that can't be named.");
+			return false;
+		}
+		r_key = E->value();
+		return true;
+	}
+
+	void write_function(const GDScript *p_class, const GDScriptFunction *p_function) {
+		write_string(p_function->name);
+		write_string(p_function->source);
+		write_bool(p_function->_static);
+		write_int(p_function->argument_types.size());
+		for (const GDScriptDataType &argument_type : p_function->argument_types) {
+			write_data_type(argument_type);
+		}
+		write_data_type(p_function->return_type);
+		write_method_info(p_function->method_info);
+		write_value(p_function->rpc_config);
+		write_int(p_function->_initial_line);
+		write_int(p_function->_argument_count);
+		write_int(p_function->_vararg_index);
+		write_int(p_function->_stack_size);
+		write_int(p_function->_instruction_args_size);
+
+		write_int(p_function->temporary_slots.size());
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			write_int(E.key);
+			write_uint32(E.value);
+		}
+
+		write_int(p_function->code.size());
+		for (int code : p_function->code) {
+			write_int(code);
+		}
+		write_int(p_function->default_arguments.size());
+		for (int address : p_function->default_arguments) {
+			write_int(address);
+		}
+
+		write_int(p_function->constants.size());
+		for (const Variant &constant : p_function->constants) {
+			write_value(constant);
+		}
+		write_int(p_function->global_names.size());
+		for (const StringName &global_name : p_function->global_names) {
+			write_string(global_name);
+		}
+
+		write_int(p_function->operator_funcs.size());
+		for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+			PointerNames::OperatorKey key;
+			if (write_pointer_key(names->operators, evaluator, key)) {
+				write_uint32(key.op);
+				write_uint32(key.type_a);
+				write_uint32(key.type_b);
+			}
+		}
+		write_int(p_function->setters.size());
+		for (Variant::ValidatedSetter setter : p_function->setters) {
+			PointerNames::MemberKey key;
+			if (write_pointer_key(names->setters, setter, key)) {
+				write_uint32(key.type);
+				write_string(key.name);
+			}
+		}
+		write_int(p_function->getters.size());
+		for (Variant::ValidatedGetter getter : p_function->getters) {
+			PointerNames::MemberKey key;
+			if (write_pointer_key(names->getters, getter, key)) {
+				write_uint32(key.type);
+				write_string(key.name);
+			}
+		}
+		write_int(p_function->keyed_setters.size());
+		for (Variant::ValidatedKeyedSetter setter : p_function->keyed_setters) {
+			Variant::Type type = Variant::NIL;
+			if (write_pointer_key(names->keyed_setters, setter, type)) {
+				write_uint32(type);
+			}
+		}
+		write_int(p_function->keyed_getters.size());
+		for (Variant::ValidatedKeyedGetter getter : p_function->keyed_getters) {
+			Variant::Type type = Variant::NIL;
+			if (write_pointer_key(names->keyed_getters, getter, type)) {
+				write_uint32(type);
+			}
+		}
+		write_int(p_function->indexed_setters.size());
+		for (Variant::ValidatedIndexedSetter setter : p_function->indexed_setters) {
+			Variant::Type type = Variant::NIL;
+			if (write_pointer_key(names->indexed_setters, setter, type)) {
+				write_uint32(type);
+			}
+		}
+		write_int(p_function->indexed_getters.size());
+		for (Variant::ValidatedIndexedGetter getter : p_function->indexed_getters) {
+			Variant::Type type = Variant::NIL;
+			if (write_pointer_key(names->indexed_getters, getter, type)) {
+				write_uint32(type);
+			}
+		}
+		write_int(p_function->builtin_methods.size());
+		for (Variant::ValidatedBuiltInMethod method : p_function->builtin_methods) {
+			PointerNames::MemberKey key;
+			if (write_pointer_key(names->builtin_methods, method, key)) {
+				write_uint32(key.type);
+				write_string(key.name);
+			}
+		}
+		write_int(p_function->constructors.size());
+		for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+			PointerNames::ConstructorKey key;
+			if (write_pointer_key(names->constructors, constructor, key)) {
+				write_uint32(key.type);
+				write_int(key.index);
+			}
+		}
+		write_int(p_function->utilities.size());
+		for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+			StringName name;
+			if (write_pointer_key(names->utilities, utility, name)) {
+				write_string(name);
+			}
+		}
+		write_int(p_function->gds_utilities.size());
+		for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+			StringName name;
+			if (write_pointer_key(names->gds_utilities, utility, name)) {
+				write_string(name);
+			}
+		}
+		write_int(p_function->methods.size());
+		for (const MethodBind *method : p_function->methods) {
+			write_string(method->get_instance_class());
+			write_string(method->get_name());
+		}
+
+		write_int(p_function->lambdas.size());
+		for (const GDScriptFunction *lambda : p_function->lambdas) {
+			const GDScript::LambdaInfo *info = p_class->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+			write_int(info ? info->capture_count : 0);
+			write_bool(info ? info->use_self : false);
+			write_function(p_class, lambda);
+		}
+
+		write_int(p_function->_inline_caches_count);
+
+#ifdef DEBUG_ENABLED
+		const Vector<String> *debug_names[] = {
+			&p_function->operator_names,
+			&p_function->setter_names,
+			&p_function->getter_names,
+			&p_function->builtin_methods_names,
+			&p_function->constructors_names,
+			&p_function->utilities_names,
+			&p_function->gds_utilities_names,
+		};
+		for (const Vector<String> *names_list : debug_names) {
+			write_int(names_list->size());
+			for (const String &debug_name : *names_list) {
+				write_string(debug_name);
+			}
+		}
+#endif
+	}
+
+	void write_optional_function(const GDScript *p_class, const GDScriptFunction *p_function) {
+		write_bool(p_function != nullptr);
+		if (p_function) {
+			write_function(p_class, p_function);
+		}
+	}
+
+	void write_class_names(const GDScript *p_class) {
+		write_string(p_class->fully_qualified_name);
+		write_string(p_class->local_name);
+		write_string(p_class->global_name);
+		write_string(p_class->simplified_icon_path);
+		write_int(p_class->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+			write_string(E.key);
+			write_class_names(E.value.ptr());
+		}
+	}
+
+	void write_class(const GDScript *p_class) {
+		write_bool(p_class->tool);
+		write_bool(p_class->_is_abstract);
+		write_string(p_class->native.is_valid() ? StringName(p_class->native->get_name()) : StringName());
+		write_script(p_class->base.ptr());
+
+		write_int(p_class->member_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->member_indices) {
+			write_string(E.key);
+			write_member_info(E.value);
+		}
+		write_int(p_class->members.size());
+		for (const StringName &member : p_class->members) {
+			write_string(member);
+		}
+		write_int(p_class->static_variables_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->static_variables_indices) {
+			write_string(E.key);
+			write_member_info(E.value);
+		}
+		write_int(p_class->constants.size());
+		for (const KeyValue<StringName, Variant> &E : p_class->constants) {
+			write_string(E.key);
+			write_value(E.value);
+		}
+		write_int(p_class->_signals.size());
+		for (const KeyValue<StringName, MethodInfo> &E : p_class->_signals) {
+			write_string(E.key);
+			write_method_info(E.value);
+		}
+		write_value(p_class->rpc_config);
+
+#ifdef TOOLS_ENABLED
+		write_int(p_class->member_default_values.size());
+		for (const KeyValue<StringName, Variant> &E : p_class->member_default_values) {
+			write_string(E.key);
+			write_value(E.value);
+		}
+#endif
+
+		write_int(p_class->member_functions.size());
+		for (const KeyValue<StringName, GDScriptFunction *> &E : p_class->member_functions) {
+			write_function(p_class, E.value);
+		}
+		write_optional_function(p_class, p_class->implicit_initializer);
+		write_optional_function(p_class, p_class->implicit_ready);
+		write_optional_function(p_class, p_class->static_initializer);
+
+		write_int(p_class->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+			write_string(E.key);
+			write_class(E.value.ptr());
+		}
+	}
+};
+
+/* READER */
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	GDScript *root = nullptr;
+	int global_count = 0;
+	String error;
+
+	bool failed() const { return !error.is_empty(); }
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	uint32_t read_uint32() {
+		if (pos + 4 > size) {
+			fail("Unexpected end of file.");
+			return 0;
+		}
+		uint32_t value = decode_uint32(data + pos);
+		pos += 4;
+		return value;
+	}
+
+	int read_int() { return int(read_uint32()); }
+	bool read_bool() { return read_uint32() != 0; }
+
+	// Counts are checked against the remaining data, so a damaged file can't
+	// trigger huge allocations.
+	int read_count() {
+		int count = read_int();
+		if (count < 0 || count > size - pos) {
+			fail("Invalid element count.");
+			return 0;
+		}
+		return count;
+	}
+
+	String read_string() {
+		const int len = read_count();
+		if (failed()) {
+			return String();
+		}
+		String string = String::utf8((const char *)data + pos, len);
+		pos += len;
+		return string;
+	}
+
+	Variant::Type read_type() {
+		uint32_t type = read_uint32();
+		if (type >= Variant::VARIANT_MAX) {
+			fail("Invalid variant type.");
+			return Variant::NIL;
+		}
+		return Variant::Type(type);
+	}
+
+	Ref<GDScript> resolve_gdscript(const String &p_path, const String &p_fqcn) {
+		Ref<GDScript> script;
+		if (p_path == root->path) {
+			script = Ref<GDScript>(root);
+		} else {
+			Error err = OK;
+			script = GDScriptCache::get_shallow_script(p_path, err, root->path);
+			if (err != OK || script.is_null()) {
+				fail(vformat(R"(Could not load script "%s".)", p_path));
+				return Ref<GDScript>();
+			}
+		}
+		script = Ref<GDScript>(script->find_class(p_fqcn));
+		if (script.is_null()) {
+			fail(vformat(R"(Could not find class "%s" in "%s".)", p_fqcn, p_path));
+		}
+		return script;
+	}
+
+	Ref<Script> read_script() {
+		switch (read_uint32()) {
+			case SCRIPT_NONE:
+				return Ref<Script>();
+			case SCRIPT_GDSCRIPT: {
+				const String path = read_string();
+				const String fqcn = read_string();
+				if (failed()) {
+					return Ref<Script>();
+				}
+				return resolve_gdscript(path, fqcn);
+			}
+			case SCRIPT_RESOURCE: {
+				const String path = read_string();
+				if (failed()) {
+					return Ref<Script>();
+				}
+				Ref<Script> script = ResourceLoader::load(path);
+				if (script.is_null()) {
+					fail(vformat(R"(Could not load script "%s".)", path));
+				}
+				return script;
+			}
+		}
+		fail("Invalid script reference.");
+		return Ref<Script>();
+	}
+
+	Variant read_value() {
+		switch (read_uint32()) {
+			case VALUE_PLAIN: {
+				Variant value;
+				int len = 0;
+				if (decode_variant(value, data + pos, size - pos, &len, false) != OK) {
+					fail("Failed to decode a constant.");
+					return Variant();
+				}
+				pos += len;
+				return value;
+			}
+			case VALUE_ARRAY: {
+				const Variant::Type type = read_type();
+				const StringName class_name = read_string();
+				const Variant script = read_value();
+				const bool read_only = read_bool();
+				const int count = read_count();
+				if (failed()) {
+					return Variant();
+				}
+				Array array;
+				array.set_typed(type, class_name, script);
+				array.resize(count);
+				for (int i = 0; i < count && !failed(); i++) {
+					array[i] = read_value();
+				}
+				if (read_only) {
+					array.make_read_only();
+				}
+				return array;
+			}
+			case VALUE_DICTIONARY: {
+				const Variant::Type key_type = read_type();
+				const StringName key_class_name = read_string();
+				const Variant key_script = read_value();
+				const Variant::Type value_type = read_type();
+				const StringName value_class_name = read_string();
+				const Variant value_script = read_value();
+				const bool read_only = read_bool();
+				const int count = read_count();
+				if (failed()) {
+					return Variant();
+				}
+				Dictionary dictionary;
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+				for (int i = 0; i < count && !failed(); i++) {
+					const Variant key = read_value();
+					dictionary[key] = read_value();
+				}
+				if (read_only) {
+					dictionary.make_read_only();
+				}
+				return dictionary;
+			}
+			case VALUE_NULL_OBJECT:
+				return Variant((Object *)nullptr);
+			case VALUE_NATIVE_CLASS: {
+				const StringName name = read_string();
+				const HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+				if (!E) {
+					fail(vformat(R"(Native class "%s" not found.)", name));
+					return Variant();
+				}
+				return GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+			}
+			case VALUE_SCRIPT:
+				return read_script();
+			case VALUE_RESOURCE: {
+				const String path = read_string();
+				if (failed()) {
+					return Variant();
+				}
+				Ref<Resource> resource = ResourceLoader::load(path);
+				if (resource.is_null()) {
+					fail(vformat(R"(Could not load resource "%s".)", path));
+				}
+				return resource;
+			}
+		}
+		fail("Invalid constant.");
+		return Variant();
+	}
+
+	void read_data_type(GDScriptDataType &r_type) {
+		r_type.has_type = read_bool();
+		const uint32_t kind = read_uint32();
+		if (kind > GDScriptDataType::GDSCRIPT) {
+			fail("Invalid data type.");
+			return;
+		}
+		r_type.kind = GDScriptDataType::Kind(kind);
+		r_type.builtin_type = read_type();
+		r_type.native_type = read_string();
+
+		Ref<Script> script = read_script();
+		r_type.script_type = script.ptr();
+		// Like the compiler, only hold a strong reference to classes from other files to avoid cycles.
+		const Ref<GDScript> gdscript = script;
+		const bool is_local_class = gdscript.is_valid() && gdscript->path == root->path;
+		if (script.is_valid() && !(r_type.kind == GDScriptDataType::GDSCRIPT && is_local_class)) {
+			r_type.script_type_ref = script;
+		}
+
+		const int count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			GDScriptDataType element_type;
+			read_data_type(element_type);
+			r_type.set_container_element_type(i, element_type);
+		}
+	}
+
+	void read_property_info(PropertyInfo &r_info) {
+		r_info.type = read_type();
+		r_info.name = read_string();
+		r_info.class_name = read_string();
+		r_info.hint = PropertyHint(read_uint32());
+		r_info.hint_string = read_string();
+		r_info.usage = read_uint32();
+	}
+
+	void read_method_info(MethodInfo &r_info) {
+		r_info.name = read_string();
+		read_property_info(r_info.return_val);
+		r_info.flags = read_uint32();
+		r_info.id = read_int();
+		int count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			PropertyInfo argument;
+			read_property_info(argument);
+			r_info.arguments.push_back(argument);
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			r_info.default_arguments.push_back(read_value());
+		}
+		r_info.return_val_metadata = read_int();
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			r_info.arguments_metadata.push_back(read_int());
+		}
+	}
+
+	void read_member_info(GDScript::MemberInfo &r_info) {
+		r_info.index = read_int();
+		r_info.setter = read_string();
+		r_info.getter = read_string();
+		read_data_type(r_info.data_type);
+		read_property_info(r_info.property_info);
+	}
+
+	template <typename T>
+	T resolve_pointer(T p_pointer) {
+		if (p_pointer == nullptr) {
+			fail("Bytecode refers to a builtin function that doesn't exist.");
+		}
+		return p_pointer;
+	}
+
+	// Mirrors what `GDScriptByteCodeGenerator::write_end()` sets up.
+	static void update_function_pointers(GDScriptFunction *p_function) {
+		p_function->_code_size = p_function->code.size();
+		p_function->_code_ptr = p_function->code.is_empty() ? nullptr : p_function->code.ptrw();
+		p_function->_default_arg_count = p_function->default_arguments.is_empty() ? 0 : p_function->default_arguments.size() - 1;
+		p_function->_default_arg_ptr = p_function->default_arguments.is_empty() ? nullptr : p_function->default_arguments.ptr();
+		p_function->_constant_count = p_function->constants.size();
+		p_function->_constants_ptr = p_function->constants.is_empty() ? nullptr : p_function->constants.ptrw();
+		p_function->_global_names_count = p_function->global_names.size();
+		p_function->_global_names_ptr = p_function->global_names.is_empty() ? nullptr : p_function->global_names.ptr();
+		p_function->_operator_funcs_count = p_function->operator_funcs.size();
+		p_function->_operator_funcs_ptr = p_function->operator_funcs.is_empty() ? nullptr : p_function->operator_funcs.ptr();
+		p_function->_setters_count = p_function->setters.size();
+		p_function->_setters_ptr = p_function->setters.is_empty() ? nullptr : p_function->setters.ptr();
+		p_function->_getters_count = p_function->getters.size();
+		p_function->_getters_ptr = p_function->getters.is_empty() ? nullptr : p_function->getters.ptr();
+		p_function->_keyed_setters_count = p_function->keyed_setters.size();
+		p_function->_keyed_setters_ptr = p_function->keyed_setters.is_empty() ? nullptr : p_function->keyed_setters.ptr();
+		p_function->_keyed_getters_count = p_function->keyed_getters.size();
+		p_function->_keyed_getters_ptr = p_function->keyed_getters.is_empty() ? nullptr : p_function->keyed_getters.ptr();
+		p_function->_indexed_setters_count = p_function->indexed_setters.size();
+		p_function->_indexed_setters_ptr = p_function->indexed_setters.is_empty() ? nullptr : p_function->indexed_setters.ptr();
+		p_function->_indexed_getters_count = p_function->indexed_getters.size();
+		p_function->_indexed_getters_ptr = p_function->indexed_getters.is_empty() ? nullptr : p_function->indexed_getters.ptr();
+		p_function->_builtin_methods_count = p_function->builtin_methods.size();
+		p_function->_builtin_methods_ptr = p_function->builtin_methods.is_empty() ? nullptr : p_function->builtin_methods.ptr();
+		p_function->_constructors_count = p_function->constructors.size();
+		p_function->_constructors_ptr = p_function->constructors.is_empty() ? nullptr : p_function->constructors.ptr();
+		p_function->_utilities_count = p_function->utilities.size();
+		p_function->_utilities_ptr = p_function->utilities.is_empty() ? nullptr : p_function->utilities.ptr();
+		p_function->_gds_utilities_count = p_function->gds_utilities.size();
+		p_function->_gds_utilities_ptr = p_function->gds_utilities.is_empty() ? nullptr : p_function->gds_utilities.ptr();
+		p_function->_methods_count = p_function->methods.size();
+		p_function->_methods_ptr = p_function->methods.is_empty() ? nullptr : p_function->methods.ptrw();
+		p_function->_lambdas_count = p_function->lambdas.size();
+		p_function->_lambdas_ptr = p_function->lambdas.is_empty() ? nullptr : p_function->lambdas.ptrw();
+	}
+
+	// The VM trusts operands in release builds, so an entry is only used if every operand of its
+	// bytecode is within the tables and stack it refers to. Follows the layout `GDScriptFunction::call()` reads.
+	void validate_code(const GDScript *p_class, GDScriptFunction *p_function) {
+		typedef GDScriptFunction GF;
+
+		const int code_size = p_function->code.size();
+		int *code = p_function->code.ptrw();
+		const int stack_size = p_function->_stack_size;
+		const int member_count = p_class->member_indices.size();
+		const int constant_count = p_function->constants.size();
+		const int global_name_count = p_function->global_names.size();
+		const int inline_cache_count = p_function->_inline_caches_count;
+
+		if (stack_size < GF::FIXED_ADDRESSES_MAX || p_function->_argument_count < 0 || p_function->_argument_count + GF::FIXED_ADDRESSES_MAX > stack_size || p_function->_vararg_index >= stack_size || p_function->_instruction_args_size < 0) {
+			fail("Invalid function layout.");
+			return;
+		}
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			if (E.key < 0 || E.key >= stack_size) {
+				fail("Invalid temporary slot.");
+				return;
+			}
+		}
+
+		LocalVector<bool> instruction_starts;
+		instruction_starts.resize_initialized(code_size);
+		LocalVector<int> jump_targets;
+		for (int address : p_function->default_arguments) {
+			jump_targets.push_back(address);
+		}
+
+		bool valid = true;
+		const auto check_address = [&](int p_address) {
+			const int index = p_address & GF::ADDR_MASK;
+			switch ((p_address & GF::ADDR_TYPE_MASK) >> GF::ADDR_BITS) {
+				case GF::ADDR_TYPE_STACK:
+					valid = valid && index < stack_size;
+					break;
+				case GF::ADDR_TYPE_CONSTANT:
+					valid = valid && index < constant_count;
+					break;
+				case GF::ADDR_TYPE_MEMBER:
+					valid = valid && index < member_count;
+					break;
+				default:
+					valid = false;
+			}
+		};
+		const auto check_index = [&](int p_index, int p_count) {
+			valid = valid && p_index >= 0 && p_index < p_count;
+		};
+		const auto check_type = [&](int p_type) {
+			check_index(p_type, Variant::VARIANT_MAX);
+		};
+
+		int ip = 0;
+		while (ip < code_size && valid) {
+			instruction_starts[ip] = true;
+			const int opcode = code[ip];
+
+			// Instructions with an address list: opcode, address count, addresses, then `p_fields` fixed operands.
+			int arg_count = 0;
+			int fields = 0;
+			const auto begin_var_args = [&](int p_fields) {
+				if (ip + 1 >= code_size) {
+					valid = false;
+					return;
+				}
+				arg_count = code[ip + 1];
+				valid = valid && arg_count >= 0 && arg_count <= p_function->_instruction_args_size && ip + 2 + arg_count + p_fields <= code_size;
+				for (int i = 0; valid && i < arg_count; i++) {
+					check_address(code[ip + 2 + i]);
+				}
+				fields = ip + 1 + arg_count;
+			};
+			// Fixed size instructions: opcode, then `p_size - 1` operands.
+			const auto begin_fixed = [&](int p_size) {
+				valid = valid && ip + p_size <= code_size;
+			};
+
+			switch (opcode) {
+				case GF::OPCODE_OPERATOR: {
+					constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*code);
+					begin_fixed(7 + pointer_size);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_address(code[ip + 3]);
+					check_index(code[ip + 4], Variant::OP_MAX);
+					// Drop the evaluator cached by any run before the entry was saved.
+					for (int i = 5; i < 7 + pointer_size; i++) {
+						code[ip + i] = 0;
+					}
+					ip += 7 + pointer_size;
+				} break;
+				case GF::OPCODE_OPERATOR_VALIDATED:
+				case GF::OPCODE_SET_KEYED_VALIDATED:
+				case GF::OPCODE_SET_INDEXED_VALIDATED:
+				case GF::OPCODE_GET_KEYED_VALIDATED:
+				case GF::OPCODE_GET_INDEXED_VALIDATED: {
+					begin_fixed(5);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_address(code[ip + 3]);
+					switch (opcode) {
+						case GF::OPCODE_OPERATOR_VALIDATED:
+							check_index(code[ip + 4], p_function->operator_funcs.size());
+							break;
+						case GF::OPCODE_SET_KEYED_VALIDATED:
+							check_index(code[ip + 4], p_function->keyed_setters.size());
+							break;
+						case GF::OPCODE_SET_INDEXED_VALIDATED:
+							check_index(code[ip + 4], p_function->indexed_setters.size());
+							break;
+						case GF::OPCODE_GET_KEYED_VALIDATED:
+							check_index(code[ip + 4], p_function->keyed_getters.size());
+							break;
+						default:
+							check_index(code[ip + 4], p_function->indexed_getters.size());
+					}
+					ip += 5;
+				} break;
+				case GF::OPCODE_ADD_INT:
+				case GF::OPCODE_SUBTRACT_INT:
+				case GF::OPCODE_MULTIPLY_INT:
+				case GF::OPCODE_EQUAL_INT:
+				case GF::OPCODE_NOT_EQUAL_INT:
+				case GF::OPCODE_LESS_INT:
+				case GF::OPCODE_LESS_EQUAL_INT:
+				case GF::OPCODE_GREATER_INT:
+				case GF::OPCODE_GREATER_EQUAL_INT:
+				case GF::OPCODE_ADD_FLOAT:
+				case GF::OPCODE_SUBTRACT_FLOAT:
+				case GF::OPCODE_MULTIPLY_FLOAT:
+				case GF::OPCODE_DIVIDE_FLOAT:
+				case GF::OPCODE_EQUAL_FLOAT:
+				case GF::OPCODE_NOT_EQUAL_FLOAT:
+				case GF::OPCODE_LESS_FLOAT:
+				case GF::OPCODE_LESS_EQUAL_FLOAT:
+				case GF::OPCODE_GREATER_FLOAT:
+				case GF::OPCODE_GREATER_EQUAL_FLOAT:
+				case GF::OPCODE_ADD_VECTOR2:
+				case GF::OPCODE_SUBTRACT_VECTOR2:
+				case GF::OPCODE_MULTIPLY_VECTOR2:
+				case GF::OPCODE_MULTIPLY_VECTOR2_FLOAT:
+				case GF::OPCODE_ADD_VECTOR3:
+				case GF::OPCODE_SUBTRACT_VECTOR3:
+				case GF::OPCODE_MULTIPLY_VECTOR3:
+				case GF::OPCODE_MULTIPLY_VECTOR3_FLOAT:
+				case GF::OPCODE_TYPE_TEST_SCRIPT:
+				case GF::OPCODE_SET_KEYED:
+				case GF::OPCODE_GET_KEYED:
+				case GF::OPCODE_ASSIGN_TYPED_NATIVE:
+				case GF::OPCODE_ASSIGN_TYPED_SCRIPT:
+				case GF::OPCODE_CAST_TO_NATIVE:
+				case GF::OPCODE_CAST_TO_SCRIPT: {
+					begin_fixed(4);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_address(code[ip + 3]);
+					ip += 4;
+				} break;
+				case GF::OPCODE_TYPE_TEST_BUILTIN:
+				case GF::OPCODE_ASSIGN_TYPED_BUILTIN:
+				case GF::OPCODE_CAST_TO_BUILTIN: {
+					begin_fixed(4);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_type(code[ip + 3]);
+					ip += 4;
+				} break;
+				case GF::OPCODE_TYPE_TEST_NATIVE:
+				case GF::OPCODE_SET_NAMED_VALIDATED:
+				case GF::OPCODE_GET_NAMED_VALIDATED: {
+					begin_fixed(4);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					if (opcode == GF::OPCODE_TYPE_TEST_NATIVE) {
+						check_index(code[ip + 3], global_name_count);
+						ip += 4;
+					} else {
+						check_index(code[ip + 3], opcode == GF::OPCODE_SET_NAMED_VALIDATED ? p_function->setters.size() : p_function->getters.size());
+						ip += 4;
+					}
+				} break;
+				case GF::OPCODE_TYPE_TEST_ARRAY:
+				case GF::OPCODE_ASSIGN_TYPED_ARRAY: {
+					begin_fixed(6);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_address(code[ip + 3]);
+					check_type(code[ip + 4]);
+					check_index(code[ip + 5], global_name_count);
+					ip += 6;
+				} break;
+				case GF::OPCODE_TYPE_TEST_DICTIONARY:
+				case GF::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+					begin_fixed(9);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_address(code[ip + 3]);
+					check_address(code[ip + 4]);
+					check_type(code[ip + 5]);
+					check_index(code[ip + 6], global_name_count);
+					check_type(code[ip + 7]);
+					check_index(code[ip + 8], global_name_count);
+					ip += 9;
+				} break;
+				case GF::OPCODE_SET_NAMED:
+				case GF::OPCODE_GET_NAMED: {
+					begin_fixed(5);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_index(code[ip + 3], global_name_count);
+					check_index(code[ip + 4], inline_cache_count);
+					ip += 5;
+				} break;
+				case GF::OPCODE_SET_MEMBER:
+				case GF::OPCODE_GET_MEMBER:
+				case GF::OPCODE_STORE_NAMED_GLOBAL: {
+					begin_fixed(3);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_index(code[ip + 2], global_name_count);
+					ip += 3;
+				} break;
+				case GF::OPCODE_SET_STATIC_VARIABLE:
+				case GF::OPCODE_GET_STATIC_VARIABLE: {
+					begin_fixed(4);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					// Variables of other classes are only known once those are loaded, the VM checks them.
+					check_index(code[ip + 3], code[ip + 2] == GF::ADDR_CLASS ? p_class->static_variables.size() : INT_MAX);
+					ip += 4;
+				} break;
+				case GF::OPCODE_ASSIGN: {
+					begin_fixed(3);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					ip += 3;
+				} break;
+				case GF::OPCODE_ASSIGN_NULL:
+				case GF::OPCODE_ASSIGN_TRUE:
+				case GF::OPCODE_ASSIGN_FALSE:
+				case GF::OPCODE_AWAIT_RESUME:
+				case GF::OPCODE_RETURN: {
+					begin_fixed(2);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					ip += 2;
+				} break;
+				case GF::OPCODE_AWAIT: {
+					// Always followed by the instruction receiving the result.
+					begin_fixed(4);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					valid = valid && code[ip + 2] == GF::OPCODE_AWAIT_RESUME;
+					ip += 2;
+				} break;
+				case GF::OPCODE_CONSTRUCT:
+				case GF::OPCODE_CONSTRUCT_VALIDATED: {
+					begin_var_args(2);
+					if (!valid) {
+						break;
+					}
+					const int argc = code[fields + 1];
+					valid = valid && argc >= 0 && argc + 1 <= arg_count;
+					if (opcode == GF::OPCODE_CONSTRUCT) {
+						check_type(code[fields + 2]);
+					} else {
+						check_index(code[fields + 2], p_function->constructors.size());
+					}
+					ip = fields + 3;
+				} break;
+				case GF::OPCODE_CONSTRUCT_ARRAY:
+				case GF::OPCODE_CONSTRUCT_DICTIONARY: {
+					begin_var_args(1);
+					if (!valid) {
+						break;
+					}
+					const int argc = code[fields + 1];
+					valid = valid && argc >= 0 && (opcode == GF::OPCODE_CONSTRUCT_ARRAY ? argc : argc * 2) + 1 <= arg_count;
+					ip = fields + 2;
+				} break;
+				case GF::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+					begin_var_args(3);
+					if (!valid) {
+						break;
+					}
+					const int argc = code[fields + 1];
+					valid = valid && argc >= 0 && argc + 2 <= arg_count;
+					check_type(code[fields + 2]);
+					check_index(code[fields + 3], global_name_count);
+					ip = fields + 4;
+				} break;
+				case GF::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+					begin_var_args(5);
+					if (!valid) {
+						break;
+					}
+					const int argc = code[fields + 1];
+					valid = valid && argc >= 0 && argc * 2 + 3 <= arg_count;
+					check_type(code[fields + 2]);
+					check_index(code[fields + 3], global_name_count);
+					check_type(code[fields + 4]);
+					check_index(code[fields + 5], global_name_count);
+					ip = fields + 6;
+				} break;
+				case GF::OPCODE_CALL:
+				case GF::OPCODE_CALL_RETURN:
+				case GF::OPCODE_CALL_ASYNC: {
+					begin_var_args(3);
+					if (!valid) {
+						break;
+					}
+					const int argc = code[fields + 1];
+					valid = valid && argc >= 0 && argc + (opcode == GF::OPCODE_CALL ? 1 : 2) <= arg_count;
+					check_index(code[fields + 2], global_name_count);
+					check_index(code[fields + 3], inline_cache_count);
+					ip = fields + 4;
+				} break;
+				case GF::OPCODE_CALL_BUILTIN_STATIC: {
+					begin_var_args(3);
+					if (!valid) {
+						break;
+					}
+					check_type(code[fields + 1]);
+					check_index(code[fields + 2], global_name_count);
+					const int argc = code[fields + 3];
+					valid = valid && argc >= 0 && argc + 1 <= arg_count;
+					ip = fields + 4;
+				} break;
+				case GF::OPCODE_CALL_NATIVE_STATIC: {
+					begin_var_args(2);
+					if (!valid) {
+						break;
+					}
+					check_index(code[fields + 1], p_function->methods.size());
+					const int argc = code[fields + 2];
+					valid = valid && argc >= 0 && argc + 1 <= arg_count;
+					ip = fields + 3;
+				} break;
+				case GF::OPCODE_CALL_UTILITY:
+				case GF::OPCODE_CALL_UTILITY_VALIDATED:
+				case GF::OPCODE_CALL_GDSCRIPT_UTILITY:
+				case GF::OPCODE_CALL_SELF_BASE:
+				case GF::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+				case GF::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+				case GF::OPCODE_CALL_METHOD_BIND:
+				case GF::OPCODE_CALL_METHOD_BIND_RET:
+				case GF::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+				case GF::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+				case GF::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+				case GF::OPCODE_CREATE_LAMBDA:
+				case GF::OPCODE_CREATE_SELF_LAMBDA: {
+					begin_var_args(2);
+					if (!valid) {
+						break;
+					}
+					// Argument (or capture) count, then the table index.
+					const int argc = code[fields + 1];
+					int used_args = argc + 1; // Arguments and result.
+					int table_size = 0;
+					switch (opcode) {
+						case GF::OPCODE_CALL_UTILITY:
+						case GF::OPCODE_CALL_SELF_BASE:
+							table_size = global_name_count;
+							break;
+						case GF::OPCODE_CALL_UTILITY_VALIDATED:
+							table_size = p_function->utilities.size();
+							break;
+						case GF::OPCODE_CALL_GDSCRIPT_UTILITY:
+							table_size = p_function->gds_utilities.size();
+							break;
+						case GF::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+						case GF::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+							table_size = p_function->methods.size();
+							break;
+						case GF::OPCODE_CALL_METHOD_BIND:
+						case GF::OPCODE_CALL_METHOD_BIND_RET:
+						case GF::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+						case GF::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+							table_size = p_function->methods.size();
+							used_args = argc + 2; // Arguments, base and result.
+							break;
+						case GF::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+							table_size = p_function->builtin_methods.size();
+							used_args = argc + 2;
+							break;
+						default:
+							table_size = p_function->lambdas.size();
+					}
+					valid = valid && argc >= 0 && used_args <= arg_count;
+					check_index(code[fields + 2], table_size);
+					ip = fields + 3;
+				} break;
+				case GF::OPCODE_JUMP: {
+					begin_fixed(2);
+					if (!valid) {
+						break;
+					}
+					jump_targets.push_back(code[ip + 1]);
+					ip += 2;
+				} break;
+				case GF::OPCODE_JUMP_IF:
+				case GF::OPCODE_JUMP_IF_NOT:
+				case GF::OPCODE_JUMP_IF_SHARED: {
+					begin_fixed(3);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					jump_targets.push_back(code[ip + 2]);
+					ip += 3;
+				} break;
+				case GF::OPCODE_JUMP_UNLESS_EQUAL_INT:
+				case GF::OPCODE_JUMP_UNLESS_NOT_EQUAL_INT:
+				case GF::OPCODE_JUMP_UNLESS_LESS_INT:
+				case GF::OPCODE_JUMP_UNLESS_LESS_EQUAL_INT:
+				case GF::OPCODE_JUMP_UNLESS_GREATER_INT:
+				case GF::OPCODE_JUMP_UNLESS_GREATER_EQUAL_INT:
+				case GF::OPCODE_JUMP_UNLESS_EQUAL_FLOAT:
+				case GF::OPCODE_JUMP_UNLESS_NOT_EQUAL_FLOAT:
+				case GF::OPCODE_JUMP_UNLESS_LESS_FLOAT:
+				case GF::OPCODE_JUMP_UNLESS_LESS_EQUAL_FLOAT:
+				case GF::OPCODE_JUMP_UNLESS_GREATER_FLOAT:
+				case GF::OPCODE_JUMP_UNLESS_GREATER_EQUAL_FLOAT: {
+					begin_fixed(4);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					jump_targets.push_back(code[ip + 3]);
+					ip += 4;
+				} break;
+				case GF::OPCODE_JUMP_TO_DEF_ARGUMENT:
+				case GF::OPCODE_BREAKPOINT:
+				case GF::OPCODE_END: {
+					ip += 1;
+				} break;
+				case GF::OPCODE_RETURN_TYPED_BUILTIN: {
+					begin_fixed(3);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_type(code[ip + 2]);
+					ip += 3;
+				} break;
+				case GF::OPCODE_RETURN_TYPED_NATIVE:
+				case GF::OPCODE_RETURN_TYPED_SCRIPT:
+				case GF::OPCODE_ASSERT: {
+					begin_fixed(3);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					ip += 3;
+				} break;
+				case GF::OPCODE_RETURN_TYPED_ARRAY: {
+					begin_fixed(5);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_type(code[ip + 3]);
+					check_index(code[ip + 4], global_name_count);
+					ip += 5;
+				} break;
+				case GF::OPCODE_RETURN_TYPED_DICTIONARY: {
+					begin_fixed(8);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_address(code[ip + 2]);
+					check_address(code[ip + 3]);
+					check_type(code[ip + 4]);
+					check_index(code[ip + 5], global_name_count);
+					check_type(code[ip + 6]);
+					check_index(code[ip + 7], global_name_count);
+					ip += 8;
+				} break;
+				case GF::OPCODE_ITERATE_BEGIN_RANGE: {
+					begin_fixed(7);
+					if (!valid) {
+						break;
+					}
+					for (int i = 1; i <= 5; i++) {
+						check_address(code[ip + i]);
+					}
+					jump_targets.push_back(code[ip + 6]);
+					ip += 7;
+				} break;
+				case GF::OPCODE_ITERATE_RANGE: {
+					begin_fixed(6);
+					if (!valid) {
+						break;
+					}
+					for (int i = 1; i <= 4; i++) {
+						check_address(code[ip + i]);
+					}
+					jump_targets.push_back(code[ip + 5]);
+					ip += 6;
+				} break;
+				case GF::OPCODE_STORE_GLOBAL: {
+					begin_fixed(3);
+					if (!valid) {
+						break;
+					}
+					check_address(code[ip + 1]);
+					check_index(code[ip + 2], global_count);
+					ip += 3;
+				} break;
+				case GF::OPCODE_LINE: {
+					begin_fixed(2);
+					ip += 2;
+				} break;
+				default: {
+					if ((opcode >= GF::OPCODE_ITERATE_BEGIN && opcode <= GF::OPCODE_ITERATE_BEGIN_OBJECT) || (opcode >= GF::OPCODE_ITERATE && opcode <= GF::OPCODE_ITERATE_OBJECT)) {
+						// Counter, container, iterator and the loop exit.
+						begin_fixed(5);
+						if (!valid) {
+							break;
+						}
+						check_address(code[ip + 1]);
+						check_address(code[ip + 2]);
+						check_address(code[ip + 3]);
+						jump_targets.push_back(code[ip + 4]);
+						ip += 5;
+					} else if (opcode >= GF::OPCODE_TYPE_ADJUST_BOOL && opcode <= GF::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+						begin_fixed(2);
+						if (!valid) {
+							break;
+						}
+						check_address(code[ip + 1]);
+						ip += 2;
+					} else {
+						valid = false;
+					}
+				}
+			}
+		}
+
+		for (int target : jump_targets) {
+			valid = valid && target >= 0 && target < code_size && instruction_starts[target];
+		}
+		if (!valid) {
+			fail(vformat(R"(Invalid bytecode in function "%s".)", p_function->name));
+		}
+	}
+
+	void read_function_body(GDScript *p_class, GDScriptFunction *p_function) {
+		p_function->name = read_string();
+		p_function->source = read_string();
+		p_function->_static = read_bool();
+		int count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			GDScriptDataType argument_type;
+			read_data_type(argument_type);
+			p_function->argument_types.push_back(argument_type);
+		}
+		read_data_type(p_function->return_type);
+		read_method_info(p_function->method_info);
+		p_function->rpc_config = read_value();
+		p_function->_initial_line = read_int();
+		p_function->_argument_count = read_int();
+		p_function->_vararg_index = read_int();
+		p_function->_stack_size = read_int();
+		p_function->_instruction_args_size = read_int();
+
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const int slot = read_int();
+			p_function->temporary_slots[slot] = read_type();
+		}
+
+		count = read_count();
+		p_function->code.resize(count);
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->code.write[i] = read_int();
+		}
+		count = read_count();
+		p_function->default_arguments.resize(count);
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->default_arguments.write[i] = read_int();
+		}
+
+		count = read_count();
+		p_function->constants.resize(count);
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->constants.write[i] = read_value();
+		}
+		count = read_count();
+		p_function->global_names.resize(count);
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->global_names.write[i] = read_string();
+		}
+
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const uint32_t op = read_uint32();
+			const Variant::Type type_a = read_type();
+			const Variant::Type type_b = read_type();
+			if (op >= Variant::OP_MAX) {
+				fail("Invalid operator.");
+				break;
+			}
+			p_function->operator_funcs.push_back(resolve_pointer(Variant::get_validated_operator_evaluator(Variant::Operator(op), type_a, type_b)));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const Variant::Type type = read_type();
+			const StringName member = read_string();
+			p_function->setters.push_back(resolve_pointer(Variant::get_member_validated_setter(type, member)));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const Variant::Type type = read_type();
+			const StringName member = read_string();
+			p_function->getters.push_back(resolve_pointer(Variant::get_member_validated_getter(type, member)));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->keyed_setters.push_back(resolve_pointer(Variant::get_member_validated_keyed_setter(read_type())));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->keyed_getters.push_back(resolve_pointer(Variant::get_member_validated_keyed_getter(read_type())));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->indexed_setters.push_back(resolve_pointer(Variant::get_member_validated_indexed_setter(read_type())));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->indexed_getters.push_back(resolve_pointer(Variant::get_member_validated_indexed_getter(read_type())));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const Variant::Type type = read_type();
+			const StringName method = read_string();
+			p_function->builtin_methods.push_back(resolve_pointer(Variant::get_validated_builtin_method(type, method)));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const Variant::Type type = read_type();
+			const int index = read_int();
+			if (index < 0 || index >= Variant::get_constructor_count(type)) {
+				fail("Invalid constructor.");
+				break;
+			}
+			p_function->constructors.push_back(resolve_pointer(Variant::get_validated_constructor(type, index)));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->utilities.push_back(resolve_pointer(Variant::get_validated_utility_function(read_string())));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			p_function->gds_utilities.push_back(resolve_pointer(GDScriptUtilityFunctions::get_function(read_string())));
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const StringName class_name = read_string();
+			const StringName method = read_string();
+			p_function->methods.push_back(resolve_pointer(ClassDB::get_method(class_name, method)));
+		}
+
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			GDScript::LambdaInfo info;
+			info.capture_count = read_int();
+			info.use_self = read_bool();
+			GDScriptFunction *lambda = read_function(p_class);
+			if (lambda == nullptr) {
+				break;
+			}
+			p_function->lambdas.push_back(lambda);
+			p_class->lambda_info.insert(lambda, info);
+		}
+
+		count = read_count();
+		if (count > 0 && !failed()) {
+			p_function->inline_caches = memnew_arr(GDScriptFunction::InlineCache, count);
+		}
+		p_function->_inline_caches_count = p_function->inline_caches ? count : 0;
+
+#ifdef DEBUG_ENABLED
+		Vector<String> *debug_names[] = {
+			&p_function->operator_names,
+			&p_function->setter_names,
+			&p_function->getter_names,
+			&p_function->builtin_methods_names,
+			&p_function->constructors_names,
+			&p_function->utilities_names,
+			&p_function->gds_utilities_names,
+		};
+		for (Vector<String> *names_list : debug_names) {
+			count = read_count();
+			for (int i = 0; i < count && !failed(); i++) {
+				names_list->push_back(read_string());
+			}
+		}
+
+		p_function->func_cname = (String(p_function->source) + " - " + String(p_function->name)).utf8();
+		p_function->_func_cname = p_function->func_cname.get_data();
+#endif
+
+		if (!failed()) {
+			validate_code(p_class, p_function);
+		}
+		update_function_pointers(p_function);
+	}
+
+	GDScriptFunction *read_function(GDScript *p_class) {
+		GDScriptFunction *function = memnew(GDScriptFunction);
+		function->_script = p_class;
+		read_function_body(p_class, function);
+		if (failed()) {
+			memdelete(function);
+			return nullptr;
+		}
+		return function;
+	}
+
+	GDScriptFunction *read_optional_function(GDScript *p_class) {
+		if (!read_bool()) {
+			return nullptr;
+		}
+		return read_function(p_class);
+	}
+
+	// Same as `GDScriptCompiler::make_scripts()`, but from the stored class names.
+	void read_class_names(GDScript *p_class) {
+		p_class->fully_qualified_name = read_string();
+		p_class->local_name = read_string();
+		p_class->global_name = read_string();
+		p_class->simplified_icon_path = read_string();
+
+		HashMap<StringName, Ref<GDScript>> old_subclasses = p_class->subclasses;
+		p_class->subclasses.clear();
+
+		const int count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const StringName name = read_string();
+			Ref<GDScript> subclass;
+			if (old_subclasses.has(name)) {
+				subclass = old_subclasses[name];
+			}
+
+			// The fully qualified name is read next, check for orphans with it.
+			const int name_pos = pos;
+			const String fqcn = read_string();
+			pos = name_pos;
+			if (subclass.is_null()) {
+				subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fqcn);
+			}
+			if (subclass.is_null()) {
+				subclass.instantiate();
+			}
+
+			subclass->_owner = p_class;
+			subclass->path = p_class->path;
+			p_class->subclasses.insert(name, subclass);
+
+			read_class_names(subclass.ptr());
+		}
+	}
+
+	void read_class(GDScript *p_class) {
+		if (!p_class->member_functions.is_empty() || p_class->implicit_initializer) {
+			fail("Class was already compiled.");
+			return;
+		}
+
+		p_class->tool = read_bool();
+		p_class->_is_abstract = read_bool();
+
+		const StringName native_name = read_string();
+		const HashMap<StringName, int>::ConstIterator native = GDScriptLanguage::get_singleton()->get_global_map().find(native_name);
+		if (!native) {
+			fail(vformat(R"(Native class "%s" not found.)", native_name));
+			return;
+		}
+		p_class->native = GDScriptLanguage::get_singleton()->get_global_array()[native->value];
+		if (p_class->native.is_null()) {
+			fail(vformat(R"(Native class "%s" not found.)", native_name));
+			return;
+		}
+
+		p_class->base = read_script();
+		p_class->_base = p_class->base.ptr();
+
+		int count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const StringName name = read_string();
+			read_member_info(p_class->member_indices[name]);
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			p_class->members.insert(read_string());
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const StringName name = read_string();
+			read_member_info(p_class->static_variables_indices[name]);
+		}
+		p_class->static_variables.resize(p_class->static_variables_indices.size());
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const StringName name = read_string();
+			p_class->constants.insert(name, read_value());
+		}
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const StringName name = read_string();
+			read_method_info(p_class->_signals[name]);
+		}
+		p_class->rpc_config = read_value();
+
+#ifdef TOOLS_ENABLED
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const StringName name = read_string();
+			p_class->member_default_values[name] = read_value();
+		}
+#endif
+
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			GDScriptFunction *function = read_function(p_class);
+			if (function == nullptr) {
+				return;
+			}
+			p_class->member_functions[function->name] = function;
+			if (function->name == GDScriptLanguage::get_singleton()->strings._init) {
+				p_class->initializer = function;
+			}
+		}
+		if (failed()) {
+			return;
+		}
+		p_class->implicit_initializer = read_optional_function(p_class);
+		p_class->implicit_ready = read_optional_function(p_class);
+		p_class->static_initializer = read_optional_function(p_class);
+
+		count = read_count();
+		for (int i = 0; i < count && !failed(); i++) {
+			const StringName name = read_string();
+			HashMap<StringName, Ref<GDScript>>::Iterator E = p_class->subclasses.find(name);
+			if (!E) {
+				fail(vformat(R"(Unknown inner class "%s".)", name));
+				return;
+			}
+			read_class(E->value.ptr());
+		}
+		if (failed()) {
+			return;
+		}
+
+		p_class->_static_default_init();
+		p_class->valid = true;
+	}
+};
+
+/* HASHES */
+
+static String _get_buffer_sha256(const Vector<uint8_t> &p_buffer) {
+	unsigned char hash[32];
+	CryptoCore::sha256(p_buffer.ptr(), p_buffer.size(), hash);
+	return String::hex_encode_buffer(hash, 32);
+}
+
+String GDScriptBytecodeCache::_get_script_source_hash(const GDScript *p_script) {
+	// Same as `GDScriptParserRef`, so entries match whatever the parser would see.
+	if (!p_script->binary_tokens.is_empty()) {
+		return _get_buffer_sha256(p_script->binary_tokens);
+	}
+	return p_script->source.sha256_text();
+}
+
+String GDScriptBytecodeCache::_get_file_source_hash(const String &p_path) {
+	{
+		MutexLock lock(mutex);
+		if (const String *hash = source_hashes.getptr(p_path)) {
+			return *hash;
+		}
+	}
+
+	String hash;
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (FileAccess::exists(remapped_path)) {
+		if (remapped_path.get_extension().to_lower() == "gdc") {
+			hash = _get_buffer_sha256(GDScriptCache::get_binary_tokens(remapped_path));
+		} else {
+			hash = GDScriptCache::get_source_code(remapped_path).sha256_text();
+		}
+	}
+
+	MutexLock lock(mutex);
+	source_hashes[p_path] = hash;
+	return hash;
+}
+
+String GDScriptBytecodeCache::_get_environment_hash() {
+	MutexLock lock(mutex);
+	if (!environment_hash.is_empty()) {
+		return environment_hash;
+	}
+
+	// Global class names and autoloads change how identifiers are resolved.
+	String environment;
+
+	List<StringName> global_classes;
+	ScriptServer::get_global_class_list(&global_classes);
+	global_classes.sort_custom<StringName::AlphCompare>();
+	for (const StringName &global_class : global_classes) {
+		environment += vformat("class %s %s %s\n", global_class, ScriptServer::get_global_class_path(global_class), ScriptServer::get_global_class_base(global_class));
+	}
+
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		environment += vformat("autoload %s %s %d\n", E.key, E.value.path, E.value.is_singleton);
+	}
+
+	environment_hash = environment.sha256_text();
+	return environment_hash;
+}
+
+String GDScriptBytecodeCache::_get_globals_hash(int p_count) {
+	// Bytecode addresses globals by their index, so the entries it may use must not have moved.
+	const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	Vector<StringName> global_names;
+	global_names.resize(p_count);
+	for (const KeyValue<StringName, int> &E : global_map) {
+		if (E.value < p_count) {
+			global_names.write[E.value] = E.key;
+		}
+	}
+
+	String globals;
+	for (const StringName &name : global_names) {
+		globals += String(name) + "\n";
+	}
+	return globals.sha256_text();
+}
+
+const GDScriptBytecodeCache::PointerNames &GDScriptBytecodeCache::_get_pointer_names() {
+	MutexLock lock(mutex);
+	if (pointer_names == nullptr) {
+		pointer_names = memnew(PointerNames);
+	}
+	return *pointer_names;
+}
+
+/* PUBLIC API */
+
+bool GDScriptBytecodeCache::is_enabled() {
+	const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	// Debugging needs the local variable and profiling data that only the compiler produces.
+	return language->is_bytecode_cache_enabled() && !language->should_track_locals() && !Engine::get_singleton()->is_editor_hint();
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	return String("user://.gdscript_cache").path_join(p_script_path.sha256_text() + ".gdbc");
+}
+
+Error GDScriptBytecodeCache::save(GDScript *p_script, GDScriptParser *p_parser, const String &p_cache_path) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_NULL_V(p_parser, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!p_script->valid, ERR_INVALID_PARAMETER);
+
+	// Every script the analyzer looked at, directly or through other scripts, may
+	// have shaped the bytecode (member indices, constants, validated calls).
+	HashMap<String, String> dependencies;
+	List<GDScriptParser *> pending;
+	pending.push_back(p_parser);
+	while (!pending.is_empty()) {
+		GDScriptParser *parser = pending.front()->get();
+		pending.pop_front();
+		for (const KeyValue<String, Ref<GDScriptParserRef>> &E : parser->get_depended_parsers()) {
+			if (E.key == p_script->path || dependencies.has(E.key)) {
+				continue;
+			}
+			dependencies.insert(E.key, _get_file_source_hash(E.key));
+			if (E.value.is_valid() && E.value->get_status() != GDScriptParserRef::EMPTY) {
+				pending.push_back(E.value->get_parser());
+			}
+		}
+	}
+
+	Writer writer;
+	writer.root = p_script;
+	writer.names = &_get_pointer_names();
+
+	writer.write_bytes((const uint8_t *)"GDBC", 4);
+	writer.write_uint32(FORMAT_VERSION);
+	writer.write_string(_get_build_id());
+	writer.write_uint32(_get_build_flags());
+	writer.write_uint32(GDScriptFunction::OPCODE_END);
+	writer.write_string(_get_script_source_hash(p_script));
+	writer.write_string(_get_environment_hash());
+	const int global_count = GDScriptLanguage::get_singleton()->get_global_map().size();
+	writer.write_int(global_count);
+	writer.write_string(_get_globals_hash(global_count));
+	writer.write_int(dependencies.size());
+	for (const KeyValue<String, String> &E : dependencies) {
+		writer.write_string(E.key);
+		writer.write_string(E.value);
+	}
+	writer.write_bool(p_parser->get_tree()->annotated_static_unload);
+
+	writer.write_class_names(p_script);
+	writer.write_class(p_script);
+	if (writer.failed()) {
+		print_verbose(vformat(R"(GDScript: Not caching bytecode for "%s": %s)", p_script->path, writer.error));
+		return ERR_UNAVAILABLE;
+	}
+	writer.write_uint32(hash_djb2_buffer(writer.buffer.ptr(), writer.buffer.size()));
+
+	Error err = DirAccess::make_dir_recursive_absolute(p_cache_path.get_base_dir());
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Could not create the GDScript bytecode cache folder "%s".)", p_cache_path.get_base_dir()));
+
+	// Write to a temporary file first so a crash can't leave a truncated entry behind.
+	const String temp_path = p_cache_path + ".tmp";
+	{
+		Ref<FileAccess> file = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Could not write the GDScript bytecode cache file "%s".)", temp_path));
+		file->store_buffer(writer.buffer.ptr(), writer.buffer.size());
+	}
+	if (FileAccess::exists(p_cache_path)) {
+		DirAccess::remove_absolute(p_cache_path);
+	}
+	return DirAccess::rename_absolute(temp_path, p_cache_path);
+}
+
+static Error _read_cache_file(const String &p_cache_path, Vector<uint8_t> &r_data) {
+	if (!FileAccess::exists(p_cache_path)) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	Error err = OK;
+	r_data = FileAccess::get_file_as_bytes(p_cache_path, &err);
+	if (err != OK) {
+		return err;
+	}
+	if (r_data.size() < 8 || memcmp(r_data.ptr(), "GDBC", 4) != 0) {
+		return ERR_FILE_CORRUPT;
+	}
+	const int body_size = r_data.size() - 4;
+	if (hash_djb2_buffer(r_data.ptr(), body_size) != decode_uint32(r_data.ptr() + body_size)) {
+		return ERR_FILE_CORRUPT;
+	}
+	return OK;
+}
+
+bool GDScriptBytecodeCache::_read_header(Reader &r_reader, bool &r_static_unload) {
+	r_reader.pos = 4;
+	if (r_reader.read_uint32() != FORMAT_VERSION || r_reader.read_string() != _get_build_id() || r_reader.read_uint32() != _get_build_flags() || r_reader.read_uint32() != GDScriptFunction::OPCODE_END) {
+		return false;
+	}
+	if (r_reader.read_string() != _get_script_source_hash(r_reader.root) || r_reader.read_string() != _get_environment_hash()) {
+		return false;
+	}
+
+	const int global_count = r_reader.read_int();
+	const String globals_hash = r_reader.read_string();
+	if (global_count < 0 || uint32_t(global_count) > GDScriptLanguage::get_singleton()->get_global_map().size() || _get_globals_hash(global_count) != globals_hash) {
+		return false;
+	}
+
+	const int dependency_count = r_reader.read_count();
+	for (int i = 0; i < dependency_count && !r_reader.failed(); i++) {
+		const String path = r_reader.read_string();
+		if (r_reader.read_string() != _get_file_source_hash(path)) {
+			return false;
+		}
+	}
+
+	r_reader.global_count = global_count;
+	r_static_unload = r_reader.read_bool();
+	return !r_reader.failed();
+}
+
+Error GDScriptBytecodeCache::load_classes(GDScript *p_script, const String &p_cache_path) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Vector<uint8_t> data;
+	Error err = _read_cache_file(p_cache_path, data);
+	if (err != OK) {
+		return err;
+	}
+
+	Reader reader;
+	reader.data = data.ptr();
+	reader.size = data.size() - 4;
+	reader.root = p_script;
+
+	bool static_unload = false;
+	if (!_read_header(reader, static_unload)) {
+		return ERR_FILE_MISSING_DEPENDENCIES;
+	}
+	reader.read_class_names(p_script);
+	return reader.failed() ? ERR_FILE_CORRUPT : OK;
+}
+
+static bool _has_static_data(const GDScript *p_class) {
+	if (p_class->get_static_initializer() != nullptr) {
+		return true;
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->get_subclasses()) {
+		if (_has_static_data(E.value.ptr())) {
+			return true;
+		}
+	}
+	return false;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const String &p_cache_path) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Vector<uint8_t> data;
+	Error err = _read_cache_file(p_cache_path, data);
+	if (err != OK) {
+		return err;
+	}
+
+	Reader reader;
+	reader.data = data.ptr();
+	reader.size = data.size() - 4;
+	reader.root = p_script;
+
+	bool static_unload = false;
+	if (!_read_header(reader, static_unload)) {
+		return ERR_FILE_MISSING_DEPENDENCIES;
+	}
+	reader.read_class_names(p_script);
+	reader.read_class(p_script);
+	if (reader.failed()) {
+		// Anything loaded so far is dropped by the compiler when it prepares the classes again.
+		print_verbose(vformat(R"(GDScript: Could not load cached bytecode for "%s": %s)", p_script->path, reader.error));
+		return ERR_FILE_CORRUPT;
+	}
+
+	p_script->_owner = nullptr;
+	GDScriptFunction::invalidate_inline_caches();
+
+	if (_has_static_data(p_script) && !static_unload) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+void GDScriptBytecodeCache::save_script(GDScript *p_script, GDScriptParser *p_parser) {
+	if (!is_enabled() || p_script->path.is_empty() || p_script->is_built_in()) {
+		return;
+	}
+	save(p_script, p_parser, get_cache_path(p_script->path));
+}
+
+Error GDScriptBytecodeCache::load_script(GDScript *p_script) {
+	if (!is_enabled() || p_script->path.is_empty() || p_script->is_built_in()) {
+		return ERR_UNAVAILABLE;
+	}
+	Error err = load(p_script, get_cache_path(p_script->path));
+	if (err == ERR_FILE_MISSING_DEPENDENCIES) {
+		print_verbose(vformat(R"(GDScript: Cached bytecode for "%s" is outdated, compiling it again.)", p_script->path));
+	}
+	return err;
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script) {
+	if (!is_enabled() || p_script->path.is_empty() || p_script->is_built_in()) {
+		return ERR_UNAVAILABLE;
+	}
+	return load_classes(p_script, get_cache_path(p_script->path));
+}
+
+void GDScriptBytecodeCache::clear() {
+	MutexLock lock(mutex);
+	if (pointer_names) {
+		memdelete(pointer_names);
+		pointer_names = nullptr;
+	}
+	source_hashes.clear();
+	environment_hash = String();
+}
@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+class GDScript;
+class GDScriptParser;
+
+// Persistent form of compiled GDScript files. When enabled, a script that was
+// compiled from source is written to the user data folder, and later runs load
+// its classes and bytecode straight from there instead of parsing, analyzing and
+// compiling it again. An entry is only used if the engine build, the bytecode
+// format, and the SHA-256 of the script source and of the sources of every script
+// it depended on during analysis are unchanged, and if its bytecode passes the
+// same bounds checks the VM does in debug builds. Otherwise the script goes
+// through the regular compiler.
+class GDScriptBytecodeCache {
+	struct PointerNames;
+	struct Reader;
+	struct Writer;
+
+	static Mutex mutex;
+	static PointerNames *pointer_names;
+	static HashMap<String, String> source_hashes;
+	static String environment_hash;
+
+	static const PointerNames &_get_pointer_names();
+
+	static String _get_script_source_hash(const GDScript *p_script);
+	static String _get_file_source_hash(const String &p_path);
+	static String _get_environment_hash();
+	static String _get_globals_hash(int p_count);
+	static bool _read_header(Reader &r_reader, bool &r_static_unload);
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 2;
+
+	static bool is_enabled();
+	static String get_cache_path(const String &p_script_path);
+
+	// Write and read an entry at an explicit location.
+	static Error save(GDScript *p_script, GDScriptParser *p_parser, const String &p_cache_path);
+	static Error load(GDScript *p_script, const String &p_cache_path);
+	static Error load_classes(GDScript *p_script, const String &p_cache_path);
+
+	// Hooks used by `GDScriptCache` and `GDScript::reload()`, no-ops unless enabled.
+	static void save_script(GDScript *p_script, GDScriptParser *p_parser);
+	static Error load_script(GDScript *p_script);
+	static Error make_scripts(GDScript *p_script);
+
+	static void clear();
+};
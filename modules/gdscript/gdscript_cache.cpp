@@ -32,10 +32,13 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -327,9 +330,12 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	// Inner classes can come from the bytecode cache, which saves parsing the script here.
+	if (GDScriptBytecodeCache::make_scripts(script.ptr()) != OK) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -434,6 +440,164 @@ Error GDScriptCache::finish_compiling(const String &p_owner) {
 	return err;
 }
 
+static String _resolve_dependency_path(const String &p_path, const String &p_base_dir) {
+	if (p_path.is_relative_path()) {
+		return p_base_dir.path_join(p_path).simplify_path();
+	}
+	return p_path.simplify_path();
+}
+
+static void _collect_type_dependencies(const GDScriptParser::TypeNode *p_type, HashSet<String> &r_paths) {
+	if (p_type == nullptr) {
+		return;
+	}
+	if (!p_type->type_chain.is_empty()) {
+		const StringName &name = p_type->type_chain[0]->name;
+		if (ScriptServer::is_global_class(name) && ScriptServer::get_global_class_language(name) == "GDScript") {
+			r_paths.insert(ScriptServer::get_global_class_path(name));
+		}
+	}
+	for (const GDScriptParser::TypeNode *container_type : p_type->container_types) {
+		_collect_type_dependencies(container_type, r_paths);
+	}
+}
+
+static void _collect_assignable_dependencies(const GDScriptParser::AssignableNode *p_assignable, const String &p_base_dir, HashSet<String> &r_paths) {
+	_collect_type_dependencies(p_assignable->datatype_specifier, r_paths);
+	// Only look for the common `const X = preload("...")` form, the analyzer finds everything else anyway.
+	if (p_assignable->initializer && p_assignable->initializer->type == GDScriptParser::Node::PRELOAD) {
+		const GDScriptParser::PreloadNode *preload = static_cast<const GDScriptParser::PreloadNode *>(p_assignable->initializer);
+		if (preload->path && preload->path->type == GDScriptParser::Node::LITERAL) {
+			const Variant &path = static_cast<const GDScriptParser::LiteralNode *>(preload->path)->value;
+			if (path.get_type() == Variant::STRING && String(path).get_extension().to_lower() == "gd") {
+				r_paths.insert(_resolve_dependency_path(path, p_base_dir));
+			}
+		}
+	}
+}
+
+// Gathers the scripts a parse tree refers to by path or by global class name, without analyzing it.
+static void _collect_dependencies(const GDScriptParser::ClassNode *p_class, const String &p_base_dir, HashSet<String> &r_paths) {
+	if (!p_class->extends_path.is_empty()) {
+		r_paths.insert(_resolve_dependency_path(p_class->extends_path, p_base_dir));
+	} else if (!p_class->extends.is_empty()) {
+		const StringName &name = p_class->extends[0]->name;
+		if (ScriptServer::is_global_class(name) && ScriptServer::get_global_class_language(name) == "GDScript") {
+			r_paths.insert(ScriptServer::get_global_class_path(name));
+		}
+	}
+
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		switch (member.type) {
+			case GDScriptParser::ClassNode::Member::CLASS:
+				_collect_dependencies(member.m_class, p_base_dir, r_paths);
+				break;
+			case GDScriptParser::ClassNode::Member::CONSTANT:
+				_collect_assignable_dependencies(member.constant, p_base_dir, r_paths);
+				break;
+			case GDScriptParser::ClassNode::Member::VARIABLE:
+				_collect_assignable_dependencies(member.variable, p_base_dir, r_paths);
+				break;
+			case GDScriptParser::ClassNode::Member::FUNCTION:
+				for (const GDScriptParser::ParameterNode *parameter : member.function->parameters) {
+					_collect_type_dependencies(parameter->datatype_specifier, r_paths);
+				}
+				_collect_type_dependencies(member.function->return_type, r_paths);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+static void _parse_dependency(void *p_userdata, uint32_t p_index) {
+	GDScriptParserRef **parser_refs = (GDScriptParserRef **)p_userdata;
+	parser_refs[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+Vector<Ref<GDScriptParserRef>> GDScriptCache::parse_dependencies(const String &p_path, GDScriptParser *p_parser) {
+	// Parsing doesn't depend on other scripts, so the dependencies of a script are parsed
+	// in parallel, wave by wave as they're discovered. Analysis and compilation stay
+	// serialized behind the cache lock: resolving a script re-enters the scripts it
+	// depends on (and cyclic references back into itself), which per-script locks
+	// would turn into lock order inversions between threads.
+	// Waiting on the workers can lift the cache lock, so the parsers of a wave stay out of
+	// the parser map until they're done, then get published (unless another thread loaded
+	// the same script in the meantime, in which case its parser wins).
+	Vector<Ref<GDScriptParserRef>> parsed;
+	if (singleton == nullptr || p_parser->get_tree() == nullptr) {
+		return parsed;
+	}
+
+	MutexLock lock(singleton->mutex);
+
+	if (singleton->cleared) {
+		return parsed;
+	}
+
+	// Built lazily on first use, so do it before other threads parse.
+	GDScriptParser::get_builtin_type(StringName());
+
+	HashSet<String> visited;
+	visited.insert(p_path);
+	HashSet<String> pending;
+	_collect_dependencies(p_parser->get_tree(), p_path.get_base_dir(), pending);
+
+	LocalVector<Ref<GDScriptParserRef>> wave_refs;
+	LocalVector<GDScriptParserRef *> wave;
+	while (!pending.is_empty()) {
+		wave_refs.clear();
+		wave.clear();
+		for (const String &path : pending) {
+			if (visited.has(path)) {
+				continue;
+			}
+			visited.insert(path);
+
+			// Parsers already known to the cache are raised on demand, as usual.
+			if (singleton->parser_map.has(path) || !FileAccess::exists(ResourceLoader::path_remap(path))) {
+				continue;
+			}
+
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->path = path;
+			// Not in the parser map yet, so it mustn't erase the entry on destruction.
+			ref->abandoned = true;
+			wave_refs.push_back(ref);
+			wave.push_back(ref.ptr());
+		}
+		pending.clear();
+
+		if (wave.size() > 1 && WorkerThreadPool::get_singleton()) {
+			WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(_parse_dependency, wave.ptr(), wave.size(), -1, true, SNAME("GDScriptParseDependencies"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+		} else {
+			for (uint32_t i = 0; i < wave.size(); i++) {
+				_parse_dependency(wave.ptr(), i);
+			}
+		}
+
+		if (singleton->cleared) {
+			break;
+		}
+
+		for (Ref<GDScriptParserRef> &ref : wave_refs) {
+			if (singleton->parser_map.has(ref->path)) {
+				continue;
+			}
+			ref->abandoned = false;
+			singleton->parser_map[ref->path] = ref.ptr();
+			parsed.push_back(ref);
+			if (ref->result == OK) {
+				_collect_dependencies(ref->parser->get_tree(), ref->path.get_base_dir(), pending);
+			}
+		}
+	}
+
+	return parsed;
+}
+
 void GDScriptCache::add_static_script(Ref<GDScript> p_script) {
 	ERR_FAIL_COND_MSG(p_script.is_null(), "Trying to cache empty script as static.");
 	ERR_FAIL_COND_MSG(!p_script->is_valid(), "Trying to cache non-compiled script as static.");
@@ -33,6 +33,7 @@
 #include "gdscript.h"
 #include "gdscript_byte_codegen.h"
 #include "gdscript_cache.h"
+#include "gdscript_native_codegen.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/config/engine.h"
@@ -2292,7 +2293,11 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_script, const GDScriptParser::ClassNode *p_class, const GDScriptParser::FunctionNode *p_func, bool p_for_ready, bool p_for_lambda) {
 	r_error = OK;
 	CodeGen codegen;
-	codegen.generator = memnew(GDScriptByteCodeGenerator);
+	if (native_code && p_func && !p_for_lambda && !p_func->is_abstract && !p_func->is_vararg()) {
+		codegen.generator = memnew(GDScriptNativeCodeGenerator(memnew(GDScriptByteCodeGenerator), native_code));
+	} else {
+		codegen.generator = memnew(GDScriptByteCodeGenerator);
+	}
 
 	codegen.class_node = p_class;
 	codegen.script = p_script;
@@ -2762,6 +2767,9 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	p_script->clearing = false;
 
+	// Members and functions were dropped, calls can't be resolved through the old ones anymore.
+	GDScriptFunction::invalidate_inline_caches();
+
 	p_script->tool = parser->is_tool();
 	p_script->_is_abstract = p_class->is_abstract;
 
@@ -3123,6 +3131,7 @@ Error GDScriptCompiler::_compile_class(GDScript *p_script, const GDScriptParser:
 	p_script->_static_default_init();
 
 	p_script->valid = true;
+	GDScriptFunction::invalidate_inline_caches();
 	return OK;
 }
 
@@ -3340,6 +3349,10 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	_get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, &new_lambda_info);
 	main_script->_recurse_replace_function_ptrs(func_ptr_replacements);
 
+	if (native_code) {
+		return OK;
+	}
+
 	if (has_static_data && !root->annotated_static_unload) {
 		GDScriptCache::add_static_script(p_script);
 	}
@@ -37,6 +37,8 @@
 
 #include "core/templates/hash_set.h"
 
+class GDScriptNativeCode;
+
 class GDScriptCompiler {
 	const GDScriptParser *parser = nullptr;
 	HashSet<GDScript *> parsed_classes;
@@ -173,12 +175,16 @@ class GDScriptCompiler {
 	String error;
 	GDScriptParser::ExpressionNode *awaited_node = nullptr;
 	bool has_static_data = false;
+	GDScriptNativeCode *native_code = nullptr;
 
 public:
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
 	static void make_scripts(GDScript *p_script, const GDScriptParser::ClassNode *p_class, bool p_keep_state);
 	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false);
 
+	// Also lower the functions to C++. The compiled script is then only a by-product and isn't cached.
+	void set_native_code(GDScriptNativeCode *p_native_code) { native_code = p_native_code; }
+
 	String get_error() const;
 	int get_error_line() const;
 	int get_error_column() const;
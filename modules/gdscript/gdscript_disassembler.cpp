@@ -97,24 +97,21 @@ static String _disassemble_address(const GDScript *p_script, const GDScriptFunct
 	return "<err>";
 }
 
-void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
-#define DADDR(m_ip) (_disassemble_address(_script, *this, _code_ptr[ip + m_ip]))
+void GDScriptFunction::_disassemble_code(const int *p_code, int p_code_size, const Vector<String> &p_code_lines, Vector<int> &r_addresses, Vector<String> &r_text) const {
+#define DADDR(m_ip) (_disassemble_address(_script, *this, p_code[ip + m_ip]))
 
-	for (int ip = 0; ip < _code_size;) {
+	for (int ip = 0; ip < p_code_size;) {
+		const int address = ip;
 		StringBuilder text;
 		int incr = 0;
 
-		text += " ";
-		text += itos(ip);
-		text += ": ";
-
 		// This makes the compiler complain if some opcode is unchecked in the switch.
-		Opcode opcode = Opcode(_code_ptr[ip]);
+		Opcode opcode = Opcode(p_code[ip]);
 
 		switch (opcode) {
 			case OPCODE_OPERATOR: {
-				constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*_code_ptr);
-				int operation = _code_ptr[ip + 4];
+				constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*p_code);
+				int operation = p_code[ip + 4];
 
 				text += "operator ";
 
@@ -135,19 +132,61 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " = ";
 				text += DADDR(1);
 				text += " ";
-				text += operator_names[_code_ptr[ip + 4]];
+				text += operator_names[p_code[ip + 4]];
 				text += " ";
 				text += DADDR(2);
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_TYPED_OPERATOR(m_name, m_op) \
+	case OPCODE_##m_name: {                      \
+		text += "typed operator ";               \
+		text += DADDR(3);                        \
+		text += " = ";                           \
+		text += DADDR(1);                        \
+		text += " " m_op " ";                    \
+		text += DADDR(2);                        \
+		text += " (";                            \
+		text += #m_name;                         \
+		text += ")";                             \
+		incr += 4;                               \
+	} break
+
+				DISASSEMBLE_TYPED_OPERATOR(ADD_INT, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_INT, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_INT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(EQUAL_INT, "==");
+				DISASSEMBLE_TYPED_OPERATOR(NOT_EQUAL_INT, "!=");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_INT, "<");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_EQUAL_INT, "<=");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_INT, ">");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_EQUAL_INT, ">=");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_FLOAT, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_FLOAT, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_FLOAT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(DIVIDE_FLOAT, "/");
+				DISASSEMBLE_TYPED_OPERATOR(EQUAL_FLOAT, "==");
+				DISASSEMBLE_TYPED_OPERATOR(NOT_EQUAL_FLOAT, "!=");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_FLOAT, "<");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_EQUAL_FLOAT, "<=");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_FLOAT, ">");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_EQUAL_FLOAT, ">=");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_VECTOR2, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_VECTOR2, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR2, "*");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR2_FLOAT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_VECTOR3, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_VECTOR3, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR3, "*");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR3_FLOAT, "*");
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
 				text += " = ";
 				text += DADDR(2);
 				text += " is ";
-				text += Variant::get_type_name(Variant::Type(_code_ptr[ip + 3]));
+				text += Variant::get_type_name(Variant::Type(p_code[ip + 3]));
 
 				incr += 4;
 			} break;
@@ -158,9 +197,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += DADDR(2);
 				text += " is Array[";
 
-				Ref<Script> script_type = get_constant(_code_ptr[ip + 3] & ADDR_MASK);
-				Variant::Type builtin_type = (Variant::Type)_code_ptr[ip + 4];
-				StringName native_type = get_global_name(_code_ptr[ip + 5]);
+				Ref<Script> script_type = get_constant(p_code[ip + 3] & ADDR_MASK);
+				Variant::Type builtin_type = (Variant::Type)p_code[ip + 4];
+				StringName native_type = get_global_name(p_code[ip + 5]);
 
 				if (script_type.is_valid() && script_type->is_valid()) {
 					text += "script(";
@@ -183,9 +222,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += DADDR(2);
 				text += " is Dictionary[";
 
-				Ref<Script> key_script_type = get_constant(_code_ptr[ip + 3] & ADDR_MASK);
-				Variant::Type key_builtin_type = (Variant::Type)_code_ptr[ip + 5];
-				StringName key_native_type = get_global_name(_code_ptr[ip + 6]);
+				Ref<Script> key_script_type = get_constant(p_code[ip + 3] & ADDR_MASK);
+				Variant::Type key_builtin_type = (Variant::Type)p_code[ip + 5];
+				StringName key_native_type = get_global_name(p_code[ip + 6]);
 
 				if (key_script_type.is_valid() && key_script_type->is_valid()) {
 					text += "script(";
@@ -199,9 +238,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				text += ", ";
 
-				Ref<Script> value_script_type = get_constant(_code_ptr[ip + 4] & ADDR_MASK);
-				Variant::Type value_builtin_type = (Variant::Type)_code_ptr[ip + 7];
-				StringName value_native_type = get_global_name(_code_ptr[ip + 8]);
+				Ref<Script> value_script_type = get_constant(p_code[ip + 4] & ADDR_MASK);
+				Variant::Type value_builtin_type = (Variant::Type)p_code[ip + 7];
+				StringName value_native_type = get_global_name(p_code[ip + 8]);
 
 				if (value_script_type.is_valid() && value_script_type->is_valid()) {
 					text += "script(";
@@ -223,7 +262,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " = ";
 				text += DADDR(2);
 				text += " is ";
-				text += get_global_name(_code_ptr[ip + 3]);
+				text += get_global_name(p_code[ip + 3]);
 
 				incr += 4;
 			} break;
@@ -304,17 +343,17 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "set_named ";
 				text += DADDR(1);
 				text += "[\"";
-				text += _global_names_ptr[_code_ptr[ip + 3]];
+				text += _global_names_ptr[p_code[ip + 3]];
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
 				text += DADDR(1);
 				text += "[\"";
-				text += setter_names[_code_ptr[ip + 3]];
+				text += setter_names[p_code[ip + 3]];
 				text += "\"] = ";
 				text += DADDR(2);
 
@@ -326,10 +365,10 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " = ";
 				text += DADDR(1);
 				text += "[\"";
-				text += _global_names_ptr[_code_ptr[ip + 3]];
+				text += _global_names_ptr[p_code[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -337,7 +376,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " = ";
 				text += DADDR(1);
 				text += "[\"";
-				text += getter_names[_code_ptr[ip + 3]];
+				text += getter_names[p_code[ip + 3]];
 				text += "\"]";
 
 				incr += 4;
@@ -345,7 +384,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			case OPCODE_SET_MEMBER: {
 				text += "set_member ";
 				text += "[\"";
-				text += _global_names_ptr[_code_ptr[ip + 2]];
+				text += _global_names_ptr[p_code[ip + 2]];
 				text += "\"] = ";
 				text += DADDR(1);
 
@@ -356,26 +395,26 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += DADDR(1);
 				text += " = ";
 				text += "[\"";
-				text += _global_names_ptr[_code_ptr[ip + 2]];
+				text += _global_names_ptr[p_code[ip + 2]];
 				text += "\"]";
 
 				incr += 3;
 			} break;
 			case OPCODE_SET_STATIC_VARIABLE: {
 				Ref<GDScript> gdscript;
-				if (_code_ptr[ip + 2] == ADDR_CLASS) {
+				if (p_code[ip + 2] == ADDR_CLASS) {
 					gdscript = Ref<GDScript>(_script);
 				} else {
-					gdscript = get_constant(_code_ptr[ip + 2] & ADDR_MASK);
+					gdscript = get_constant(p_code[ip + 2] & ADDR_MASK);
 				}
 
 				text += "set_static_variable script(";
 				text += GDScript::debug_get_script_name(gdscript);
 				text += ")";
 				if (gdscript.is_valid()) {
-					text += "[\"" + gdscript->debug_get_static_var_by_index(_code_ptr[ip + 3]) + "\"]";
+					text += "[\"" + gdscript->debug_get_static_var_by_index(p_code[ip + 3]) + "\"]";
 				} else {
-					text += "[<index " + itos(_code_ptr[ip + 3]) + ">]";
+					text += "[<index " + itos(p_code[ip + 3]) + ">]";
 				}
 				text += " = ";
 				text += DADDR(1);
@@ -384,10 +423,10 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 			case OPCODE_GET_STATIC_VARIABLE: {
 				Ref<GDScript> gdscript;
-				if (_code_ptr[ip + 2] == ADDR_CLASS) {
+				if (p_code[ip + 2] == ADDR_CLASS) {
 					gdscript = Ref<GDScript>(_script);
 				} else {
-					gdscript = get_constant(_code_ptr[ip + 2] & ADDR_MASK);
+					gdscript = get_constant(p_code[ip + 2] & ADDR_MASK);
 				}
 
 				text += "get_static_variable ";
@@ -396,9 +435,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += GDScript::debug_get_script_name(gdscript);
 				text += ")";
 				if (gdscript.is_valid()) {
-					text += "[\"" + gdscript->debug_get_static_var_by_index(_code_ptr[ip + 3]) + "\"]";
+					text += "[\"" + gdscript->debug_get_static_var_by_index(p_code[ip + 3]) + "\"]";
 				} else {
-					text += "[<index " + itos(_code_ptr[ip + 3]) + ">]";
+					text += "[<index " + itos(p_code[ip + 3]) + ">]";
 				}
 
 				incr += 4;
@@ -434,7 +473,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 			case OPCODE_ASSIGN_TYPED_BUILTIN: {
 				text += "assign typed builtin (";
-				text += Variant::get_type_name((Variant::Type)_code_ptr[ip + 3]);
+				text += Variant::get_type_name((Variant::Type)p_code[ip + 3]);
 				text += ") ";
 				text += DADDR(1);
 				text += " = ";
@@ -469,7 +508,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr += 4;
 			} break;
 			case OPCODE_ASSIGN_TYPED_SCRIPT: {
-				Ref<Script> script = get_constant(_code_ptr[ip + 3] & ADDR_MASK);
+				Ref<Script> script = get_constant(p_code[ip + 3] & ADDR_MASK);
 
 				text += "assign typed script (";
 				text += GDScript::debug_get_script_name(script);
@@ -486,7 +525,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " = ";
 				text += DADDR(1);
 				text += " as ";
-				text += Variant::get_type_name(Variant::Type(_code_ptr[ip + 1]));
+				text += Variant::get_type_name(Variant::Type(p_code[ip + 1]));
 
 				incr += 4;
 			} break;
@@ -511,9 +550,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr += 4;
 			} break;
 			case OPCODE_CONSTRUCT: {
-				int instr_var_args = _code_ptr[++ip];
-				Variant::Type t = Variant::Type(_code_ptr[ip + 3 + instr_var_args]);
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				Variant::Type t = Variant::Type(p_code[ip + 3 + instr_var_args]);
+				int argc = p_code[ip + 1 + instr_var_args];
 
 				text += "construct ";
 				text += DADDR(1 + argc);
@@ -531,14 +570,14 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 3 + instr_var_args;
 			} break;
 			case OPCODE_CONSTRUCT_VALIDATED: {
-				int instr_var_args = _code_ptr[++ip];
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				int argc = p_code[ip + 1 + instr_var_args];
 
 				text += "construct validated ";
 				text += DADDR(1 + argc);
 				text += " = ";
 
-				text += constructors_names[_code_ptr[ip + 3 + argc]];
+				text += constructors_names[p_code[ip + 3 + argc]];
 				text += "(";
 				for (int i = 0; i < argc; i++) {
 					if (i > 0) {
@@ -551,8 +590,8 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 3 + instr_var_args;
 			} break;
 			case OPCODE_CONSTRUCT_ARRAY: {
-				int instr_var_args = _code_ptr[++ip];
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				int argc = p_code[ip + 1 + instr_var_args];
 				text += "make_array ";
 				text += DADDR(1 + argc);
 				text += " = [";
@@ -569,12 +608,12 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr += 3 + argc;
 			} break;
 			case OPCODE_CONSTRUCT_TYPED_ARRAY: {
-				int instr_var_args = _code_ptr[++ip];
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				int argc = p_code[ip + 1 + instr_var_args];
 
-				Ref<Script> script_type = get_constant(_code_ptr[ip + argc + 2] & ADDR_MASK);
-				Variant::Type builtin_type = (Variant::Type)_code_ptr[ip + argc + 4];
-				StringName native_type = get_global_name(_code_ptr[ip + argc + 5]);
+				Ref<Script> script_type = get_constant(p_code[ip + argc + 2] & ADDR_MASK);
+				Variant::Type builtin_type = (Variant::Type)p_code[ip + argc + 4];
+				StringName native_type = get_global_name(p_code[ip + argc + 5]);
 
 				String type_name;
 				if (script_type.is_valid() && script_type->is_valid()) {
@@ -604,8 +643,8 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr += 6 + argc;
 			} break;
 			case OPCODE_CONSTRUCT_DICTIONARY: {
-				int instr_var_args = _code_ptr[++ip];
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				int argc = p_code[ip + 1 + instr_var_args];
 				text += "make_dict ";
 				text += DADDR(1 + argc * 2);
 				text += " = {";
@@ -624,12 +663,12 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr += 3 + argc * 2;
 			} break;
 			case OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
-				int instr_var_args = _code_ptr[++ip];
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				int argc = p_code[ip + 1 + instr_var_args];
 
-				Ref<Script> key_script_type = get_constant(_code_ptr[ip + argc * 2 + 2] & ADDR_MASK);
-				Variant::Type key_builtin_type = (Variant::Type)_code_ptr[ip + argc * 2 + 5];
-				StringName key_native_type = get_global_name(_code_ptr[ip + argc * 2 + 6]);
+				Ref<Script> key_script_type = get_constant(p_code[ip + argc * 2 + 2] & ADDR_MASK);
+				Variant::Type key_builtin_type = (Variant::Type)p_code[ip + argc * 2 + 5];
+				StringName key_native_type = get_global_name(p_code[ip + argc * 2 + 6]);
 
 				String key_type_name;
 				if (key_script_type.is_valid() && key_script_type->is_valid()) {
@@ -640,9 +679,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 					key_type_name = Variant::get_type_name(key_builtin_type);
 				}
 
-				Ref<Script> value_script_type = get_constant(_code_ptr[ip + argc * 2 + 3] & ADDR_MASK);
-				Variant::Type value_builtin_type = (Variant::Type)_code_ptr[ip + argc * 2 + 7];
-				StringName value_native_type = get_global_name(_code_ptr[ip + argc * 2 + 8]);
+				Ref<Script> value_script_type = get_constant(p_code[ip + argc * 2 + 3] & ADDR_MASK);
+				Variant::Type value_builtin_type = (Variant::Type)p_code[ip + argc * 2 + 7];
+				StringName value_native_type = get_global_name(p_code[ip + argc * 2 + 8]);
 
 				String value_type_name;
 				if (value_script_type.is_valid() && value_script_type->is_valid()) {
@@ -678,10 +717,10 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			case OPCODE_CALL:
 			case OPCODE_CALL_RETURN:
 			case OPCODE_CALL_ASYNC: {
-				bool ret = (_code_ptr[ip]) == OPCODE_CALL_RETURN;
-				bool async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
+				bool ret = (p_code[ip]) == OPCODE_CALL_RETURN;
+				bool async = (p_code[ip]) == OPCODE_CALL_ASYNC;
 
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 
 				if (ret) {
 					text += "call-ret ";
@@ -691,13 +730,13 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 					text += "call ";
 				}
 
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 1 + instr_var_args];
 				if (ret || async) {
 					text += DADDR(2 + argc) + " = ";
 				}
 
 				text += DADDR(1 + argc) + ".";
-				text += String(_global_names_ptr[_code_ptr[ip + 2 + instr_var_args]]);
+				text += String(_global_names_ptr[p_code[ip + 2 + instr_var_args]]);
 				text += "(";
 
 				for (int i = 0; i < argc; i++) {
@@ -708,12 +747,12 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
-				bool ret = (_code_ptr[ip]) == OPCODE_CALL_METHOD_BIND_RET;
-				int instr_var_args = _code_ptr[++ip];
+				bool ret = (p_code[ip]) == OPCODE_CALL_METHOD_BIND_RET;
+				int instr_var_args = p_code[++ip];
 
 				if (ret) {
 					text += "call-method_bind-ret ";
@@ -721,9 +760,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 					text += "call-method_bind ";
 				}
 
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 2 + instr_var_args]];
+				MethodBind *method = _methods_ptr[p_code[ip + 2 + instr_var_args]];
 
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 1 + instr_var_args];
 				if (ret) {
 					text += DADDR(2 + argc) + " = ";
 				}
@@ -743,16 +782,16 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 5 + argc;
 			} break;
 			case OPCODE_CALL_BUILTIN_STATIC: {
-				int instr_var_args = _code_ptr[++ip];
-				Variant::Type type = (Variant::Type)_code_ptr[ip + 1 + instr_var_args];
-				int argc = _code_ptr[ip + 3 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				Variant::Type type = (Variant::Type)p_code[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 3 + instr_var_args];
 
 				text += "call built-in method static ";
 				text += DADDR(1 + argc);
 				text += " = ";
 				text += Variant::get_type_name(type);
 				text += ".";
-				text += _global_names_ptr[_code_ptr[ip + 2 + instr_var_args]].operator String();
+				text += _global_names_ptr[p_code[ip + 2 + instr_var_args]].operator String();
 				text += "(";
 
 				for (int i = 0; i < argc; i++) {
@@ -766,9 +805,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr += 5 + argc;
 			} break;
 			case OPCODE_CALL_NATIVE_STATIC: {
-				int instr_var_args = _code_ptr[++ip];
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 1 + instr_var_args]];
-				int argc = _code_ptr[ip + 2 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				MethodBind *method = _methods_ptr[p_code[ip + 1 + instr_var_args]];
+				int argc = p_code[ip + 2 + instr_var_args];
 
 				text += "call native method static ";
 				text += DADDR(1 + argc);
@@ -790,10 +829,10 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 
 			case OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN: {
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 				text += "call native static method validated (return) ";
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 2 + instr_var_args]];
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				MethodBind *method = _methods_ptr[p_code[ip + 2 + instr_var_args]];
+				int argc = p_code[ip + 1 + instr_var_args];
 				text += DADDR(1 + argc) + " = ";
 				text += method->get_instance_class();
 				text += ".";
@@ -810,13 +849,13 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 
 			case OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 
 				text += "call native static method validated (no return) ";
 
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 2 + instr_var_args]];
+				MethodBind *method = _methods_ptr[p_code[ip + 2 + instr_var_args]];
 
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 1 + instr_var_args];
 
 				text += method->get_instance_class();
 				text += ".";
@@ -835,10 +874,10 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 
 			case OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN: {
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 				text += "call method-bind validated (return) ";
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 2 + instr_var_args]];
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				MethodBind *method = _methods_ptr[p_code[ip + 2 + instr_var_args]];
+				int argc = p_code[ip + 1 + instr_var_args];
 				text += DADDR(2 + argc) + " = ";
 				text += DADDR(1 + argc) + ".";
 				text += method->get_name();
@@ -854,13 +893,13 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 
 			case OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 
 				text += "call method-bind validated (no return) ";
 
-				MethodBind *method = _methods_ptr[_code_ptr[ip + 2 + instr_var_args]];
+				MethodBind *method = _methods_ptr[p_code[ip + 2 + instr_var_args]];
 
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 1 + instr_var_args];
 
 				text += DADDR(1 + argc) + ".";
 				text += method->get_name();
@@ -878,15 +917,15 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 
 			case OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
-				int instr_var_args = _code_ptr[++ip];
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int instr_var_args = p_code[++ip];
+				int argc = p_code[ip + 1 + instr_var_args];
 
 				text += "call-builtin-method validated ";
 
 				text += DADDR(2 + argc) + " = ";
 
 				text += DADDR(1) + ".";
-				text += builtin_methods_names[_code_ptr[ip + 4 + argc]];
+				text += builtin_methods_names[p_code[ip + 4 + argc]];
 
 				text += "(";
 
@@ -901,14 +940,14 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 5 + argc;
 			} break;
 			case OPCODE_CALL_UTILITY: {
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 
 				text += "call-utility ";
 
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 1 + instr_var_args];
 				text += DADDR(1 + argc) + " = ";
 
-				text += _global_names_ptr[_code_ptr[ip + 2 + instr_var_args]];
+				text += _global_names_ptr[p_code[ip + 2 + instr_var_args]];
 				text += "(";
 
 				for (int i = 0; i < argc; i++) {
@@ -922,14 +961,14 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 4 + argc;
 			} break;
 			case OPCODE_CALL_UTILITY_VALIDATED: {
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 
 				text += "call-utility validated ";
 
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 1 + instr_var_args];
 				text += DADDR(1 + argc) + " = ";
 
-				text += utilities_names[_code_ptr[ip + 3 + argc]];
+				text += utilities_names[p_code[ip + 3 + argc]];
 				text += "(";
 
 				for (int i = 0; i < argc; i++) {
@@ -943,14 +982,14 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 4 + argc;
 			} break;
 			case OPCODE_CALL_GDSCRIPT_UTILITY: {
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 
 				text += "call-gdscript-utility ";
 
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 1 + instr_var_args];
 				text += DADDR(1 + argc) + " = ";
 
-				text += gds_utilities_names[_code_ptr[ip + 3 + argc]];
+				text += gds_utilities_names[p_code[ip + 3 + argc]];
 				text += "(";
 
 				for (int i = 0; i < argc; i++) {
@@ -964,14 +1003,14 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 4 + argc;
 			} break;
 			case OPCODE_CALL_SELF_BASE: {
-				int instr_var_args = _code_ptr[++ip];
+				int instr_var_args = p_code[++ip];
 
 				text += "call-self-base ";
 
-				int argc = _code_ptr[ip + 1 + instr_var_args];
+				int argc = p_code[ip + 1 + instr_var_args];
 				text += DADDR(2 + argc) + " = ";
 
-				text += _global_names_ptr[_code_ptr[ip + 2 + instr_var_args]];
+				text += _global_names_ptr[p_code[ip + 2 + instr_var_args]];
 				text += "(";
 
 				for (int i = 0; i < argc; i++) {
@@ -997,9 +1036,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 2;
 			} break;
 			case OPCODE_CREATE_LAMBDA: {
-				int instr_var_args = _code_ptr[++ip];
-				int captures_count = _code_ptr[ip + 1 + instr_var_args];
-				GDScriptFunction *lambda = _lambdas_ptr[_code_ptr[ip + 2 + instr_var_args]];
+				int instr_var_args = p_code[++ip];
+				int captures_count = p_code[ip + 1 + instr_var_args];
+				GDScriptFunction *lambda = _lambdas_ptr[p_code[ip + 2 + instr_var_args]];
 
 				text += DADDR(1 + captures_count);
 				text += "create lambda from ";
@@ -1017,9 +1056,9 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr = 4 + captures_count;
 			} break;
 			case OPCODE_CREATE_SELF_LAMBDA: {
-				int instr_var_args = _code_ptr[++ip];
-				int captures_count = _code_ptr[ip + 1 + instr_var_args];
-				GDScriptFunction *lambda = _lambdas_ptr[_code_ptr[ip + 2 + instr_var_args]];
+				int instr_var_args = p_code[++ip];
+				int captures_count = p_code[ip + 1 + instr_var_args];
+				GDScriptFunction *lambda = _lambdas_ptr[p_code[ip + 2 + instr_var_args]];
 
 				text += DADDR(1 + captures_count);
 				text += "create self lambda from ";
@@ -1038,7 +1077,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 			case OPCODE_JUMP: {
 				text += "jump ";
-				text += itos(_code_ptr[ip + 1]);
+				text += itos(p_code[ip + 1]);
 
 				incr = 2;
 			} break;
@@ -1046,7 +1085,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "jump-if ";
 				text += DADDR(1);
 				text += " to ";
-				text += itos(_code_ptr[ip + 2]);
+				text += itos(p_code[ip + 2]);
 
 				incr = 3;
 			} break;
@@ -1054,10 +1093,36 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "jump-if-not ";
 				text += DADDR(1);
 				text += " to ";
-				text += itos(_code_ptr[ip + 2]);
+				text += itos(p_code[ip + 2]);
 
 				incr = 3;
 			} break;
+
+#define DISASSEMBLE_JUMP_UNLESS(m_name, m_op) \
+	case OPCODE_JUMP_UNLESS_##m_name: {       \
+		text += "jump-unless ";               \
+		text += DADDR(1);                     \
+		text += " " m_op " ";                 \
+		text += DADDR(2);                     \
+		text += " (";                         \
+		text += #m_name;                      \
+		text += ") to ";                      \
+		text += itos(p_code[ip + 3]);      \
+		incr = 4;                             \
+	} break
+
+				DISASSEMBLE_JUMP_UNLESS(EQUAL_INT, "==");
+				DISASSEMBLE_JUMP_UNLESS(NOT_EQUAL_INT, "!=");
+				DISASSEMBLE_JUMP_UNLESS(LESS_INT, "<");
+				DISASSEMBLE_JUMP_UNLESS(LESS_EQUAL_INT, "<=");
+				DISASSEMBLE_JUMP_UNLESS(GREATER_INT, ">");
+				DISASSEMBLE_JUMP_UNLESS(GREATER_EQUAL_INT, ">=");
+				DISASSEMBLE_JUMP_UNLESS(EQUAL_FLOAT, "==");
+				DISASSEMBLE_JUMP_UNLESS(NOT_EQUAL_FLOAT, "!=");
+				DISASSEMBLE_JUMP_UNLESS(LESS_FLOAT, "<");
+				DISASSEMBLE_JUMP_UNLESS(LESS_EQUAL_FLOAT, "<=");
+				DISASSEMBLE_JUMP_UNLESS(GREATER_FLOAT, ">");
+				DISASSEMBLE_JUMP_UNLESS(GREATER_EQUAL_FLOAT, ">=");
 			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
 				text += "jump-to-default-argument ";
 
@@ -1067,7 +1132,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "jump-if-shared ";
 				text += DADDR(1);
 				text += " to ";
-				text += itos(_code_ptr[ip + 2]);
+				text += itos(p_code[ip + 2]);
 
 				incr = 3;
 			} break;
@@ -1079,7 +1144,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			} break;
 			case OPCODE_RETURN_TYPED_BUILTIN: {
 				text += "return typed builtin (";
-				text += Variant::get_type_name((Variant::Type)_code_ptr[ip + 2]);
+				text += Variant::get_type_name((Variant::Type)p_code[ip + 2]);
 				text += ") ";
 				text += DADDR(1);
 
@@ -1106,7 +1171,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				incr += 3;
 			} break;
 			case OPCODE_RETURN_TYPED_SCRIPT: {
-				Ref<Script> script = get_constant(_code_ptr[ip + 2] & ADDR_MASK);
+				Ref<Script> script = get_constant(p_code[ip + 2] & ADDR_MASK);
 
 				text += "return typed script (";
 				text += GDScript::debug_get_script_name(script);
@@ -1127,7 +1192,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 		text += " counter ";             \
 		text += DADDR(1);                \
 		text += " end ";                 \
-		text += itos(_code_ptr[ip + 4]); \
+		text += itos(p_code[ip + 4]); \
 		incr += 5;                       \
 	} break
 
@@ -1142,7 +1207,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 		text += " counter ";              \
 		text += DADDR(1);                 \
 		text += " end ";                  \
-		text += itos(_code_ptr[ip + 4]);  \
+		text += itos(p_code[ip + 4]);  \
 		incr += 5;                        \
 	} break
 
@@ -1176,7 +1241,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " counter ";
 				text += DADDR(1);
 				text += " end ";
-				text += itos(_code_ptr[ip + 4]);
+				text += itos(p_code[ip + 4]);
 
 				incr += 5;
 			} break;
@@ -1193,7 +1258,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " counter ";
 				text += DADDR(1);
 				text += " end ";
-				text += itos(_code_ptr[ip + 6]);
+				text += itos(p_code[ip + 6]);
 
 				incr += 7;
 			} break;
@@ -1205,7 +1270,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " counter ";
 				text += DADDR(1);
 				text += " end ";
-				text += itos(_code_ptr[ip + 4]);
+				text += itos(p_code[ip + 4]);
 
 				incr += 5;
 			} break;
@@ -1220,7 +1285,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += " counter ";
 				text += DADDR(1);
 				text += " end ";
-				text += itos(_code_ptr[ip + 5]);
+				text += itos(p_code[ip + 5]);
 
 				incr += 6;
 			} break;
@@ -1228,7 +1293,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "store global ";
 				text += DADDR(1);
 				text += " = ";
-				text += String::num_int64(_code_ptr[ip + 2]);
+				text += String::num_int64(p_code[ip + 2]);
 
 				incr += 3;
 			} break;
@@ -1236,12 +1301,12 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "store named global ";
 				text += DADDR(1);
 				text += " = ";
-				text += String(_global_names_ptr[_code_ptr[ip + 2]]);
+				text += String(_global_names_ptr[p_code[ip + 2]]);
 
 				incr += 3;
 			} break;
 			case OPCODE_LINE: {
-				int line = _code_ptr[ip + 1] - 1;
+				int line = p_code[ip + 1] - 1;
 				if (line >= 0 && line < p_code_lines.size()) {
 					text += "line ";
 					text += itos(line + 1);
@@ -1325,9 +1390,70 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 		ip += incr;
 		if (text.get_string_length() > 0) {
-			print_line(text.as_string());
+			r_addresses.push_back(address);
+			r_text.push_back(text.as_string());
 		}
 	}
 }
 
+void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
+	Vector<int> addresses;
+	Vector<String> text;
+	_disassemble_code(_code_ptr, _code_size, p_code_lines, addresses, text);
+
+	for (int i = 0; i < text.size(); i++) {
+		print_line(" " + itos(addresses[i]) + ": " + text[i]);
+	}
+}
+
+void GDScriptFunction::disassemble_diff(const Vector<String> &p_code_lines) const {
+	if (unoptimized_code.is_empty()) {
+		// Nothing was kept to compare with.
+		disassemble(p_code_lines);
+		return;
+	}
+
+	Vector<int> old_addresses;
+	Vector<String> old_text;
+	_disassemble_code(unoptimized_code.ptr(), unoptimized_code.size(), p_code_lines, old_addresses, old_text);
+
+	Vector<int> new_addresses;
+	Vector<String> new_text;
+	_disassemble_code(_code_ptr, _code_size, p_code_lines, new_addresses, new_text);
+
+	// Longest common subsequence of the instructions, compared without their addresses.
+	const int old_count = old_text.size();
+	const int new_count = new_text.size();
+	Vector<int> common;
+	common.resize_initialized((old_count + 1) * (new_count + 1));
+	int *table = common.ptrw();
+	for (int i = old_count - 1; i >= 0; i--) {
+		for (int j = new_count - 1; j >= 0; j--) {
+			if (old_text[i] == new_text[j]) {
+				table[i * (new_count + 1) + j] = table[(i + 1) * (new_count + 1) + j + 1] + 1;
+			} else {
+				table[i * (new_count + 1) + j] = MAX(table[(i + 1) * (new_count + 1) + j], table[i * (new_count + 1) + j + 1]);
+			}
+		}
+	}
+
+	int i = 0;
+	int j = 0;
+	while (i < old_count || j < new_count) {
+		if (i < old_count && j < new_count && old_text[i] == new_text[j]) {
+			print_line(" " + itos(new_addresses[j]) + ": " + new_text[j]);
+			i++;
+			j++;
+		} else if (j < new_count && (i == old_count || table[i * (new_count + 1) + j + 1] >= table[(i + 1) * (new_count + 1) + j])) {
+			print_line("+" + itos(new_addresses[j]) + ": " + new_text[j]);
+			j++;
+		} else {
+			print_line("-" + itos(old_addresses[i]) + ": " + old_text[i]);
+			i++;
+		}
+	}
+
+	print_line(vformat("Code size: %d -> %d", unoptimized_code.size(), _code_size));
+}
+
 #endif // DEBUG_ENABLED
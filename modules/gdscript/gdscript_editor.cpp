@@ -339,6 +339,10 @@ void GDScriptLanguage::debug_get_stack_level_locals(int p_level, List<String> *p
 
 	CallLevel *cl = _get_stack_level(p_level);
 	GDScriptFunction *f = cl->function;
+	if (cl->stack == nullptr) {
+		// Functions lowered to C++ keep their locals in native variables.
+		return;
+	}
 
 	List<Pair<StringName, int>> locals;
 
@@ -32,6 +32,9 @@
 
 #include "gdscript.h"
 
+#include "core/object/class_db.h"
+#include "scene/scene_string_names.h"
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -42,6 +45,367 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+SafeNumeric<uint32_t> GDScriptFunction::cache_epoch(1);
+
+void GDScriptFunction::invalidate_inline_caches() {
+	// Zero marks unused cache entries, so it's never a valid epoch.
+	if (unlikely(cache_epoch.increment() == 0)) {
+		cache_epoch.increment();
+	}
+}
+
+bool GDScriptFunction::InlineCache::lookup(const GDScript *p_script, const void *p_class_name, uint32_t p_epoch, Target &r_target) const {
+	const uint32_t seq = sequence.load(std::memory_order_acquire);
+	if (unlikely(seq & 1)) {
+		return false; // Being written to.
+	}
+
+	bool found = false;
+	for (uint32_t i = 0; i < ENTRY_COUNT; i++) {
+		const Entry &entry = entries[i];
+		if (entry.epoch.load(std::memory_order_relaxed) == p_epoch && entry.script.load(std::memory_order_relaxed) == p_script && entry.class_name.load(std::memory_order_relaxed) == p_class_name) {
+			r_target.kind = Kind(entry.kind.load(std::memory_order_relaxed));
+			r_target.ptr = entry.ptr.load(std::memory_order_relaxed);
+			r_target.type = entry.type.load(std::memory_order_relaxed);
+			r_target.index = entry.index.load(std::memory_order_relaxed);
+			found = true;
+			break;
+		}
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return found && sequence.load(std::memory_order_relaxed) == seq;
+}
+
+void GDScriptFunction::InlineCache::store(const GDScript *p_script, const void *p_class_name, uint32_t p_epoch, const Target &p_target) {
+	uint32_t seq = sequence.load(std::memory_order_relaxed);
+	if ((seq & 1) || !sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_relaxed)) {
+		return; // Another thread is filling this site, no need to wait for it.
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// Reuse a stale entry if there is one, otherwise evict round-robin.
+	uint32_t slot = ENTRY_COUNT;
+	for (uint32_t i = 0; i < ENTRY_COUNT; i++) {
+		if (entries[i].epoch.load(std::memory_order_relaxed) != p_epoch) {
+			slot = i;
+			break;
+		}
+	}
+	if (slot == ENTRY_COUNT) {
+		slot = next_entry;
+		next_entry = (next_entry + 1) % ENTRY_COUNT;
+	}
+
+	Entry &entry = entries[slot];
+	entry.script.store(p_script, std::memory_order_relaxed);
+	entry.class_name.store(p_class_name, std::memory_order_relaxed);
+	entry.epoch.store(p_epoch, std::memory_order_relaxed);
+	entry.kind.store(p_target.kind, std::memory_order_relaxed);
+	entry.ptr.store(p_target.ptr, std::memory_order_relaxed);
+	entry.type.store(p_target.type, std::memory_order_relaxed);
+	entry.index.store(p_target.index, std::memory_order_relaxed);
+
+	sequence.store(seq + 2, std::memory_order_release);
+}
+
+bool GDScriptFunction::_get_inline_cache_key(Object *p_object, GDScriptInstance *&r_instance, const void *&r_class_name) {
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance) {
+		if (script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+			return false;
+		}
+		r_instance = static_cast<GDScriptInstance *>(script_instance);
+	} else {
+		r_instance = nullptr;
+	}
+	// The same script can be attached to objects of different native classes.
+	r_class_name = p_object->get_class_name().data_unique_pointer();
+	return true;
+}
+
+static bool _is_extension_class(const StringName &p_class) {
+	const ClassDB::APIType api = ClassDB::get_api_type(p_class);
+	return api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION;
+}
+
+GDScriptFunction *GDScriptFunction::_find_script_function(const GDScript *p_script, const StringName &p_name) {
+	for (const GDScript *sptr = p_script; sptr; sptr = sptr->_base) {
+		if (likely(sptr->valid)) {
+			HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+			if (E) {
+				return E->value;
+			}
+		}
+	}
+	return nullptr;
+}
+
+// The resolvers below mirror `Object::callp()`, `Object::get()` and `Object::set()`
+// (and the GDScriptInstance overrides they call into). Whenever the outcome could
+// depend on more than the receiver's script and native class, they leave the target
+// as `KIND_NONE` so the site keeps using the regular path.
+
+void GDScriptFunction::_resolve_cached_call(Object *p_object, GDScriptInstance *p_instance, const StringName &p_method, InlineCache::Target &r_target) {
+	r_target = InlineCache::Target();
+
+	if (p_method == CoreStringName(free_) || p_method == SceneStringName(_ready)) {
+		return; // Both are special-cased.
+	}
+
+	if (p_instance) {
+		GDScriptFunction *function = _find_script_function(p_instance->script.ptr(), p_method);
+		if (function) {
+			r_target.kind = InlineCache::KIND_SCRIPT_FUNCTION;
+			r_target.ptr = function;
+			return;
+		}
+	}
+
+	// Only engine method binds live as long as their class.
+	if (_is_extension_class(p_object->get_class_name())) {
+		return;
+	}
+	MethodBind *method = ClassDB::get_method(p_object->get_class_name(), p_method);
+	if (method) {
+		r_target.kind = InlineCache::KIND_METHOD_BIND;
+		r_target.ptr = method;
+	}
+}
+
+void GDScriptFunction::_resolve_cached_get(Object *p_object, GDScriptInstance *p_instance, const StringName &p_name, InlineCache::Target &r_target) {
+	r_target = InlineCache::Target();
+
+	if (p_instance) {
+		const GDScript *script = p_instance->script.ptr();
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+		if (E) {
+			if (likely(script->valid) && E->value.getter) {
+				GDScriptFunction *getter = _find_script_function(script, E->value.getter);
+				if (getter) {
+					r_target.kind = InlineCache::KIND_SCRIPT_FUNCTION;
+					r_target.ptr = getter;
+				}
+			} else {
+				r_target.kind = InlineCache::KIND_MEMBER;
+				r_target.index = E->value.index;
+			}
+			return;
+		}
+
+		for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+			if (sptr->constants.has(p_name) || sptr->static_variables_indices.has(p_name) || sptr->_signals.has(p_name) || sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name) || sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._get)) {
+				return;
+			}
+		}
+	}
+
+	// Extension instances may also override properties with their own `set`/`get`.
+	const StringName &class_name = p_object->get_class_name();
+	if (_is_extension_class(class_name)) {
+		return;
+	}
+	bool is_property = false;
+	if (ClassDB::get_property_index(class_name, p_name, &is_property) != -1 || !is_property) {
+		return; // Indexed properties are called with an extra argument.
+	}
+	const StringName getter = ClassDB::get_property_getter(class_name, p_name);
+	if (getter == StringName()) {
+		return;
+	}
+	MethodBind *method = ClassDB::get_method(class_name, getter);
+	if (method) {
+		r_target.kind = InlineCache::KIND_METHOD_BIND;
+		r_target.ptr = method;
+	}
+}
+
+void GDScriptFunction::_resolve_cached_set(Object *p_object, GDScriptInstance *p_instance, const StringName &p_name, InlineCache::Target &r_target) {
+	r_target = InlineCache::Target();
+
+	if (p_instance) {
+		const GDScript *script = p_instance->script.ptr();
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+		if (E) {
+			const GDScript::MemberInfo &member = E->value;
+			if (likely(script->valid) && member.setter) {
+				GDScriptFunction *setter = _find_script_function(script, member.setter);
+				if (!setter) {
+					return;
+				}
+				r_target.kind = InlineCache::KIND_SCRIPT_FUNCTION;
+				r_target.ptr = setter;
+			} else {
+				r_target.kind = InlineCache::KIND_MEMBER;
+				r_target.index = member.index;
+			}
+			// Values of other types go through the regular path, which converts them.
+			r_target.type = member.data_type.has_type ? &member.data_type : nullptr;
+			return;
+		}
+
+		for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+			if (sptr->static_variables_indices.has(p_name) || sptr->member_functions.has(GDScriptLanguage::get_singleton()->strings._set)) {
+				return;
+			}
+		}
+	}
+
+	// Extension instances may also override properties with their own `set`/`get`.
+	const StringName &class_name = p_object->get_class_name();
+	if (_is_extension_class(class_name)) {
+		return;
+	}
+	bool is_property = false;
+	if (ClassDB::get_property_index(class_name, p_name, &is_property) != -1 || !is_property) {
+		return;
+	}
+	const StringName setter = ClassDB::get_property_setter(class_name, p_name);
+	if (setter == StringName()) {
+		return; // Read-only, let the regular path report it.
+	}
+	MethodBind *method = ClassDB::get_method(class_name, setter);
+	if (method) {
+		r_target.kind = InlineCache::KIND_METHOD_BIND;
+		r_target.ptr = method;
+	}
+}
+
+void GDScriptFunction::_call_cached(InlineCache &p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	Object *object = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	const void *class_name = nullptr;
+	if (!object || !_get_inline_cache_key(object, instance, class_name)) {
+		p_base->callp(p_method, p_args, p_argcount, r_ret, r_err);
+		return;
+	}
+
+	const GDScript *script = instance ? instance->script.ptr() : nullptr;
+	const uint32_t epoch = cache_epoch.get();
+	InlineCache::Target target;
+	if (!p_cache.lookup(script, class_name, epoch, target)) {
+		_resolve_cached_call(object, instance, p_method, target);
+		p_cache.store(script, class_name, epoch, target);
+	}
+
+	if (target.kind == InlineCache::KIND_NONE) {
+		p_base->callp(p_method, p_args, p_argcount, r_ret, r_err);
+		return;
+	}
+
+#ifdef DEBUG_ENABLED
+	// Same as `Object::callp()`, so the object can't be freed while running the method.
+	_ObjectDebugLock debug_lock(object);
+#endif
+	r_err.error = Callable::CallError::CALL_OK;
+	if (target.kind == InlineCache::KIND_SCRIPT_FUNCTION) {
+		r_ret = static_cast<GDScriptFunction *>(target.ptr)->call(instance, p_args, p_argcount, r_err);
+	} else {
+		r_ret = static_cast<MethodBind *>(target.ptr)->call(object, p_args, p_argcount, r_err);
+	}
+}
+
+void GDScriptFunction::_get_named_cached(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret, bool &r_valid) {
+	Object *object = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	const void *class_name = nullptr;
+	if (!object || !_get_inline_cache_key(object, instance, class_name)) {
+		r_ret = p_base->get_named(p_name, r_valid);
+		return;
+	}
+
+	const GDScript *script = instance ? instance->script.ptr() : nullptr;
+	const uint32_t epoch = cache_epoch.get();
+	InlineCache::Target target;
+	if (!p_cache.lookup(script, class_name, epoch, target)) {
+		_resolve_cached_get(object, instance, p_name, target);
+		p_cache.store(script, class_name, epoch, target);
+	}
+
+	switch (target.kind) {
+		case InlineCache::KIND_MEMBER: {
+			if (likely(target.index < instance->members.size())) {
+				r_ret = instance->members[target.index];
+				r_valid = true;
+				return;
+			}
+		} break;
+		case InlineCache::KIND_SCRIPT_FUNCTION: {
+			Callable::CallError err;
+			const Variant ret = static_cast<GDScriptFunction *>(target.ptr)->call(instance, nullptr, 0, err);
+			r_ret = (err.error == Callable::CallError::CALL_OK) ? ret : Variant();
+			r_valid = true;
+			return;
+		}
+		case InlineCache::KIND_METHOD_BIND: {
+			Callable::CallError err;
+			r_ret = static_cast<MethodBind *>(target.ptr)->call(object, nullptr, 0, err);
+			r_valid = true;
+			return;
+		}
+		case InlineCache::KIND_NONE:
+			break;
+	}
+
+	r_ret = p_base->get_named(p_name, r_valid);
+}
+
+void GDScriptFunction::_set_named_cached(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	Object *object = p_base->get_validated_object();
+	GDScriptInstance *instance = nullptr;
+	const void *class_name = nullptr;
+	if (!object || !_get_inline_cache_key(object, instance, class_name)) {
+		p_base->set_named(p_name, p_value, r_valid);
+		return;
+	}
+
+	const GDScript *script = instance ? instance->script.ptr() : nullptr;
+	const uint32_t epoch = cache_epoch.get();
+	InlineCache::Target target;
+	if (!p_cache.lookup(script, class_name, epoch, target)) {
+		_resolve_cached_set(object, instance, p_name, target);
+		p_cache.store(script, class_name, epoch, target);
+	}
+
+#ifdef TOOLS_ENABLED
+	// `Object::set()` flags the object as edited, only skip it once that's done.
+	if (!object->is_edited()) {
+		target.kind = InlineCache::KIND_NONE;
+	}
+#endif
+	if (target.type && !target.type->is_type(p_value)) {
+		target.kind = InlineCache::KIND_NONE;
+	}
+
+	switch (target.kind) {
+		case InlineCache::KIND_MEMBER: {
+			if (likely(target.index < instance->members.size())) {
+				instance->members.write[target.index] = p_value;
+				r_valid = true;
+				return;
+			}
+		} break;
+		case InlineCache::KIND_SCRIPT_FUNCTION: {
+			const Variant *args = &p_value;
+			Callable::CallError err;
+			static_cast<GDScriptFunction *>(target.ptr)->call(instance, &args, 1, err);
+			r_valid = err.error == Callable::CallError::CALL_OK;
+			return;
+		}
+		case InlineCache::KIND_METHOD_BIND: {
+			const Variant *args = &p_value;
+			Callable::CallError err;
+			static_cast<MethodBind *>(target.ptr)->call(object, &args, 1, err);
+			r_valid = err.error == Callable::CallError::CALL_OK;
+			return;
+		}
+		case InlineCache::KIND_NONE:
+			break;
+	}
+
+	p_base->set_named(p_name, p_value, r_valid);
+}
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
@@ -117,6 +481,12 @@ GDScriptFunction::GDScriptFunction() {
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
 
+	// Caches of other functions may point to this one.
+	invalidate_inline_caches();
+	if (inline_caches) {
+		memdelete_arr(inline_caches);
+	}
+
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
@@ -135,23 +505,12 @@ GDScriptFunction::~GDScriptFunction() {
 /////////////////////
 
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
-	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
 
 	if (p_argcount == 0) {
 		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
 		r_error.expected = 1;
 		return Variant();
-	} else if (p_argcount == 1) {
-		//noooneee
-	} else if (p_argcount == 2) {
-		arg = *p_args[0];
-	} else {
-		Array extra_args;
-		for (int i = 0; i < p_argcount - 1; i++) {
-			extra_args.push_back(*p_args[i]);
-		}
-		arg = extra_args;
 	}
 
 	Ref<GDScriptFunctionState> self = *p_args[p_argcount - 1];
@@ -163,6 +522,22 @@ Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_ar
 		return Variant();
 	}
 
+	return _resume_with_signal_arguments(p_args, p_argcount - 1);
+}
+
+Variant GDScriptFunctionState::_resume_with_signal_arguments(const Variant **p_args, int p_argcount) {
+	Variant arg;
+
+	if (p_argcount == 1) {
+		arg = *p_args[0];
+	} else if (p_argcount > 1) {
+		Array extra_args;
+		for (int i = 0; i < p_argcount; i++) {
+			extra_args.push_back(*p_args[i]);
+		}
+		arg = extra_args;
+	}
+
 	return resume(arg);
 }
 
@@ -233,14 +608,18 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 	if (completed) {
 		_clear_stack();
+	} else {
+		// The function already freed the stack it resumed on after copying it into the new state.
+		state.stack_size = 0;
 	}
+	_release_frame();
 
 	return ret;
 }
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// First `GDScriptFunction::FIXED_ADDRESSES_MAX` stack addresses are special
 		// and not copied to the state, so we skip them here.
 		for (int i = GDScriptFunction::FIXED_ADDRESSES_MAX; i < state.stack_size; i++) {
@@ -250,6 +629,73 @@ void GDScriptFunctionState::_clear_stack() {
 	}
 }
 
+void GDScriptFunctionState::_release_frame() {
+	if (state.stack) {
+		_free_frame(state.stack, state.stack_alloc_size);
+		state.stack = nullptr;
+		state.stack_alloc_size = 0;
+	}
+}
+
+void GDScriptFunctionState::_set_finished(const Variant &p_result) {
+	finished = true;
+	finished_result = p_result;
+}
+
+BinaryMutex GDScriptFunctionState::frame_pool_mutex;
+LocalVector<uint8_t *> GDScriptFunctionState::frame_pool[FRAME_POOL_BUCKETS];
+
+uint32_t GDScriptFunctionState::_get_frame_shift(uint32_t p_size) {
+	uint32_t shift = FRAME_POOL_MIN_SHIFT;
+	while ((1u << shift) < p_size && shift <= FRAME_POOL_MAX_SHIFT) {
+		shift++;
+	}
+	return shift;
+}
+
+uint8_t *GDScriptFunctionState::_alloc_frame(uint32_t p_size) {
+	const uint32_t shift = _get_frame_shift(p_size);
+	if (shift > FRAME_POOL_MAX_SHIFT) {
+		return (uint8_t *)memalloc(p_size);
+	}
+
+	{
+		MutexLock lock(frame_pool_mutex);
+		LocalVector<uint8_t *> &bucket = frame_pool[shift - FRAME_POOL_MIN_SHIFT];
+		if (!bucket.is_empty()) {
+			uint8_t *frame = bucket[bucket.size() - 1];
+			bucket.remove_at_unordered(bucket.size() - 1);
+			return frame;
+		}
+	}
+
+	return (uint8_t *)memalloc(1u << shift);
+}
+
+void GDScriptFunctionState::_free_frame(uint8_t *p_frame, uint32_t p_size) {
+	const uint32_t shift = _get_frame_shift(p_size);
+	if (shift <= FRAME_POOL_MAX_SHIFT) {
+		MutexLock lock(frame_pool_mutex);
+		LocalVector<uint8_t *> &bucket = frame_pool[shift - FRAME_POOL_MIN_SHIFT];
+		if (bucket.size() < FRAME_POOL_MAX_FRAMES) {
+			bucket.push_back(p_frame);
+			return;
+		}
+	}
+
+	memfree(p_frame);
+}
+
+void GDScriptFunctionState::clear_frame_pool() {
+	MutexLock lock(frame_pool_mutex);
+	for (LocalVector<uint8_t *> &bucket : frame_pool) {
+		for (uint8_t *frame : bucket) {
+			memfree(frame);
+		}
+		bucket.reset();
+	}
+}
+
 void GDScriptFunctionState::_clear_connections() {
 	List<Object::Connection> conns;
 	get_signals_connected_to_this(&conns);
@@ -278,4 +724,50 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+	_release_frame();
+}
+
+/////////////////////
+
+bool GDScriptFunctionStateCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+	// Only compared by reference, each await connects its own callable.
+	return p_a == p_b;
+}
+
+bool GDScriptFunctionStateCallable::compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+	// Only compared by reference, each await connects its own callable.
+	return p_a < p_b;
+}
+
+uint32_t GDScriptFunctionStateCallable::hash() const {
+	return hash_murmur3_one_64((uint64_t)state->get_instance_id());
+}
+
+String GDScriptFunctionStateCallable::get_as_text() const {
+	return "GDScriptFunctionState::_signal_callback";
+}
+
+CallableCustom::CompareEqualFunc GDScriptFunctionStateCallable::get_compare_equal_func() const {
+	return compare_equal;
+}
+
+CallableCustom::CompareLessFunc GDScriptFunctionStateCallable::get_compare_less_func() const {
+	return compare_less;
+}
+
+ObjectID GDScriptFunctionStateCallable::get_object() const {
+	return state->get_instance_id();
+}
+
+StringName GDScriptFunctionStateCallable::get_method() const {
+	return SNAME("_signal_callback");
+}
+
+void GDScriptFunctionStateCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
+	r_call_error.error = Callable::CallError::CALL_OK;
+	r_return_value = state->_resume_with_signal_arguments(p_arguments, p_argcount);
+}
+
+GDScriptFunctionStateCallable::GDScriptFunctionStateCallable(const Ref<GDScriptFunctionState> &p_state) :
+		state(p_state) {
 }
@@ -30,16 +30,21 @@
 
 #pragma once
 
+#include "gdscript_native_functions.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
 
@@ -269,6 +274,36 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		// Unboxed operators for fully typed operands, emitted instead of
+		// OPCODE_OPERATOR_VALIDATED. They read and write the Variant payload
+		// directly and expect the destination to already hold the result type.
+		OPCODE_ADD_INT,
+		OPCODE_SUBTRACT_INT,
+		OPCODE_MULTIPLY_INT,
+		OPCODE_EQUAL_INT,
+		OPCODE_NOT_EQUAL_INT,
+		OPCODE_LESS_INT,
+		OPCODE_LESS_EQUAL_INT,
+		OPCODE_GREATER_INT,
+		OPCODE_GREATER_EQUAL_INT,
+		OPCODE_ADD_FLOAT,
+		OPCODE_SUBTRACT_FLOAT,
+		OPCODE_MULTIPLY_FLOAT,
+		OPCODE_DIVIDE_FLOAT,
+		OPCODE_EQUAL_FLOAT,
+		OPCODE_NOT_EQUAL_FLOAT,
+		OPCODE_LESS_FLOAT,
+		OPCODE_LESS_EQUAL_FLOAT,
+		OPCODE_GREATER_FLOAT,
+		OPCODE_GREATER_EQUAL_FLOAT,
+		OPCODE_ADD_VECTOR2,
+		OPCODE_SUBTRACT_VECTOR2,
+		OPCODE_MULTIPLY_VECTOR2,
+		OPCODE_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_ADD_VECTOR3,
+		OPCODE_SUBTRACT_VECTOR3,
+		OPCODE_MULTIPLY_VECTOR3,
+		OPCODE_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -329,6 +364,20 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		// Typed comparison fused with OPCODE_JUMP_IF_NOT: jumps unless the
+		// comparison holds.
+		OPCODE_JUMP_UNLESS_EQUAL_INT,
+		OPCODE_JUMP_UNLESS_NOT_EQUAL_INT,
+		OPCODE_JUMP_UNLESS_LESS_INT,
+		OPCODE_JUMP_UNLESS_LESS_EQUAL_INT,
+		OPCODE_JUMP_UNLESS_GREATER_INT,
+		OPCODE_JUMP_UNLESS_GREATER_EQUAL_INT,
+		OPCODE_JUMP_UNLESS_EQUAL_FLOAT,
+		OPCODE_JUMP_UNLESS_NOT_EQUAL_FLOAT,
+		OPCODE_JUMP_UNLESS_LESS_FLOAT,
+		OPCODE_JUMP_UNLESS_LESS_EQUAL_FLOAT,
+		OPCODE_JUMP_UNLESS_GREATER_FLOAT,
+		OPCODE_JUMP_UNLESS_GREATER_EQUAL_FLOAT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
 		OPCODE_RETURN,
@@ -454,8 +503,52 @@ public:
 		StringName identifier;
 	};
 
+	// Per-site cache for untyped calls and named property access on objects.
+	// Entries are keyed on the receiver's script and native class, and get
+	// stale as soon as any script is recompiled or freed (see `cache_epoch`).
+	struct InlineCache {
+		enum Kind {
+			KIND_NONE,
+			KIND_SCRIPT_FUNCTION, // `ptr` is a GDScriptFunction (a method, or a property getter/setter).
+			KIND_METHOD_BIND, // `ptr` is a MethodBind (a method, or a property getter/setter).
+			KIND_MEMBER, // `index` is a GDScriptInstance member.
+		};
+
+		struct Target {
+			Kind kind = KIND_NONE; // Cached miss, resolve the regular way.
+			void *ptr = nullptr;
+			const GDScriptDataType *type = nullptr; // Type of the assigned script member, if any.
+			int index = -1;
+		};
+
+		static constexpr uint32_t ENTRY_COUNT = 2;
+
+		// Fields are written under `sequence` (seqlock) so concurrent readers
+		// only ever see a complete entry.
+		struct Entry {
+			std::atomic<const GDScript *> script{ nullptr };
+			std::atomic<const void *> class_name{ nullptr };
+			std::atomic<uint32_t> epoch{ 0 };
+			std::atomic<int> kind{ KIND_NONE };
+			std::atomic<void *> ptr{ nullptr };
+			std::atomic<const GDScriptDataType *> type{ nullptr };
+			std::atomic<int> index{ -1 };
+		};
+
+		std::atomic<uint32_t> sequence{ 0 };
+		uint32_t next_entry = 0;
+		Entry entries[ENTRY_COUNT];
+
+		bool lookup(const GDScript *p_script, const void *p_class_name, uint32_t p_epoch, Target &r_target) const;
+		void store(const GDScript *p_script, const void *p_class_name, uint32_t p_epoch, const Target &p_target);
+	};
+
+	static SafeNumeric<uint32_t> cache_epoch;
+	static void invalidate_inline_caches();
+
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
@@ -497,6 +590,7 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	InlineCache *inline_caches = nullptr;
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -515,6 +609,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -534,6 +629,10 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Same function compiled into the engine, see `GDScriptNativeFunctions`.
+	GDScriptNativeFunctions::Function native_function = nullptr;
+	_FORCE_INLINE_ bool _can_call_native(const Variant **p_args, int p_argcount) const;
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -546,6 +645,12 @@ private:
 	Vector<String> utilities_names;
 	Vector<String> gds_utilities_names;
 
+	// Code as generated, before the optimization pass. Only kept when
+	// `GDScriptByteCodeGenerator::keep_unoptimized_code` is set.
+	Vector<int> unoptimized_code;
+
+	void _disassemble_code(const int *p_code, int p_code_size, const Vector<String> &p_code_lines, Vector<int> &r_addresses, Vector<String> &r_text) const;
+
 	struct Profile {
 		StringName signature;
 		SafeNumeric<uint64_t> call_count;
@@ -571,6 +676,15 @@ private:
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	static bool _get_inline_cache_key(Object *p_object, GDScriptInstance *&r_instance, const void *&r_class_name);
+	static GDScriptFunction *_find_script_function(const GDScript *p_script, const StringName &p_name);
+	static void _resolve_cached_call(Object *p_object, GDScriptInstance *p_instance, const StringName &p_method, InlineCache::Target &r_target);
+	static void _resolve_cached_get(Object *p_object, GDScriptInstance *p_instance, const StringName &p_name, InlineCache::Target &r_target);
+	static void _resolve_cached_set(Object *p_object, GDScriptInstance *p_instance, const StringName &p_name, InlineCache::Target &r_target);
+	static void _call_cached(InlineCache &p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	static void _get_named_cached(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret, bool &r_valid);
+	static void _set_named_cached(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
@@ -582,7 +696,8 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Frame taken from the coroutine frame pool.
+		uint32_t stack_alloc_size = 0;
 		int stack_size = 0;
 		int ip = 0;
 		int line = 0;
@@ -599,6 +714,7 @@ public:
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ int get_code_size() const { return _code_size; }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
@@ -609,6 +725,7 @@ public:
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
+	void disassemble_diff(const Vector<String> &p_code_lines) const;
 #endif
 
 	GDScriptFunction();
@@ -618,14 +735,37 @@ public:
 class GDScriptFunctionState : public RefCounted {
 	GDCLASS(GDScriptFunctionState, RefCounted);
 	friend class GDScriptFunction;
+	friend class GDScriptFunctionStateCallable;
 	GDScriptFunction *function = nullptr;
 	GDScriptFunction::CallState state;
 	Variant _signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Variant _resume_with_signal_arguments(const Variant **p_args, int p_argcount);
 	Ref<GDScriptFunctionState> first_state;
 
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
+	// Set on the first state of a coroutine once it returned, so awaiting it again doesn't wait forever.
+	bool finished = false;
+	Variant finished_result;
+
+	// Suspended stack frames are recycled through free lists bucketed by power of two sizes,
+	// since the same few coroutines usually get suspended over and over.
+	enum {
+		FRAME_POOL_MIN_SHIFT = 6, // 64 bytes.
+		FRAME_POOL_MAX_SHIFT = 16, // 64 KiB, bigger frames are not pooled.
+		FRAME_POOL_BUCKETS = FRAME_POOL_MAX_SHIFT - FRAME_POOL_MIN_SHIFT + 1,
+		FRAME_POOL_MAX_FRAMES = 64, // Per bucket.
+	};
+	static BinaryMutex frame_pool_mutex;
+	static LocalVector<uint8_t *> frame_pool[FRAME_POOL_BUCKETS];
+
+	static uint32_t _get_frame_shift(uint32_t p_size);
+	static uint8_t *_alloc_frame(uint32_t p_size);
+	static void _free_frame(uint8_t *p_frame, uint32_t p_size);
+	void _release_frame();
+	void _set_finished(const Variant &p_result);
+
 protected:
 	static void _bind_methods();
 
@@ -643,6 +783,28 @@ public:
 	void _clear_stack();
 	void _clear_connections();
 
+	static void clear_frame_pool();
+
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
 };
+
+// Resumes a suspended function when the awaited signal is emitted. Cheaper than binding
+// the state to `_signal_callback`, which allocates the bound arguments and looks the method up by name.
+class GDScriptFunctionStateCallable : public CallableCustom {
+	Ref<GDScriptFunctionState> state;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
+
+public:
+	uint32_t hash() const override;
+	String get_as_text() const override;
+	CompareEqualFunc get_compare_equal_func() const override;
+	CompareLessFunc get_compare_less_func() const override;
+	ObjectID get_object() const override;
+	StringName get_method() const override;
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override;
+
+	GDScriptFunctionStateCallable(const Ref<GDScriptFunctionState> &p_state);
+};
@@ -0,0 +1,979 @@
+/**************************************************************************/
+/*  gdscript_native_codegen.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_codegen.h"
+
+#include "gdscript.h"
+#include "gdscript_analyzer.h"
+#include "gdscript_compiler.h"
+#include "gdscript_parser.h"
+
+void GDScriptNativeCode::add_function(const String &p_fqcn, const StringName &p_name, const String &p_body) {
+	const String symbol = "gdscript_native_" + itos(definitions.size());
+
+	definitions.push_back(vformat("// %s.%s\nstatic void %s(const Variant **p_args, Variant &r_ret) {\n%s}\n", p_fqcn, p_name, symbol, p_body));
+	registrations.push_back(vformat("\tGDScriptNativeFunctions::register_function(\"%s\", \"%s\", 0x%su, &%s);\n", p_fqcn.c_escape(), String(p_name).c_escape(), String::num_uint64(current_source_hash, 16), symbol));
+}
+
+Error GDScriptNativeCode::add_script(const String &p_path, const String &p_source, uint32_t p_source_hash) {
+	GDScriptParser parser;
+	Error err = parser.parse(p_source, p_path, false);
+	if (err) {
+		return err;
+	}
+
+	GDScriptAnalyzer analyzer(&parser);
+	err = analyzer.analyze();
+	if (err) {
+		return err;
+	}
+
+	current_path = p_path;
+	current_source_hash = p_source_hash;
+
+	// Not given the resource path, so the script loaded from it stays the one in use.
+	Ref<GDScript> script;
+	script.instantiate();
+
+	GDScriptCompiler compiler;
+	compiler.set_native_code(this);
+	return compiler.compile(&parser, script.ptr(), false);
+}
+
+String GDScriptNativeCode::get_source() const {
+	String source = "/* Generated by the GDScript exporter, do not edit. */\n\n";
+	source += "#include \"modules/gdscript/gdscript_native_functions.h\"\n\n";
+	source += "#include \"core/math/math_funcs.h\"\n";
+	source += "#include \"core/variant/variant_utility.h\"\n\n";
+	// Variables only written on some paths, like loop counters and cleared locals.
+	source += "GODOT_GCC_WARNING_IGNORE(\"-Wunused-but-set-variable\")\n";
+	source += "GODOT_CLANG_WARNING_IGNORE(\"-Wunused-but-set-variable\")\n\n";
+
+	for (const String &definition : definitions) {
+		source += definition + "\n";
+	}
+
+	source += "void register_gdscript_native_functions() {\n";
+	for (const String &registration : registrations) {
+		source += registration;
+	}
+	source += "}\n";
+	return source;
+}
+
+const char *GDScriptNativeCodeGenerator::_get_cpp_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return "bool";
+		case Variant::INT:
+			return "int64_t";
+		case Variant::FLOAT:
+			return "double";
+		default:
+			return nullptr;
+	}
+}
+
+bool GDScriptNativeCodeGenerator::_is_lowerable(const GDScriptDataType &p_type) {
+	return p_type.has_type && p_type.kind == GDScriptDataType::BUILTIN && _get_cpp_type(p_type.builtin_type) != nullptr;
+}
+
+String GDScriptNativeCodeGenerator::_get_literal(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::BOOL:
+			return bool(p_value) ? "true" : "false";
+		case Variant::INT: {
+			const int64_t value = p_value;
+			if (value == INT64_MIN) {
+				return "INT64_MIN";
+			}
+			return "int64_t(" + itos(value) + "LL)";
+		}
+		case Variant::FLOAT: {
+			const double value = p_value;
+			if (Math::is_nan(value)) {
+				return "Math::NaN";
+			}
+			if (Math::is_inf(value)) {
+				return value > 0 ? "Math::INF" : "-Math::INF";
+			}
+			// Hexadecimal, so the value is exact.
+			char buffer[64];
+			snprintf(buffer, sizeof(buffer), "%a", value);
+			return buffer;
+		}
+		default:
+			return String();
+	}
+}
+
+String GDScriptNativeCodeGenerator::_get_default_literal(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return _get_literal(false);
+		case Variant::INT:
+			return _get_literal(int64_t(0));
+		default:
+			return _get_literal(0.0);
+	}
+}
+
+String GDScriptNativeCodeGenerator::_convert(const String &p_expression, Variant::Type p_from, Variant::Type p_to) {
+	if (p_from == p_to) {
+		return p_expression;
+	}
+	// Same as the `Variant` conversions between these types.
+	return vformat("%s(%s)", _get_cpp_type(p_to), p_expression);
+}
+
+void GDScriptNativeCodeGenerator::_unsupported() {
+	lowerable = false;
+}
+
+void GDScriptNativeCodeGenerator::_write_line(const String &p_line) {
+	if (lowerable) {
+		lines.push_back(String("\t").repeat(indent) + p_line);
+	}
+}
+
+String GDScriptNativeCodeGenerator::_get_variable(const Address &p_address) {
+	const Variant::Type type = p_address.type.builtin_type;
+	switch (p_address.mode) {
+		case Address::FUNCTION_PARAMETER:
+			return "p" + itos(p_address.address);
+		case Address::LOCAL_VARIABLE:
+		case Address::TEMPORARY: {
+			// Stack slots are reused by variables of different types.
+			const String suffix = type == Variant::BOOL ? "b" : (type == Variant::INT ? "i" : "f");
+			const String name = (p_address.mode == Address::LOCAL_VARIABLE ? "l" : "t") + itos(p_address.address) + "_" + suffix;
+			variables[name] = type;
+			return name;
+		}
+		default:
+			return String();
+	}
+}
+
+String GDScriptNativeCodeGenerator::_read(const Address &p_address, Variant::Type p_as) {
+	String expression;
+	Variant::Type type = Variant::NIL;
+
+	switch (p_address.mode) {
+		case Address::CONSTANT: {
+			const Variant *value = constants.getptr(p_address.address);
+			if (value == nullptr || _get_cpp_type(value->get_type()) == nullptr) {
+				_unsupported();
+				return String();
+			}
+			expression = _get_literal(*value);
+			type = value->get_type();
+		} break;
+		case Address::FUNCTION_PARAMETER:
+		case Address::LOCAL_VARIABLE:
+		case Address::TEMPORARY: {
+			if (!_is_lowerable(p_address.type)) {
+				_unsupported();
+				return String();
+			}
+			expression = _get_variable(p_address);
+			type = p_address.type.builtin_type;
+		} break;
+		default: {
+			_unsupported();
+			return String();
+		}
+	}
+
+	return p_as == Variant::NIL ? expression : _convert(expression, type, p_as);
+}
+
+Variant::Type GDScriptNativeCodeGenerator::_get_type(const Address &p_address) const {
+	switch (p_address.mode) {
+		case Address::CONSTANT: {
+			const Variant *value = constants.getptr(p_address.address);
+			if (value == nullptr || _get_cpp_type(value->get_type()) == nullptr) {
+				return Variant::NIL;
+			}
+			return value->get_type();
+		}
+		case Address::FUNCTION_PARAMETER:
+		case Address::LOCAL_VARIABLE:
+		case Address::TEMPORARY:
+			return _is_lowerable(p_address.type) ? p_address.type.builtin_type : Variant::NIL;
+		default:
+			// Members and globals are not available natively.
+			return Variant::NIL;
+	}
+}
+
+void GDScriptNativeCodeGenerator::_assign(const Address &p_target, const String &p_expression, Variant::Type p_type) {
+	if (p_target.mode == Address::NIL) {
+		// Result is discarded.
+		_write_line(p_expression + ";");
+		return;
+	}
+	if (p_target.mode == Address::CONSTANT || _get_type(p_target) == Variant::NIL || _get_cpp_type(p_type) == nullptr) {
+		_unsupported();
+		return;
+	}
+	_write_line(vformat("%s = %s;", _get_variable(p_target), _convert(p_expression, p_type, p_target.type.builtin_type)));
+}
+
+void GDScriptNativeCodeGenerator::_write_error_check(const String &p_condition, const String &p_error) {
+	_write_line(vformat("if (unlikely(%s)) {", p_condition));
+	_write_line(vformat("\tGDScriptNativeFunctions::runtime_error(\"%s\", \"%s\", %d, \"%s\");", String(function_name).c_escape(), native_code->current_path.c_escape(), current_line, p_error.c_escape()));
+	_write_line("\treturn;");
+	_write_line("}");
+}
+
+uint32_t GDScriptNativeCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
+	const uint32_t address = bytecode->add_parameter(p_name, p_is_optional, p_type);
+	// Default values are assigned by the bytecode prologue.
+	if (p_is_optional || !_is_lowerable(p_type)) {
+		_unsupported();
+	}
+	parameters.push_back(Pair<uint32_t, Variant::Type>(address, p_type.builtin_type));
+	return address;
+}
+
+uint32_t GDScriptNativeCodeGenerator::add_local(const StringName &p_name, const GDScriptDataType &p_type) {
+	return bytecode->add_local(p_name, p_type);
+}
+
+uint32_t GDScriptNativeCodeGenerator::add_local_constant(const StringName &p_name, const Variant &p_constant) {
+	const uint32_t index = bytecode->add_local_constant(p_name, p_constant);
+	constants[index] = p_constant;
+	return index;
+}
+
+uint32_t GDScriptNativeCodeGenerator::add_or_get_constant(const Variant &p_constant) {
+	const uint32_t index = bytecode->add_or_get_constant(p_constant);
+	constants[index] = p_constant;
+	return index;
+}
+
+uint32_t GDScriptNativeCodeGenerator::add_or_get_name(const StringName &p_name) {
+	return bytecode->add_or_get_name(p_name);
+}
+
+uint32_t GDScriptNativeCodeGenerator::add_temporary(const GDScriptDataType &p_type) {
+	return bytecode->add_temporary(p_type);
+}
+
+void GDScriptNativeCodeGenerator::pop_temporary() {
+	bytecode->pop_temporary();
+}
+
+void GDScriptNativeCodeGenerator::clear_temporaries() {
+	bytecode->clear_temporaries();
+}
+
+void GDScriptNativeCodeGenerator::clear_address(const Address &p_address) {
+	bytecode->clear_address(p_address);
+
+	const Variant::Type type = _get_type(p_address);
+	if (type == Variant::NIL || p_address.mode == Address::CONSTANT) {
+		_unsupported();
+		return;
+	}
+	_write_line(vformat("%s = %s;", _get_variable(p_address), _get_default_literal(type)));
+}
+
+bool GDScriptNativeCodeGenerator::is_local_dirty(const Address &p_address) const {
+	return bytecode->is_local_dirty(p_address);
+}
+
+void GDScriptNativeCodeGenerator::start_parameters() {
+	bytecode->start_parameters();
+}
+
+void GDScriptNativeCodeGenerator::end_parameters() {
+	bytecode->end_parameters();
+}
+
+void GDScriptNativeCodeGenerator::start_block() {
+	bytecode->start_block();
+}
+
+void GDScriptNativeCodeGenerator::end_block() {
+	bytecode->end_block();
+}
+
+void GDScriptNativeCodeGenerator::write_start(GDScript *p_script, const StringName &p_function_name, bool p_static, Variant p_rpc_config, const GDScriptDataType &p_return_type) {
+	bytecode->write_start(p_script, p_function_name, p_static, p_rpc_config, p_return_type);
+
+	fqcn = p_script->get_fully_qualified_name();
+	function_name = p_function_name;
+	return_type = p_return_type;
+
+	const bool returns_void = p_return_type.has_type && p_return_type.kind == GDScriptDataType::BUILTIN && p_return_type.builtin_type == Variant::NIL;
+	if (!returns_void && !_is_lowerable(p_return_type)) {
+		_unsupported();
+	}
+}
+
+GDScriptFunction *GDScriptNativeCodeGenerator::write_end() {
+	GDScriptFunction *function = bytecode->write_end();
+
+	if (lowerable) {
+		String body;
+		for (int i = 0; i < parameters.size(); i++) {
+			body += vformat("\t%s p%d = *p_args[%d];\n", _get_cpp_type(parameters[i].second), parameters[i].first, i);
+		}
+		for (const KeyValue<String, Variant::Type> &E : variables) {
+			body += vformat("\t%s %s = %s;\n", _get_cpp_type(E.value), E.key, _get_default_literal(E.value));
+		}
+		for (const String &line : lines) {
+			body += line + "\n";
+		}
+		native_code->add_function(fqcn, function_name, body);
+	}
+
+	return function;
+}
+
+#ifdef DEBUG_ENABLED
+void GDScriptNativeCodeGenerator::set_signature(const String &p_signature) {
+	bytecode->set_signature(p_signature);
+}
+#endif
+
+void GDScriptNativeCodeGenerator::set_initial_line(int p_line) {
+	bytecode->set_initial_line(p_line);
+}
+
+void GDScriptNativeCodeGenerator::write_type_adjust(const Address &p_target, Variant::Type p_new_type) {
+	bytecode->write_type_adjust(p_target, p_new_type);
+	// Native variables never change type, a different one would be a different variable.
+	if (_get_type(p_target) != p_new_type) {
+		_unsupported();
+	}
+}
+
+void GDScriptNativeCodeGenerator::write_unary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand) {
+	bytecode->write_unary_operator(p_target, p_operator, p_left_operand);
+
+	const Variant::Type type = _get_type(p_left_operand);
+	const Variant::Type result_type = Variant::get_operator_return_type(p_operator, type, Variant::NIL);
+	if (type == Variant::NIL || _get_cpp_type(result_type) == nullptr) {
+		_unsupported();
+		return;
+	}
+
+	const String operand = _read(p_left_operand);
+	switch (p_operator) {
+		case Variant::OP_NEGATE:
+			_assign(p_target, "-(" + operand + ")", result_type);
+			break;
+		case Variant::OP_POSITIVE:
+			_assign(p_target, operand, result_type);
+			break;
+		case Variant::OP_NOT:
+			_assign(p_target, "!(" + operand + ")", result_type);
+			break;
+		case Variant::OP_BIT_NEGATE:
+			_assign(p_target, "~(" + operand + ")", result_type);
+			break;
+		default:
+			_unsupported();
+			break;
+	}
+}
+
+void GDScriptNativeCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
+	bytecode->write_binary_operator(p_target, p_operator, p_left_operand, p_right_operand);
+
+	const Variant::Type left_type = _get_type(p_left_operand);
+	const Variant::Type right_type = _get_type(p_right_operand);
+	const Variant::Type result_type = Variant::get_operator_return_type(p_operator, left_type, right_type);
+	if (left_type == Variant::NIL || right_type == Variant::NIL || _get_cpp_type(result_type) == nullptr) {
+		_unsupported();
+		return;
+	}
+	// `bool` is only equal to `bool` for `Variant`, but not in C++.
+	if ((left_type == Variant::BOOL) != (right_type == Variant::BOOL)) {
+		_unsupported();
+		return;
+	}
+
+	const String left = _read(p_left_operand);
+	const String right = _read(p_right_operand);
+	const bool integer = left_type == Variant::INT && right_type == Variant::INT;
+
+	const char *symbol = nullptr;
+	switch (p_operator) {
+		case Variant::OP_EQUAL:
+			symbol = "==";
+			break;
+		case Variant::OP_NOT_EQUAL:
+			symbol = "!=";
+			break;
+		case Variant::OP_LESS:
+			symbol = "<";
+			break;
+		case Variant::OP_LESS_EQUAL:
+			symbol = "<=";
+			break;
+		case Variant::OP_GREATER:
+			symbol = ">";
+			break;
+		case Variant::OP_GREATER_EQUAL:
+			symbol = ">=";
+			break;
+		case Variant::OP_ADD:
+			symbol = "+";
+			break;
+		case Variant::OP_SUBTRACT:
+			symbol = "-";
+			break;
+		case Variant::OP_MULTIPLY:
+			symbol = "*";
+			break;
+		case Variant::OP_DIVIDE:
+		case Variant::OP_MODULE: {
+			symbol = p_operator == Variant::OP_DIVIDE ? "/" : "%";
+			// Same check as the operator evaluator, only integers can't be divided by zero.
+			const Variant *constant = p_right_operand.mode == Address::CONSTANT ? constants.getptr(p_right_operand.address) : nullptr;
+			if (integer && (constant == nullptr || int64_t(*constant) == 0)) {
+				const String error = p_operator == Variant::OP_DIVIDE ? "Division by zero error in operator '/'." : "Modulo by zero error in operator '%'.";
+				_write_error_check(right + " == 0", error);
+			}
+		} break;
+		case Variant::OP_POWER:
+			_assign(p_target, vformat("%s(Math::pow(double(%s), double(%s)))", _get_cpp_type(result_type), left, right), result_type);
+			return;
+		case Variant::OP_SHIFT_LEFT:
+		case Variant::OP_SHIFT_RIGHT: {
+			symbol = p_operator == Variant::OP_SHIFT_LEFT ? "<<" : ">>";
+			if (!integer) {
+				_unsupported();
+				return;
+			}
+			// Same check as the operator evaluator. Shift counts C++ leaves undefined are errors too.
+			const Variant *left_constant = p_left_operand.mode == Address::CONSTANT ? constants.getptr(p_left_operand.address) : nullptr;
+			const Variant *right_constant = p_right_operand.mode == Address::CONSTANT ? constants.getptr(p_right_operand.address) : nullptr;
+			const bool left_checked = left_constant != nullptr && int64_t(*left_constant) >= 0;
+			const bool right_checked = right_constant != nullptr && int64_t(*right_constant) >= 0;
+			if (!left_checked || !right_checked) {
+				_write_error_check(vformat("%s < 0 || %s < 0", left, right), "Invalid operands for bit shifting. Only positive operands are supported.");
+			}
+			if (right_constant == nullptr || int64_t(*right_constant) >= 64) {
+				_write_error_check(vformat("%s >= 64", right), "Invalid operands for bit shifting. The shift amount must be less than 64.");
+			}
+		} break;
+		case Variant::OP_BIT_AND:
+			symbol = "&";
+			break;
+		case Variant::OP_BIT_OR:
+			symbol = "|";
+			break;
+		case Variant::OP_BIT_XOR:
+			symbol = "^";
+			break;
+		case Variant::OP_AND:
+			symbol = "&&";
+			break;
+		case Variant::OP_OR:
+			symbol = "||";
+			break;
+		case Variant::OP_XOR:
+			_assign(p_target, vformat("(bool(%s) != bool(%s))", left, right), result_type);
+			return;
+		default:
+			_unsupported();
+			return;
+	}
+
+	_assign(p_target, vformat("(%s %s %s)", left, symbol, right), result_type);
+}
+
+void GDScriptNativeCodeGenerator::write_type_test(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
+	bytecode->write_type_test(p_target, p_source, p_type);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
+	bytecode->write_and_left_operand(p_left_operand);
+
+	const int label = label_count++;
+	logic_labels.push_back(label);
+	_write_line(vformat("bool and_%d = false;", label));
+	_write_line(vformat("if (%s) {", _read(p_left_operand, Variant::BOOL)));
+	indent++;
+}
+
+void GDScriptNativeCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
+	bytecode->write_and_right_operand(p_right_operand);
+
+	_write_line(vformat("and_%d = %s;", logic_labels.back()->get(), _read(p_right_operand, Variant::BOOL)));
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptNativeCodeGenerator::write_end_and(const Address &p_target) {
+	bytecode->write_end_and(p_target);
+
+	_assign(p_target, vformat("and_%d", logic_labels.back()->get()), Variant::BOOL);
+	logic_labels.pop_back();
+}
+
+void GDScriptNativeCodeGenerator::write_or_left_operand(const Address &p_left_operand) {
+	bytecode->write_or_left_operand(p_left_operand);
+
+	const int label = label_count++;
+	logic_labels.push_back(label);
+	_write_line(vformat("bool or_%d = true;", label));
+	_write_line(vformat("if (!%s) {", _read(p_left_operand, Variant::BOOL)));
+	indent++;
+}
+
+void GDScriptNativeCodeGenerator::write_or_right_operand(const Address &p_right_operand) {
+	bytecode->write_or_right_operand(p_right_operand);
+
+	_write_line(vformat("or_%d = %s;", logic_labels.back()->get(), _read(p_right_operand, Variant::BOOL)));
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptNativeCodeGenerator::write_end_or(const Address &p_target) {
+	bytecode->write_end_or(p_target);
+
+	_assign(p_target, vformat("or_%d", logic_labels.back()->get()), Variant::BOOL);
+	logic_labels.pop_back();
+}
+
+void GDScriptNativeCodeGenerator::write_start_ternary(const Address &p_target) {
+	bytecode->write_start_ternary(p_target);
+	ternary_targets.push_back(p_target);
+}
+
+void GDScriptNativeCodeGenerator::write_ternary_condition(const Address &p_condition) {
+	bytecode->write_ternary_condition(p_condition);
+
+	_write_line(vformat("if (%s) {", _read(p_condition, Variant::BOOL)));
+	indent++;
+}
+
+void GDScriptNativeCodeGenerator::write_ternary_true_expr(const Address &p_expr) {
+	bytecode->write_ternary_true_expr(p_expr);
+
+	_assign(ternary_targets.back()->get(), _read(p_expr), _get_type(p_expr));
+	indent--;
+	_write_line("} else {");
+	indent++;
+}
+
+void GDScriptNativeCodeGenerator::write_ternary_false_expr(const Address &p_expr) {
+	bytecode->write_ternary_false_expr(p_expr);
+
+	_assign(ternary_targets.back()->get(), _read(p_expr), _get_type(p_expr));
+}
+
+void GDScriptNativeCodeGenerator::write_end_ternary() {
+	bytecode->write_end_ternary();
+
+	indent--;
+	_write_line("}");
+	ternary_targets.pop_back();
+}
+
+void GDScriptNativeCodeGenerator::write_set(const Address &p_target, const Address &p_index, const Address &p_source) {
+	bytecode->write_set(p_target, p_index, p_source);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_get(const Address &p_target, const Address &p_index, const Address &p_source) {
+	bytecode->write_get(p_target, p_index, p_source);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
+	bytecode->write_set_named(p_target, p_name, p_source);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
+	bytecode->write_get_named(p_target, p_name, p_source);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
+	bytecode->write_set_member(p_value, p_name);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_get_member(const Address &p_target, const StringName &p_name) {
+	bytecode->write_get_member(p_target, p_name);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_set_static_variable(const Address &p_value, const Address &p_class, int p_index) {
+	bytecode->write_set_static_variable(p_value, p_class, p_index);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_get_static_variable(const Address &p_target, const Address &p_class, int p_index) {
+	bytecode->write_get_static_variable(p_target, p_class, p_index);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	bytecode->write_assign(p_target, p_source);
+	_assign(p_target, _read(p_source), _get_type(p_source));
+}
+
+void GDScriptNativeCodeGenerator::write_assign_with_conversion(const Address &p_target, const Address &p_source) {
+	bytecode->write_assign_with_conversion(p_target, p_source);
+	_assign(p_target, _read(p_source), _get_type(p_source));
+}
+
+void GDScriptNativeCodeGenerator::write_assign_null(const Address &p_target) {
+	bytecode->write_assign_null(p_target);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_assign_true(const Address &p_target) {
+	bytecode->write_assign_true(p_target);
+	_assign(p_target, "true", Variant::BOOL);
+}
+
+void GDScriptNativeCodeGenerator::write_assign_false(const Address &p_target) {
+	bytecode->write_assign_false(p_target);
+	_assign(p_target, "false", Variant::BOOL);
+}
+
+void GDScriptNativeCodeGenerator::write_assign_default_parameter(const Address &p_dst, const Address &p_src, bool p_use_conversion) {
+	bytecode->write_assign_default_parameter(p_dst, p_src, p_use_conversion);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
+	bytecode->write_store_global(p_dst, p_global_index);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_store_named_global(const Address &p_dst, const StringName &p_global) {
+	bytecode->write_store_named_global(p_dst, p_global);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_cast(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) {
+	bytecode->write_cast(p_target, p_source, p_type);
+
+	if (!_is_lowerable(p_type)) {
+		_unsupported();
+		return;
+	}
+	_assign(p_target, _read(p_source, p_type.builtin_type), p_type.builtin_type);
+}
+
+void GDScriptNativeCodeGenerator::write_call(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call(p_target, p_base, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_super_call(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_super_call(p_target, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_async(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call_async(p_target, p_base, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) {
+	bytecode->write_call_utility(p_target, p_function, p_arguments);
+
+	// Only functions taking and returning the lowered types, called directly.
+	if (Variant::is_utility_function_vararg(p_function) || Variant::get_utility_function_argument_count(p_function) != p_arguments.size()) {
+		_unsupported();
+		return;
+	}
+
+	String arguments;
+	for (int i = 0; i < p_arguments.size(); i++) {
+		const Variant::Type type = Variant::get_utility_function_argument_type(p_function, i);
+		if (_get_cpp_type(type) == nullptr || _get_type(p_arguments[i]) == Variant::NIL) {
+			_unsupported();
+			return;
+		}
+		if (i > 0) {
+			arguments += ", ";
+		}
+		arguments += _read(p_arguments[i], type);
+	}
+
+	const String call = vformat("VariantUtilityFunctions::%s(%s)", p_function, arguments);
+	if (!Variant::has_utility_function_return_value(p_function)) {
+		_write_line(call + ";");
+		return;
+	}
+	_assign(p_target, call, Variant::get_utility_function_return_type(p_function));
+}
+
+void GDScriptNativeCodeGenerator::write_call_gdscript_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) {
+	bytecode->write_call_gdscript_utility(p_target, p_function, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_builtin_type(const Address &p_target, const Address &p_base, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_builtin_type(p_target, p_base, p_type, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_builtin_type_static(const Address &p_target, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_builtin_type_static(p_target, p_type, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_native_static(const Address &p_target, const StringName &p_class, const StringName &p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_native_static(p_target, p_class, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_native_static_validated(const Address &p_target, MethodBind *p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_native_static_validated(p_target, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_method_bind(const Address &p_target, const Address &p_base, MethodBind *p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_method_bind(p_target, p_base, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_method_bind_validated(const Address &p_target, const Address &p_base, MethodBind *p_method, const Vector<Address> &p_arguments) {
+	bytecode->write_call_method_bind_validated(p_target, p_base, p_method, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_self(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call_self(p_target, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_self_async(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call_self_async(p_target, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_call_script_function(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) {
+	bytecode->write_call_script_function(p_target, p_base, p_function_name, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_captures, bool p_use_self) {
+	bytecode->write_lambda(p_target, p_function, p_captures, p_use_self);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_construct(const Address &p_target, Variant::Type p_type, const Vector<Address> &p_arguments) {
+	bytecode->write_construct(p_target, p_type, p_arguments);
+
+	// Only `int()`, `float()` and `bool()`, which are conversions.
+	if (_get_cpp_type(p_type) == nullptr || p_arguments.size() > 1 || (p_arguments.size() == 1 && _get_type(p_arguments[0]) == Variant::NIL)) {
+		_unsupported();
+		return;
+	}
+	if (p_arguments.is_empty()) {
+		_assign(p_target, _get_default_literal(p_type), p_type);
+	} else {
+		_assign(p_target, _read(p_arguments[0], p_type), p_type);
+	}
+}
+
+void GDScriptNativeCodeGenerator::write_construct_array(const Address &p_target, const Vector<Address> &p_arguments) {
+	bytecode->write_construct_array(p_target, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_construct_typed_array(const Address &p_target, const GDScriptDataType &p_element_type, const Vector<Address> &p_arguments) {
+	bytecode->write_construct_typed_array(p_target, p_element_type, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_construct_dictionary(const Address &p_target, const Vector<Address> &p_arguments) {
+	bytecode->write_construct_dictionary(p_target, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_construct_typed_dictionary(const Address &p_target, const GDScriptDataType &p_key_type, const GDScriptDataType &p_value_type, const Vector<Address> &p_arguments) {
+	bytecode->write_construct_typed_dictionary(p_target, p_key_type, p_value_type, p_arguments);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_await(const Address &p_target, const Address &p_operand) {
+	bytecode->write_await(p_target, p_operand);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_if(const Address &p_condition) {
+	bytecode->write_if(p_condition);
+
+	_write_line(vformat("if (%s) {", _read(p_condition, Variant::BOOL)));
+	indent++;
+}
+
+void GDScriptNativeCodeGenerator::write_else() {
+	bytecode->write_else();
+
+	indent--;
+	_write_line("} else {");
+	indent++;
+}
+
+void GDScriptNativeCodeGenerator::write_endif() {
+	bytecode->write_endif();
+
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptNativeCodeGenerator::write_jump_if_shared(const Address &p_value) {
+	bytecode->write_jump_if_shared(p_value);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_end_jump_if_shared() {
+	bytecode->write_end_jump_if_shared();
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::start_for(const GDScriptDataType &p_iterator_type, const GDScriptDataType &p_list_type, bool p_is_range) {
+	bytecode->start_for(p_iterator_type, p_list_type, p_is_range);
+
+	// Only `range()` loops, anything else iterates a container.
+	if (!p_is_range) {
+		_unsupported();
+	}
+	ForRange range;
+	range.label = label_count++;
+	for_ranges.push_back(range);
+}
+
+void GDScriptNativeCodeGenerator::write_for_list_assignment(const Address &p_list) {
+	bytecode->write_for_list_assignment(p_list);
+	_unsupported();
+}
+
+void GDScriptNativeCodeGenerator::write_for_range_assignment(const Address &p_from, const Address &p_to, const Address &p_step) {
+	bytecode->write_for_range_assignment(p_from, p_to, p_step);
+
+	ForRange &range = for_ranges.back()->get();
+	range.from = _read(p_from, Variant::INT);
+	range.to = _read(p_to, Variant::INT);
+	range.step = _read(p_step, Variant::INT);
+}
+
+void GDScriptNativeCodeGenerator::write_for(const Address &p_variable, bool p_use_conversion, bool p_is_range) {
+	bytecode->write_for(p_variable, p_use_conversion, p_is_range);
+
+	// Same bounds as `OPCODE_ITERATE_BEGIN_RANGE` and `OPCODE_ITERATE_RANGE`, a zero step doesn't loop.
+	const ForRange &range = for_ranges.back()->get();
+	const String counter = vformat("range_counter_%d", range.label);
+	const String to = vformat("range_to_%d", range.label);
+	const String step = vformat("range_step_%d", range.label);
+	_write_line(vformat("for (int64_t %s = %s, %s = %s, %s = %s; %s > 0 ? %s < %s : (%s < 0 && %s > %s); %s += %s) {", to, range.to, step, range.step, counter, range.from, step, counter, to, step, counter, to, counter, step));
+	indent++;
+	_assign(p_variable, counter, Variant::INT);
+}
+
+void GDScriptNativeCodeGenerator::write_endfor(bool p_is_range) {
+	bytecode->write_endfor(p_is_range);
+
+	indent--;
+	_write_line("}");
+	for_ranges.pop_back();
+}
+
+void GDScriptNativeCodeGenerator::start_while_condition() {
+	bytecode->start_while_condition();
+
+	// The condition is evaluated inside the loop, so `continue` goes back to it.
+	_write_line("for (;;) {");
+	indent++;
+}
+
+void GDScriptNativeCodeGenerator::write_while(const Address &p_condition) {
+	bytecode->write_while(p_condition);
+
+	_write_line(vformat("if (!%s) {", _read(p_condition, Variant::BOOL)));
+	_write_line("\tbreak;");
+	_write_line("}");
+}
+
+void GDScriptNativeCodeGenerator::write_endwhile() {
+	bytecode->write_endwhile();
+
+	indent--;
+	_write_line("}");
+}
+
+void GDScriptNativeCodeGenerator::write_break() {
+	bytecode->write_break();
+	_write_line("break;");
+}
+
+void GDScriptNativeCodeGenerator::write_continue() {
+	bytecode->write_continue();
+	_write_line("continue;");
+}
+
+void GDScriptNativeCodeGenerator::write_breakpoint() {
+	// Native functions are not used while the debugger is active.
+	bytecode->write_breakpoint();
+}
+
+void GDScriptNativeCodeGenerator::write_newline(int p_line) {
+	bytecode->write_newline(p_line);
+	current_line = p_line;
+}
+
+void GDScriptNativeCodeGenerator::write_return(const Address &p_return_value) {
+	bytecode->write_return(p_return_value);
+
+	if (p_return_value.mode != Address::NIL) {
+		if (_get_cpp_type(return_type.builtin_type) == nullptr) {
+			_unsupported();
+			return;
+		}
+		_write_line(vformat("r_ret = %s;", _read(p_return_value, return_type.builtin_type)));
+	}
+	_write_line("return;");
+}
+
+void GDScriptNativeCodeGenerator::write_assert(const Address &p_test, const Address &p_message) {
+	// Not checked natively, like in release builds.
+	bytecode->write_assert(p_test, p_message);
+}
+
+GDScriptNativeCodeGenerator::~GDScriptNativeCodeGenerator() {
+	memdelete(bytecode);
+}
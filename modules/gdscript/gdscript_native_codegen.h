@@ -0,0 +1,209 @@
+/**************************************************************************/
+/*  gdscript_native_codegen.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript_codegen.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/pair.h"
+
+// C++ source for the script functions lowered by `GDScriptNativeCodeGenerator`.
+// Compiled into an export template, it registers the functions with `GDScriptNativeFunctions`.
+class GDScriptNativeCode {
+	friend class GDScriptNativeCodeGenerator;
+
+	String current_path;
+	uint32_t current_source_hash = 0;
+
+	Vector<String> definitions;
+	Vector<String> registrations;
+
+	void add_function(const String &p_fqcn, const StringName &p_name, const String &p_body);
+
+public:
+	// Compiles the script a second time, with every function that can be lowered also written as C++.
+	// The compiled script is discarded, `p_source_hash` must match what the script will hash to when exported.
+	Error add_script(const String &p_path, const String &p_source, uint32_t p_source_hash);
+
+	int get_function_count() const { return registrations.size(); }
+	String get_source() const;
+};
+
+// Writes the bytecode for a function like `GDScriptByteCodeGenerator` (which it wraps), and if the function only
+// uses `int`, `float` and `bool` values also lowers it to C++.
+// Anything that cannot be lowered (untyped values, objects, calls to script or engine methods, coroutines...)
+// leaves the function to the bytecode.
+class GDScriptNativeCodeGenerator : public GDScriptCodeGenerator {
+	GDScriptCodeGenerator *bytecode = nullptr;
+	GDScriptNativeCode *native_code = nullptr;
+
+	bool lowerable = true;
+	String fqcn;
+	StringName function_name;
+	GDScriptDataType return_type;
+	int current_line = 0;
+
+	Vector<Pair<uint32_t, Variant::Type>> parameters;
+	HashMap<uint32_t, Variant> constants;
+	HashMap<String, Variant::Type> variables;
+
+	Vector<String> lines;
+	int indent = 1;
+	int label_count = 0;
+
+	List<int> logic_labels;
+	List<Address> ternary_targets;
+	struct ForRange {
+		int label = 0;
+		String from;
+		String to;
+		String step;
+	};
+	List<ForRange> for_ranges;
+
+	static const char *_get_cpp_type(Variant::Type p_type);
+	static bool _is_lowerable(const GDScriptDataType &p_type);
+	static String _get_literal(const Variant &p_value);
+	static String _get_default_literal(Variant::Type p_type);
+	static String _convert(const String &p_expression, Variant::Type p_from, Variant::Type p_to);
+
+	void _unsupported();
+	void _write_line(const String &p_line);
+	String _get_variable(const Address &p_address);
+	Variant::Type _get_type(const Address &p_address) const;
+	String _read(const Address &p_address, Variant::Type p_as = Variant::NIL);
+	void _assign(const Address &p_target, const String &p_expression, Variant::Type p_type);
+	void _write_error_check(const String &p_condition, const String &p_error);
+
+public:
+	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
+	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
+	virtual uint32_t add_local_constant(const StringName &p_name, const Variant &p_constant) override;
+	virtual uint32_t add_or_get_constant(const Variant &p_constant) override;
+	virtual uint32_t add_or_get_name(const StringName &p_name) override;
+	virtual uint32_t add_temporary(const GDScriptDataType &p_type) override;
+	virtual void pop_temporary() override;
+	virtual void clear_temporaries() override;
+	virtual void clear_address(const Address &p_address) override;
+	virtual bool is_local_dirty(const Address &p_address) const override;
+
+	virtual void start_parameters() override;
+	virtual void end_parameters() override;
+
+	virtual void start_block() override;
+	virtual void end_block() override;
+
+	virtual void write_start(GDScript *p_script, const StringName &p_function_name, bool p_static, Variant p_rpc_config, const GDScriptDataType &p_return_type) override;
+	virtual GDScriptFunction *write_end() override;
+
+#ifdef DEBUG_ENABLED
+	virtual void set_signature(const String &p_signature) override;
+#endif
+	virtual void set_initial_line(int p_line) override;
+
+	virtual void write_type_adjust(const Address &p_target, Variant::Type p_new_type) override;
+	virtual void write_unary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand) override;
+	virtual void write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) override;
+	virtual void write_type_test(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) override;
+	virtual void write_and_left_operand(const Address &p_left_operand) override;
+	virtual void write_and_right_operand(const Address &p_right_operand) override;
+	virtual void write_end_and(const Address &p_target) override;
+	virtual void write_or_left_operand(const Address &p_left_operand) override;
+	virtual void write_or_right_operand(const Address &p_right_operand) override;
+	virtual void write_end_or(const Address &p_target) override;
+	virtual void write_start_ternary(const Address &p_target) override;
+	virtual void write_ternary_condition(const Address &p_condition) override;
+	virtual void write_ternary_true_expr(const Address &p_expr) override;
+	virtual void write_ternary_false_expr(const Address &p_expr) override;
+	virtual void write_end_ternary() override;
+	virtual void write_set(const Address &p_target, const Address &p_index, const Address &p_source) override;
+	virtual void write_get(const Address &p_target, const Address &p_index, const Address &p_source) override;
+	virtual void write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) override;
+	virtual void write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) override;
+	virtual void write_set_member(const Address &p_value, const StringName &p_name) override;
+	virtual void write_get_member(const Address &p_target, const StringName &p_name) override;
+	virtual void write_set_static_variable(const Address &p_value, const Address &p_class, int p_index) override;
+	virtual void write_get_static_variable(const Address &p_target, const Address &p_class, int p_index) override;
+	virtual void write_assign(const Address &p_target, const Address &p_source) override;
+	virtual void write_assign_with_conversion(const Address &p_target, const Address &p_source) override;
+	virtual void write_assign_null(const Address &p_target) override;
+	virtual void write_assign_true(const Address &p_target) override;
+	virtual void write_assign_false(const Address &p_target) override;
+	virtual void write_assign_default_parameter(const Address &p_dst, const Address &p_src, bool p_use_conversion) override;
+	virtual void write_store_global(const Address &p_dst, int p_global_index) override;
+	virtual void write_store_named_global(const Address &p_dst, const StringName &p_global) override;
+	virtual void write_cast(const Address &p_target, const Address &p_source, const GDScriptDataType &p_type) override;
+	virtual void write_call(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_super_call(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_call_async(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_call_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) override;
+	virtual void write_call_gdscript_utility(const Address &p_target, const StringName &p_function, const Vector<Address> &p_arguments) override;
+	virtual void write_call_builtin_type(const Address &p_target, const Address &p_base, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_builtin_type_static(const Address &p_target, Variant::Type p_type, const StringName &p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_native_static(const Address &p_target, const StringName &p_class, const StringName &p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_native_static_validated(const Address &p_target, MethodBind *p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_method_bind(const Address &p_target, const Address &p_base, MethodBind *p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_method_bind_validated(const Address &p_target, const Address &p_base, MethodBind *p_method, const Vector<Address> &p_arguments) override;
+	virtual void write_call_self(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_call_self_async(const Address &p_target, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_call_script_function(const Address &p_target, const Address &p_base, const StringName &p_function_name, const Vector<Address> &p_arguments) override;
+	virtual void write_lambda(const Address &p_target, GDScriptFunction *p_function, const Vector<Address> &p_captures, bool p_use_self) override;
+	virtual void write_construct(const Address &p_target, Variant::Type p_type, const Vector<Address> &p_arguments) override;
+	virtual void write_construct_array(const Address &p_target, const Vector<Address> &p_arguments) override;
+	virtual void write_construct_typed_array(const Address &p_target, const GDScriptDataType &p_element_type, const Vector<Address> &p_arguments) override;
+	virtual void write_construct_dictionary(const Address &p_target, const Vector<Address> &p_arguments) override;
+	virtual void write_construct_typed_dictionary(const Address &p_target, const GDScriptDataType &p_key_type, const GDScriptDataType &p_value_type, const Vector<Address> &p_arguments) override;
+	virtual void write_await(const Address &p_target, const Address &p_operand) override;
+	virtual void write_if(const Address &p_condition) override;
+	virtual void write_else() override;
+	virtual void write_endif() override;
+	virtual void write_jump_if_shared(const Address &p_value) override;
+	virtual void write_end_jump_if_shared() override;
+	virtual void start_for(const GDScriptDataType &p_iterator_type, const GDScriptDataType &p_list_type, bool p_is_range) override;
+	virtual void write_for_list_assignment(const Address &p_list) override;
+	virtual void write_for_range_assignment(const Address &p_from, const Address &p_to, const Address &p_step) override;
+	virtual void write_for(const Address &p_variable, bool p_use_conversion, bool p_is_range) override;
+	virtual void write_endfor(bool p_is_range) override;
+	virtual void start_while_condition() override;
+	virtual void write_while(const Address &p_condition) override;
+	virtual void write_endwhile() override;
+	virtual void write_break() override;
+	virtual void write_continue() override;
+	virtual void write_breakpoint() override;
+	virtual void write_newline(int p_line) override;
+	virtual void write_return(const Address &p_return_value) override;
+	virtual void write_assert(const Address &p_test, const Address &p_message) override;
+
+	GDScriptNativeCodeGenerator(GDScriptCodeGenerator *p_bytecode, GDScriptNativeCode *p_native_code) :
+			bytecode(p_bytecode), native_code(p_native_code) {}
+	virtual ~GDScriptNativeCodeGenerator();
+};
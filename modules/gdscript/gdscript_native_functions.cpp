@@ -0,0 +1,63 @@
+/**************************************************************************/
+/*  gdscript_native_functions.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_functions.h"
+
+HashMap<String, GDScriptNativeFunctions::Entry> GDScriptNativeFunctions::functions;
+
+void GDScriptNativeFunctions::register_function(const String &p_fqcn, const StringName &p_name, uint32_t p_source_hash, Function p_function) {
+	ERR_FAIL_NULL(p_function);
+
+	Entry entry;
+	entry.source_hash = p_source_hash;
+	entry.function = p_function;
+	functions[p_fqcn + "." + p_name] = entry;
+}
+
+GDScriptNativeFunctions::Function GDScriptNativeFunctions::get_function(const String &p_fqcn, const StringName &p_name, uint32_t p_source_hash) {
+	const Entry *entry = functions.getptr(p_fqcn + "." + p_name);
+	if (!entry) {
+		return nullptr;
+	}
+
+	// Lowered from a different version of the script, the bytecode has to be used.
+	if (entry->source_hash != p_source_hash) {
+		return nullptr;
+	}
+	return entry->function;
+}
+
+void GDScriptNativeFunctions::clear() {
+	functions.clear();
+}
+
+void GDScriptNativeFunctions::runtime_error(const char *p_function, const char *p_file, int p_line, const char *p_error) {
+	_err_print_error(p_function, p_file, p_line, p_error, false, ERR_HANDLER_SCRIPT);
+}
@@ -0,0 +1,61 @@
+/**************************************************************************/
+/*  gdscript_native_functions.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+// Registry of script functions lowered to C++ by `GDScriptNativeCodeGenerator` and compiled into the engine.
+// `GDScript` looks them up after compiling, and `GDScriptFunction::call()` runs them instead of the bytecode
+// when the arguments have the exact types they were lowered for.
+class GDScriptNativeFunctions {
+public:
+	// Arguments are already checked against the function signature.
+	typedef void (*Function)(const Variant **p_args, Variant &r_ret);
+
+private:
+	struct Entry {
+		uint32_t source_hash = 0;
+		Function function = nullptr;
+	};
+
+	static HashMap<String, Entry> functions;
+
+public:
+	static void register_function(const String &p_fqcn, const StringName &p_name, uint32_t p_source_hash, Function p_function);
+	static Function get_function(const String &p_fqcn, const StringName &p_name, uint32_t p_source_hash);
+	_FORCE_INLINE_ static bool has_functions() { return !functions.is_empty(); }
+	static void clear();
+
+	static void runtime_error(const char *p_function, const char *p_file, int p_line, const char *p_error);
+};
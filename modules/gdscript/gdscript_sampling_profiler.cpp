@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::tick;
+thread_local uint32_t GDScriptSamplingProfiler::thread_tick = 0;
+
+SafeFlag GDScriptSamplingProfiler::running;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::start_tick;
+uint32_t GDScriptSamplingProfiler::interval_usec = 1000;
+Thread GDScriptSamplingProfiler::thread;
+
+Mutex GDScriptSamplingProfiler::mutex;
+HashMap<String, uint64_t> GDScriptSamplingProfiler::folded_stacks;
+uint64_t GDScriptSamplingProfiler::sample_count = 0;
+String GDScriptSamplingProfiler::output_path;
+
+void GDScriptSamplingProfiler::_thread_func(void *p_userdata) {
+	while (running.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		tick.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::_record_sample(uint32_t p_tick) {
+	// Every tick since the last safepoint belongs to the current stack, but not
+	// the ones from before the profiler was started.
+	const uint32_t weight = MIN(p_tick - thread_tick, p_tick - start_tick.get());
+	thread_tick = p_tick;
+	if (weight == 0 || !running.is_set()) {
+		return;
+	}
+
+	LocalVector<String> frames;
+	for (GDScriptLanguage::CallLevel *level = GDScriptLanguage::_call_stack; level; level = level->prev) {
+		if (!level->function) {
+			continue;
+		}
+		const String path = level->function->get_script() ? level->function->get_script()->get_script_path() : String();
+		const String name = level->function->get_name();
+		frames.push_back(path.is_empty() ? name : path + ":" + name);
+	}
+	if (frames.is_empty()) {
+		return;
+	}
+
+	// Folded stacks go from the outermost frame to the innermost one.
+	String stack = frames[frames.size() - 1];
+	for (int i = int(frames.size()) - 2; i >= 0; i--) {
+		stack += ";" + frames[i];
+	}
+
+	MutexLock lock(mutex);
+	HashMap<String, uint64_t>::Iterator E = folded_stacks.find(stack);
+	if (E) {
+		E->value += weight;
+	} else {
+		folded_stacks.insert(stack, weight);
+	}
+	sample_count += weight;
+}
+
+void GDScriptSamplingProfiler::start(uint32_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(running.is_set(), "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND_MSG(!GDScriptLanguage::get_singleton()->should_track_call_stack(), "The GDScript sampling profiler needs call stacks to be tracked. Enable \"debug/settings/gdscript/always_track_call_stacks\" in release builds.");
+
+	interval_usec = MAX(p_interval_usec, 1u);
+	start_tick.set(tick.get());
+	running.set();
+	thread.start(_thread_func, nullptr);
+}
+
+void GDScriptSamplingProfiler::request_sample() {
+	tick.increment();
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+	running.clear();
+	thread.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	folded_stacks.clear();
+	sample_count = 0;
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+String GDScriptSamplingProfiler::get_folded_stacks() {
+	LocalVector<String> lines;
+	{
+		MutexLock lock(mutex);
+		lines.reserve(folded_stacks.size());
+		for (const KeyValue<String, uint64_t> &E : folded_stacks) {
+			lines.push_back(E.key + " " + itos(E.value));
+		}
+	}
+	lines.sort();
+
+	String text;
+	for (const String &line : lines) {
+		text += line + "\n";
+	}
+	return text;
+}
+
+Error GDScriptSamplingProfiler::save(const String &p_path) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Cannot write GDScript sampling profile to \"%s\".", p_path));
+	file->store_string(get_folded_stacks());
+	return OK;
+}
+
+void GDScriptSamplingProfiler::handle_cmdline() {
+	List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+
+	for (List<String>::Element *E = cmdline_args.front(); E; E = E->next()) {
+		if (E->get() == "--gdscript-sample-profile" && E->next()) {
+			output_path = E->next()->get();
+		} else if (E->get() == "--gdscript-sample-interval" && E->next()) {
+			const String interval = E->next()->get();
+			const int64_t value = interval.to_int();
+			if (!interval.is_valid_int() || value <= 0 || value > UINT32_MAX) {
+				ERR_PRINT(vformat("Invalid GDScript sampling interval \"%s\", expected a positive number of microseconds. Using %d instead.", interval, interval_usec));
+			} else {
+				interval_usec = value;
+			}
+		}
+	}
+
+	if (output_path.is_empty() || running.is_set()) {
+		return;
+	}
+
+	// No script is running yet, so call stacks can start being tracked in any build.
+	GDScriptLanguage::get_singleton()->track_call_stack = true;
+	start(interval_usec);
+}
+
+void GDScriptSamplingProfiler::finish() {
+	stop();
+
+	if (!output_path.is_empty()) {
+		if (save(output_path) == OK) {
+			print_line(vformat("GDScript sampling profile with %d samples written to \"%s\".", get_sample_count(), output_path));
+		}
+		output_path = String();
+	}
+	clear();
+}
@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+// Statistical profiler for GDScript, aggregating call stacks into folded stacks
+// (one `outer;inner count` line per stack) as read by flamegraph tools.
+//
+// Unlike the instrumented profiler of `GDScriptFunction`, nothing is timed per call:
+// a separate thread advances a tick counter at a fixed interval, and threads running
+// script code record their own call stack at the next safepoint (function entry,
+// function exit or line marker) once they notice a new tick. Stacks are never read
+// from another thread, and samples are attributed to the nearest safepoint.
+//
+// Can be started from the command line with `--gdscript-sample-profile <path>` and
+// `--gdscript-sample-interval <usec>`, the folded stacks are written on exit.
+class GDScriptSamplingProfiler {
+	static SafeNumeric<uint32_t> tick;
+	static thread_local uint32_t thread_tick;
+
+	static SafeFlag running;
+	static SafeNumeric<uint32_t> start_tick;
+	static uint32_t interval_usec;
+	static Thread thread;
+
+	static Mutex mutex;
+	static HashMap<String, uint64_t> folded_stacks;
+	static uint64_t sample_count;
+	static String output_path;
+
+	static void _thread_func(void *p_userdata);
+	static void _record_sample(uint32_t p_tick);
+
+public:
+	// Called at safepoints with the call stack of the current thread up to date.
+	_FORCE_INLINE_ static void poll() {
+		const uint32_t current_tick = tick.get();
+		if (unlikely(current_tick != thread_tick)) {
+			_record_sample(current_tick);
+		}
+	}
+
+	// Called when a thread starts running script code, ticks until then were spent elsewhere.
+	_FORCE_INLINE_ static void skip() {
+		thread_tick = tick.get();
+	}
+
+	static void start(uint32_t p_interval_usec = 1000);
+	// Same as a tick of the interval: running threads record their stack at their next safepoint.
+	static void request_sample();
+	static void stop();
+	static bool is_running() { return running.is_set(); }
+
+	static void clear();
+	static uint64_t get_sample_count();
+	static String get_folded_stacks();
+	static Error save(const String &p_path);
+
+	static void handle_cmdline();
+	static void finish();
+};
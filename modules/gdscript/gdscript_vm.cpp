@@ -254,6 +254,33 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_ADD_INT,                                \
+		&&OPCODE_SUBTRACT_INT,                           \
+		&&OPCODE_MULTIPLY_INT,                           \
+		&&OPCODE_EQUAL_INT,                              \
+		&&OPCODE_NOT_EQUAL_INT,                          \
+		&&OPCODE_LESS_INT,                               \
+		&&OPCODE_LESS_EQUAL_INT,                         \
+		&&OPCODE_GREATER_INT,                            \
+		&&OPCODE_GREATER_EQUAL_INT,                      \
+		&&OPCODE_ADD_FLOAT,                              \
+		&&OPCODE_SUBTRACT_FLOAT,                         \
+		&&OPCODE_MULTIPLY_FLOAT,                         \
+		&&OPCODE_DIVIDE_FLOAT,                           \
+		&&OPCODE_EQUAL_FLOAT,                            \
+		&&OPCODE_NOT_EQUAL_FLOAT,                        \
+		&&OPCODE_LESS_FLOAT,                             \
+		&&OPCODE_LESS_EQUAL_FLOAT,                       \
+		&&OPCODE_GREATER_FLOAT,                          \
+		&&OPCODE_GREATER_EQUAL_FLOAT,                    \
+		&&OPCODE_ADD_VECTOR2,                            \
+		&&OPCODE_SUBTRACT_VECTOR2,                       \
+		&&OPCODE_MULTIPLY_VECTOR2,                       \
+		&&OPCODE_MULTIPLY_VECTOR2_FLOAT,                 \
+		&&OPCODE_ADD_VECTOR3,                            \
+		&&OPCODE_SUBTRACT_VECTOR3,                       \
+		&&OPCODE_MULTIPLY_VECTOR3,                       \
+		&&OPCODE_MULTIPLY_VECTOR3_FLOAT,                 \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -314,6 +341,18 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP,                                   \
 		&&OPCODE_JUMP_IF,                                \
 		&&OPCODE_JUMP_IF_NOT,                            \
+		&&OPCODE_JUMP_UNLESS_EQUAL_INT,                  \
+		&&OPCODE_JUMP_UNLESS_NOT_EQUAL_INT,              \
+		&&OPCODE_JUMP_UNLESS_LESS_INT,                   \
+		&&OPCODE_JUMP_UNLESS_LESS_EQUAL_INT,             \
+		&&OPCODE_JUMP_UNLESS_GREATER_INT,                \
+		&&OPCODE_JUMP_UNLESS_GREATER_EQUAL_INT,          \
+		&&OPCODE_JUMP_UNLESS_EQUAL_FLOAT,                \
+		&&OPCODE_JUMP_UNLESS_NOT_EQUAL_FLOAT,            \
+		&&OPCODE_JUMP_UNLESS_LESS_FLOAT,                 \
+		&&OPCODE_JUMP_UNLESS_LESS_EQUAL_FLOAT,           \
+		&&OPCODE_JUMP_UNLESS_GREATER_FLOAT,              \
+		&&OPCODE_JUMP_UNLESS_GREATER_EQUAL_FLOAT,        \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
 		&&OPCODE_JUMP_IF_SHARED,                         \
 		&&OPCODE_RETURN,                                 \
@@ -494,6 +533,23 @@ void (*type_init_function_table[])(Variant *) = {
 #define METHOD_CALL_ON_NULL_VALUE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a null value."
 #define METHOD_CALL_ON_FREED_INSTANCE_ERROR(method_pointer) "Cannot call method '" + (method_pointer)->get_name() + "' on a previously freed instance."
 
+_FORCE_INLINE_ bool GDScriptFunction::_can_call_native(const Variant **p_args, int p_argcount) const {
+	// Breakpoints, stepping and profiling need the bytecode.
+	if (EngineDebugger::is_active()) {
+		return false;
+	}
+	// Conversions and errors for the arguments are left to the bytecode too.
+	if (p_argcount != _argument_count) {
+		return false;
+	}
+	for (int i = 0; i < p_argcount; i++) {
+		if (p_args[i]->get_type() != argument_types[i].builtin_type) {
+			return false;
+		}
+	}
+	return true;
+}
+
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	OPCODES_TABLE;
 
@@ -528,6 +584,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		return _get_default_variant_for_data_type(return_type);
 	}
 
+	if (native_function != nullptr && p_state == nullptr && _can_call_native(p_args, p_argcount)) {
+		// Counted and pushed on the call stack like bytecode calls, for the overflow check,
+		// error reports and the sampling profiler. There is no Variant stack to inspect.
+		int native_ip = 0;
+		int native_line = _initial_line;
+		GDScriptLanguage::CallLevel call_level;
+		GDScriptLanguage::get_singleton()->enter_function(&call_level, p_instance, this, nullptr, &native_ip, &native_line);
+		Variant ret;
+		native_function(p_args, ret);
+		GDScriptLanguage::get_singleton()->exit_function();
+		call_depth--;
+		return ret;
+	}
+
 	Variant retvalue;
 	Variant *stack = nullptr;
 	Variant **instruction_args = nullptr;
@@ -540,11 +610,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->stack_alloc_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -849,6 +919,45 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_TYPED_OPERATOR(m_name, m_left, m_op, m_right, m_ret)                                                              \
+	OPCODE(OPCODE_##m_name) {                                                                                                    \
+		CHECK_SPACE(4);                                                                                                          \
+		GET_VARIANT_PTR(a, 0);                                                                                                   \
+		GET_VARIANT_PTR(b, 1);                                                                                                   \
+		GET_VARIANT_PTR(dst, 2);                                                                                                 \
+		*VariantInternal::OP_GET_##m_ret(dst) = *VariantInternal::OP_GET_##m_left(a) m_op *VariantInternal::OP_GET_##m_right(b); \
+		ip += 4;                                                                                                                 \
+	}                                                                                                                            \
+	DISPATCH_OPCODE
+
+			OPCODE_TYPED_OPERATOR(ADD_INT, INT, +, INT, INT);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_INT, INT, -, INT, INT);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_INT, INT, *, INT, INT);
+			OPCODE_TYPED_OPERATOR(EQUAL_INT, INT, ==, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(NOT_EQUAL_INT, INT, !=, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(LESS_INT, INT, <, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(LESS_EQUAL_INT, INT, <=, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(GREATER_INT, INT, >, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(GREATER_EQUAL_INT, INT, >=, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(ADD_FLOAT, FLOAT, +, FLOAT, FLOAT);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_FLOAT, FLOAT, -, FLOAT, FLOAT);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_FLOAT, FLOAT, *, FLOAT, FLOAT);
+			OPCODE_TYPED_OPERATOR(DIVIDE_FLOAT, FLOAT, /, FLOAT, FLOAT);
+			OPCODE_TYPED_OPERATOR(EQUAL_FLOAT, FLOAT, ==, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(NOT_EQUAL_FLOAT, FLOAT, !=, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(LESS_FLOAT, FLOAT, <, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(LESS_EQUAL_FLOAT, FLOAT, <=, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(GREATER_FLOAT, FLOAT, >, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(GREATER_EQUAL_FLOAT, FLOAT, >=, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(ADD_VECTOR2, VECTOR2, +, VECTOR2, VECTOR2);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_VECTOR2, VECTOR2, -, VECTOR2, VECTOR2);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR2, VECTOR2, *, VECTOR2, VECTOR2);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR2_FLOAT, VECTOR2, *, FLOAT, VECTOR2);
+			OPCODE_TYPED_OPERATOR(ADD_VECTOR3, VECTOR3, +, VECTOR3, VECTOR3);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_VECTOR3, VECTOR3, -, VECTOR3, VECTOR3);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR3, VECTOR3, *, VECTOR3, VECTOR3);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR3_FLOAT, VECTOR3, *, FLOAT, VECTOR3);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1193,7 +1302,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1203,8 +1312,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (dst->get_type() == Variant::OBJECT) {
+					_set_named_cached(inline_caches[cache_idx], dst, *index, *value, valid);
+				} else {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1225,7 +1341,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1245,7 +1361,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1255,22 +1371,25 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				bool valid;
-#ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
-
-#else
-				*dst = src->get_named(*index, valid);
-#endif
+				Variant ret;
+				if (src->get_type() == Variant::OBJECT) {
+					_get_named_cached(inline_caches[cache_idx], src, *index, ret, valid);
+				} else {
+					ret = src->get_named(*index, valid);
+				}
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
 					OPCODE_BREAK;
 				}
-				*dst = ret;
 #endif
-				ip += 4;
+				*dst = ret;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1889,7 +2008,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1900,6 +2019,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				InlineCache &inline_cache = inline_caches[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1918,7 +2041,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (base->get_type() == Variant::OBJECT) {
+						_call_cached(inline_cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					} else {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1947,6 +2074,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
+				} else if (base->get_type() == Variant::OBJECT) {
+					_call_cached(inline_cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				} else {
 					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
@@ -2003,7 +2132,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2549,7 +2678,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						// Is this even possible to be null at this point?
 						if (obj) {
 							if (obj->is_class_ptr(GDScriptFunctionState::get_class_ptr_static())) {
-								result = Signal(obj, SNAME("completed"));
+								const GDScriptFunctionState *awaited_state = static_cast<GDScriptFunctionState *>(obj);
+								if (awaited_state->finished) {
+									// Already returned, `completed` won't be emitted again.
+									result = awaited_state->finished_result;
+								} else {
+									result = Signal(obj, SNAME("completed"));
+								}
 							}
 						}
 					}
@@ -2569,11 +2704,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
+					gdfs->state.stack = GDScriptFunctionState::_alloc_frame(alloca_size);
+					gdfs->state.stack_alloc_size = alloca_size;
 
 					// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
+					Variant *frame = (Variant *)gdfs->state.stack;
 					for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+						memnew_placement(&frame[i], Variant(stack[i]));
 					}
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.ip = ip + 2;
@@ -2605,7 +2742,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					Error err = sig.connect(Callable(memnew(GDScriptFunctionStateCallable(gdfs))), Object::CONNECT_ONE_SHOT);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
@@ -2743,6 +2880,34 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_JUMP_UNLESS(m_name, m_type, m_op)                                                 \
+	OPCODE(OPCODE_JUMP_UNLESS_##m_name) {                                                        \
+		CHECK_SPACE(4);                                                                          \
+		GET_VARIANT_PTR(a, 0);                                                                   \
+		GET_VARIANT_PTR(b, 1);                                                                   \
+		if (!(*VariantInternal::OP_GET_##m_type(a) m_op *VariantInternal::OP_GET_##m_type(b))) { \
+			int to = _code_ptr[ip + 3];                                                          \
+			GD_ERR_BREAK(to < 0 || to > _code_size);                                             \
+			ip = to;                                                                             \
+		} else {                                                                                 \
+			ip += 4;                                                                             \
+		}                                                                                        \
+	}                                                                                            \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_UNLESS(EQUAL_INT, INT, ==);
+			OPCODE_JUMP_UNLESS(NOT_EQUAL_INT, INT, !=);
+			OPCODE_JUMP_UNLESS(LESS_INT, INT, <);
+			OPCODE_JUMP_UNLESS(LESS_EQUAL_INT, INT, <=);
+			OPCODE_JUMP_UNLESS(GREATER_INT, INT, >);
+			OPCODE_JUMP_UNLESS(GREATER_EQUAL_INT, INT, >=);
+			OPCODE_JUMP_UNLESS(EQUAL_FLOAT, FLOAT, ==);
+			OPCODE_JUMP_UNLESS(NOT_EQUAL_FLOAT, FLOAT, !=);
+			OPCODE_JUMP_UNLESS(LESS_FLOAT, FLOAT, <);
+			OPCODE_JUMP_UNLESS(LESS_EQUAL_FLOAT, FLOAT, <=);
+			OPCODE_JUMP_UNLESS(GREATER_FLOAT, FLOAT, >);
+			OPCODE_JUMP_UNLESS(GREATER_EQUAL_FLOAT, FLOAT, >=);
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -3878,6 +4043,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				GDScriptSamplingProfiler::poll();
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3991,6 +4158,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	if (p_state && !awaited) {
 		// This means we have finished executing a resumed function and it was not awaited again.
 
+		GDScriptFunctionState *first_state = Object::cast_to<GDScriptFunctionState>(p_state->completed.get_object());
+		if (first_state) {
+			first_state->_set_finished(retvalue);
+		}
+
 		// Signal the next function-state to resume.
 		const Variant *args[1] = { &retvalue };
 		p_state->completed.emit(args, 1);
@@ -32,11 +32,14 @@
 
 #include "gdscript.h"
 #include "gdscript_cache.h"
+#include "gdscript_native_functions.h"
 #include "gdscript_parser.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
 #ifdef TOOLS_ENABLED
+#include "gdscript_native_codegen.h"
+
 #include "editor/gdscript_highlighter.h"
 #include "editor/gdscript_translation_parser_plugin.h"
 
@@ -66,6 +69,11 @@
 #include "tests/test_macros.h"
 #endif
 
+#ifdef GDSCRIPT_NATIVE_CODE
+// Defined in the source generated on export, see `GDScriptNativeCode`.
+void register_gdscript_native_functions();
+#endif
+
 GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
@@ -81,18 +89,29 @@ class EditorExportGDScript : public EditorExportPlugin {
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
 
+	// Functions lowered to C++, to be compiled into the export template with `gdscript_native_code=<path>`.
+	String native_code_path;
+	GDScriptNativeCode native_code;
+
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_code_path", PROPERTY_HINT_GLOBAL_SAVE_FILE, "*.cpp"), ""));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		native_code_path = String();
+		native_code = GDScriptNativeCode();
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			native_code_path = get_option("gdscript/native_code_path");
 		}
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+		if (p_path.get_extension() != "gd" || (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT && native_code_path.is_empty())) {
 			return;
 		}
 
@@ -102,13 +121,34 @@ protected:
 		}
 
 		String source = String::utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
-		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
-		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
-		if (file.is_empty()) {
+		if (script_mode != EditorExportPreset::MODE_SCRIPT_TEXT) {
+			GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
+			file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
+			if (file.is_empty()) {
+				return;
+			}
+
+			add_file(p_path.get_basename() + ".gdc", file, true);
+		}
+
+		if (!native_code_path.is_empty()) {
+			// Same hash the exported script will have when loaded.
+			uint32_t source_hash = script_mode == EditorExportPreset::MODE_SCRIPT_TEXT ? source.hash() : hash_djb2_buffer(file.ptr(), file.size());
+			if (native_code.add_script(p_path, source, source_hash) != OK) {
+				WARN_PRINT(vformat("Could not lower the functions of \"%s\" to C++, they will run as bytecode.", p_path));
+			}
+		}
+	}
+
+	virtual void _export_end() override {
+		if (native_code_path.is_empty()) {
 			return;
 		}
 
-		add_file(p_path.get_basename() + ".gdc", file, true);
+		Ref<FileAccess> f = FileAccess::open(native_code_path, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), vformat("Cannot write the GDScript native code to \"%s\".", native_code_path));
+		f->store_string(native_code.get_source());
+		print_verbose(vformat("GDScript: Lowered %d functions to C++ in \"%s\".", native_code.get_function_count(), native_code_path));
 	}
 
 public:
@@ -152,6 +192,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+#ifdef GDSCRIPT_NATIVE_CODE
+		register_gdscript_native_functions();
+#endif
 	}
 
 #ifdef TOOLS_ENABLED
@@ -186,6 +230,7 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		GDScriptParser::cleanup();
 		GDScriptUtilityFunctions::unregister_functions();
+		GDScriptNativeFunctions::clear();
 	}
 
 #ifdef TOOLS_ENABLED
@@ -0,0 +1,430 @@
+/**************************************************************************/
+/*  benchmark_gdscript.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef BENCHMARKS_ENABLED
+
+#include "../gdscript.h"
+
+#include "tests/benchmarks/benchmark.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptBenchmarks {
+
+static const char *benchmark_source = R"(
+extends RefCounted
+
+signal tick(value)
+
+var points_transform := Transform3D(Basis(Vector3.UP, 0.5), Vector3(1, 2, 3))
+
+func fibonacci(n: int) -> int:
+	if n < 2:
+		return n
+	return fibonacci(n - 1) + fibonacci(n - 2)
+
+func typed_sum(count: int) -> int:
+	var total := 0
+	for i in count:
+		total += i
+	return total
+
+func untyped_sum(count):
+	var total = 0
+	for i in range(count):
+		total += i
+	return total
+
+func array_append(count: int) -> int:
+	var array := []
+	for i in count:
+		array.append(i * 2)
+	return array.size()
+
+func vector_math(count: int) -> Vector3:
+	var v := Vector3.ZERO
+	for i in count:
+		v += Vector3(i, 1, 2) * 0.5
+	return v
+
+func typed_while_compare(count: int) -> int:
+	var hits := 0
+	var i := 0
+	while i < count:
+		if i * 3 > count:
+			hits += 1
+		i += 1
+	return hits
+
+func untyped_while_compare(count):
+	var hits = 0
+	var i = 0
+	while i < count:
+		if i * 3 > count:
+			hits += 1
+		i += 1
+	return hits
+
+func typed_float_math(count: int) -> float:
+	var x := 0.0
+	var step := 0.25
+	var total := 0.0
+	for _i in count:
+		x = x * 0.5 + step
+		if x >= 0.4:
+			total += x - step
+	return total
+
+func untyped_float_math(count):
+	var x = 0.0
+	var step = 0.25
+	var total = 0.0
+	for _i in count:
+		x = x * 0.5 + step
+		if x >= 0.4:
+			total += x - step
+	return total
+
+func typed_vector2_math(count: int) -> Vector2:
+	var position := Vector2.ZERO
+	var velocity := Vector2(1.0, 0.5)
+	var delta := 0.016
+	for _i in count:
+		position = position + velocity * delta
+		velocity = velocity * 0.999
+	return position
+
+func untyped_vector2_math(count):
+	var position = Vector2.ZERO
+	var velocity = Vector2(1.0, 0.5)
+	var delta = 0.016
+	for _i in count:
+		position = position + velocity * delta
+		velocity = velocity * 0.999
+	return position
+
+func packed_remap_loop(values: PackedFloat32Array) -> float:
+	for i in values.size():
+		values[i] = values[i] * 2.0 - 1.0
+	var total := 0.0
+	for value in values:
+		total += value
+	return total
+
+func packed_remap_bulk(values: PackedFloat32Array) -> float:
+	values.multiply_add_scalar(2.0, -1.0)
+	return values.sum()
+
+func packed_transform_loop(points: PackedVector3Array) -> PackedVector3Array:
+	for i in points.size():
+		points[i] = points_transform * points[i]
+	return points
+
+func packed_transform_bulk(points: PackedVector3Array) -> PackedVector3Array:
+	points.transform(points_transform)
+	return points
+
+class Walker:
+	var speed = 1.0
+
+	func step(delta):
+		return speed * delta
+
+class Runner:
+	var speed = 2.0
+
+	func step(delta):
+		return speed + delta
+
+func duck_typed_calls(count):
+	var movers = [Walker.new(), Walker.new()]
+	var total = 0.0
+	for i in count:
+		total += movers[i & 1].step(0.5)
+	return total
+
+func duck_typed_calls_polymorphic(count):
+	var movers = [Walker.new(), Runner.new()]
+	var total = 0.0
+	for i in count:
+		total += movers[i & 1].step(0.5)
+	return total
+
+func duck_typed_members(count):
+	var mover = [Walker.new()][0]
+	for i in count:
+		mover.speed = mover.speed + 1.0
+	return mover.speed
+
+func await_signal(count: int) -> int:
+	var total := 0
+	for _i in count:
+		total += await tick
+	return total
+
+func await_finished(coroutine, count: int) -> int:
+	var total := 0
+	for _i in count:
+		total += await coroutine
+	return total
+
+func await_value(count: int) -> int:
+	var total := 0
+	for i in count:
+		total += await i
+	return total
+
+func duck_typed_native_properties(count):
+	var resource = [Resource.new()][0]
+	var total = 0
+	for i in count:
+		resource.resource_local_to_scene = not resource.resource_local_to_scene
+		total += int(resource.resource_local_to_scene)
+	return total
+)";
+
+static Ref<GDScript> _compile_benchmark_script() {
+	static bool language_initialized = false;
+	if (!language_initialized) {
+		GDScriptLanguage::get_singleton()->init();
+		language_initialized = true;
+	}
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(benchmark_source);
+	// Silence the spurious `Condition "err" is true` message printed by a successful reload.
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	return err == OK ? script : Ref<GDScript>();
+}
+
+static Ref<RefCounted> _instantiate_benchmark_script(BenchmarkState &p_state) {
+	Ref<GDScript> script = _compile_benchmark_script();
+	if (script.is_null()) {
+		p_state.skip_with_error("Failed to compile the benchmark script.");
+		return Ref<RefCounted>();
+	}
+	Ref<RefCounted> instance;
+	instance.instantiate();
+	instance->set_script(script);
+	return instance;
+}
+
+static void _run_method(BenchmarkState &p_state, const StringName &p_method, const Variant &p_arg, int p_items) {
+	Ref<RefCounted> instance = _instantiate_benchmark_script(p_state);
+	if (instance.is_null()) {
+		return;
+	}
+
+	const Variant *args[1] = { &p_arg };
+	while (p_state.keep_running()) {
+		Callable::CallError ce;
+		Variant ret = instance->callp(p_method, args, 1, ce);
+		benchmark_do_not_optimize(ret);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * p_items);
+}
+
+BENCHMARK("[GDScript] Compile script") {
+	while (p_state.keep_running()) {
+		Ref<GDScript> script = _compile_benchmark_script();
+		benchmark_do_not_optimize(script);
+	}
+}
+
+BENCHMARK("[GDScript] Recursive calls (fibonacci 20)") {
+	_run_method(p_state, "fibonacci", 20, 1);
+}
+
+BENCHMARK("[GDScript] Typed integer loop (10k)") {
+	_run_method(p_state, "typed_sum", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Untyped integer loop (10k)") {
+	_run_method(p_state, "untyped_sum", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Array append (10k)") {
+	_run_method(p_state, "array_append", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Vector3 math (10k)") {
+	_run_method(p_state, "vector_math", 10000, 10000);
+}
+
+// Typed and untyped versions of the same loops. The typed ones use the unboxed
+// operator opcodes and fused compare-and-jump, the untyped ones go through the
+// generic operator path.
+
+BENCHMARK("[GDScript] Typed while loop with int comparisons (10k)") {
+	_run_method(p_state, "typed_while_compare", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Untyped while loop with int comparisons (10k)") {
+	_run_method(p_state, "untyped_while_compare", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Typed float arithmetic (10k)") {
+	_run_method(p_state, "typed_float_math", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Untyped float arithmetic (10k)") {
+	_run_method(p_state, "untyped_float_math", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Typed Vector2 arithmetic (10k)") {
+	_run_method(p_state, "typed_vector2_math", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Untyped Vector2 arithmetic (10k)") {
+	_run_method(p_state, "untyped_vector2_math", 10000, 10000);
+}
+
+// The packed array benchmarks pair a scripted loop with the equivalent bulk
+// method, so the gap between the two rows is what the bulk API saves.
+
+static PackedFloat32Array _make_float_samples(int p_count) {
+	PackedFloat32Array samples;
+	samples.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		samples.set(i, (i % 100) * 0.01f);
+	}
+	return samples;
+}
+
+static PackedVector3Array _make_points(int p_count) {
+	PackedVector3Array points;
+	points.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		points.set(i, Vector3(i % 10, i % 7, i % 3));
+	}
+	return points;
+}
+
+BENCHMARK("[GDScript] PackedFloat32Array remap and sum, scripted loop (10k)") {
+	_run_method(p_state, "packed_remap_loop", _make_float_samples(10000), 10000);
+}
+
+BENCHMARK("[GDScript] PackedFloat32Array remap and sum, bulk methods (10k)") {
+	_run_method(p_state, "packed_remap_bulk", _make_float_samples(10000), 10000);
+}
+
+BENCHMARK("[GDScript] PackedVector3Array transform, scripted loop (10k)") {
+	_run_method(p_state, "packed_transform_loop", _make_points(10000), 10000);
+}
+
+BENCHMARK("[GDScript] PackedVector3Array transform, bulk method (10k)") {
+	_run_method(p_state, "packed_transform_bulk", _make_points(10000), 10000);
+}
+
+// Receivers are read back out of untyped arrays, so every access below resolves
+// by name at runtime (through the per-site inline caches).
+
+BENCHMARK("[GDScript] Duck-typed method calls (10k)") {
+	_run_method(p_state, "duck_typed_calls", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Duck-typed method calls, two receiver scripts (10k)") {
+	_run_method(p_state, "duck_typed_calls_polymorphic", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Duck-typed script member get and set (10k)") {
+	_run_method(p_state, "duck_typed_members", 10000, 10000);
+}
+
+BENCHMARK("[GDScript] Duck-typed native property get and set (10k)") {
+	_run_method(p_state, "duck_typed_native_properties", 10000, 10000);
+}
+
+// Every item of the await benchmarks is one `await`. Allocations are only tracked on debug builds,
+// where `bytes/await` counts everything allocated to suspend and resume the coroutine.
+
+static void _set_bytes_per_await(BenchmarkState &p_state, uint64_t p_allocated_before, uint64_t p_awaits) {
+#ifdef DEBUG_ENABLED
+	p_state.set_counter("bytes/await", double(Memory::get_mem_total_allocated() - p_allocated_before) / p_awaits);
+#endif
+}
+
+BENCHMARK("[GDScript] Await a signal (1k)") {
+	Ref<RefCounted> instance = _instantiate_benchmark_script(p_state);
+	if (instance.is_null()) {
+		return;
+	}
+
+	const uint64_t allocated_before = Memory::get_mem_total_allocated();
+	while (p_state.keep_running()) {
+		Variant coroutine = instance->call(SNAME("await_signal"), 1000);
+		for (int i = 0; i < 1000; i++) {
+			instance->emit_signal(SNAME("tick"), 1);
+		}
+		benchmark_do_not_optimize(coroutine);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * 1000);
+	_set_bytes_per_await(p_state, allocated_before, p_state.get_iterations() * 1000);
+}
+
+BENCHMARK("[GDScript] Await a finished coroutine (1k)") {
+	Ref<RefCounted> instance = _instantiate_benchmark_script(p_state);
+	if (instance.is_null()) {
+		return;
+	}
+	Variant coroutine = instance->call(SNAME("await_signal"), 1);
+	instance->emit_signal(SNAME("tick"), 1);
+
+	const uint64_t allocated_before = Memory::get_mem_total_allocated();
+	while (p_state.keep_running()) {
+		Variant ret = instance->call(SNAME("await_finished"), coroutine, 1000);
+		benchmark_do_not_optimize(ret);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * 1000);
+	_set_bytes_per_await(p_state, allocated_before, p_state.get_iterations() * 1000);
+}
+
+BENCHMARK("[GDScript] Await a plain value (1k)") {
+	Ref<RefCounted> instance = _instantiate_benchmark_script(p_state);
+	if (instance.is_null()) {
+		return;
+	}
+
+	const uint64_t allocated_before = Memory::get_mem_total_allocated();
+	while (p_state.keep_running()) {
+		Variant ret = instance->call(SNAME("await_value"), 1000);
+		benchmark_do_not_optimize(ret);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * 1000);
+	_set_bytes_per_await(p_state, allocated_before, p_state.get_iterations() * 1000);
+}
+
+} // namespace GDScriptBenchmarks
+
+#endif // BENCHMARKS_ENABLED
@@ -32,7 +32,20 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_analyzer.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_compiler.h"
+#include "../gdscript_native_codegen.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -72,6 +85,380 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Load compiled bytecode from the cache") {
+	GDScriptLanguage::get_singleton()->init();
+	const String script_path = TestUtils::get_temp_path("bytecode_cache/counter.gd");
+	const String cache_path = TestUtils::get_temp_path("bytecode_cache/counter.gdbc");
+	const String source = R"(
+extends RefCounted
+
+class Counter:
+	var total := 0
+
+	func add(value: int) -> void:
+		total += value
+
+const FACTORS: Array[int] = [2, 3, 5]
+
+func _init():
+	var counter := Counter.new()
+	for factor in FACTORS:
+		counter.add(factor * factor)
+	var square := func(value: int) -> int: return value * value
+	set_meta("result", counter.total + square.call(4) + Vector2i(1, 2).length_squared())
+)";
+
+	{
+		Ref<GDScript> gdscript;
+		gdscript.instantiate();
+		gdscript->set_path(script_path);
+		gdscript->set_source_code(source);
+
+		GDScriptParser parser;
+		REQUIRE(parser.parse(source, script_path, false) == OK);
+		GDScriptAnalyzer analyzer(&parser);
+		REQUIRE(analyzer.analyze() == OK);
+		GDScriptCompiler compiler;
+		REQUIRE(compiler.compile(&parser, gdscript.ptr(), false) == OK);
+
+		CHECK_MESSAGE(GDScriptBytecodeCache::save(gdscript.ptr(), &parser, cache_path) == OK, "The compiled script should be written to the cache.");
+	}
+
+	{
+		Ref<GDScript> gdscript;
+		gdscript.instantiate();
+		gdscript->set_path(script_path);
+		gdscript->set_source_code(source);
+		REQUIRE_MESSAGE(GDScriptBytecodeCache::load(gdscript.ptr(), cache_path) == OK, "The script should load from the cache without being compiled.");
+		CHECK(gdscript->is_valid());
+		CHECK(gdscript->get_subclasses().has("Counter"));
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 4 + 9 + 25 + 16 + 5, "The cached bytecode should run like the compiled one.");
+	}
+
+	{
+		Ref<GDScript> gdscript;
+		gdscript.instantiate();
+		gdscript->set_path(script_path);
+		gdscript->set_source_code(source + "\nconst EXTRA = 1\n");
+		CHECK_MESSAGE(GDScriptBytecodeCache::load(gdscript.ptr(), cache_path) == ERR_FILE_MISSING_DEPENDENCIES, "A cache entry for different source code should be rejected.");
+		CHECK_FALSE(gdscript->is_valid());
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Reject cached bytecode with out of range operands") {
+	GDScriptLanguage::get_singleton()->init();
+	const String script_path = TestUtils::get_temp_path("bytecode_cache/operands.gd");
+	const String cache_path = TestUtils::get_temp_path("bytecode_cache/operands.gdbc");
+	const String source = R"(
+extends RefCounted
+
+static func sum_all(a, b, c, d, e, f, g):
+	var sum = a + b + c + d + e + f + g
+	return sum
+)";
+
+	{
+		Ref<GDScript> gdscript;
+		gdscript.instantiate();
+		gdscript->set_path(script_path);
+		gdscript->set_source_code(source);
+
+		GDScriptParser parser;
+		REQUIRE(parser.parse(source, script_path, false) == OK);
+		GDScriptAnalyzer analyzer(&parser);
+		REQUIRE(analyzer.analyze() == OK);
+		GDScriptCompiler compiler;
+		REQUIRE(compiler.compile(&parser, gdscript.ptr(), false) == OK);
+		REQUIRE(GDScriptBytecodeCache::save(gdscript.ptr(), &parser, cache_path) == OK);
+	}
+
+	// Shrink the stack of `sum_all()` to just its arguments, which leaves the operands addressing
+	// `sum` and the temporaries out of range. The stack size follows the argument count (7) and
+	// the vararg index (-1). The checksum is updated so only the bytecode checks can catch it.
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_path);
+	REQUIRE(data.size() > 16);
+	const uint8_t layout[8] = { 7, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF };
+	int stack_size_ofs = -1;
+	for (int i = 0; i + 12 <= data.size() - 4; i++) {
+		if (memcmp(data.ptr() + i, layout, sizeof(layout)) == 0) {
+			stack_size_ofs = i + sizeof(layout);
+			break;
+		}
+	}
+	REQUIRE(stack_size_ofs >= 0);
+	REQUIRE(decode_uint32(data.ptr() + stack_size_ofs) > 7 + GDScriptFunction::FIXED_ADDRESSES_MAX);
+	encode_uint32(7 + GDScriptFunction::FIXED_ADDRESSES_MAX, data.ptrw() + stack_size_ofs);
+	encode_uint32(hash_djb2_buffer(data.ptr(), data.size() - 4), data.ptrw() + data.size() - 4);
+	{
+		Ref<FileAccess> file = FileAccess::open(cache_path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		file->store_buffer(data);
+	}
+
+	Ref<GDScript> gdscript;
+	gdscript.instantiate();
+	gdscript->set_path(script_path);
+	gdscript->set_source_code(source);
+	CHECK_MESSAGE(GDScriptBytecodeCache::load(gdscript.ptr(), cache_path) == ERR_FILE_CORRUPT, "Bytecode with operands outside of its stack should be rejected.");
+	CHECK_FALSE(gdscript->is_valid());
+
+	// The script is compiled from source instead.
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+	CHECK(int(gdscript->call("sum_all", 1, 2, 3, 4, 5, 6, 7)) == 28);
+}
+
+static void write_test_script(const String &p_path, const String &p_source) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(p_source);
+}
+
+TEST_CASE("[Modules][GDScript] Parse script dependencies ahead of analysis") {
+	GDScriptLanguage::get_singleton()->init();
+	const String dir = TestUtils::get_temp_path("parse_dependencies");
+	DirAccess::make_dir_recursive_absolute(dir);
+	const String main_path = dir.path_join("main.gd");
+	const String main_source = R"(
+extends "base.gd"
+
+const Helper = preload("helper.gd")
+
+func _init():
+	set_meta("result", get_value() + Helper.VALUE)
+)";
+	write_test_script(main_path, main_source);
+	write_test_script(dir.path_join("base.gd"), R"(
+extends RefCounted
+
+const Helper = preload("helper.gd")
+
+func get_value() -> int:
+	return Helper.VALUE * 2
+)");
+	// Cyclic reference back to the base script.
+	write_test_script(dir.path_join("helper.gd"), R"(
+extends RefCounted
+
+const Base = preload("base.gd")
+
+const VALUE = 3
+)");
+
+	{
+		GDScriptParser parser;
+		REQUIRE(parser.parse(main_source, main_path, false) == OK);
+		const Vector<Ref<GDScriptParserRef>> parsers = GDScriptCache::parse_dependencies(main_path, &parser);
+		CHECK_MESSAGE(parsers.size() == 2, "Both the base script and the helper it shares should be parsed.");
+		for (const Ref<GDScriptParserRef> &parser_ref : parsers) {
+			CHECK(parser_ref->get_status() == GDScriptParserRef::PARSED);
+			CHECK(GDScriptCache::has_parser(parser_ref->get_path()));
+		}
+	}
+
+	Error err = OK;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(main_path, err);
+	REQUIRE(err == OK);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 3 * 2 + 3, "Scripts with cyclic preloads should still compile.");
+}
+
+static int native_stack_depth = 0;
+static String native_stack_function;
+
+// Stands in for the generated function, with a result the bytecode can't give.
+static void native_sum_to(const Variant **p_args, Variant &r_ret) {
+	native_stack_depth = GDScriptLanguage::get_singleton()->debug_get_stack_level_count();
+	native_stack_function = GDScriptLanguage::get_singleton()->debug_get_stack_level_function(0);
+	r_ret = -*VariantInternal::get_int(p_args[0]);
+}
+
+TEST_CASE("[Modules][GDScript] Lower typed functions to C++ and call them natively") {
+	GDScriptLanguage::get_singleton()->init();
+	const String script_path = TestUtils::get_temp_path("native_code/sum.gd");
+	const String source = R"(
+extends RefCounted
+
+static func sum_to(count: int) -> int:
+	var total := 0
+	for i in range(count):
+		if i % 3 == 0 and i > 0:
+			continue
+		total += i * i
+	return total
+
+static func untyped(value):
+	return value
+
+static func shift(value: int, count: int) -> int:
+	return (value << count) + (value >> 2)
+)";
+
+	GDScriptNativeCode native_code;
+	REQUIRE(native_code.add_script(script_path, source, source.hash()) == OK);
+	CHECK_MESSAGE(native_code.get_function_count() == 2, "Only the fully typed functions should be lowered.");
+	const String native_source = native_code.get_source();
+	CHECK(native_source.contains(vformat("register_function(\"%s\", \"sum_to\"", script_path)));
+	CHECK_FALSE(native_source.contains("\"untyped\""));
+	CHECK_MESSAGE(native_source.contains("Only positive operands are supported."), "Shifts should check their operands like the operator evaluator.");
+	CHECK_MESSAGE(native_source.contains("The shift amount must be less than 64."), "Shifts by a variable count should check it against the integer width.");
+
+	GDScriptNativeFunctions::register_function(script_path, "sum_to", source.hash(), native_sum_to);
+
+	Ref<GDScript> gdscript;
+	gdscript.instantiate();
+	gdscript->set_path(script_path);
+	gdscript->set_source_code(source);
+	REQUIRE(gdscript->reload() == OK);
+
+	native_stack_depth = 0;
+	CHECK_MESSAGE(int(gdscript->call("sum_to", 4)) == -4, "The registered native function should run instead of the bytecode.");
+	if (GDScriptLanguage::get_singleton()->should_track_call_stack()) {
+		CHECK_MESSAGE(native_stack_depth == 1, "Native calls should be on the script call stack.");
+		CHECK(native_stack_function == "sum_to");
+		CHECK(GDScriptLanguage::get_singleton()->debug_get_stack_level_count() == 0);
+	}
+	CHECK_MESSAGE(int(gdscript->call("sum_to", 4.0)) == 0 + 1 + 4, "Arguments needing a conversion should run the bytecode.");
+
+	GDScriptNativeFunctions::clear();
+}
+
+TEST_CASE("[Modules][GDScript] Resume coroutines and await finished ones") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+signal tick(value)
+
+func produce(count: int) -> int:
+	var total := 0
+	for _i in count:
+		total += await tick
+	return total
+
+func consume(coroutine) -> int:
+	return await coroutine
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	const Variant coroutine = ref_counted->call("produce", 3);
+	REQUIRE(Object::cast_to<GDScriptFunctionState>(coroutine) != nullptr);
+	const Variant waiting = ref_counted->call("consume", coroutine);
+	CHECK_MESSAGE(Object::cast_to<GDScriptFunctionState>(waiting) != nullptr, "Awaiting a running coroutine should suspend.");
+
+	// Each resume suspends again on a frame taken from the pool.
+	for (int i = 1; i <= 3; i++) {
+		ref_counted->emit_signal("tick", i);
+	}
+
+	CHECK_MESSAGE(int(ref_counted->call("consume", coroutine)) == 1 + 2 + 3, "Awaiting a finished coroutine should return its result right away.");
+}
+
+TEST_CASE("[Modules][GDScript] Optimize bytecode without changing behavior") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func padded():
+	pass
+	pass
+	pass
+	return 1
+
+func compact():
+	pass
+	return 1
+
+func defaults(a, b = 2, c = b + 1):
+	return a + b + c
+
+func loop(n):
+	var total = 0
+	for i in n:
+		if i % 2 == 0:
+			continue
+		elif i > 7:
+			break
+		var doubled = i * 2
+		total = total + (doubled if i != 3 else 0)
+	while total > 100:
+		total = total - 100
+	return total
+
+func chained(x):
+	var y = x * 7
+	var z = y - x
+	return z + y
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	// Without a debugger attached, consecutive line markers collapse into one.
+	const HashMap<StringName, GDScriptFunction *> &functions = gdscript->get_member_functions();
+	CHECK(functions["padded"]->get_code_size() == functions["compact"]->get_code_size());
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	CHECK(int(ref_counted->call("padded")) == 1);
+	CHECK_MESSAGE(int(ref_counted->call("defaults", 1)) == 6, "Default argument entry points should be relocated.");
+	CHECK(int(ref_counted->call("defaults", 1, 5)) == 12);
+	CHECK(int(ref_counted->call("defaults", 1, 5, 1)) == 7);
+	CHECK_MESSAGE(int(ref_counted->call("loop", 10)) == 26, "Jumps should be relocated after code is removed.");
+	CHECK_MESSAGE(int(ref_counted->call("chained", 6)) == 78, "Results should be written straight to the variables.");
+}
+
+TEST_CASE("[Modules][GDScript] Sample script call stacks into folded stacks") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func inner(request_sample: Callable):
+	request_sample.call()
+	return 1
+
+func outer(request_sample: Callable):
+	return inner(request_sample) + 1
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler::clear();
+	GDScriptSamplingProfiler::start(1000);
+	CHECK(GDScriptSamplingProfiler::is_running());
+	CHECK(int(ref_counted->call("outer", callable_mp_static(&GDScriptSamplingProfiler::request_sample))) == 2);
+	GDScriptSamplingProfiler::stop();
+	CHECK_FALSE(GDScriptSamplingProfiler::is_running());
+
+	// The sample requested from native code is recorded when `inner()` returns, its next safepoint.
+	// The interval timer may add more samples.
+	CHECK(GDScriptSamplingProfiler::get_sample_count() > 0);
+	CHECK_MESSAGE(GDScriptSamplingProfiler::get_folded_stacks().contains("outer;inner "), "Samples should be folded from the outermost frame.");
+	GDScriptSamplingProfiler::clear();
+	CHECK(GDScriptSamplingProfiler::get_folded_stacks().is_empty());
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
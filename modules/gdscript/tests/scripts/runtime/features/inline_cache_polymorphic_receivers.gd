@@ -0,0 +1,80 @@
+# Untyped calls and property accesses are cached per site and keyed on the
+# receiver's script and native class. Use more receiver kinds than a site holds
+# and go through each site several times, so entries are filled, hit and evicted.
+
+@warning_ignore_start("unsafe_method_access", "unsafe_property_access")
+
+class Walker:
+	var speed = 1
+
+	func move():
+		return "walk %d" % speed
+
+class Swimmer:
+	var _speed = 2
+	var speed:
+		get:
+			return _speed * 10
+		set(value):
+			_speed = value + 1
+
+	func move():
+		return "swim %d" % _speed
+
+class Typed:
+	var speed: int = 3
+
+	func move():
+		return "typed %d" % speed
+
+class Dynamic:
+	func _get(property):
+		if property == &"speed":
+			return 42
+		return null
+
+	func _set(property, _value):
+		return property == &"speed"
+
+	func move():
+		return "dynamic"
+
+class NamedResource extends Resource:
+	var extra = 0
+
+func call_move(thing):
+	return thing.move()
+
+func get_speed(thing):
+	return thing.speed
+
+func set_speed(thing, value):
+	thing.speed = value
+
+func rename(thing, value):
+	thing.resource_name = value
+
+func name_of(thing):
+	return thing.resource_name
+
+func test():
+	var things = [Walker.new(), Swimmer.new(), Typed.new(), Dynamic.new(), Walker.new()]
+	for _round in 3:
+		for thing in things:
+			print(call_move(thing), " ", get_speed(thing))
+
+	for thing in things:
+		set_speed(thing, 5)
+		print(get_speed(thing))
+
+	# Values that need converting still go through the regular path.
+	var typed = Typed.new()
+	set_speed(typed, 7.9)
+	print(get_speed(typed))
+
+	# Native properties and methods, with and without a script attached.
+	var resources = [Resource.new(), NamedResource.new()]
+	for i in 3:
+		for resource in resources:
+			rename(resource, "res %d" % i)
+			print(name_of(resource), " ", resource.get_class())
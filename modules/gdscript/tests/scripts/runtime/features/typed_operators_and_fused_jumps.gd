@@ -0,0 +1,50 @@
+# Fully typed operands compile to unboxed operator opcodes, and comparisons
+# used as conditions are fused with the conditional jump.
+
+func test():
+	var a := 7
+	var b := 3
+	print(a + b, " ", a - b, " ", a * b)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= b, " ", a > b, " ", a >= b)
+
+	var x := 1.5
+	var y := 0.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+	print(x == y, " ", x != y, " ", x < y, " ", x <= y, " ", x > y, " ", x >= y)
+
+	var v2 := Vector2(1, 2)
+	print(v2 + Vector2(3, 4), " ", v2 - Vector2(3, 4), " ", v2 * Vector2(3, 4), " ", v2 * 2.0)
+	var v3 := Vector3(1, 2, 3)
+	print(v3 + Vector3.ONE, " ", v3 - Vector3.ONE, " ", v3 * v3, " ", v3 * 0.5)
+
+	var count := 0
+	var i := 0
+	while i < 10:
+		if i % 2 == 0:
+			count += 1
+		i += 1
+	print(count)
+
+	var total := 0.0
+	var f := 0.0
+	while f <= 2.0:
+		total += f
+		f += 0.5
+	print(total)
+
+	print("less" if a < b else "not less")
+	print("greater" if x > y else "not greater")
+
+	# Every comparison with NaN is false, so a fused jump must not be replaced
+	# by the inverse comparison.
+	var nan_value := NAN
+	if nan_value < 1.0:
+		print("nan < 1.0")
+	else:
+		print("not nan < 1.0")
+	if nan_value >= 1.0:
+		print("nan >= 1.0")
+	else:
+		print("not nan >= 1.0")
+	if nan_value != nan_value:
+		print("nan != nan")
@@ -31,6 +31,7 @@
 #include "test_gdscript.h"
 
 #include "../gdscript_analyzer.h"
+#include "../gdscript_byte_codegen.h"
 #include "../gdscript_compiler.h"
 #include "../gdscript_parser.h"
 #include "../gdscript_tokenizer.h"
@@ -195,7 +196,7 @@ static void test_parser(const String &p_code, const String &p_script_path, const
 #endif
 }
 
-static void disassemble_function(const GDScriptFunction *p_func, const Vector<String> &p_lines) {
+static void disassemble_function(const GDScriptFunction *p_func, const Vector<String> &p_lines, bool p_diff) {
 	ERR_FAIL_NULL(p_func);
 
 	String arg_string;
@@ -214,46 +215,50 @@ static void disassemble_function(const GDScriptFunction *p_func, const Vector<St
 
 	print_line(vformat("Function %s(%s)", p_func->get_name(), arg_string));
 #ifdef TOOLS_ENABLED
-	p_func->disassemble(p_lines);
+	if (p_diff) {
+		p_func->disassemble_diff(p_lines);
+	} else {
+		p_func->disassemble(p_lines);
+	}
 #endif
 	print_line("");
 	print_line("");
 }
 
-static void recursively_disassemble_functions(const Ref<GDScript> p_script, const Vector<String> &p_lines) {
+static void recursively_disassemble_functions(const Ref<GDScript> p_script, const Vector<String> &p_lines, bool p_diff) {
 	print_line(vformat("Class %s", p_script->get_fully_qualified_name()));
 	print_line("");
 	print_line("");
 
 	const GDScriptFunction *implicit_initializer = p_script->get_implicit_initializer();
 	if (implicit_initializer != nullptr) {
-		disassemble_function(implicit_initializer, p_lines);
+		disassemble_function(implicit_initializer, p_lines, p_diff);
 	}
 
 	const GDScriptFunction *implicit_ready = p_script->get_implicit_ready();
 	if (implicit_ready != nullptr) {
-		disassemble_function(implicit_ready, p_lines);
+		disassemble_function(implicit_ready, p_lines, p_diff);
 	}
 
 	const GDScriptFunction *static_initializer = p_script->get_static_initializer();
 	if (static_initializer != nullptr) {
-		disassemble_function(static_initializer, p_lines);
+		disassemble_function(static_initializer, p_lines, p_diff);
 	}
 
 	for (const KeyValue<GDScriptFunction *, GDScript::LambdaInfo> &E : p_script->get_lambda_info()) {
-		disassemble_function(E.key, p_lines);
+		disassemble_function(E.key, p_lines, p_diff);
 	}
 
 	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->get_member_functions()) {
-		disassemble_function(E.value, p_lines);
+		disassemble_function(E.value, p_lines, p_diff);
 	}
 
 	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->get_subclasses()) {
-		recursively_disassemble_functions(E.value, p_lines);
+		recursively_disassemble_functions(E.value, p_lines, p_diff);
 	}
 }
 
-static void test_compiler(const String &p_code, const String &p_script_path, const Vector<String> &p_lines) {
+static void test_compiler(const String &p_code, const String &p_script_path, const Vector<String> &p_lines, bool p_diff) {
 	GDScriptParser parser;
 	Error err = parser.parse(p_code, p_script_path, false);
 
@@ -283,7 +288,14 @@ static void test_compiler(const String &p_code, const String &p_script_path, con
 	script.instantiate();
 	script->set_path(p_script_path);
 
+#ifdef TOOLS_ENABLED
+	// Show what the optimization pass did to each function.
+	GDScriptByteCodeGenerator::keep_unoptimized_code = p_diff;
+#endif
 	err = compiler.compile(&parser, script.ptr(), false);
+#ifdef TOOLS_ENABLED
+	GDScriptByteCodeGenerator::keep_unoptimized_code = false;
+#endif
 
 	if (err) {
 		print_line("Error in compiler:");
@@ -291,7 +303,7 @@ static void test_compiler(const String &p_code, const String &p_script_path, con
 		return;
 	}
 
-	recursively_disassemble_functions(script, p_lines);
+	recursively_disassemble_functions(script, p_lines, p_diff);
 }
 
 void test(TestType p_type) {
@@ -355,10 +367,10 @@ void test(TestType p_type) {
 			test_parser(code, test, lines);
 			break;
 		case TEST_COMPILER:
-			test_compiler(code, test, lines);
+			test_compiler(code, test, lines, false);
 			break;
 		case TEST_BYTECODE:
-			print_line("Not implemented.");
+			test_compiler(code, test, lines, true);
 	}
 
 	finish_language();
@@ -606,7 +606,8 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector2();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		deferred_motion = motion;
+		deferred_updates |= DEFERRED_UPDATE_SHAPES_WITH_MOTION;
 	}
 
 	contact_count = 0;
@@ -620,14 +621,14 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	ERR_FAIL_NULL(get_space());
 
 	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		deferred_updates |= DEFERRED_UPDATE_STATE_QUERY;
 	}
 
 	if (mode == PhysicsServer2D::BODY_MODE_KINEMATIC) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.is_empty() && linear_velocity == Vector2() && angular_velocity == 0) {
-			set_active(false); //stopped moving, deactivate
+			deferred_updates |= DEFERRED_UPDATE_DEACTIVATE; //stopped moving, deactivate
 		}
 		return;
 	}
@@ -644,16 +645,34 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 		pos += center_of_mass - center_of_mass.rotated(angle_delta);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	_set_transform(Transform2D(angle, pos), false);
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
 		new_transform = get_transform();
+	} else {
+		deferred_updates |= DEFERRED_UPDATE_SHAPES;
 	}
 
 	_update_transform_dependent();
 }
 
+void GodotBody2D::apply_deferred_updates() {
+	if (deferred_updates & DEFERRED_UPDATE_SHAPES_WITH_MOTION) {
+		_update_shapes_with_motion(deferred_motion);
+	}
+	if (deferred_updates & DEFERRED_UPDATE_SHAPES) {
+		_update_shapes();
+	}
+	if (deferred_updates & DEFERRED_UPDATE_STATE_QUERY) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+	if (deferred_updates & DEFERRED_UPDATE_DEACTIVATE) {
+		set_active(false);
+	}
+	deferred_updates = 0;
+}
+
 void GodotBody2D::wakeup_neighbours() {
 	for (const Pair<GodotConstraint2D *, int> &E : constraint_list) {
 		const GodotConstraint2D *c = E.first;
@@ -720,6 +739,41 @@ bool GodotBody2D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody2D::save_state(State &r_state) const {
+	r_state.self = get_self();
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.still_time = still_time;
+	r_state.shape_count = get_shape_count();
+	r_state.active = active;
+}
+
+void GodotBody2D::restore_state(const State &p_state, const Rect2 *p_shape_aabbs) {
+	_set_transform(p_state.transform, false);
+	_set_inv_transform(get_transform().affine_inverse());
+	_restore_shape_aabbs(p_shape_aabbs);
+	_update_transform_dependent();
+
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	biased_linear_velocity = Vector2();
+	biased_angular_velocity = 0.0;
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+
+	// Sync the node on the next query flush, even if the body was restored asleep.
+	if ((fi_callback_data || body_state_callback.is_valid()) && get_space() && !direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void GodotBody2D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -95,6 +95,17 @@ class GodotBody2D : public GodotCollisionObject2D {
 	SelfList<GodotBody2D> mass_properties_update_list;
 	SelfList<GodotBody2D> direct_state_query_list;
 
+	// Space updates of integrate_forces() and integrate_velocities(), which run
+	// on worker threads, applied afterwards by apply_deferred_updates().
+	enum DeferredUpdate {
+		DEFERRED_UPDATE_SHAPES = 1 << 0,
+		DEFERRED_UPDATE_SHAPES_WITH_MOTION = 1 << 1,
+		DEFERRED_UPDATE_STATE_QUERY = 1 << 2,
+		DEFERRED_UPDATE_DEACTIVATE = 1 << 3,
+	};
+	uint32_t deferred_updates = 0;
+	Vector2 deferred_motion;
+
 	VSet<RID> exceptions;
 	PhysicsServer2D::CCDMode continuous_cd_mode = PhysicsServer2D::CCD_MODE_DISABLED;
 	bool omit_force_integration = false;
@@ -315,8 +326,10 @@ public:
 	_FORCE_INLINE_ real_t get_friction() const { return friction; }
 	_FORCE_INLINE_ real_t get_bounce() const { return bounce; }
 
+	// Thread-safe for distinct bodies, apply_deferred_updates() must be called after each of them.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void apply_deferred_updates();
 
 	_FORCE_INLINE_ Vector2 get_velocity_in_local_point(const Vector2 &rel_pos) const {
 		return linear_velocity + Vector2(-angular_velocity * rel_pos.y, angular_velocity * rel_pos.x);
@@ -336,6 +349,24 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulated state saved in space snapshots, copied as is.
+	struct State {
+		RID self;
+		Transform2D transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 prev_linear_velocity;
+		real_t prev_angular_velocity = 0.0;
+		real_t still_time = 0.0;
+		uint32_t shape_count = 0;
+		bool active = false;
+	};
+
+	void save_state(State &r_state) const;
+	// Shape AABBs are restored as saved, so the broadphase gets the same bounds.
+	void restore_state(const State &p_state, const Rect2 *p_shape_aabbs);
+
 	GodotBody2D();
 	~GodotBody2D();
 };
@@ -593,6 +593,36 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair2D::save_state(State &r_state) const {
+	r_state.shape_A = shape_A;
+	r_state.shape_B = shape_B;
+	memcpy(r_state.contacts, contacts, sizeof(contacts));
+	r_state.contact_count = contact_count;
+	r_state.sep_axis = sep_axis;
+	r_state.offset_B = offset_B;
+	r_state.collided = collided;
+	r_state.check_ccd = check_ccd;
+	r_state.oneway_disabled = oneway_disabled;
+}
+
+void GodotBodyPair2D::restore_state(const State &p_state) {
+	memcpy(contacts, p_state.contacts, sizeof(contacts));
+	contact_count = p_state.contact_count;
+	sep_axis = p_state.sep_axis;
+	offset_B = p_state.offset_B;
+	collided = p_state.collided;
+	check_ccd = p_state.check_ccd;
+	oneway_disabled = p_state.oneway_disabled;
+}
+
+void GodotBodyPair2D::reset_state() {
+	contact_count = 0;
+	sep_axis = Vector2();
+	collided = false;
+	check_ccd = false;
+	oneway_disabled = false;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
 		GodotConstraint2D(_arr, 2) {
 	A = p_A;
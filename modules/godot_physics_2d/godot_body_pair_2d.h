@@ -89,6 +89,32 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	// Warm starting state saved in space snapshots, copied as is.
+	struct State {
+		uint32_t body_A = 0; // Index of the body in the snapshot.
+		uint32_t body_B = 0;
+		int shape_A = 0;
+		int shape_B = 0;
+		Contact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		Vector2 sep_axis;
+		Vector2 offset_B;
+		bool collided = false;
+		bool check_ccd = false;
+		bool oneway_disabled = false;
+	};
+
+	_FORCE_INLINE_ GodotBody2D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody2D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+	void reset_state();
+
+	virtual bool is_body_pair() const override { return true; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
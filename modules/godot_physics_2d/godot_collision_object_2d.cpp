@@ -184,6 +184,27 @@ void GodotCollisionObject2D::_update_shapes() {
 	}
 }
 
+void GodotCollisionObject2D::_restore_shape_aabbs(const Rect2 *p_aabbs) {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		s.aabb_cache = p_aabbs[i];
+		if (s.disabled) {
+			continue;
+		}
+
+		if (s.bpid == 0) {
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
+			space->get_broadphase()->set_static(s.bpid, _static);
+		}
+
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
+	}
+}
+
 void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion) {
 	if (!space) {
 		return;
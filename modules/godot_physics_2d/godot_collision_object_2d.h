@@ -74,10 +74,10 @@ private:
 
 	SelfList<GodotCollisionObject2D> pending_shape_update_list;
 
-	void _update_shapes();
-
 protected:
+	void _update_shapes();
 	void _update_shapes_with_motion(const Vector2 &p_motion);
+	void _restore_shape_aabbs(const Rect2 *p_aabbs);
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform2D &p_transform, bool p_update_shapes = true) {
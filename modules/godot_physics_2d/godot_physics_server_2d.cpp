@@ -276,6 +276,22 @@ int GodotPhysicsServer2D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer2D::space_snapshot(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), Vector<uint8_t>(), "Space snapshots can't be taken while the space is being stepped.");
+
+	return space->snapshot();
+}
+
+void GodotPhysicsServer2D::space_restore(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	ERR_FAIL_COND_MSG(space->is_locked(), "Space snapshots can't be restored while the space is being stepped.");
+
+	space->restore(p_snapshot);
+}
+
 PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_space) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL_V(space, nullptr);
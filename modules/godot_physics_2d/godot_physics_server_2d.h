@@ -115,6 +115,9 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_snapshot(RID p_space) const override;
+	virtual void space_restore(RID p_space, const Vector<uint8_t> &p_snapshot) override;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
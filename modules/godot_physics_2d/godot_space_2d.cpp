@@ -34,6 +34,7 @@
 #include "godot_physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "godot_area_pair_2d.h"
 #include "godot_body_pair_2d.h"
 
@@ -115,16 +116,15 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState2D::_intersect_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits) {
 	Vector2 begin, end;
 	Vector2 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	// Batches cull from several threads, each with its own hit list, without locking the broadphase.
+	int amount = r_cull_hits ? space->broadphase->cull_segment_concurrent(begin, end, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices, *r_cull_hits) : space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -135,17 +135,17 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindices[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -205,19 +205,18 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
 
-	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
 
-	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
+int GodotPhysicsDirectSpaceState2D::_intersect_shape(const ShapeParameters &p_parameters, GodotShape2D *p_shape, const Transform2D &p_transform, ShapeResult *r_results, int p_result_max, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits) {
+	Rect2 aabb = p_transform.xform(p_shape->get_aabb());
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = r_cull_hits ? space->broadphase->cull_aabb_concurrent(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices, *r_cull_hits) : space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	int cc = 0;
 
@@ -226,18 +225,18 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (!GodotCollisionSolver2D::solve(p_shape, p_transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
@@ -254,43 +253,51 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
 	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
+	ERR_FAIL_NULL_V(shape, 0);
 
-	Rect2 aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
+	return _intersect_shape(p_parameters, shape, p_parameters.transform, r_results, p_result_max, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+bool GodotPhysicsDirectSpaceState2D::_cast_motion(const ShapeParameters &p_parameters, GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits) {
+	Rect2 aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(Rect2(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = r_cull_hits ? space->broadphase->cull_aabb_concurrent(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices, *r_cull_hits) : space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (!GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
-		if (GodotCollisionSolver2D::solve(shape, p_parameters.transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
+		if (GodotCollisionSolver2D::solve(p_shape, p_transform, Vector2(), col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
 		}
 
-		Vector2 mnormal = p_parameters.motion.normalized();
+		Vector2 mnormal = p_motion.normalized();
 
 		//just do kinematic solving
 		real_t low = 0.0;
@@ -300,7 +307,7 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
 			Vector2 sep = mnormal; //important optimization for this to work fast enough
-			bool collided = GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
+			bool collided = GodotCollisionSolver2D::solve(p_shape, p_transform, p_motion * fraction, col_obj->get_shape(shape_idx), col_obj_xform, Vector2(), nullptr, nullptr, &sep, p_parameters.margin);
 
 			if (collided) {
 				hi = fraction;
@@ -337,6 +344,101 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	return _cast_motion(p_parameters, shape, p_parameters.transform, p_parameters.motion, p_closest_safe, p_closest_unsafe, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+void GodotPhysicsDirectSpaceState2D::_intersect_rays_task(uint32_t p_index, RayQueryBatch *p_batch) {
+	// Each query culls into its own buffers, the space's buffers are shared.
+	static thread_local LocalVector<uint32_t> cull_hits;
+	GodotCollisionObject2D *cull_results[GodotSpace2D::INTERSECTION_QUERY_MAX];
+	int cull_subindices[GodotSpace2D::INTERSECTION_QUERY_MAX];
+
+	p_batch->collided[p_index] = _intersect_ray(*p_batch->parameters, p_batch->from[p_index], p_batch->to[p_index], p_batch->results[p_index], cull_results, cull_subindices, &cull_hits);
+}
+
+void GodotPhysicsDirectSpaceState2D::_intersect_shapes_task(uint32_t p_index, ShapeQueryBatch *p_batch) {
+	static thread_local LocalVector<uint32_t> cull_hits;
+	GodotCollisionObject2D *cull_results[GodotSpace2D::INTERSECTION_QUERY_MAX];
+	int cull_subindices[GodotSpace2D::INTERSECTION_QUERY_MAX];
+
+	p_batch->result_counts[p_index] = _intersect_shape(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], p_batch->results + p_index * p_batch->result_max, p_batch->result_max, cull_results, cull_subindices, &cull_hits);
+}
+
+void GodotPhysicsDirectSpaceState2D::_cast_motions_task(uint32_t p_index, ShapeQueryBatch *p_batch) {
+	static thread_local LocalVector<uint32_t> cull_hits;
+	GodotCollisionObject2D *cull_results[GodotSpace2D::INTERSECTION_QUERY_MAX];
+	int cull_subindices[GodotSpace2D::INTERSECTION_QUERY_MAX];
+
+	_cast_motion(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], p_batch->motions[p_index], p_batch->closest_safe[p_index], p_batch->closest_unsafe[p_index], cull_results, cull_subindices, &cull_hits);
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, bool *r_collided, RayResult *r_results) {
+	ERR_FAIL_COND(space->locked);
+
+	RayQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.collided = r_collided;
+	batch.results = r_results;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_rays_task, &batch, p_count, -1, true, SNAME("Physics2DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_shapes(const ShapeParameters &p_parameters, const Transform2D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	for (int i = 0; i < p_count; i++) {
+		r_result_counts[i] = 0;
+	}
+
+	ERR_FAIL_COND(space->locked);
+
+	if (p_result_max <= 0) {
+		return;
+	}
+
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_shapes_task, &batch, p_count, -1, true, SNAME("Physics2DIntersectShapes"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState2D::cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+
+	ERR_FAIL_COND(space->locked);
+
+	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_cast_motions_task, &batch, p_count, -1, true, SNAME("Physics2DCastMotions"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool GodotPhysicsDirectSpaceState2D::collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -1026,16 +1128,16 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 		GodotArea2D *area = static_cast<GodotArea2D *>(A);
 		if (type_B == GodotCollisionObject2D::TYPE_AREA) {
 			GodotArea2D *area_b = static_cast<GodotArea2D *>(B);
-			GodotArea2Pair2D *area2_pair = memnew(GodotArea2Pair2D(area_b, p_subindex_B, area, p_subindex_A));
+			GodotArea2Pair2D *area2_pair = self->area2_pair_allocator.alloc(area_b, p_subindex_B, area, p_subindex_A);
 			return area2_pair;
 		} else {
 			GodotBody2D *body = static_cast<GodotBody2D *>(B);
-			GodotAreaPair2D *area_pair = memnew(GodotAreaPair2D(body, p_subindex_B, area, p_subindex_A));
+			GodotAreaPair2D *area_pair = self->area_pair_allocator.alloc(body, p_subindex_B, area, p_subindex_A);
 			return area_pair;
 		}
 
 	} else {
-		GodotBodyPair2D *b = memnew(GodotBodyPair2D(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B));
+		GodotBodyPair2D *b = self->body_pair_allocator.alloc(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B);
 		return b;
 	}
 }
@@ -1047,8 +1149,23 @@ void GodotSpace2D::_broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_
 
 	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
 	self->collision_pairs--;
-	GodotConstraint2D *c = static_cast<GodotConstraint2D *>(p_data);
-	memdelete(c);
+
+	// Same ordering as in _broadphase_pair(), to find the allocator the pair came from.
+	GodotCollisionObject2D::Type type_A = A->get_type();
+	GodotCollisionObject2D::Type type_B = B->get_type();
+	if (type_A > type_B) {
+		SWAP(type_A, type_B);
+	}
+
+	if (type_A == GodotCollisionObject2D::TYPE_AREA) {
+		if (type_B == GodotCollisionObject2D::TYPE_AREA) {
+			self->area2_pair_allocator.free(static_cast<GodotArea2Pair2D *>(p_data));
+		} else {
+			self->area_pair_allocator.free(static_cast<GodotAreaPair2D *>(p_data));
+		}
+	} else {
+		self->body_pair_allocator.free(static_cast<GodotBodyPair2D *>(p_data));
+	}
 }
 
 const SelfList<GodotBody2D>::List &GodotSpace2D::get_active_body_list() const {
@@ -1216,6 +1333,183 @@ GodotPhysicsDirectSpaceState2D *GodotSpace2D::get_direct_state() {
 	return direct_access;
 }
 
+// A snapshot is this header followed by the body states, the shape Rect2s of all bodies,
+// and the body pair states. They're all trivially copyable and their offsets are
+// multiples of 8 bytes, so they're written and read in place.
+struct SpaceSnapshotHeader2D {
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t body_count = 0;
+	uint32_t shape_count = 0;
+	uint32_t pair_count = 0;
+	uint32_t padding = 0;
+};
+
+static constexpr uint32_t SPACE_SNAPSHOT_MAGIC_2D = 0x32535047; // "GPS2"
+static constexpr uint32_t SPACE_SNAPSHOT_VERSION_2D = 1;
+
+static_assert(std::is_trivially_copyable_v<GodotBody2D::State>);
+static_assert(std::is_trivially_copyable_v<GodotBodyPair2D::State>);
+
+Vector<uint8_t> GodotSpace2D::snapshot() const {
+	LocalVector<const GodotBody2D *> bodies;
+	HashMap<const GodotBody2D *, uint32_t> body_indices;
+	uint32_t shape_count = 0;
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody2D *body = static_cast<const GodotBody2D *>(object);
+		body_indices.insert(body, bodies.size());
+		bodies.push_back(body);
+		shape_count += body->get_shape_count();
+	}
+
+	// Body pairs are in the constraint list of both bodies, only take them from body A.
+	LocalVector<const GodotBodyPair2D *> pairs;
+	for (const GodotBody2D *body : bodies) {
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			if (E.second == 0 && E.first->is_body_pair()) {
+				pairs.push_back(static_cast<const GodotBodyPair2D *>(E.first));
+			}
+		}
+	}
+
+	const uint32_t body_offset = sizeof(SpaceSnapshotHeader2D);
+	const uint32_t shape_offset = body_offset + bodies.size() * sizeof(GodotBody2D::State);
+	const uint32_t pair_offset = shape_offset + shape_count * sizeof(Rect2);
+
+	Vector<uint8_t> snapshot;
+	snapshot.resize(pair_offset + pairs.size() * sizeof(GodotBodyPair2D::State));
+	uint8_t *w = snapshot.ptrw();
+
+	SpaceSnapshotHeader2D *header = reinterpret_cast<SpaceSnapshotHeader2D *>(w);
+	*header = SpaceSnapshotHeader2D();
+	header->magic = SPACE_SNAPSHOT_MAGIC_2D;
+	header->version = SPACE_SNAPSHOT_VERSION_2D;
+	header->body_count = bodies.size();
+	header->shape_count = shape_count;
+	header->pair_count = pairs.size();
+
+	GodotBody2D::State *body_states = reinterpret_cast<GodotBody2D::State *>(w + body_offset);
+	Rect2 *shape_aabbs = reinterpret_cast<Rect2 *>(w + shape_offset);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		const GodotBody2D *body = bodies[i];
+		body_states[i] = GodotBody2D::State();
+		body->save_state(body_states[i]);
+		for (int j = 0; j < body->get_shape_count(); j++) {
+			*shape_aabbs++ = body->get_shape_aabb(j);
+		}
+	}
+
+	GodotBodyPair2D::State *pair_states = reinterpret_cast<GodotBodyPair2D::State *>(w + pair_offset);
+	for (uint32_t i = 0; i < pairs.size(); i++) {
+		const GodotBodyPair2D *pair = pairs[i];
+		pair_states[i] = GodotBodyPair2D::State();
+		pair->save_state(pair_states[i]);
+		pair_states[i].body_A = body_indices[pair->get_body_A()];
+		pair_states[i].body_B = body_indices[pair->get_body_B()];
+	}
+
+	return snapshot;
+}
+
+void GodotSpace2D::restore(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_MSG(p_snapshot.size() < (int64_t)sizeof(SpaceSnapshotHeader2D), "Invalid space snapshot.");
+
+	const uint8_t *r = p_snapshot.ptr();
+	const SpaceSnapshotHeader2D *header = reinterpret_cast<const SpaceSnapshotHeader2D *>(r);
+	ERR_FAIL_COND_MSG(header->magic != SPACE_SNAPSHOT_MAGIC_2D || header->version != SPACE_SNAPSHOT_VERSION_2D, "Invalid space snapshot.");
+
+	const uint64_t body_offset = sizeof(SpaceSnapshotHeader2D);
+	const uint64_t shape_offset = body_offset + header->body_count * sizeof(GodotBody2D::State);
+	const uint64_t pair_offset = shape_offset + header->shape_count * sizeof(Rect2);
+	ERR_FAIL_COND_MSG((uint64_t)p_snapshot.size() != pair_offset + header->pair_count * sizeof(GodotBodyPair2D::State), "Invalid space snapshot.");
+
+	const GodotBody2D::State *body_states = reinterpret_cast<const GodotBody2D::State *>(r + body_offset);
+	const Rect2 *shape_aabbs = reinterpret_cast<const Rect2 *>(r + shape_offset);
+	const GodotBodyPair2D::State *pair_states = reinterpret_cast<const GodotBodyPair2D::State *>(r + pair_offset);
+
+	// Bodies are saved in the order of the space objects, which stays the same unless objects are added or removed.
+	LocalVector<GodotBody2D *> bodies;
+	bodies.resize(header->body_count);
+	uint32_t body_count = 0;
+	bool same_order = true;
+	for (GodotCollisionObject2D *object : objects) {
+		if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		if (body_count == header->body_count || object->get_self() != body_states[body_count].self) {
+			same_order = false;
+			break;
+		}
+		bodies[body_count++] = static_cast<GodotBody2D *>(object);
+	}
+
+	if (!same_order || body_count != header->body_count) {
+		HashMap<RID, GodotBody2D *> bodies_by_rid;
+		for (GodotCollisionObject2D *object : objects) {
+			if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+				bodies_by_rid.insert(object->get_self(), static_cast<GodotBody2D *>(object));
+			}
+		}
+		ERR_FAIL_COND_MSG(bodies_by_rid.size() != header->body_count, "The bodies in the space changed since the snapshot was taken.");
+
+		for (uint32_t i = 0; i < header->body_count; i++) {
+			GodotBody2D **body = bodies_by_rid.getptr(body_states[i].self);
+			ERR_FAIL_NULL_MSG(body, "The bodies in the space changed since the snapshot was taken.");
+			bodies[i] = *body;
+		}
+	}
+
+	uint32_t shape_count = 0;
+	for (uint32_t i = 0; i < header->body_count; i++) {
+		ERR_FAIL_COND_MSG(bodies[i]->get_shape_count() != (int)body_states[i].shape_count, "The shapes of a body changed since the snapshot was taken.");
+		shape_count += body_states[i].shape_count;
+	}
+	ERR_FAIL_COND_MSG(shape_count != header->shape_count, "Invalid space snapshot.");
+
+	for (uint32_t i = 0; i < header->pair_count; i++) {
+		const GodotBodyPair2D::State &pair_state = pair_states[i];
+		ERR_FAIL_COND_MSG(pair_state.body_A >= header->body_count || pair_state.body_B >= header->body_count, "Invalid space snapshot.");
+		ERR_FAIL_COND_MSG(pair_state.contact_count < 0 || pair_state.contact_count > (int)std::size(pair_state.contacts), "Invalid space snapshot.");
+	}
+
+	for (uint32_t i = 0; i < header->body_count; i++) {
+		bodies[i]->restore_state(body_states[i], shape_aabbs);
+		shape_aabbs += body_states[i].shape_count;
+	}
+
+	// Let the broadphase add and remove pairs for the restored bounds.
+	broadphase->update();
+
+	// Pairs which aren't in the snapshot start over without contacts.
+	for (GodotBody2D *body : bodies) {
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			if (E.second == 0 && E.first->is_body_pair()) {
+				static_cast<GodotBodyPair2D *>(E.first)->reset_state();
+			}
+		}
+	}
+
+	// Pairs only overlapping within the broadphase margin may not be created again,
+	// they'll find their contacts again on the next step.
+	for (uint32_t i = 0; i < header->pair_count; i++) {
+		const GodotBodyPair2D::State &pair_state = pair_states[i];
+		const GodotBody2D *body_B = bodies[pair_state.body_B];
+		for (const Pair<GodotConstraint2D *, int> &E : bodies[pair_state.body_A]->get_constraint_list()) {
+			if (E.second != 0 || !E.first->is_body_pair()) {
+				continue;
+			}
+			GodotBodyPair2D *pair = static_cast<GodotBodyPair2D *>(E.first);
+			if (pair->get_body_B() == body_B && pair->get_shape_A() == pair_state.shape_A && pair->get_shape_B() == pair_state.shape_B) {
+				pair->restore_state(pair_state);
+				break;
+			}
+		}
+	}
+}
+
 GodotSpace2D::GodotSpace2D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/2d/sleep_threshold_angular");
@@ -1228,6 +1522,10 @@ GodotSpace2D::GodotSpace2D() {
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
 
 	broadphase = GodotBroadPhase2D::create_func();
+	body_pair_allocator.configure(PAIR_ALLOCATOR_PAGE_SIZE);
+	area_pair_allocator.configure(PAIR_ALLOCATOR_PAGE_SIZE);
+	area2_pair_allocator.configure(PAIR_ALLOCATOR_PAGE_SIZE);
+
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
 
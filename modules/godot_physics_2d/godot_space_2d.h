@@ -31,15 +31,46 @@
 #pragma once
 
 #include "godot_area_2d.h"
+#include "godot_area_pair_2d.h"
 #include "godot_body_2d.h"
+#include "godot_body_pair_2d.h"
 #include "godot_broad_phase_2d.h"
 #include "godot_collision_object_2d.h"
 
+#include "core/templates/paged_allocator.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	struct RayQueryBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector2 *from = nullptr;
+		const Vector2 *to = nullptr;
+		bool *collided = nullptr;
+		RayResult *results = nullptr;
+	};
+
+	struct ShapeQueryBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape2D *shape = nullptr;
+		const Transform2D *transforms = nullptr;
+		const Vector2 *motions = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector2 &p_from, const Vector2 &p_to, RayResult &r_result, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits = nullptr);
+	int _intersect_shape(const ShapeParameters &p_parameters, GodotShape2D *p_shape, const Transform2D &p_transform, ShapeResult *r_results, int p_result_max, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits = nullptr);
+	bool _cast_motion(const ShapeParameters &p_parameters, GodotShape2D *p_shape, const Transform2D &p_transform, const Vector2 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits = nullptr);
+
+	void _intersect_rays_task(uint32_t p_index, RayQueryBatch *p_batch);
+	void _intersect_shapes_task(uint32_t p_index, ShapeQueryBatch *p_batch);
+	void _cast_motions_task(uint32_t p_index, ShapeQueryBatch *p_batch);
+
 public:
 	GodotSpace2D *space = nullptr;
 
@@ -50,6 +81,10 @@ public:
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, bool *r_collided, RayResult *r_results) override;
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform2D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState2D() {}
 };
 
@@ -87,6 +122,16 @@ private:
 	static void *_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_A, GodotCollisionObject2D *B, int p_subindex_B, void *p_data, void *p_self);
 
+	// Pairs are created and destroyed in bulk as objects move, so they're pooled
+	// instead of going through the general allocator one at a time.
+	enum {
+		PAIR_ALLOCATOR_PAGE_SIZE = 256
+	};
+
+	PagedAllocator<GodotBodyPair2D> body_pair_allocator;
+	PagedAllocator<GodotAreaPair2D> area_pair_allocator;
+	PagedAllocator<GodotArea2Pair2D> area2_pair_allocator;
+
 	HashSet<GodotCollisionObject2D *> objects;
 
 	GodotArea2D *area = nullptr;
@@ -171,6 +216,10 @@ public:
 	void lock();
 	void unlock();
 
+	// Saves and restores the simulated state of the bodies, for rollback.
+	Vector<uint8_t> snapshot() const;
+	void restore(const Vector<uint8_t> &p_snapshot);
+
 	real_t get_last_step() const { return last_step; }
 	void set_last_step(real_t p_step) { last_step = p_step; }
 
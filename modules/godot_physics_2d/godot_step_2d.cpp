@@ -30,6 +30,7 @@
 
 #include "godot_step_2d.h"
 
+#include "core/debugger/trace_events.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "godot_constraint_2d.h"
@@ -73,11 +74,26 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 	}
 }
 
+void GodotStep2D::_gather_active_bodies(const SelfList<GodotBody2D>::List &p_body_list) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody2D> *b = p_body_list.first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+}
+
+void GodotStep2D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
 void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint2D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
 }
 
+void GodotStep2D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
@@ -127,6 +143,8 @@ void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) cons
 }
 
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
+	TRACE_ZONE("GodotStep2D::step");
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -143,16 +161,17 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(*body_list);
 
-	const SelfList<GodotBody2D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Broadphase updates aren't thread-safe, and are applied in list order to keep pairs deterministic.
+	for (GodotBody2D *body : active_bodies) {
+		body->apply_deferred_updates();
 	}
 
-	p_space->set_active_objects(active_count);
+	p_space->set_active_objects(active_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -193,7 +212,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody2D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -241,7 +260,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -272,11 +291,14 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody2D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n; // in case it shuts itself down
+	// New pairs may have woken up more bodies since the forces were integrated.
+	_gather_active_bodies(*body_list);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics2DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotBody2D *body : active_bodies) {
+		body->apply_deferred_updates();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -665,7 +665,8 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		deferred_motion = motion;
+		deferred_updates |= DEFERRED_UPDATE_SHAPES_WITH_MOTION;
 	}
 
 	contact_count = 0;
@@ -679,7 +680,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	ERR_FAIL_NULL(get_space());
 
 	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		deferred_updates |= DEFERRED_UPDATE_STATE_QUERY;
 	}
 
 	//apply axis lock linear
@@ -702,7 +703,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			deferred_updates |= DEFERRED_UPDATE_DEACTIVATE; //stopped moving, deactivate
 		}
 
 		return;
@@ -731,12 +732,29 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	deferred_updates |= DEFERRED_UPDATE_SHAPES;
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::apply_deferred_updates() {
+	if (deferred_updates & DEFERRED_UPDATE_SHAPES_WITH_MOTION) {
+		_update_shapes_with_motion(deferred_motion);
+	}
+	if (deferred_updates & DEFERRED_UPDATE_SHAPES) {
+		_update_shapes();
+	}
+	if (deferred_updates & DEFERRED_UPDATE_STATE_QUERY) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+	if (deferred_updates & DEFERRED_UPDATE_DEACTIVATE) {
+		set_active(false);
+	}
+	deferred_updates = 0;
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -799,6 +817,41 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody3D::save_state(State &r_state) const {
+	r_state.self = get_self();
+	r_state.transform = get_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.prev_linear_velocity = prev_linear_velocity;
+	r_state.prev_angular_velocity = prev_angular_velocity;
+	r_state.still_time = still_time;
+	r_state.shape_count = get_shape_count();
+	r_state.active = active;
+}
+
+void GodotBody3D::restore_state(const State &p_state, const AABB *p_shape_aabbs) {
+	_set_transform(p_state.transform, false);
+	_set_inv_transform(get_transform().affine_inverse());
+	_restore_shape_aabbs(p_shape_aabbs);
+	_update_transform_dependent();
+
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	prev_linear_velocity = p_state.prev_linear_velocity;
+	prev_angular_velocity = p_state.prev_angular_velocity;
+	biased_linear_velocity = Vector3();
+	biased_angular_velocity = Vector3();
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+
+	// Sync the node on the next query flush, even if the body was restored asleep.
+	if ((fi_callback_data || body_state_callback.is_valid()) && get_space() && !direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -99,6 +99,17 @@ class GodotBody3D : public GodotCollisionObject3D {
 	SelfList<GodotBody3D> mass_properties_update_list;
 	SelfList<GodotBody3D> direct_state_query_list;
 
+	// Space updates of integrate_forces() and integrate_velocities(), which run
+	// on worker threads, applied afterwards by apply_deferred_updates().
+	enum DeferredUpdate {
+		DEFERRED_UPDATE_SHAPES = 1 << 0,
+		DEFERRED_UPDATE_SHAPES_WITH_MOTION = 1 << 1,
+		DEFERRED_UPDATE_STATE_QUERY = 1 << 2,
+		DEFERRED_UPDATE_DEACTIVATE = 1 << 3,
+	};
+	uint32_t deferred_updates = 0;
+	Vector3 deferred_motion;
+
 	VSet<RID> exceptions;
 	bool omit_force_integration = false;
 	bool active = true;
@@ -217,7 +228,10 @@ public:
 	_FORCE_INLINE_ Vector3 get_prev_linear_velocity() const { return prev_linear_velocity; }
 	_FORCE_INLINE_ Vector3 get_prev_angular_velocity() const { return prev_angular_velocity; }
 
+	_FORCE_INLINE_ void set_biased_linear_velocity(const Vector3 &p_velocity) { biased_linear_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
+
+	_FORCE_INLINE_ void set_biased_angular_velocity(const Vector3 &p_velocity) { biased_angular_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
 
 	_FORCE_INLINE_ void apply_central_impulse(const Vector3 &p_impulse) {
@@ -316,8 +330,10 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// Thread-safe for distinct bodies, apply_deferred_updates() must be called after each of them.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void apply_deferred_updates();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -343,6 +359,24 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulated state saved in space snapshots, copied as is.
+	struct State {
+		RID self;
+		Transform3D transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		real_t still_time = 0.0;
+		uint32_t shape_count = 0;
+		bool active = false;
+	};
+
+	void save_state(State &r_state) const;
+	// Shape AABBs are restored as saved, so the broadphase gets the same bounds.
+	void restore_state(const State &p_state, const AABB *p_shape_aabbs);
+
 	GodotBody3D();
 	~GodotBody3D();
 };
@@ -33,9 +33,6 @@
 #include "godot_collision_solver_3d.h"
 #include "godot_space_3d.h"
 
-#define MIN_VELOCITY 0.0001
-#define MAX_BIAS_ROTATION (Math::PI / 8)
-
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
 	pair->contact_added_callback(p_point_A, p_index_A, p_point_B, p_index_B, normal);
@@ -595,6 +592,33 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::save_state(State &r_state) const {
+	r_state.shape_A = shape_A;
+	r_state.shape_B = shape_B;
+	memcpy(r_state.contacts, contacts, sizeof(contacts));
+	r_state.contact_count = contact_count;
+	r_state.sep_axis = sep_axis;
+	r_state.offset_B = offset_B;
+	r_state.collided = collided;
+	r_state.check_ccd = check_ccd;
+}
+
+void GodotBodyPair3D::restore_state(const State &p_state) {
+	memcpy(contacts, p_state.contacts, sizeof(contacts));
+	contact_count = p_state.contact_count;
+	sep_axis = p_state.sep_axis;
+	offset_B = p_state.offset_B;
+	collided = p_state.collided;
+	check_ccd = p_state.check_ccd;
+}
+
+void GodotBodyPair3D::reset_state() {
+	contact_count = 0;
+	sep_axis = Vector3();
+	collided = false;
+	check_ccd = false;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
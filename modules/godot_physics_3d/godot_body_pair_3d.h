@@ -37,6 +37,11 @@
 #include "core/templates/local_vector.h"
 
 class GodotBodyContact3D : public GodotConstraint3D {
+public:
+	// Shared with GodotContactSolver3D, which must solve contacts like GodotBodyPair3D::solve().
+	static constexpr double MIN_VELOCITY = 0.0001;
+	static constexpr double MAX_BIAS_ROTATION = Math::PI / 8;
+
 protected:
 	struct Contact {
 		Vector3 position;
@@ -70,6 +75,8 @@ protected:
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+	friend class GodotContactSolver3D;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -104,6 +111,31 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	// Warm starting state saved in space snapshots, copied as is.
+	struct State {
+		uint32_t body_A = 0; // Index of the body in the snapshot.
+		uint32_t body_B = 0;
+		int shape_A = 0;
+		int shape_B = 0;
+		Contact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		Vector3 sep_axis;
+		Vector3 offset_B;
+		bool collided = false;
+		bool check_ccd = false;
+	};
+
+	_FORCE_INLINE_ GodotBody3D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
+	void save_state(State &r_state) const;
+	void restore_state(const State &p_state);
+	void reset_state();
+
+	virtual bool is_body_pair() const override { return true; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
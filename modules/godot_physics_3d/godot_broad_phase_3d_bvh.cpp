@@ -86,6 +86,14 @@ int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D *
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+int GodotBroadPhase3DBVH::cull_segment_concurrent(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, LocalVector<uint32_t> &r_hits) const {
+	return bvh.cull_segment_concurrent(p_from, p_to, p_results, p_max_results, r_hits, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
+int GodotBroadPhase3DBVH::cull_aabb_concurrent(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices, LocalVector<uint32_t> &r_hits) const {
+	return bvh.cull_aabb_concurrent(p_aabb, p_results, p_max_results, r_hits, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
 void *GodotBroadPhase3DBVH::_pair_callback(void *self, uint32_t p_A, GodotCollisionObject3D *p_object_A, int subindex_A, uint32_t p_B, GodotCollisionObject3D *p_object_B, int subindex_B) {
 	GodotBroadPhase3DBVH *bpo = static_cast<GodotBroadPhase3DBVH *>(self);
 	if (!bpo->pair_callback) {
@@ -125,4 +133,5 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+	bvh.params_set_threaded_pairing(true);
 }
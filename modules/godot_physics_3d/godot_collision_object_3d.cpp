@@ -182,6 +182,30 @@ void GodotCollisionObject3D::_update_shapes() {
 	}
 }
 
+void GodotCollisionObject3D::_restore_shape_aabbs(const AABB *p_aabbs) {
+	if (!space) {
+		return;
+	}
+
+	for (int i = 0; i < shapes.size(); i++) {
+		Shape &s = shapes.write[i];
+		s.aabb_cache = p_aabbs[i];
+		if (s.disabled) {
+			continue;
+		}
+
+		Vector3 scale = (transform * s.xform).get_basis().get_scale();
+		s.area_cache = s.shape->get_volume() * scale.x * scale.y * scale.z;
+
+		if (s.bpid == 0) {
+			s.bpid = space->get_broadphase()->create(this, i, s.aabb_cache, _static);
+			space->get_broadphase()->set_static(s.bpid, _static);
+		}
+
+		space->get_broadphase()->move(s.bpid, s.aabb_cache);
+	}
+}
+
 void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
 	if (!space) {
 		return;
@@ -78,10 +78,10 @@ private:
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
-	void _update_shapes();
-
 protected:
+	void _update_shapes();
 	void _update_shapes_with_motion(const Vector3 &p_motion);
+	void _restore_shape_aabbs(const AABB *p_aabbs);
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
@@ -0,0 +1,454 @@
+/**************************************************************************/
+/*  godot_contact_solver_3d.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_contact_solver_3d.h"
+
+#include "godot_body_pair_3d.h"
+
+static _FORCE_INLINE_ Vector3 _limit_length(const Vector3 &p_vector, real_t p_max_length) {
+	const real_t length = p_vector.length();
+	return length > p_max_length ? p_vector * (p_max_length / length) : p_vector;
+}
+
+uint32_t GodotContactSolver3D::_get_body_slot(GodotBody3D *p_body) {
+	const uint32_t *existing_slot = body_slots.getptr(p_body);
+	if (existing_slot) {
+		return *existing_slot;
+	}
+
+	const uint32_t slot = bodies.size();
+	bodies.push_back(p_body);
+	body_dynamic.push_back(p_body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC);
+	body_slots.insert(p_body, slot);
+
+	const Vector3 linear_velocity = p_body->get_linear_velocity();
+	const Vector3 angular_velocity = p_body->get_angular_velocity();
+	const Vector3 &biased_linear_velocity = p_body->get_biased_linear_velocity();
+	const Vector3 &biased_angular_velocity = p_body->get_biased_angular_velocity();
+	const Basis &inv_inertia_tensor = p_body->get_inv_inertia_tensor();
+
+	body_data[BODY_LINEAR_VELOCITY_X].push_back(linear_velocity.x);
+	body_data[BODY_LINEAR_VELOCITY_Y].push_back(linear_velocity.y);
+	body_data[BODY_LINEAR_VELOCITY_Z].push_back(linear_velocity.z);
+	body_data[BODY_ANGULAR_VELOCITY_X].push_back(angular_velocity.x);
+	body_data[BODY_ANGULAR_VELOCITY_Y].push_back(angular_velocity.y);
+	body_data[BODY_ANGULAR_VELOCITY_Z].push_back(angular_velocity.z);
+	body_data[BODY_BIASED_LINEAR_VELOCITY_X].push_back(biased_linear_velocity.x);
+	body_data[BODY_BIASED_LINEAR_VELOCITY_Y].push_back(biased_linear_velocity.y);
+	body_data[BODY_BIASED_LINEAR_VELOCITY_Z].push_back(biased_linear_velocity.z);
+	body_data[BODY_BIASED_ANGULAR_VELOCITY_X].push_back(biased_angular_velocity.x);
+	body_data[BODY_BIASED_ANGULAR_VELOCITY_Y].push_back(biased_angular_velocity.y);
+	body_data[BODY_BIASED_ANGULAR_VELOCITY_Z].push_back(biased_angular_velocity.z);
+	body_data[BODY_INV_MASS].push_back(p_body->get_inv_mass());
+	for (int row = 0; row < 3; row++) {
+		for (int column = 0; column < 3; column++) {
+			body_data[BODY_INV_INERTIA_XX + row * 3 + column].push_back(inv_inertia_tensor.rows[row][column]);
+		}
+	}
+
+	return slot;
+}
+
+uint32_t GodotContactSolver3D::_find_batch(uint32_t p_body_A, uint32_t p_body_B, uint32_t p_first_batch) {
+	const uint32_t end = MIN(batch_sizes.size(), p_first_batch + MAX_BATCH_SEARCH);
+	for (uint32_t batch = p_first_batch; batch < end; batch++) {
+		const uint32_t size = batch_sizes[batch];
+		if (size == LANES) {
+			continue;
+		}
+
+		const uint32_t *batch_body = &batch_bodies[batch * LANES * 2];
+		bool conflict = false;
+		for (uint32_t i = 0; i < size * 2; i++) {
+			if (batch_body[i] != 0 && (batch_body[i] == p_body_A || batch_body[i] == p_body_B)) {
+				conflict = true;
+				break;
+			}
+		}
+		if (!conflict) {
+			return batch;
+		}
+	}
+
+	return batch_sizes.size();
+}
+
+void GodotContactSolver3D::pack(LocalVector<GodotConstraint3D *> &r_constraint_island) {
+	bodies.clear();
+	body_dynamic.clear();
+	body_slots.clear();
+	for (uint32_t field = 0; field < BODY_FIELD_MAX; field++) {
+		body_data[field].clear();
+	}
+	packed_contacts.clear();
+	batch_sizes.clear();
+	batch_bodies.clear();
+	batch_count = 0;
+
+	bodies.push_back(nullptr);
+	body_dynamic.push_back(false);
+	for (uint32_t field = 0; field < BODY_FIELD_MAX; field++) {
+		body_data[field].push_back(0.0);
+	}
+
+	// Keep the other constraints in the island, in order.
+	uint32_t constraint_count = r_constraint_island.size();
+	uint32_t other_constraint_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = r_constraint_island[constraint_index];
+		if (!constraint->is_body_pair()) {
+			r_constraint_island[other_constraint_count++] = constraint;
+			continue;
+		}
+
+		GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(constraint);
+		const uint32_t body_A = _get_body_slot(pair->A);
+		const uint32_t body_B = _get_body_slot(pair->B);
+		for (int i = 0; i < pair->contact_count; i++) {
+			if (!pair->contacts[i].active) {
+				continue;
+			}
+			PackedContact packed_contact;
+			packed_contact.pair = pair;
+			packed_contact.index = i;
+			packed_contact.body_A = body_A;
+			packed_contact.body_B = body_B;
+			packed_contacts.push_back(packed_contact);
+		}
+	}
+	r_constraint_island.resize(other_constraint_count);
+
+	if (packed_contacts.is_empty()) {
+		return;
+	}
+
+	// Greedily assign contacts to the first batch which doesn't touch their rigid bodies yet.
+	// Static and kinematic bodies are never written to, so they can be shared within a batch.
+	uint32_t first_open_batch = 0;
+	for (PackedContact &packed_contact : packed_contacts) {
+		const uint32_t body_A = body_dynamic[packed_contact.body_A] ? packed_contact.body_A : 0;
+		const uint32_t body_B = body_dynamic[packed_contact.body_B] ? packed_contact.body_B : 0;
+
+		const uint32_t batch = _find_batch(body_A, body_B, first_open_batch);
+		if (batch == batch_sizes.size()) {
+			batch_sizes.push_back(0);
+			batch_bodies.resize(batch_bodies.size() + LANES * 2);
+		}
+
+		const uint32_t lane = batch_sizes[batch]++;
+		batch_bodies[(batch * LANES + lane) * 2] = body_A;
+		batch_bodies[(batch * LANES + lane) * 2 + 1] = body_B;
+		packed_contact.slot = batch * LANES + lane;
+
+		while (first_open_batch < batch_sizes.size() && batch_sizes[first_open_batch] == LANES) {
+			++first_open_batch;
+		}
+	}
+	batch_count = batch_sizes.size();
+
+	// Padding lanes are inactive and point to the empty body slot.
+	const uint32_t lane_count = batch_count * LANES;
+	for (uint32_t field = 0; field < CONTACT_FIELD_MAX; field++) {
+		contact_data[field].resize(lane_count);
+		memset(contact_data[field].ptr(), 0, lane_count * sizeof(real_t));
+	}
+	contact_body_A.resize(lane_count);
+	memset(contact_body_A.ptr(), 0, lane_count * sizeof(uint32_t));
+	contact_body_B.resize(lane_count);
+	memset(contact_body_B.ptr(), 0, lane_count * sizeof(uint32_t));
+
+	for (const PackedContact &packed_contact : packed_contacts) {
+		const GodotBodyPair3D *pair = packed_contact.pair;
+		const GodotBodyPair3D::Contact &c = pair->contacts[packed_contact.index];
+		const uint32_t slot = packed_contact.slot;
+
+		contact_body_A[slot] = packed_contact.body_A;
+		contact_body_B[slot] = packed_contact.body_B;
+
+		contact_data[CONTACT_NORMAL_X][slot] = c.normal.x;
+		contact_data[CONTACT_NORMAL_Y][slot] = c.normal.y;
+		contact_data[CONTACT_NORMAL_Z][slot] = c.normal.z;
+		contact_data[CONTACT_R_A_X][slot] = c.rA.x;
+		contact_data[CONTACT_R_A_Y][slot] = c.rA.y;
+		contact_data[CONTACT_R_A_Z][slot] = c.rA.z;
+		contact_data[CONTACT_R_B_X][slot] = c.rB.x;
+		contact_data[CONTACT_R_B_Y][slot] = c.rB.y;
+		contact_data[CONTACT_R_B_Z][slot] = c.rB.z;
+		contact_data[CONTACT_SCALE_A][slot] = pair->collide_A ? 1.0 : 0.0;
+		contact_data[CONTACT_SCALE_B][slot] = pair->collide_B ? 1.0 : 0.0;
+		contact_data[CONTACT_MASS_NORMAL][slot] = c.mass_normal;
+		contact_data[CONTACT_BIAS][slot] = c.bias;
+		contact_data[CONTACT_BOUNCE][slot] = c.bounce;
+		contact_data[CONTACT_FRICTION][slot] = Math::abs(MIN(pair->A->get_friction(), pair->B->get_friction()));
+		contact_data[CONTACT_ACC_NORMAL_IMPULSE][slot] = c.acc_normal_impulse;
+		contact_data[CONTACT_ACC_TANGENT_IMPULSE_X][slot] = c.acc_tangent_impulse.x;
+		contact_data[CONTACT_ACC_TANGENT_IMPULSE_Y][slot] = c.acc_tangent_impulse.y;
+		contact_data[CONTACT_ACC_TANGENT_IMPULSE_Z][slot] = c.acc_tangent_impulse.z;
+		contact_data[CONTACT_ACC_BIAS_IMPULSE][slot] = c.acc_bias_impulse;
+		contact_data[CONTACT_ACC_BIAS_IMPULSE_CENTER_OF_MASS][slot] = c.acc_bias_impulse_center_of_mass;
+		contact_data[CONTACT_ACTIVE][slot] = 1.0;
+	}
+}
+
+void GodotContactSolver3D::_solve_batch(uint32_t p_first_lane, real_t p_max_bias_av) {
+	real_t a[BODY_FIELD_MAX][LANES];
+	real_t b[BODY_FIELD_MAX][LANES];
+
+	const uint32_t *slot_A = contact_body_A.ptr() + p_first_lane;
+	const uint32_t *slot_B = contact_body_B.ptr() + p_first_lane;
+
+	for (uint32_t field = 0; field < BODY_FIELD_MAX; field++) {
+		const real_t *data = body_data[field].ptr();
+		for (uint32_t lane = 0; lane < LANES; lane++) {
+			a[field][lane] = data[slot_A[lane]];
+			b[field][lane] = data[slot_B[lane]];
+		}
+	}
+
+	real_t *c[CONTACT_FIELD_MAX];
+	for (uint32_t field = 0; field < CONTACT_FIELD_MAX; field++) {
+		c[field] = contact_data[field].ptr() + p_first_lane;
+	}
+
+	// Same math as GodotBodyPair3D::solve(), with branches turned into selects
+	// so every lane runs the same instructions.
+	for (uint32_t lane = 0; lane < LANES; lane++) {
+		const bool active = c[CONTACT_ACTIVE][lane] != 0.0;
+		const Vector3 normal(c[CONTACT_NORMAL_X][lane], c[CONTACT_NORMAL_Y][lane], c[CONTACT_NORMAL_Z][lane]);
+		const Vector3 rA(c[CONTACT_R_A_X][lane], c[CONTACT_R_A_Y][lane], c[CONTACT_R_A_Z][lane]);
+		const Vector3 rB(c[CONTACT_R_B_X][lane], c[CONTACT_R_B_Y][lane], c[CONTACT_R_B_Z][lane]);
+		const real_t mass_normal = c[CONTACT_MASS_NORMAL][lane];
+		const real_t bias = c[CONTACT_BIAS][lane];
+
+		const real_t scale_A = c[CONTACT_SCALE_A][lane];
+		const real_t scale_B = c[CONTACT_SCALE_B][lane];
+		const real_t inv_mass_A = a[BODY_INV_MASS][lane] * scale_A;
+		const real_t inv_mass_B = b[BODY_INV_MASS][lane] * scale_B;
+		const Basis inv_inertia_tensor_A = Basis(
+				a[BODY_INV_INERTIA_XX][lane], a[BODY_INV_INERTIA_XY][lane], a[BODY_INV_INERTIA_XZ][lane],
+				a[BODY_INV_INERTIA_YX][lane], a[BODY_INV_INERTIA_YY][lane], a[BODY_INV_INERTIA_YZ][lane],
+				a[BODY_INV_INERTIA_ZX][lane], a[BODY_INV_INERTIA_ZY][lane], a[BODY_INV_INERTIA_ZZ][lane]) *
+				scale_A;
+		const Basis inv_inertia_tensor_B = Basis(
+				b[BODY_INV_INERTIA_XX][lane], b[BODY_INV_INERTIA_XY][lane], b[BODY_INV_INERTIA_XZ][lane],
+				b[BODY_INV_INERTIA_YX][lane], b[BODY_INV_INERTIA_YY][lane], b[BODY_INV_INERTIA_YZ][lane],
+				b[BODY_INV_INERTIA_ZX][lane], b[BODY_INV_INERTIA_ZY][lane], b[BODY_INV_INERTIA_ZZ][lane]) *
+				scale_B;
+
+		Vector3 lvA(a[BODY_LINEAR_VELOCITY_X][lane], a[BODY_LINEAR_VELOCITY_Y][lane], a[BODY_LINEAR_VELOCITY_Z][lane]);
+		Vector3 avA(a[BODY_ANGULAR_VELOCITY_X][lane], a[BODY_ANGULAR_VELOCITY_Y][lane], a[BODY_ANGULAR_VELOCITY_Z][lane]);
+		Vector3 blvA(a[BODY_BIASED_LINEAR_VELOCITY_X][lane], a[BODY_BIASED_LINEAR_VELOCITY_Y][lane], a[BODY_BIASED_LINEAR_VELOCITY_Z][lane]);
+		Vector3 bavA(a[BODY_BIASED_ANGULAR_VELOCITY_X][lane], a[BODY_BIASED_ANGULAR_VELOCITY_Y][lane], a[BODY_BIASED_ANGULAR_VELOCITY_Z][lane]);
+		Vector3 lvB(b[BODY_LINEAR_VELOCITY_X][lane], b[BODY_LINEAR_VELOCITY_Y][lane], b[BODY_LINEAR_VELOCITY_Z][lane]);
+		Vector3 avB(b[BODY_ANGULAR_VELOCITY_X][lane], b[BODY_ANGULAR_VELOCITY_Y][lane], b[BODY_ANGULAR_VELOCITY_Z][lane]);
+		Vector3 blvB(b[BODY_BIASED_LINEAR_VELOCITY_X][lane], b[BODY_BIASED_LINEAR_VELOCITY_Y][lane], b[BODY_BIASED_LINEAR_VELOCITY_Z][lane]);
+		Vector3 bavB(b[BODY_BIASED_ANGULAR_VELOCITY_X][lane], b[BODY_BIASED_ANGULAR_VELOCITY_Y][lane], b[BODY_BIASED_ANGULAR_VELOCITY_Z][lane]);
+
+		//bias impulse
+
+		Vector3 dbv = blvB + bavB.cross(rB) - blvA - bavA.cross(rA);
+		real_t vbn = dbv.dot(normal);
+
+		const bool apply_bias = active && Math::abs(-vbn + bias) > GodotBodyContact3D::MIN_VELOCITY;
+		const real_t acc_bias_old = c[CONTACT_ACC_BIAS_IMPULSE][lane];
+		const real_t acc_bias = apply_bias ? MAX(acc_bias_old + (-vbn + bias) * mass_normal, 0.0f) : acc_bias_old;
+		c[CONTACT_ACC_BIAS_IMPULSE][lane] = acc_bias;
+
+		const Vector3 jb = normal * (acc_bias - acc_bias_old);
+		blvA -= jb * inv_mass_A;
+		bavA += _limit_length(inv_inertia_tensor_A.xform(rA.cross(-jb)), p_max_bias_av);
+		blvB += jb * inv_mass_B;
+		bavB += _limit_length(inv_inertia_tensor_B.xform(rB.cross(jb)), p_max_bias_av);
+
+		dbv = blvB + bavB.cross(rB) - blvA - bavA.cross(rA);
+		vbn = dbv.dot(normal);
+
+		const bool apply_bias_com = apply_bias && Math::abs(-vbn + bias) > GodotBodyContact3D::MIN_VELOCITY;
+		const real_t acc_bias_com_old = c[CONTACT_ACC_BIAS_IMPULSE_CENTER_OF_MASS][lane];
+		const real_t acc_bias_com = apply_bias_com ? MAX(acc_bias_com_old + (-vbn + bias) / (inv_mass_A + inv_mass_B), 0.0f) : acc_bias_com_old;
+		c[CONTACT_ACC_BIAS_IMPULSE_CENTER_OF_MASS][lane] = acc_bias_com;
+
+		const Vector3 jb_com = normal * (acc_bias_com - acc_bias_com_old);
+		blvA -= jb_com * inv_mass_A;
+		blvB += jb_com * inv_mass_B;
+
+		//normal impulse
+
+		const Vector3 dv = lvB + avB.cross(rB) - lvA - avA.cross(rA);
+		const real_t vn = dv.dot(normal);
+
+		const bool apply_normal = active && Math::abs(vn) > GodotBodyContact3D::MIN_VELOCITY;
+		const real_t acc_normal_old = c[CONTACT_ACC_NORMAL_IMPULSE][lane];
+		const real_t acc_normal = apply_normal ? MAX(acc_normal_old - (c[CONTACT_BOUNCE][lane] + vn) * mass_normal, 0.0f) : acc_normal_old;
+		c[CONTACT_ACC_NORMAL_IMPULSE][lane] = acc_normal;
+
+		const Vector3 j = normal * (acc_normal - acc_normal_old);
+		lvA -= j * inv_mass_A;
+		avA += inv_inertia_tensor_A.xform(rA.cross(-j));
+		lvB += j * inv_mass_B;
+		avB += inv_inertia_tensor_B.xform(rB.cross(j));
+
+		//friction impulse
+
+		const Vector3 dtv = (lvB + avB.cross(rB)) - (lvA + avA.cross(rA));
+		Vector3 tv = dtv - normal * normal.dot(dtv);
+		const real_t tvl = tv.length();
+
+		const bool apply_friction = active && tvl > GodotBodyContact3D::MIN_VELOCITY;
+		tv *= apply_friction ? 1.0f / tvl : 0.0f;
+
+		const Vector3 temp1 = inv_inertia_tensor_A.xform(rA.cross(tv));
+		const Vector3 temp2 = inv_inertia_tensor_B.xform(rB.cross(tv));
+		const real_t t = apply_friction ? -tvl / (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(rA) + temp2.cross(rB))) : 0.0f;
+
+		const Vector3 acc_tangent_old(c[CONTACT_ACC_TANGENT_IMPULSE_X][lane], c[CONTACT_ACC_TANGENT_IMPULSE_Y][lane], c[CONTACT_ACC_TANGENT_IMPULSE_Z][lane]);
+		Vector3 acc_tangent = acc_tangent_old + tv * t;
+
+		const real_t fi_len = acc_tangent.length();
+		const real_t jt_max = acc_normal * c[CONTACT_FRICTION][lane];
+		acc_tangent *= (apply_friction && fi_len > CMP_EPSILON && fi_len > jt_max) ? jt_max / fi_len : 1.0f;
+		c[CONTACT_ACC_TANGENT_IMPULSE_X][lane] = acc_tangent.x;
+		c[CONTACT_ACC_TANGENT_IMPULSE_Y][lane] = acc_tangent.y;
+		c[CONTACT_ACC_TANGENT_IMPULSE_Z][lane] = acc_tangent.z;
+
+		const Vector3 jt = acc_tangent - acc_tangent_old;
+		lvA -= jt * inv_mass_A;
+		avA += inv_inertia_tensor_A.xform(rA.cross(-jt));
+		lvB += jt * inv_mass_B;
+		avB += inv_inertia_tensor_B.xform(rB.cross(jt));
+
+		// Deactivate the contact until the next step once it stops applying impulses.
+		c[CONTACT_ACTIVE][lane] = (apply_bias || apply_normal || apply_friction) ? 1.0f : 0.0f;
+
+		a[BODY_LINEAR_VELOCITY_X][lane] = lvA.x;
+		a[BODY_LINEAR_VELOCITY_Y][lane] = lvA.y;
+		a[BODY_LINEAR_VELOCITY_Z][lane] = lvA.z;
+		a[BODY_ANGULAR_VELOCITY_X][lane] = avA.x;
+		a[BODY_ANGULAR_VELOCITY_Y][lane] = avA.y;
+		a[BODY_ANGULAR_VELOCITY_Z][lane] = avA.z;
+		a[BODY_BIASED_LINEAR_VELOCITY_X][lane] = blvA.x;
+		a[BODY_BIASED_LINEAR_VELOCITY_Y][lane] = blvA.y;
+		a[BODY_BIASED_LINEAR_VELOCITY_Z][lane] = blvA.z;
+		a[BODY_BIASED_ANGULAR_VELOCITY_X][lane] = bavA.x;
+		a[BODY_BIASED_ANGULAR_VELOCITY_Y][lane] = bavA.y;
+		a[BODY_BIASED_ANGULAR_VELOCITY_Z][lane] = bavA.z;
+		b[BODY_LINEAR_VELOCITY_X][lane] = lvB.x;
+		b[BODY_LINEAR_VELOCITY_Y][lane] = lvB.y;
+		b[BODY_LINEAR_VELOCITY_Z][lane] = lvB.z;
+		b[BODY_ANGULAR_VELOCITY_X][lane] = avB.x;
+		b[BODY_ANGULAR_VELOCITY_Y][lane] = avB.y;
+		b[BODY_ANGULAR_VELOCITY_Z][lane] = avB.z;
+		b[BODY_BIASED_LINEAR_VELOCITY_X][lane] = blvB.x;
+		b[BODY_BIASED_LINEAR_VELOCITY_Y][lane] = blvB.y;
+		b[BODY_BIASED_LINEAR_VELOCITY_Z][lane] = blvB.z;
+		b[BODY_BIASED_ANGULAR_VELOCITY_X][lane] = bavB.x;
+		b[BODY_BIASED_ANGULAR_VELOCITY_Y][lane] = bavB.y;
+		b[BODY_BIASED_ANGULAR_VELOCITY_Z][lane] = bavB.z;
+	}
+
+	// Lanes never share a rigid body, and static or kinematic bodies are written back unchanged.
+	for (uint32_t field = 0; field < BODY_VELOCITY_FIELD_MAX; field++) {
+		real_t *data = body_data[field].ptr();
+		for (uint32_t lane = 0; lane < LANES; lane++) {
+			data[slot_A[lane]] = a[field][lane];
+			data[slot_B[lane]] = b[field][lane];
+		}
+	}
+}
+
+void GodotContactSolver3D::solve(real_t p_step) {
+	const real_t max_bias_av = GodotBodyContact3D::MAX_BIAS_ROTATION / p_step;
+
+	for (uint32_t batch = 0; batch < batch_count; batch++) {
+		_solve_batch(batch * LANES, max_bias_av);
+	}
+}
+
+void GodotContactSolver3D::load_body_velocities() {
+	for (uint32_t slot = 1; slot < bodies.size(); slot++) {
+		if (!body_dynamic[slot]) {
+			continue;
+		}
+
+		const GodotBody3D *body = bodies[slot];
+		const Vector3 linear_velocity = body->get_linear_velocity();
+		const Vector3 angular_velocity = body->get_angular_velocity();
+		const Vector3 &biased_linear_velocity = body->get_biased_linear_velocity();
+		const Vector3 &biased_angular_velocity = body->get_biased_angular_velocity();
+
+		body_data[BODY_LINEAR_VELOCITY_X][slot] = linear_velocity.x;
+		body_data[BODY_LINEAR_VELOCITY_Y][slot] = linear_velocity.y;
+		body_data[BODY_LINEAR_VELOCITY_Z][slot] = linear_velocity.z;
+		body_data[BODY_ANGULAR_VELOCITY_X][slot] = angular_velocity.x;
+		body_data[BODY_ANGULAR_VELOCITY_Y][slot] = angular_velocity.y;
+		body_data[BODY_ANGULAR_VELOCITY_Z][slot] = angular_velocity.z;
+		body_data[BODY_BIASED_LINEAR_VELOCITY_X][slot] = biased_linear_velocity.x;
+		body_data[BODY_BIASED_LINEAR_VELOCITY_Y][slot] = biased_linear_velocity.y;
+		body_data[BODY_BIASED_LINEAR_VELOCITY_Z][slot] = biased_linear_velocity.z;
+		body_data[BODY_BIASED_ANGULAR_VELOCITY_X][slot] = biased_angular_velocity.x;
+		body_data[BODY_BIASED_ANGULAR_VELOCITY_Y][slot] = biased_angular_velocity.y;
+		body_data[BODY_BIASED_ANGULAR_VELOCITY_Z][slot] = biased_angular_velocity.z;
+	}
+}
+
+void GodotContactSolver3D::store_body_velocities() const {
+	for (uint32_t slot = 1; slot < bodies.size(); slot++) {
+		if (!body_dynamic[slot]) {
+			continue;
+		}
+
+		GodotBody3D *body = bodies[slot];
+		body->set_linear_velocity(Vector3(body_data[BODY_LINEAR_VELOCITY_X][slot], body_data[BODY_LINEAR_VELOCITY_Y][slot], body_data[BODY_LINEAR_VELOCITY_Z][slot]));
+		body->set_angular_velocity(Vector3(body_data[BODY_ANGULAR_VELOCITY_X][slot], body_data[BODY_ANGULAR_VELOCITY_Y][slot], body_data[BODY_ANGULAR_VELOCITY_Z][slot]));
+		body->set_biased_linear_velocity(Vector3(body_data[BODY_BIASED_LINEAR_VELOCITY_X][slot], body_data[BODY_BIASED_LINEAR_VELOCITY_Y][slot], body_data[BODY_BIASED_LINEAR_VELOCITY_Z][slot]));
+		body->set_biased_angular_velocity(Vector3(body_data[BODY_BIASED_ANGULAR_VELOCITY_X][slot], body_data[BODY_BIASED_ANGULAR_VELOCITY_Y][slot], body_data[BODY_BIASED_ANGULAR_VELOCITY_Z][slot]));
+	}
+}
+
+void GodotContactSolver3D::finish() {
+	store_body_velocities();
+
+	for (const PackedContact &packed_contact : packed_contacts) {
+		GodotBodyPair3D::Contact &c = packed_contact.pair->contacts[packed_contact.index];
+		const uint32_t slot = packed_contact.slot;
+
+		const real_t acc_normal_impulse = contact_data[CONTACT_ACC_NORMAL_IMPULSE][slot];
+		const Vector3 acc_tangent_impulse(contact_data[CONTACT_ACC_TANGENT_IMPULSE_X][slot], contact_data[CONTACT_ACC_TANGENT_IMPULSE_Y][slot], contact_data[CONTACT_ACC_TANGENT_IMPULSE_Z][slot]);
+
+		// Same total as subtracting each applied impulse in GodotBodyPair3D::solve().
+		c.acc_impulse -= c.normal * (acc_normal_impulse - c.acc_normal_impulse) + (acc_tangent_impulse - c.acc_tangent_impulse);
+
+		c.acc_normal_impulse = acc_normal_impulse;
+		c.acc_tangent_impulse = acc_tangent_impulse;
+		c.acc_bias_impulse = contact_data[CONTACT_ACC_BIAS_IMPULSE][slot];
+		c.acc_bias_impulse_center_of_mass = contact_data[CONTACT_ACC_BIAS_IMPULSE_CENTER_OF_MASS][slot];
+		c.active = contact_data[CONTACT_ACTIVE][slot] != 0.0;
+	}
+}
@@ -0,0 +1,151 @@
+/**************************************************************************/
+/*  godot_contact_solver_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class GodotBody3D;
+class GodotBodyPair3D;
+class GodotConstraint3D;
+
+// Solves the contacts of an island's body pairs from structure-of-arrays buffers.
+// Contacts are grouped in batches of LANES contacts which never share a rigid body,
+// so all the lanes of a batch can be solved at once without conflicting writes.
+class GodotContactSolver3D {
+public:
+#ifdef REAL_T_IS_DOUBLE
+	static constexpr uint32_t LANES = 4;
+#else
+	static constexpr uint32_t LANES = 8;
+#endif
+
+private:
+	enum BodyField {
+		BODY_LINEAR_VELOCITY_X,
+		BODY_LINEAR_VELOCITY_Y,
+		BODY_LINEAR_VELOCITY_Z,
+		BODY_ANGULAR_VELOCITY_X,
+		BODY_ANGULAR_VELOCITY_Y,
+		BODY_ANGULAR_VELOCITY_Z,
+		BODY_BIASED_LINEAR_VELOCITY_X,
+		BODY_BIASED_LINEAR_VELOCITY_Y,
+		BODY_BIASED_LINEAR_VELOCITY_Z,
+		BODY_BIASED_ANGULAR_VELOCITY_X,
+		BODY_BIASED_ANGULAR_VELOCITY_Y,
+		BODY_BIASED_ANGULAR_VELOCITY_Z,
+		BODY_INV_MASS,
+		BODY_INV_INERTIA_XX,
+		BODY_INV_INERTIA_XY,
+		BODY_INV_INERTIA_XZ,
+		BODY_INV_INERTIA_YX,
+		BODY_INV_INERTIA_YY,
+		BODY_INV_INERTIA_YZ,
+		BODY_INV_INERTIA_ZX,
+		BODY_INV_INERTIA_ZY,
+		BODY_INV_INERTIA_ZZ,
+		BODY_FIELD_MAX,
+		// Only velocities change while solving.
+		BODY_VELOCITY_FIELD_MAX = BODY_INV_MASS,
+	};
+
+	enum ContactField {
+		CONTACT_NORMAL_X,
+		CONTACT_NORMAL_Y,
+		CONTACT_NORMAL_Z,
+		CONTACT_R_A_X,
+		CONTACT_R_A_Y,
+		CONTACT_R_A_Z,
+		CONTACT_R_B_X,
+		CONTACT_R_B_Y,
+		CONTACT_R_B_Z,
+		CONTACT_SCALE_A, // 0 when the contact doesn't push body A.
+		CONTACT_SCALE_B,
+		CONTACT_MASS_NORMAL,
+		CONTACT_BIAS,
+		CONTACT_BOUNCE,
+		CONTACT_FRICTION,
+		CONTACT_ACC_NORMAL_IMPULSE,
+		CONTACT_ACC_TANGENT_IMPULSE_X,
+		CONTACT_ACC_TANGENT_IMPULSE_Y,
+		CONTACT_ACC_TANGENT_IMPULSE_Z,
+		CONTACT_ACC_BIAS_IMPULSE,
+		CONTACT_ACC_BIAS_IMPULSE_CENTER_OF_MASS,
+		CONTACT_ACTIVE,
+		CONTACT_FIELD_MAX,
+	};
+
+	enum {
+		// Batches searched for a free lane before opening a new one.
+		MAX_BATCH_SEARCH = 64,
+	};
+
+	struct PackedContact {
+		GodotBodyPair3D *pair = nullptr;
+		int index = 0;
+		uint32_t body_A = 0;
+		uint32_t body_B = 0;
+		uint32_t slot = 0;
+	};
+
+	// Slot 0 is a static body with no velocity, used by the padding lanes.
+	LocalVector<GodotBody3D *> bodies;
+	LocalVector<bool> body_dynamic;
+	HashMap<GodotBody3D *, uint32_t> body_slots;
+	LocalVector<real_t> body_data[BODY_FIELD_MAX];
+
+	LocalVector<PackedContact> packed_contacts;
+	LocalVector<uint32_t> batch_sizes;
+	LocalVector<uint32_t> batch_bodies;
+
+	LocalVector<real_t> contact_data[CONTACT_FIELD_MAX];
+	LocalVector<uint32_t> contact_body_A;
+	LocalVector<uint32_t> contact_body_B;
+	uint32_t batch_count = 0;
+
+	uint32_t _get_body_slot(GodotBody3D *p_body);
+	uint32_t _find_batch(uint32_t p_body_A, uint32_t p_body_B, uint32_t p_first_batch);
+	void _solve_batch(uint32_t p_first_lane, real_t p_max_bias_av);
+
+public:
+	// Packs the contacts of the body pairs in the island, and removes these pairs from it.
+	void pack(LocalVector<GodotConstraint3D *> &r_constraint_island);
+	_FORCE_INLINE_ bool has_contacts() const { return batch_count > 0; }
+
+	void solve(real_t p_step);
+
+	// Used to interleave the batched contacts with constraints solved directly on the bodies.
+	void load_body_velocities();
+	void store_body_velocities() const;
+
+	// Writes back the velocities and accumulated impulses.
+	void finish();
+};
@@ -214,6 +214,22 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer3D::space_snapshot(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), Vector<uint8_t>(), "Space snapshots can't be taken while the space is being stepped.");
+
+	return space->snapshot();
+}
+
+void GodotPhysicsServer3D::space_restore(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	ERR_FAIL_COND_MSG(space->is_locked(), "Space snapshots can't be restored while the space is being stepped.");
+
+	space->restore(p_snapshot);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1079,10 +1079,7 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 		node.f = Vector3();
 	}
 
-	// Bounds and tree update.
-	update_bounds();
-
-	// Node tree update.
+	// Node tree update, the bounds are updated by the caller as they move the shape in the broadphase.
 	for (const Node &node : nodes) {
 		AABB node_aabb(node.x, Vector3());
 		node_aabb.expand_to(node.x + node.v * p_delta);
@@ -207,7 +207,9 @@ public:
 	void set_drag_coefficient(real_t p_val);
 	_FORCE_INLINE_ real_t get_drag_coefficient() const { return drag_coefficient; }
 
+	// Thread-safe for distinct soft bodies, update_bounds() must be called after it.
 	void predict_motion(real_t p_delta);
+	void update_bounds();
 	void solve_constraints(real_t p_delta);
 
 	_FORCE_INLINE_ uint32_t get_node_index(void *p_node) const { return static_cast<Node *>(p_node)->index; }
@@ -225,7 +227,6 @@ protected:
 
 private:
 	void update_normals_and_centroids();
-	void update_bounds();
 	void update_constants();
 	void update_area();
 	void reset_link_rest_lengths();
@@ -34,6 +34,7 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_pair_3d.h"
 
@@ -107,16 +108,15 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits) {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	// Batches cull from several threads, each with its own hit list, without locking the broadphase.
+	int amount = r_cull_hits ? space->broadphase->cull_segment_concurrent(begin, end, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices, *r_cull_hits) : space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -128,21 +128,21 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(r_cull_results[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,17 +207,16 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	if (p_result_max <= 0) {
-		return 0;
-	}
+bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
 
-	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
+int GodotPhysicsDirectSpaceState3D::_intersect_shape(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits) {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = r_cull_hits ? space->broadphase->cull_aabb_concurrent(aabb, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices, *r_cull_hits) : space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	int cc = 0;
 
@@ -228,20 +227,20 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
 		//area can't be picked by ray (default)
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -262,55 +261,63 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	if (p_result_max <= 0) {
+		return 0;
+	}
+
 	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
+	ERR_FAIL_NULL_V(shape, 0);
 
-	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
-	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
+	return _intersect_shape(p_parameters, shape, p_parameters.transform, r_results, p_result_max, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_cast_motion(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits) {
+	AABB aabb = p_transform.xform(p_shape->get_aabb());
+	aabb = aabb.merge(AABB(aabb.position + p_motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = r_cull_hits ? space->broadphase->cull_aabb_concurrent(aabb, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices, *r_cull_hits) : space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace3D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
-	Transform3D xform_inv = p_parameters.transform.affine_inverse();
+	Transform3D xform_inv = p_transform.affine_inverse();
 	GodotMotionShape3D mshape;
-	mshape.shape = shape;
-	mshape.motion = xform_inv.basis.xform(p_parameters.motion);
+	mshape.shape = p_shape;
+	mshape.motion = xform_inv.basis.xform(p_motion);
 
 	bool best_first = true;
 
-	Vector3 motion_normal = p_parameters.motion.normalized();
+	Vector3 motion_normal = p_motion.normalized();
 
 	Vector3 closest_A, closest_B;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject3D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
 		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
-		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
 		//test initial overlap, ignore objects it's inside of.
 		sep_axis = motion_normal;
 
-		if (!GodotCollisionSolver3D::solve_distance(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
+		if (!GodotCollisionSolver3D::solve_distance(p_shape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
 		}
 
@@ -321,11 +328,11 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 		for (int j = 0; j < 8; j++) { //steps should be customizable..
 			real_t fraction = low + (hi - low) * fraction_coeff;
 
-			mshape.motion = xform_inv.basis.xform(p_parameters.motion * fraction);
+			mshape.motion = xform_inv.basis.xform(p_motion * fraction);
 
 			Vector3 lA, lB;
 			Vector3 sep = motion_normal; //important optimization for this to work fast enough
-			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
+			bool collided = !GodotCollisionSolver3D::solve_distance(&mshape, p_transform, col_obj->get_shape(shape_idx), col_obj_xform, lA, lB, aabb, &sep);
 
 			if (collided) {
 				hi = fraction;
@@ -381,6 +388,101 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info) {
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	return _cast_motion(p_parameters, shape, p_parameters.transform, p_parameters.motion, p_closest_safe, p_closest_unsafe, r_info, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_rays_task(uint32_t p_index, RayQueryBatch *p_batch) {
+	// Each query culls into its own buffers, the space's buffers are shared.
+	static thread_local LocalVector<uint32_t> cull_hits;
+	GodotCollisionObject3D *cull_results[GodotSpace3D::INTERSECTION_QUERY_MAX];
+	int cull_subindices[GodotSpace3D::INTERSECTION_QUERY_MAX];
+
+	p_batch->collided[p_index] = _intersect_ray(*p_batch->parameters, p_batch->from[p_index], p_batch->to[p_index], p_batch->results[p_index], cull_results, cull_subindices, &cull_hits);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_shapes_task(uint32_t p_index, ShapeQueryBatch *p_batch) {
+	static thread_local LocalVector<uint32_t> cull_hits;
+	GodotCollisionObject3D *cull_results[GodotSpace3D::INTERSECTION_QUERY_MAX];
+	int cull_subindices[GodotSpace3D::INTERSECTION_QUERY_MAX];
+
+	p_batch->result_counts[p_index] = _intersect_shape(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], p_batch->results + p_index * p_batch->result_max, p_batch->result_max, cull_results, cull_subindices, &cull_hits);
+}
+
+void GodotPhysicsDirectSpaceState3D::_cast_motions_task(uint32_t p_index, ShapeQueryBatch *p_batch) {
+	static thread_local LocalVector<uint32_t> cull_hits;
+	GodotCollisionObject3D *cull_results[GodotSpace3D::INTERSECTION_QUERY_MAX];
+	int cull_subindices[GodotSpace3D::INTERSECTION_QUERY_MAX];
+
+	_cast_motion(*p_batch->parameters, p_batch->shape, p_batch->transforms[p_index], p_batch->motions[p_index], p_batch->closest_safe[p_index], p_batch->closest_unsafe[p_index], nullptr, cull_results, cull_subindices, &cull_hits);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, bool *r_collided, RayResult *r_results) {
+	ERR_FAIL_COND(space->locked);
+
+	RayQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.collided = r_collided;
+	batch.results = r_results;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_rays_task, &batch, p_count, -1, true, SNAME("Physics3DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	for (int i = 0; i < p_count; i++) {
+		r_result_counts[i] = 0;
+	}
+
+	ERR_FAIL_COND(space->locked);
+
+	if (p_result_max <= 0) {
+		return;
+	}
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_shapes_task, &batch, p_count, -1, true, SNAME("Physics3DIntersectShapes"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+
+	ERR_FAIL_COND(space->locked);
+
+	GodotShape3D *shape = GodotPhysicsServer3D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	ShapeQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.shape = shape;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_cast_motions_task, &batch, p_count, -1, true, SNAME("Physics3DCastMotions"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -1048,23 +1150,23 @@ void *GodotSpace3D::_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A
 		GodotArea3D *area = static_cast<GodotArea3D *>(A);
 		if (type_B == GodotCollisionObject3D::TYPE_AREA) {
 			GodotArea3D *area_b = static_cast<GodotArea3D *>(B);
-			GodotArea2Pair3D *area2_pair = memnew(GodotArea2Pair3D(area_b, p_subindex_B, area, p_subindex_A));
+			GodotArea2Pair3D *area2_pair = self->area2_pair_allocator.alloc(area_b, p_subindex_B, area, p_subindex_A);
 			return area2_pair;
 		} else if (type_B == GodotCollisionObject3D::TYPE_SOFT_BODY) {
 			GodotSoftBody3D *softbody = static_cast<GodotSoftBody3D *>(B);
-			GodotAreaSoftBodyPair3D *soft_area_pair = memnew(GodotAreaSoftBodyPair3D(softbody, p_subindex_B, area, p_subindex_A));
+			GodotAreaSoftBodyPair3D *soft_area_pair = self->area_soft_body_pair_allocator.alloc(softbody, p_subindex_B, area, p_subindex_A);
 			return soft_area_pair;
 		} else {
 			GodotBody3D *body = static_cast<GodotBody3D *>(B);
-			GodotAreaPair3D *area_pair = memnew(GodotAreaPair3D(body, p_subindex_B, area, p_subindex_A));
+			GodotAreaPair3D *area_pair = self->area_pair_allocator.alloc(body, p_subindex_B, area, p_subindex_A);
 			return area_pair;
 		}
 	} else if (type_A == GodotCollisionObject3D::TYPE_BODY) {
 		if (type_B == GodotCollisionObject3D::TYPE_SOFT_BODY) {
-			GodotBodySoftBodyPair3D *soft_pair = memnew(GodotBodySoftBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotSoftBody3D *>(B)));
+			GodotBodySoftBodyPair3D *soft_pair = self->body_soft_body_pair_allocator.alloc(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotSoftBody3D *>(B));
 			return soft_pair;
 		} else {
-			GodotBodyPair3D *b = memnew(GodotBodyPair3D(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotBody3D *>(B), p_subindex_B));
+			GodotBodyPair3D *b = self->body_pair_allocator.alloc(static_cast<GodotBody3D *>(A), p_subindex_A, static_cast<GodotBody3D *>(B), p_subindex_B);
 			return b;
 		}
 	} else {
@@ -1081,8 +1183,27 @@ void GodotSpace3D::_broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_
 
 	GodotSpace3D *self = static_cast<GodotSpace3D *>(p_self);
 	self->collision_pairs--;
-	GodotConstraint3D *c = static_cast<GodotConstraint3D *>(p_data);
-	memdelete(c);
+
+	// Same ordering as in _broadphase_pair(), to find the allocator the pair came from.
+	GodotCollisionObject3D::Type type_A = A->get_type();
+	GodotCollisionObject3D::Type type_B = B->get_type();
+	if (type_A > type_B) {
+		SWAP(type_A, type_B);
+	}
+
+	if (type_A == GodotCollisionObject3D::TYPE_AREA) {
+		if (type_B == GodotCollisionObject3D::TYPE_AREA) {
+			self->area2_pair_allocator.free(static_cast<GodotArea2Pair3D *>(p_data));
+		} else if (type_B == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+			self->area_soft_body_pair_allocator.free(static_cast<GodotAreaSoftBodyPair3D *>(p_data));
+		} else {
+			self->area_pair_allocator.free(static_cast<GodotAreaPair3D *>(p_data));
+		}
+	} else if (type_B == GodotCollisionObject3D::TYPE_SOFT_BODY) {
+		self->body_soft_body_pair_allocator.free(static_cast<GodotBodySoftBodyPair3D *>(p_data));
+	} else {
+		self->body_pair_allocator.free(static_cast<GodotBodyPair3D *>(p_data));
+	}
 }
 
 const SelfList<GodotBody3D>::List &GodotSpace3D::get_active_body_list() const {
@@ -1256,6 +1377,183 @@ GodotPhysicsDirectSpaceState3D *GodotSpace3D::get_direct_state() {
 	return direct_access;
 }
 
+// A snapshot is this header followed by the body states, the shape AABBs of all bodies,
+// and the body pair states. They're all trivially copyable and their offsets are
+// multiples of 8 bytes, so they're written and read in place.
+struct SpaceSnapshotHeader3D {
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t body_count = 0;
+	uint32_t shape_count = 0;
+	uint32_t pair_count = 0;
+	uint32_t padding = 0;
+};
+
+static constexpr uint32_t SPACE_SNAPSHOT_MAGIC_3D = 0x33535047; // "GPS3"
+static constexpr uint32_t SPACE_SNAPSHOT_VERSION_3D = 1;
+
+static_assert(std::is_trivially_copyable_v<GodotBody3D::State>);
+static_assert(std::is_trivially_copyable_v<GodotBodyPair3D::State>);
+
+Vector<uint8_t> GodotSpace3D::snapshot() const {
+	LocalVector<const GodotBody3D *> bodies;
+	HashMap<const GodotBody3D *, uint32_t> body_indices;
+	uint32_t shape_count = 0;
+	for (const GodotCollisionObject3D *object : objects) {
+		if (object->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(object);
+		body_indices.insert(body, bodies.size());
+		bodies.push_back(body);
+		shape_count += body->get_shape_count();
+	}
+
+	// Body pairs are in the constraint map of both bodies, only take them from body A.
+	LocalVector<const GodotBodyPair3D *> pairs;
+	for (const GodotBody3D *body : bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			if (E.value == 0 && E.key->is_body_pair()) {
+				pairs.push_back(static_cast<const GodotBodyPair3D *>(E.key));
+			}
+		}
+	}
+
+	const uint32_t body_offset = sizeof(SpaceSnapshotHeader3D);
+	const uint32_t shape_offset = body_offset + bodies.size() * sizeof(GodotBody3D::State);
+	const uint32_t pair_offset = shape_offset + shape_count * sizeof(AABB);
+
+	Vector<uint8_t> snapshot;
+	snapshot.resize(pair_offset + pairs.size() * sizeof(GodotBodyPair3D::State));
+	uint8_t *w = snapshot.ptrw();
+
+	SpaceSnapshotHeader3D *header = reinterpret_cast<SpaceSnapshotHeader3D *>(w);
+	*header = SpaceSnapshotHeader3D();
+	header->magic = SPACE_SNAPSHOT_MAGIC_3D;
+	header->version = SPACE_SNAPSHOT_VERSION_3D;
+	header->body_count = bodies.size();
+	header->shape_count = shape_count;
+	header->pair_count = pairs.size();
+
+	GodotBody3D::State *body_states = reinterpret_cast<GodotBody3D::State *>(w + body_offset);
+	AABB *shape_aabbs = reinterpret_cast<AABB *>(w + shape_offset);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		const GodotBody3D *body = bodies[i];
+		body_states[i] = GodotBody3D::State();
+		body->save_state(body_states[i]);
+		for (int j = 0; j < body->get_shape_count(); j++) {
+			*shape_aabbs++ = body->get_shape_aabb(j);
+		}
+	}
+
+	GodotBodyPair3D::State *pair_states = reinterpret_cast<GodotBodyPair3D::State *>(w + pair_offset);
+	for (uint32_t i = 0; i < pairs.size(); i++) {
+		const GodotBodyPair3D *pair = pairs[i];
+		pair_states[i] = GodotBodyPair3D::State();
+		pair->save_state(pair_states[i]);
+		pair_states[i].body_A = body_indices[pair->get_body_A()];
+		pair_states[i].body_B = body_indices[pair->get_body_B()];
+	}
+
+	return snapshot;
+}
+
+void GodotSpace3D::restore(const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_COND_MSG(p_snapshot.size() < (int64_t)sizeof(SpaceSnapshotHeader3D), "Invalid space snapshot.");
+
+	const uint8_t *r = p_snapshot.ptr();
+	const SpaceSnapshotHeader3D *header = reinterpret_cast<const SpaceSnapshotHeader3D *>(r);
+	ERR_FAIL_COND_MSG(header->magic != SPACE_SNAPSHOT_MAGIC_3D || header->version != SPACE_SNAPSHOT_VERSION_3D, "Invalid space snapshot.");
+
+	const uint64_t body_offset = sizeof(SpaceSnapshotHeader3D);
+	const uint64_t shape_offset = body_offset + header->body_count * sizeof(GodotBody3D::State);
+	const uint64_t pair_offset = shape_offset + header->shape_count * sizeof(AABB);
+	ERR_FAIL_COND_MSG((uint64_t)p_snapshot.size() != pair_offset + header->pair_count * sizeof(GodotBodyPair3D::State), "Invalid space snapshot.");
+
+	const GodotBody3D::State *body_states = reinterpret_cast<const GodotBody3D::State *>(r + body_offset);
+	const AABB *shape_aabbs = reinterpret_cast<const AABB *>(r + shape_offset);
+	const GodotBodyPair3D::State *pair_states = reinterpret_cast<const GodotBodyPair3D::State *>(r + pair_offset);
+
+	// Bodies are saved in the order of the space objects, which stays the same unless objects are added or removed.
+	LocalVector<GodotBody3D *> bodies;
+	bodies.resize(header->body_count);
+	uint32_t body_count = 0;
+	bool same_order = true;
+	for (GodotCollisionObject3D *object : objects) {
+		if (object->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		if (body_count == header->body_count || object->get_self() != body_states[body_count].self) {
+			same_order = false;
+			break;
+		}
+		bodies[body_count++] = static_cast<GodotBody3D *>(object);
+	}
+
+	if (!same_order || body_count != header->body_count) {
+		HashMap<RID, GodotBody3D *> bodies_by_rid;
+		for (GodotCollisionObject3D *object : objects) {
+			if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+				bodies_by_rid.insert(object->get_self(), static_cast<GodotBody3D *>(object));
+			}
+		}
+		ERR_FAIL_COND_MSG(bodies_by_rid.size() != header->body_count, "The bodies in the space changed since the snapshot was taken.");
+
+		for (uint32_t i = 0; i < header->body_count; i++) {
+			GodotBody3D **body = bodies_by_rid.getptr(body_states[i].self);
+			ERR_FAIL_NULL_MSG(body, "The bodies in the space changed since the snapshot was taken.");
+			bodies[i] = *body;
+		}
+	}
+
+	uint32_t shape_count = 0;
+	for (uint32_t i = 0; i < header->body_count; i++) {
+		ERR_FAIL_COND_MSG(bodies[i]->get_shape_count() != (int)body_states[i].shape_count, "The shapes of a body changed since the snapshot was taken.");
+		shape_count += body_states[i].shape_count;
+	}
+	ERR_FAIL_COND_MSG(shape_count != header->shape_count, "Invalid space snapshot.");
+
+	for (uint32_t i = 0; i < header->pair_count; i++) {
+		const GodotBodyPair3D::State &pair_state = pair_states[i];
+		ERR_FAIL_COND_MSG(pair_state.body_A >= header->body_count || pair_state.body_B >= header->body_count, "Invalid space snapshot.");
+		ERR_FAIL_COND_MSG(pair_state.contact_count < 0 || pair_state.contact_count > (int)std::size(pair_state.contacts), "Invalid space snapshot.");
+	}
+
+	for (uint32_t i = 0; i < header->body_count; i++) {
+		bodies[i]->restore_state(body_states[i], shape_aabbs);
+		shape_aabbs += body_states[i].shape_count;
+	}
+
+	// Let the broadphase add and remove pairs for the restored bounds.
+	broadphase->update();
+
+	// Pairs which aren't in the snapshot start over without contacts.
+	for (GodotBody3D *body : bodies) {
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			if (E.value == 0 && E.key->is_body_pair()) {
+				static_cast<GodotBodyPair3D *>(E.key)->reset_state();
+			}
+		}
+	}
+
+	// Pairs only overlapping within the broadphase margin may not be created again,
+	// they'll find their contacts again on the next step.
+	for (uint32_t i = 0; i < header->pair_count; i++) {
+		const GodotBodyPair3D::State &pair_state = pair_states[i];
+		const GodotBody3D *body_B = bodies[pair_state.body_B];
+		for (const KeyValue<GodotConstraint3D *, int> &E : bodies[pair_state.body_A]->get_constraint_map()) {
+			if (E.value != 0 || !E.key->is_body_pair()) {
+				continue;
+			}
+			GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(E.key);
+			if (pair->get_body_B() == body_B && pair->get_shape_A() == pair_state.shape_A && pair->get_shape_B() == pair_state.shape_B) {
+				pair->restore_state(pair_state);
+				break;
+			}
+		}
+	}
+}
+
 GodotSpace3D::GodotSpace3D() {
 	body_linear_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_linear");
 	body_angular_velocity_sleep_threshold = GLOBAL_GET("physics/3d/sleep_threshold_angular");
@@ -1265,8 +1563,15 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	use_batched_contact_solver = GLOBAL_GET("physics/3d/solver/use_batched_contact_solver");
 
 	broadphase = GodotBroadPhase3D::create_func();
+	body_pair_allocator.configure(PAIR_ALLOCATOR_PAGE_SIZE);
+	body_soft_body_pair_allocator.configure(PAIR_ALLOCATOR_PAGE_SIZE);
+	area_pair_allocator.configure(PAIR_ALLOCATOR_PAGE_SIZE);
+	area2_pair_allocator.configure(PAIR_ALLOCATOR_PAGE_SIZE);
+	area_soft_body_pair_allocator.configure(PAIR_ALLOCATOR_PAGE_SIZE);
+
 	broadphase->set_pair_callback(_broadphase_pair, this);
 	broadphase->set_unpair_callback(_broadphase_unpair, this);
 
@@ -31,16 +31,47 @@
 #pragma once
 
 #include "godot_area_3d.h"
+#include "godot_area_pair_3d.h"
 #include "godot_body_3d.h"
+#include "godot_body_pair_3d.h"
 #include "godot_broad_phase_3d.h"
 #include "godot_collision_object_3d.h"
 #include "godot_soft_body_3d.h"
 
+#include "core/templates/paged_allocator.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	struct RayQueryBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		bool *collided = nullptr;
+		RayResult *results = nullptr;
+	};
+
+	struct ShapeQueryBatch {
+		const ShapeParameters *parameters = nullptr;
+		GodotShape3D *shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		const Vector3 *motions = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits = nullptr);
+	int _intersect_shape(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits = nullptr);
+	bool _cast_motion(const ShapeParameters &p_parameters, GodotShape3D *p_shape, const Transform3D &p_transform, const Vector3 &p_motion, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices, LocalVector<uint32_t> *r_cull_hits = nullptr);
+
+	void _intersect_rays_task(uint32_t p_index, RayQueryBatch *p_batch);
+	void _intersect_shapes_task(uint32_t p_index, ShapeQueryBatch *p_batch);
+	void _cast_motions_task(uint32_t p_index, ShapeQueryBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -52,6 +83,10 @@ public:
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const override;
 
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, bool *r_collided, RayResult *r_results) override;
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	GodotPhysicsDirectSpaceState3D();
 };
 
@@ -84,6 +119,18 @@ private:
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
 
+	// Pairs are created and destroyed in bulk as objects move, so they're pooled
+	// instead of going through the general allocator one at a time.
+	enum {
+		PAIR_ALLOCATOR_PAGE_SIZE = 256
+	};
+
+	PagedAllocator<GodotBodyPair3D> body_pair_allocator;
+	PagedAllocator<GodotBodySoftBodyPair3D> body_soft_body_pair_allocator;
+	PagedAllocator<GodotAreaPair3D> area_pair_allocator;
+	PagedAllocator<GodotArea2Pair3D> area2_pair_allocator;
+	PagedAllocator<GodotAreaSoftBodyPair3D> area_soft_body_pair_allocator;
+
 	HashSet<GodotCollisionObject3D *> objects;
 
 	GodotArea3D *area = nullptr;
@@ -95,6 +142,8 @@ private:
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
 
+	bool use_batched_contact_solver = false;
+
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
 	};
@@ -160,6 +209,7 @@ public:
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
+	_FORCE_INLINE_ bool is_using_batched_contact_solver() const { return use_batched_contact_solver; }
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
@@ -172,6 +222,10 @@ public:
 	void lock();
 	void unlock();
 
+	// Saves and restores the simulated state of the bodies, for rollback.
+	Vector<uint8_t> snapshot() const;
+	void restore(const Vector<uint8_t> &p_snapshot);
+
 	real_t get_last_step() const { return last_step; }
 	void set_last_step(real_t p_step) { last_step = p_step; }
 
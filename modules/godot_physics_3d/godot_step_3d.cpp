@@ -32,6 +32,7 @@
 
 #include "godot_joint_3d.h"
 
+#include "core/debugger/trace_events.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
@@ -112,11 +113,30 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_gather_active_bodies(const SelfList<GodotBody3D>::List &p_body_list) {
+	active_bodies.clear();
+	for (const SelfList<GodotBody3D> *b = p_body_list.first(); b; b = b->next()) {
+		active_bodies.push_back(b->self());
+	}
+}
+
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata) {
+	active_soft_bodies[p_soft_body_index]->predict_motion(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
 }
 
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
@@ -136,6 +156,12 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	int current_priority = 1;
 
 	uint32_t constraint_count = constraint_island.size();
+	if (use_batched_contact_solver) {
+		// Solves the first priority pass, and leaves the higher priority constraints in the island.
+		constraint_count = _solve_island_batched(p_island_index);
+		++current_priority;
+	}
+
 	while (constraint_count > 0) {
 		for (int i = 0; i < iterations; i++) {
 			// Go through all iterations.
@@ -158,6 +184,40 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+uint32_t GodotStep3D::_solve_island_batched(uint32_t p_island_index) {
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+	GodotContactSolver3D &contact_solver = contact_solvers[p_island_index];
+
+	// Body pairs are moved out of the island into the contact solver.
+	contact_solver.pack(constraint_island);
+
+	uint32_t constraint_count = constraint_island.size();
+	for (int i = 0; i < iterations; i++) {
+		contact_solver.solve(delta);
+
+		if (constraint_count > 0) {
+			// Joints and soft body contacts work on the bodies directly.
+			contact_solver.store_body_velocities();
+			for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+				constraint_island[constraint_index]->solve(delta);
+			}
+			contact_solver.load_body_velocities();
+		}
+	}
+
+	contact_solver.finish();
+
+	// Body pairs have the default priority, only keep higher priority constraints.
+	uint32_t priority_constraint_count = 0;
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = constraint_island[constraint_index];
+		if (constraint->get_priority() >= 2) {
+			constraint_island[priority_constraint_count++] = constraint;
+		}
+	}
+	return priority_constraint_count;
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -183,6 +243,8 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	TRACE_ZONE("GodotStep3D::step");
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -201,25 +263,31 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	_gather_active_bodies(*body_list);
 
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Broadphase updates aren't thread-safe, and are applied in list order to keep pairs deterministic.
+	for (GodotBody3D *body : active_bodies) {
+		body->apply_deferred_updates();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
 
-	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
-	while (sb) {
-		sb->self()->predict_motion(p_delta);
-		sb = sb->next();
-		active_count++;
+	active_soft_bodies.clear();
+	for (const SelfList<GodotSoftBody3D> *sb = soft_body_list->first(); sb; sb = sb->next()) {
+		active_soft_bodies.push_back(sb->self());
 	}
 
-	p_space->set_active_objects(active_count);
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_predict_soft_body_motion, nullptr, active_soft_bodies.size(), -1, true, SNAME("Physics3DPredictSoftBodyMotion"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotSoftBody3D *soft_body : active_soft_bodies) {
+		soft_body->update_bounds();
+	}
+
+	p_space->set_active_objects(active_bodies.size() + active_soft_bodies.size());
 
 	// Update the broadphase to register collision pairs.
 	p_space->update();
@@ -260,7 +328,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody3D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -299,7 +367,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE SOFT BODIES */
 
-	sb = soft_body_list->first();
+	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
 	while (sb) {
 		GodotSoftBody3D *soft_body = sb->self();
 
@@ -344,7 +412,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -362,6 +430,11 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	use_batched_contact_solver = p_space->is_using_batched_contact_solver();
+	if (use_batched_contact_solver && contact_solvers.size() < island_count) {
+		contact_solvers.resize(island_count);
+	}
+
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
@@ -375,11 +448,14 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+	// New pairs may have woken up more bodies since the forces were integrated.
+	_gather_active_bodies(*body_list);
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	for (GodotBody3D *body : active_bodies) {
+		body->apply_deferred_updates();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
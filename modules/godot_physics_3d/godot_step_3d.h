@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "godot_contact_solver_3d.h"
 #include "godot_space_3d.h"
 
 #include "core/templates/local_vector.h"
@@ -39,16 +40,25 @@ class GodotStep3D {
 
 	int iterations = 0;
 	real_t delta = 0.0;
+	bool use_batched_contact_solver = false;
 
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotBody3D *> active_bodies;
+	LocalVector<GodotSoftBody3D *> active_soft_bodies;
+	LocalVector<GodotContactSolver3D> contact_solvers;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _gather_active_bodies(const SelfList<GodotBody3D>::List &p_body_list);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _predict_soft_body_motion(uint32_t p_soft_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	uint32_t _solve_island_batched(uint32_t p_island_index);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
@@ -44,6 +44,8 @@
 #include "jolt_query_filter_3d.h"
 #include "jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include "Jolt/Geometry/GJKClosestPoint.h"
 #include "Jolt/Physics/Body/Body.h"
 #include "Jolt/Physics/Body/BodyFilter.h"
@@ -461,15 +463,9 @@ JoltPhysicsDirectSpaceState3D::JoltPhysicsDirectSpaceState3D(JoltSpace3D *p_spac
 		space(p_space) {
 }
 
-bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
-
-	space->flush_pending_objects();
-
-	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
-
-	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
-	const JPH::RVec3 to = to_jolt_r(p_parameters.to);
+bool JoltPhysicsDirectSpaceState3D::_intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, const JoltQueryFilter3D &p_query_filter, RayResult &r_result) {
+	const JPH::RVec3 from = to_jolt_r(p_from);
+	const JPH::RVec3 to = to_jolt_r(p_to);
 	const JPH::Vec3 vector = JPH::Vec3(to - from);
 	const JPH::RRayCast ray(from, vector);
 
@@ -480,7 +476,7 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	settings.mBackFaceModeTriangles = back_face_mode;
 
 	JoltQueryCollectorClosest<JPH::CastRayCollector> collector;
-	space->get_narrow_phase_query().CastRay(ray, settings, collector, query_filter, query_filter, query_filter);
+	space->get_narrow_phase_query().CastRay(ray, settings, collector, p_query_filter, p_query_filter, p_query_filter);
 
 	if (!collector.had_hit()) {
 		return false;
@@ -524,6 +520,16 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	return true;
 }
 
+bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
+
+	space->flush_pending_objects();
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+
+	return _intersect_ray(p_parameters, p_parameters.from, p_parameters.to, query_filter, r_result);
+}
+
 int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_point must not be called while the physics space is being stepped.");
 
@@ -562,37 +568,21 @@ int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_para
 	return hit_count;
 }
 
-int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_shape must not be called while the physics space is being stepped.");
-
-	if (p_result_max == 0) {
-		return 0;
-	}
-
-	space->flush_pending_objects();
-
-	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, 0);
-
-	const JPH::ShapeRefC jolt_shape = shape->try_build();
-	ERR_FAIL_NULL_V(jolt_shape, 0);
-
-	Transform3D transform = p_parameters.transform;
+int JoltPhysicsDirectSpaceState3D::_intersect_shape(const ShapeParameters &p_parameters, const JPH::Shape *p_jolt_shape, const Transform3D &p_transform, const JoltQueryFilter3D &p_query_filter, ShapeResult *r_results, int p_result_max) {
+	Transform3D transform = p_transform;
 	JOLT_ENSURE_SCALE_NOT_ZERO(transform, "intersect_shape was passed an invalid transform.");
 
 	Vector3 scale;
 	JoltMath::decompose(transform, scale);
-	JOLT_ENSURE_SCALE_VALID(jolt_shape, scale, "intersect_shape was passed an invalid transform.");
+	JOLT_ENSURE_SCALE_VALID(p_jolt_shape, scale, "intersect_shape was passed an invalid transform.");
 
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
+	const Vector3 com_scaled = to_godot(p_jolt_shape->GetCenterOfMass());
 	const Transform3D transform_com = transform.translated_local(com_scaled);
 
 	JPH::CollideShapeSettings settings;
 	settings.mMaxSeparationDistance = (float)p_parameters.margin;
-
-	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
 	JoltQueryCollectorAnyMulti<JPH::CollideShapeCollector, 32> collector(p_result_max);
-	_collide_shape_queries(jolt_shape, to_jolt(scale), to_jolt_r(transform_com), settings, to_jolt_r(transform_com.origin), collector, query_filter, query_filter, query_filter);
+	_collide_shape_queries(p_jolt_shape, to_jolt(scale), to_jolt_r(transform_com), settings, to_jolt_r(transform_com.origin), collector, p_query_filter, p_query_filter, p_query_filter);
 
 	const int hit_count = collector.get_hit_count();
 
@@ -619,37 +609,158 @@ int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_para
 	return hit_count;
 }
 
-bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &r_closest_safe, real_t &r_closest_unsafe, ShapeRestInfo *r_info) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "cast_motion must not be called while the physics space is being stepped.");
-	ERR_FAIL_COND_V_MSG(r_info != nullptr, false, "Providing rest info as part of cast_motion is not supported when using Jolt Physics.");
+int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_shape must not be called while the physics space is being stepped.");
+
+	if (p_result_max == 0) {
+		return 0;
+	}
 
 	space->flush_pending_objects();
 
 	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
-	ERR_FAIL_NULL_V(shape, false);
+	ERR_FAIL_NULL_V(shape, 0);
 
 	const JPH::ShapeRefC jolt_shape = shape->try_build();
-	ERR_FAIL_NULL_V(jolt_shape, false);
+	ERR_FAIL_NULL_V(jolt_shape, 0);
 
-	Transform3D transform = p_parameters.transform;
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+
+	return _intersect_shape(p_parameters, jolt_shape, p_parameters.transform, query_filter, r_results, p_result_max);
+}
+
+void JoltPhysicsDirectSpaceState3D::_cast_motion(const ShapeParameters &p_parameters, const JPH::Shape &p_jolt_shape, const Transform3D &p_transform, const Vector3 &p_motion, const JoltQueryFilter3D &p_query_filter, real_t &r_closest_safe, real_t &r_closest_unsafe) {
+	Transform3D transform = p_transform;
 	JOLT_ENSURE_SCALE_NOT_ZERO(transform, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
 
 	Vector3 scale;
 	JoltMath::decompose(transform, scale);
-	JOLT_ENSURE_SCALE_VALID(jolt_shape, scale, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
+	JOLT_ENSURE_SCALE_VALID(&p_jolt_shape, scale, "cast_motion (maybe from ShapeCast3D?) was passed an invalid transform.");
 
-	const Vector3 com_scaled = to_godot(jolt_shape->GetCenterOfMass());
+	const Vector3 com_scaled = to_godot(p_jolt_shape.GetCenterOfMass());
 	Transform3D transform_com = transform.translated_local(com_scaled);
 
 	JPH::CollideShapeSettings settings;
 	settings.mMaxSeparationDistance = (float)p_parameters.margin;
+	_cast_motion_impl(p_jolt_shape, transform_com, scale, p_motion, JoltProjectSettings::use_enhanced_internal_edge_removal_for_queries, true, settings, p_query_filter, p_query_filter, p_query_filter, JPH::ShapeFilter(), r_closest_safe, r_closest_unsafe);
+}
+
+bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &r_closest_safe, real_t &r_closest_unsafe, ShapeRestInfo *r_info) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "cast_motion must not be called while the physics space is being stepped.");
+	ERR_FAIL_COND_V_MSG(r_info != nullptr, false, "Providing rest info as part of cast_motion is not supported when using Jolt Physics.");
+
+	space->flush_pending_objects();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL_V(shape, false);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL_V(jolt_shape, false);
 
 	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
-	_cast_motion_impl(*jolt_shape, transform_com, scale, p_parameters.motion, JoltProjectSettings::use_enhanced_internal_edge_removal_for_queries, true, settings, query_filter, query_filter, query_filter, JPH::ShapeFilter(), r_closest_safe, r_closest_unsafe);
+
+	_cast_motion(p_parameters, *jolt_shape, p_parameters.transform, p_parameters.motion, query_filter, r_closest_safe, r_closest_unsafe);
 
 	return true;
 }
 
+void JoltPhysicsDirectSpaceState3D::_intersect_rays_task(uint32_t p_index, RayQueryBatch *p_batch) {
+	p_batch->collided[p_index] = _intersect_ray(*p_batch->parameters, p_batch->from[p_index], p_batch->to[p_index], *p_batch->query_filter, p_batch->results[p_index]);
+}
+
+void JoltPhysicsDirectSpaceState3D::_intersect_shapes_task(uint32_t p_index, ShapeQueryBatch *p_batch) {
+	p_batch->result_counts[p_index] = _intersect_shape(*p_batch->parameters, p_batch->jolt_shape, p_batch->transforms[p_index], *p_batch->query_filter, p_batch->results + p_index * p_batch->result_max, p_batch->result_max);
+}
+
+void JoltPhysicsDirectSpaceState3D::_cast_motions_task(uint32_t p_index, ShapeQueryBatch *p_batch) {
+	_cast_motion(*p_batch->parameters, *p_batch->jolt_shape, p_batch->transforms[p_index], p_batch->motions[p_index], *p_batch->query_filter, p_batch->closest_safe[p_index], p_batch->closest_unsafe[p_index]);
+}
+
+void JoltPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, bool *r_collided, RayResult *r_results) {
+	ERR_FAIL_COND_MSG(space->is_stepping(), "intersect_rays must not be called while the physics space is being stepped.");
+
+	space->flush_pending_objects();
+
+	// The queries only read from the physics system, so they can share the filter and run concurrently.
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
+
+	RayQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.query_filter = &query_filter;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.collided = r_collided;
+	batch.results = r_results;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_intersect_rays_task, &batch, p_count, -1, true, SNAME("JoltIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void JoltPhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	for (int i = 0; i < p_count; i++) {
+		r_result_counts[i] = 0;
+	}
+
+	ERR_FAIL_COND_MSG(space->is_stepping(), "intersect_shapes must not be called while the physics space is being stepped.");
+
+	if (p_result_max == 0) {
+		return;
+	}
+
+	space->flush_pending_objects();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL(jolt_shape);
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+
+	ShapeQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.query_filter = &query_filter;
+	batch.jolt_shape = jolt_shape;
+	batch.transforms = p_transforms;
+	batch.results = r_results;
+	batch.result_max = p_result_max;
+	batch.result_counts = r_result_counts;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_intersect_shapes_task, &batch, p_count, -1, true, SNAME("JoltIntersectShapes"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void JoltPhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0f;
+		r_closest_unsafe[i] = 1.0f;
+	}
+
+	ERR_FAIL_COND_MSG(space->is_stepping(), "cast_motions must not be called while the physics space is being stepped.");
+
+	space->flush_pending_objects();
+
+	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
+	ERR_FAIL_NULL(shape);
+
+	const JPH::ShapeRefC jolt_shape = shape->try_build();
+	ERR_FAIL_NULL(jolt_shape);
+
+	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude);
+
+	ShapeQueryBatch batch;
+	batch.parameters = &p_parameters;
+	batch.query_filter = &query_filter;
+	batch.jolt_shape = jolt_shape;
+	batch.transforms = p_transforms;
+	batch.motions = p_motions;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsDirectSpaceState3D::_cast_motions_task, &batch, p_count, -1, true, SNAME("JoltCastMotions"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 bool JoltPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	r_result_count = 0;
 
@@ -43,6 +43,7 @@
 #include "Jolt/Physics/Collision/ShapeFilter.h"
 
 class JoltBody3D;
+class JoltQueryFilter3D;
 class JoltShape3D;
 class JoltSpace3D;
 
@@ -53,6 +54,36 @@ class JoltPhysicsDirectSpaceState3D final : public PhysicsDirectSpaceState3D {
 
 	static void _bind_methods() {}
 
+	struct RayQueryBatch {
+		const RayParameters *parameters = nullptr;
+		const JoltQueryFilter3D *query_filter = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		bool *collided = nullptr;
+		RayResult *results = nullptr;
+	};
+
+	struct ShapeQueryBatch {
+		const ShapeParameters *parameters = nullptr;
+		const JoltQueryFilter3D *query_filter = nullptr;
+		const JPH::Shape *jolt_shape = nullptr;
+		const Transform3D *transforms = nullptr;
+		const Vector3 *motions = nullptr;
+		ShapeResult *results = nullptr;
+		int result_max = 0;
+		int *result_counts = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	bool _intersect_ray(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, const JoltQueryFilter3D &p_query_filter, RayResult &r_result);
+	int _intersect_shape(const ShapeParameters &p_parameters, const JPH::Shape *p_jolt_shape, const Transform3D &p_transform, const JoltQueryFilter3D &p_query_filter, ShapeResult *r_results, int p_result_max);
+	void _cast_motion(const ShapeParameters &p_parameters, const JPH::Shape &p_jolt_shape, const Transform3D &p_transform, const Vector3 &p_motion, const JoltQueryFilter3D &p_query_filter, real_t &r_closest_safe, real_t &r_closest_unsafe);
+
+	void _intersect_rays_task(uint32_t p_index, RayQueryBatch *p_batch);
+	void _intersect_shapes_task(uint32_t p_index, ShapeQueryBatch *p_batch);
+	void _cast_motions_task(uint32_t p_index, ShapeQueryBatch *p_batch);
+
 	bool _cast_motion_impl(const JPH::Shape &p_jolt_shape, const Transform3D &p_transform_com, const Vector3 &p_scale, const Vector3 &p_motion, bool p_use_edge_removal, bool p_ignore_overlaps, const JPH::CollideShapeSettings &p_settings, const JPH::BroadPhaseLayerFilter &p_broad_phase_layer_filter, const JPH::ObjectLayerFilter &p_object_layer_filter, const JPH::BodyFilter &p_body_filter, const JPH::ShapeFilter &p_shape_filter, real_t &r_closest_safe, real_t &r_closest_unsafe) const;
 
 	bool _body_motion_recover(const JoltBody3D &p_body, const Transform3D &p_transform, float p_margin, const HashSet<RID> &p_excluded_bodies, const HashSet<ObjectID> &p_excluded_objects, Vector3 &r_recovery) const;
@@ -78,6 +109,10 @@ public:
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) override;
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, Vector3 p_point) const override;
 
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, bool *r_collided, RayResult *r_results) override;
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) override;
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) override;
+
 	bool body_test_motion(const JoltBody3D &p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) const;
 
 	JoltSpace3D &get_space() const { return *space; }
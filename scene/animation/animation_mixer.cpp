@@ -32,6 +32,7 @@
 #include "animation_mixer.compat.inc"
 
 #include "core/config/engine.h"
+#include "core/debugger/frame_benchmark.h"
 #include "core/config/project_settings.h"
 #include "core/string/string_name.h"
 #include "scene/2d/audio_stream_player_2d.h"
@@ -976,6 +977,8 @@ bool AnimationMixer::_update_caches() {
 /* -------------------------------------------- */
 
 void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
+	FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_ANIMATION);
+
 	_blend_init();
 	if (_blend_pre_process(p_delta, track_count, track_map)) {
 		_blend_capture(p_delta);
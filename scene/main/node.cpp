@@ -32,6 +32,7 @@
 #include "node.compat.inc"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/frame_benchmark.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
@@ -80,10 +81,12 @@ void Node::_notification(int p_notification) {
 		} break;
 
 		case NOTIFICATION_PROCESS: {
+			FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_SCRIPTS);
 			GDVIRTUAL_CALL(_process, get_process_delta_time());
 		} break;
 
 		case NOTIFICATION_PHYSICS_PROCESS: {
+			FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_SCRIPTS);
 			GDVIRTUAL_CALL(_physics_process, get_physics_process_delta_time());
 		} break;
 
@@ -31,6 +31,8 @@
 #include "scene_tree.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/frame_benchmark.h"
+#include "core/debugger/trace_events.h"
 #include "core/input/input.h"
 #include "core/io/image_loader.h"
 #include "core/io/resource_loader.h"
@@ -624,6 +626,9 @@ void SceneTree::iteration_prepare() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	TRACE_ZONE("SceneTree::physics_process");
+	FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_PHYSICS_PROCESS);
+
 	current_frame++;
 
 	flush_transform_notifications();
@@ -673,6 +678,9 @@ void SceneTree::iteration_end() {
 }
 
 bool SceneTree::process(double p_time) {
+	TRACE_ZONE("SceneTree::process");
+	FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_PROCESS);
+
 	// First pass of scene tree fixed timestep interpolation.
 	if (get_scene_tree_fti().is_enabled()) {
 		// Special, we need to ensure RenderingServer is up to date
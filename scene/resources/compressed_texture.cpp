@@ -310,6 +310,9 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 		Vector<Ref<Image>> mipmap_images;
 		uint64_t total_size = 0;
 
+		// PNG mipmaps are decoded in place when the file is mapped, without copying it.
+		const Span<uint8_t> mapped_data = (data_format == DATA_FORMAT_PNG && Image::_png_mem_unpacker_func) ? f->get_mapped_data() : Span<uint8_t>();
+
 		for (uint32_t i = 0; i < mipmaps + 1; i++) {
 			uint32_t size = f->get_32();
 
@@ -321,18 +324,24 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
-
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+			const uint64_t pos = f->get_position();
+			if (pos + size <= mapped_data.size()) {
+				img = Image::_png_mem_unpacker_func(mapped_data.ptr() + pos, size);
+				f->seek(pos + size);
+			} else {
+				Vector<uint8_t> pv;
+				pv.resize(size);
+				{
+					uint8_t *wr = pv.ptrw();
+					f->get_buffer(wr, size);
+				}
+
+				if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
+					img = Image::png_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
+					img = Image::webp_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->is_empty()) {
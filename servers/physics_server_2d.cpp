@@ -456,6 +456,154 @@ Dictionary PhysicsDirectSpaceState2D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState2D::_intersect_rays(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to) {
+	ERR_FAIL_COND_V(p_ray_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	const int count = p_from.size();
+	LocalVector<bool> collided_results;
+	collided_results.resize(count);
+	LocalVector<RayResult> results;
+	results.resize(count);
+
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, collided_results.ptr(), results.ptr());
+
+	PackedByteArray collided;
+	collided.resize(count);
+	PackedVector2Array position;
+	position.resize(count);
+	PackedVector2Array normal;
+	normal.resize(count);
+	PackedInt64Array collider_id;
+	collider_id.resize(count);
+	PackedInt32Array shape;
+	shape.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		if (!collided_results[i]) {
+			results[i] = RayResult();
+		}
+		collided.set(i, collided_results[i]);
+		position.set(i, results[i].position);
+		normal.set(i, results[i].normal);
+		collider_id.set(i, (int64_t)results[i].collider_id);
+		shape.set(i, results[i].shape);
+	}
+
+	Dictionary r;
+	r["collided"] = collided;
+	r["position"] = position;
+	r["normal"] = normal;
+	r["collider_id"] = collider_id;
+	r["shape"] = shape;
+
+	return r;
+}
+
+Dictionary PhysicsDirectSpaceState2D::_intersect_shapes(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, int p_max_results) {
+	ERR_FAIL_COND_V(p_shape_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V(p_max_results <= 0, Dictionary());
+
+	const ShapeParameters &parameters = p_shape_query->get_parameters();
+	const int count = p_origins.size();
+
+	LocalVector<Transform2D> transforms;
+	transforms.resize(count);
+	Transform2D transform = parameters.transform;
+	for (int i = 0; i < count; i++) {
+		transform.columns[2] = p_origins[i];
+		transforms[i] = transform;
+	}
+
+	LocalVector<ShapeResult> results;
+	results.resize(count * p_max_results);
+	LocalVector<int> result_counts;
+	result_counts.resize(count);
+
+	intersect_shapes(parameters, transforms.ptr(), count, results.ptr(), p_max_results, result_counts.ptr());
+
+	PackedInt32Array counts;
+	counts.resize(count);
+	PackedInt64Array collider_id;
+	PackedInt32Array shape;
+
+	for (int i = 0; i < count; i++) {
+		counts.set(i, result_counts[i]);
+		for (int j = 0; j < result_counts[i]; j++) {
+			const ShapeResult &result = results[i * p_max_results + j];
+			collider_id.push_back((int64_t)result.collider_id);
+			shape.push_back(result.shape);
+		}
+	}
+
+	Dictionary r;
+	r["count"] = counts;
+	r["collider_id"] = collider_id;
+	r["shape"] = shape;
+
+	return r;
+}
+
+Vector<real_t> PhysicsDirectSpaceState2D::_cast_motions(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions) {
+	ERR_FAIL_COND_V(p_shape_query.is_null(), Vector<real_t>());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Vector<real_t>(), "The origins and motions arrays must have the same size.");
+
+	const ShapeParameters &parameters = p_shape_query->get_parameters();
+	const int count = p_origins.size();
+
+	LocalVector<Transform2D> transforms;
+	transforms.resize(count);
+	Transform2D transform = parameters.transform;
+	for (int i = 0; i < count; i++) {
+		transform.columns[2] = p_origins[i];
+		transforms[i] = transform;
+	}
+
+	LocalVector<real_t> closest_safe;
+	closest_safe.resize(count);
+	LocalVector<real_t> closest_unsafe;
+	closest_unsafe.resize(count);
+
+	cast_motions(parameters, transforms.ptr(), p_motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+	Vector<real_t> ret;
+	ret.resize(count * 2);
+	real_t *ret_ptrw = ret.ptrw();
+	for (int i = 0; i < count; i++) {
+		ret_ptrw[i * 2 + 0] = closest_safe[i];
+		ret_ptrw[i * 2 + 1] = closest_unsafe[i];
+	}
+	return ret;
+}
+
+void PhysicsDirectSpaceState2D::intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, bool *r_collided, RayResult *r_results) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_collided[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState2D::intersect_shapes(const ShapeParameters &p_parameters, const Transform2D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		r_result_counts[i] = intersect_shape(parameters, r_results + i * p_result_max, p_result_max);
+	}
+}
+
+void PhysicsDirectSpaceState2D::cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i]);
+	}
+}
+
 PhysicsDirectSpaceState2D::PhysicsDirectSpaceState2D() {
 }
 
@@ -466,6 +614,9 @@ void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState2D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState2D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState2D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_shapes", "parameters", "origins", "max_results"), &PhysicsDirectSpaceState2D::_intersect_shapes, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("cast_motions", "parameters", "origins", "motions"), &PhysicsDirectSpaceState2D::_cast_motions);
 }
 
 ///////////////////////////////
@@ -624,6 +775,14 @@ bool PhysicsServer2D::_body_test_motion(RID p_body, const Ref<PhysicsTestMotionP
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+Vector<uint8_t> PhysicsServer2D::space_snapshot(RID p_space) const {
+	ERR_FAIL_V_MSG(Vector<uint8_t>(), "Space snapshots aren't supported by this physics server.");
+}
+
+void PhysicsServer2D::space_restore(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_MSG("Space snapshots aren't supported by this physics server.");
+}
+
 void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("world_boundary_shape_create"), &PhysicsServer2D::world_boundary_shape_create);
 	ClassDB::bind_method(D_METHOD("separation_ray_shape_create"), &PhysicsServer2D::separation_ray_shape_create);
@@ -645,6 +804,8 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_snapshot", "space"), &PhysicsServer2D::space_snapshot);
+	ClassDB::bind_method(D_METHOD("space_restore", "space", "snapshot"), &PhysicsServer2D::space_restore);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
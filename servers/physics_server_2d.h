@@ -131,6 +131,10 @@ class PhysicsDirectSpaceState2D : public Object {
 	TypedArray<Vector2> _collide_shape(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query);
 
+	Dictionary _intersect_rays(const Ref<PhysicsRayQueryParameters2D> &p_ray_query, const PackedVector2Array &p_from, const PackedVector2Array &p_to);
+	Dictionary _intersect_shapes(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, int p_max_results = 32);
+	Vector<real_t> _cast_motions(const Ref<PhysicsShapeQueryParameters2D> &p_shape_query, const PackedVector2Array &p_origins, const PackedVector2Array &p_motions);
+
 protected:
 	static void _bind_methods();
 
@@ -205,6 +209,14 @@ public:
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
+	// Batched queries. All queries share p_parameters, except for the ray ends or the shape transforms
+	// and motions, which are given per query. Servers may run the queries in parallel, the default
+	// implementations run them one after the other.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector2 *p_from, const Vector2 *p_to, int p_count, bool *r_collided, RayResult *r_results);
+	// r_results holds p_result_max results for each query, r_result_counts how many of them were used.
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform2D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts);
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform2D *p_transforms, const Vector2 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	PhysicsDirectSpaceState2D();
 };
 
@@ -283,6 +295,11 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Saves the simulated state of the bodies in a space, and restores it, for rollback.
+	// Not pure virtual, as not all physics servers support it.
+	virtual Vector<uint8_t> space_snapshot(RID p_space) const;
+	virtual void space_restore(RID p_space, const Vector<uint8_t> &p_snapshot);
+
 	//missing space parameters
 
 	/* AREA API */
@@ -120,6 +120,9 @@ public:
 		return physics_server_2d->space_get_contact_count(p_space);
 	}
 
+	FUNC1RC(Vector<uint8_t>, space_snapshot, RID);
+	FUNC2(space_restore, RID, const Vector<uint8_t> &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
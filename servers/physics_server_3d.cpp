@@ -483,6 +483,158 @@ Dictionary PhysicsDirectSpaceState3D::_get_rest_info(const Ref<PhysicsShapeQuery
 	return r;
 }
 
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(p_ray_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The from and to arrays must have the same size.");
+
+	const int count = p_from.size();
+	LocalVector<bool> collided_results;
+	collided_results.resize(count);
+	LocalVector<RayResult> results;
+	results.resize(count);
+
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, collided_results.ptr(), results.ptr());
+
+	PackedByteArray collided;
+	collided.resize(count);
+	PackedVector3Array position;
+	position.resize(count);
+	PackedVector3Array normal;
+	normal.resize(count);
+	PackedInt64Array collider_id;
+	collider_id.resize(count);
+	PackedInt32Array shape;
+	shape.resize(count);
+	PackedInt32Array face_index;
+	face_index.resize(count);
+
+	for (int i = 0; i < count; i++) {
+		if (!collided_results[i]) {
+			results[i] = RayResult();
+		}
+		collided.set(i, collided_results[i]);
+		position.set(i, results[i].position);
+		normal.set(i, results[i].normal);
+		collider_id.set(i, (int64_t)results[i].collider_id);
+		shape.set(i, results[i].shape);
+		face_index.set(i, results[i].face_index);
+	}
+
+	Dictionary r;
+	r["collided"] = collided;
+	r["position"] = position;
+	r["normal"] = normal;
+	r["collider_id"] = collider_id;
+	r["shape"] = shape;
+	r["face_index"] = face_index;
+
+	return r;
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_shapes(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, int p_max_results) {
+	ERR_FAIL_COND_V(p_shape_query.is_null(), Dictionary());
+	ERR_FAIL_COND_V(p_max_results <= 0, Dictionary());
+
+	const ShapeParameters &parameters = p_shape_query->get_parameters();
+	const int count = p_origins.size();
+
+	LocalVector<Transform3D> transforms;
+	transforms.resize(count);
+	Transform3D transform = parameters.transform;
+	for (int i = 0; i < count; i++) {
+		transform.origin = p_origins[i];
+		transforms[i] = transform;
+	}
+
+	LocalVector<ShapeResult> results;
+	results.resize(count * p_max_results);
+	LocalVector<int> result_counts;
+	result_counts.resize(count);
+
+	intersect_shapes(parameters, transforms.ptr(), count, results.ptr(), p_max_results, result_counts.ptr());
+
+	PackedInt32Array counts;
+	counts.resize(count);
+	PackedInt64Array collider_id;
+	PackedInt32Array shape;
+
+	for (int i = 0; i < count; i++) {
+		counts.set(i, result_counts[i]);
+		for (int j = 0; j < result_counts[i]; j++) {
+			const ShapeResult &result = results[i * p_max_results + j];
+			collider_id.push_back((int64_t)result.collider_id);
+			shape.push_back(result.shape);
+		}
+	}
+
+	Dictionary r;
+	r["count"] = counts;
+	r["collider_id"] = collider_id;
+	r["shape"] = shape;
+
+	return r;
+}
+
+Vector<real_t> PhysicsDirectSpaceState3D::_cast_motions(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions) {
+	ERR_FAIL_COND_V(p_shape_query.is_null(), Vector<real_t>());
+	ERR_FAIL_COND_V_MSG(p_origins.size() != p_motions.size(), Vector<real_t>(), "The origins and motions arrays must have the same size.");
+
+	const ShapeParameters &parameters = p_shape_query->get_parameters();
+	const int count = p_origins.size();
+
+	LocalVector<Transform3D> transforms;
+	transforms.resize(count);
+	Transform3D transform = parameters.transform;
+	for (int i = 0; i < count; i++) {
+		transform.origin = p_origins[i];
+		transforms[i] = transform;
+	}
+
+	LocalVector<real_t> closest_safe;
+	closest_safe.resize(count);
+	LocalVector<real_t> closest_unsafe;
+	closest_unsafe.resize(count);
+
+	cast_motions(parameters, transforms.ptr(), p_motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+	Vector<real_t> ret;
+	ret.resize(count * 2);
+	real_t *ret_ptrw = ret.ptrw();
+	for (int i = 0; i < count; i++) {
+		ret_ptrw[i * 2 + 0] = closest_safe[i];
+		ret_ptrw[i * 2 + 1] = closest_unsafe[i];
+	}
+	return ret;
+}
+
+void PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, bool *r_collided, RayResult *r_results) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_collided[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+void PhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		r_result_counts[i] = intersect_shape(parameters, r_results + i * p_result_max, p_result_max);
+	}
+}
+
+void PhysicsDirectSpaceState3D::cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	ShapeParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.transform = p_transforms[i];
+		parameters.motion = p_motions[i];
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+		cast_motion(parameters, r_closest_safe[i], r_closest_unsafe[i]);
+	}
+}
+
 PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 }
 
@@ -493,6 +645,9 @@ void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("get_rest_info", "parameters"), &PhysicsDirectSpaceState3D::_get_rest_info);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays);
+	ClassDB::bind_method(D_METHOD("intersect_shapes", "parameters", "origins", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shapes, DEFVAL(32));
+	ClassDB::bind_method(D_METHOD("cast_motions", "parameters", "origins", "motions"), &PhysicsDirectSpaceState3D::_cast_motions);
 }
 
 ///////////////////////////////
@@ -696,6 +851,14 @@ RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	}
 }
 
+Vector<uint8_t> PhysicsServer3D::space_snapshot(RID p_space) const {
+	ERR_FAIL_V_MSG(Vector<uint8_t>(), "Space snapshots aren't supported by this physics server.");
+}
+
+void PhysicsServer3D::space_restore(RID p_space, const Vector<uint8_t> &p_snapshot) {
+	ERR_FAIL_MSG("Space snapshots aren't supported by this physics server.");
+}
+
 void PhysicsServer3D::_bind_methods() {
 #ifndef _3D_DISABLED
 
@@ -723,6 +886,8 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_snapshot", "space"), &PhysicsServer3D::space_snapshot);
+	ClassDB::bind_method(D_METHOD("space_restore", "space", "snapshot"), &PhysicsServer3D::space_restore);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -1154,6 +1319,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/use_batched_contact_solver", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
@@ -135,6 +135,10 @@ private:
 	TypedArray<Vector3> _collide_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Dictionary _get_rest_info(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
 
+	Dictionary _intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
+	Dictionary _intersect_shapes(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, int p_max_results = 32);
+	Vector<real_t> _cast_motions(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, const PackedVector3Array &p_origins, const PackedVector3Array &p_motions);
+
 protected:
 	static void _bind_methods();
 
@@ -212,6 +216,14 @@ public:
 
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const = 0;
 
+	// Batched queries. All queries share p_parameters, except for the ray ends or the shape transforms
+	// and motions, which are given per query. Servers may run the queries in parallel, the default
+	// implementations run them one after the other.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, bool *r_collided, RayResult *r_results);
+	// r_results holds p_result_max results for each query, r_result_counts how many of them were used.
+	virtual void intersect_shapes(const ShapeParameters &p_parameters, const Transform3D *p_transforms, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts);
+	virtual void cast_motions(const ShapeParameters &p_parameters, const Transform3D *p_transforms, const Vector3 *p_motions, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	PhysicsDirectSpaceState3D();
 };
 
@@ -313,6 +325,11 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Saves the simulated state of the bodies in a space, and restores it, for rollback.
+	// Not pure virtual, as not all physics servers support it.
+	virtual Vector<uint8_t> space_snapshot(RID p_space) const;
+	virtual void space_restore(RID p_space, const Vector<uint8_t> &p_snapshot);
+
 	//missing space parameters
 
 	/* AREA API */
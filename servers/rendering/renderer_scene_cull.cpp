@@ -31,6 +31,7 @@
 #include "renderer_scene_cull.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/frame_benchmark.h"
 #include "core/object/worker_thread_pool.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
@@ -3219,6 +3220,8 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	scene_cull_result.clear();
 
 	{
+		FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_CULLING);
+
 		uint64_t cull_from = 0;
 		uint64_t cull_to = scenario->instance_data.size();
 
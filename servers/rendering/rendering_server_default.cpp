@@ -30,6 +30,8 @@
 
 #include "rendering_server_default.h"
 
+#include "core/debugger/frame_benchmark.h"
+#include "core/debugger/trace_events.h"
 #include "core/os/os.h"
 #include "renderer_canvas_cull.h"
 #include "renderer_scene_cull.h"
@@ -66,6 +68,8 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	TRACE_ZONE("RenderingServerDefault::_draw");
+
 	RSG::rasterizer->begin_frame(frame_step);
 
 	TIMESTAMP_BEGIN()
@@ -409,6 +413,9 @@ void RenderingServerDefault::set_physics_interpolation_enabled(bool p_enabled) {
 /* EVENT QUEUING */
 
 void RenderingServerDefault::sync() {
+	TRACE_ZONE("RenderingServerDefault::sync");
+	FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_RENDERING);
+
 	if (create_thread) {
 		command_queue.sync();
 	} else {
@@ -417,6 +424,8 @@ void RenderingServerDefault::sync() {
 }
 
 void RenderingServerDefault::draw(bool p_present, double frame_step) {
+	FrameBenchmark::Scope benchmark_scope(FrameBenchmark::CATEGORY_RENDERING);
+
 	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "Manually triggering the draw function from the RenderingServer can only be done on the main thread. Call this function from the main thread or use call_deferred().");
 	// Needs to be done before changes is reset to 0, to not force the editor to redraw.
 	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
@@ -0,0 +1,415 @@
+/**************************************************************************/
+/*  benchmark.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "benchmark.h"
+
+#include "core/config/engine.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/os/time.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+
+#include "tests/benchmarks/core/benchmark_object.h"
+#include "tests/benchmarks/core/benchmark_packed_array_math.h"
+#include "tests/benchmarks/core/benchmark_small_block_allocator.h"
+#include "tests/benchmarks/core/benchmark_string.h"
+#include "tests/benchmarks/core/benchmark_string_name.h"
+#include "tests/benchmarks/core/benchmark_templates.h"
+#include "tests/benchmarks/core/benchmark_variant.h"
+#include "tests/benchmarks/core/benchmark_worker_thread_pool.h"
+#include "tests/benchmarks/servers/benchmark_physics.h"
+
+struct BenchmarkEntry {
+	String name;
+	BenchmarkFunc func = nullptr;
+};
+
+static LocalVector<BenchmarkEntry> *benchmarks = nullptr;
+
+int register_benchmark(const char *p_name, BenchmarkFunc p_func) {
+	if (!benchmarks) {
+		benchmarks = new LocalVector<BenchmarkEntry>;
+	}
+	BenchmarkEntry entry;
+	entry.name = String::utf8(p_name);
+	entry.func = p_func;
+	benchmarks->push_back(entry);
+	return 0;
+}
+
+bool BenchmarkState::_keep_running_slow() {
+	if (!started) {
+		started = true;
+		remaining = error.is_empty() ? iterations : 0;
+		start_usec = OS::get_singleton()->get_ticks_usec();
+		if (remaining > 0) {
+			remaining--;
+			return true;
+		}
+	}
+	if (!finished) {
+		elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec - paused_usec;
+		finished = true;
+	}
+	return false;
+}
+
+void BenchmarkState::pause_timing() {
+	pause_start_usec = OS::get_singleton()->get_ticks_usec();
+}
+
+void BenchmarkState::resume_timing() {
+	paused_usec += OS::get_singleton()->get_ticks_usec() - pause_start_usec;
+}
+
+class BenchmarkRunner {
+public:
+	struct Settings {
+		String filter = "*";
+		int samples = 10;
+		uint64_t min_time_usec = 20000;
+		uint64_t warmup_usec = 100000;
+	};
+
+	struct Result {
+		String name;
+		String error;
+		uint64_t iterations = 0;
+		LocalVector<double> samples_ns;
+		double mean_ns = 0.0;
+		double median_ns = 0.0;
+		double min_ns = 0.0;
+		double max_ns = 0.0;
+		double stddev_ns = 0.0;
+		double items_per_second = 0.0;
+		List<String> counter_names;
+		List<double> counter_values;
+
+		Dictionary to_dict() const;
+	};
+
+private:
+	static bool _run_once(BenchmarkFunc p_func, uint64_t p_iterations, BenchmarkState &r_state);
+
+public:
+	static bool matches_filter(const String &p_name, const String &p_filter);
+	static Result run(const BenchmarkEntry &p_entry, const Settings &p_settings);
+};
+
+bool BenchmarkRunner::_run_once(BenchmarkFunc p_func, uint64_t p_iterations, BenchmarkState &r_state) {
+	r_state = BenchmarkState();
+	r_state.iterations = p_iterations;
+	p_func(r_state);
+	if (!r_state.error.is_empty()) {
+		return false;
+	}
+	if (!r_state.finished) {
+		r_state.error = "The benchmark didn't loop until `keep_running()` returned false.";
+		return false;
+	}
+	return true;
+}
+
+bool BenchmarkRunner::matches_filter(const String &p_name, const String &p_filter) {
+	for (const String &pattern : p_filter.split(",", false)) {
+		if (p_name.matchn(pattern)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+BenchmarkRunner::Result BenchmarkRunner::run(const BenchmarkEntry &p_entry, const Settings &p_settings) {
+	Result result;
+	result.name = p_entry.name;
+
+	// Warm up while growing the iteration count until a single sample takes long enough to be timed reliably.
+	const uint64_t max_iterations = uint64_t(1) << 40;
+	uint64_t iterations = 1;
+	const uint64_t warmup_start = OS::get_singleton()->get_ticks_usec();
+	BenchmarkState state;
+	while (true) {
+		if (!_run_once(p_entry.func, iterations, state)) {
+			result.error = state.error;
+			return result;
+		}
+		const bool warm = OS::get_singleton()->get_ticks_usec() - warmup_start >= p_settings.warmup_usec;
+		if (state.elapsed_usec >= p_settings.min_time_usec || iterations >= max_iterations) {
+			if (warm) {
+				break;
+			}
+			continue;
+		}
+		// Aim slightly above the minimum time, but grow by at most tenfold at once.
+		uint64_t next = state.elapsed_usec > 0 ? uint64_t(iterations * 1.4 * p_settings.min_time_usec / state.elapsed_usec) : iterations * 10;
+		iterations = CLAMP(next, iterations + 1, MIN(iterations * 10, max_iterations));
+	}
+	result.iterations = iterations;
+
+	uint64_t total_usec = 0;
+	uint64_t total_items = 0;
+	for (int i = 0; i < p_settings.samples; i++) {
+		if (!_run_once(p_entry.func, iterations, state)) {
+			result.error = state.error;
+			return result;
+		}
+		result.samples_ns.push_back(state.elapsed_usec * 1000.0 / iterations);
+		total_usec += state.elapsed_usec;
+		total_items += state.items_processed;
+
+		if (i == 0) {
+			result.counter_names = state.counter_names;
+			for (int j = 0; j < state.counter_names.size(); j++) {
+				result.counter_values.push_back(0.0);
+			}
+		}
+		List<double>::Element *total = result.counter_values.front();
+		for (const List<double>::Element *E = state.counter_values.front(); E && total; E = E->next(), total = total->next()) {
+			total->get() += E->get() / p_settings.samples;
+		}
+	}
+
+	LocalVector<double> sorted = result.samples_ns;
+	sorted.sort();
+	const uint32_t count = sorted.size();
+	result.min_ns = sorted[0];
+	result.max_ns = sorted[count - 1];
+	result.median_ns = (count % 2) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) * 0.5;
+
+	double sum = 0.0;
+	for (double sample : sorted) {
+		sum += sample;
+	}
+	result.mean_ns = sum / count;
+
+	if (count > 1) {
+		double variance = 0.0;
+		for (double sample : sorted) {
+			variance += (sample - result.mean_ns) * (sample - result.mean_ns);
+		}
+		result.stddev_ns = Math::sqrt(variance / (count - 1));
+	}
+
+	if (total_items > 0 && total_usec > 0) {
+		result.items_per_second = total_items * 1000000.0 / total_usec;
+	}
+
+	return result;
+}
+
+Dictionary BenchmarkRunner::Result::to_dict() const {
+	Dictionary dict;
+	dict["name"] = name;
+	if (!error.is_empty()) {
+		dict["error"] = error;
+		return dict;
+	}
+	dict["iterations"] = iterations;
+	Array samples;
+	for (double sample : samples_ns) {
+		samples.push_back(sample);
+	}
+	dict["samples_ns"] = samples;
+	dict["mean_ns"] = mean_ns;
+	dict["median_ns"] = median_ns;
+	dict["min_ns"] = min_ns;
+	dict["max_ns"] = max_ns;
+	dict["stddev_ns"] = stddev_ns;
+	if (items_per_second > 0.0) {
+		dict["items_per_second"] = items_per_second;
+	}
+	if (!counter_names.is_empty()) {
+		Dictionary counters;
+		const List<double>::Element *value = counter_values.front();
+		for (const String &counter_name : counter_names) {
+			counters[counter_name] = value->get();
+			value = value->next();
+		}
+		dict["counters"] = counters;
+	}
+	return dict;
+}
+
+static bool _has_arg(const List<String> &p_args, const String &p_name) {
+	for (const String &arg : p_args) {
+		if (arg == p_name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static String _get_arg_value(const List<String> &p_args, const String &p_name, const String &p_default = String()) {
+	const String prefix = p_name + "=";
+	for (const String &arg : p_args) {
+		if (arg.begins_with(prefix)) {
+			return arg.substr(prefix.length());
+		}
+	}
+	return p_default;
+}
+
+static String _format_time(double p_ns) {
+	if (p_ns >= 1e9) {
+		return String::num(p_ns / 1e9, 3) + " s";
+	} else if (p_ns >= 1e6) {
+		return String::num(p_ns / 1e6, 3) + " ms";
+	} else if (p_ns >= 1e3) {
+		return String::num(p_ns / 1e3, 3) + " us";
+	}
+	return String::num(p_ns, 1) + " ns";
+}
+
+static void _print_help() {
+	print_line("Usage: godot --test --benchmarks [options]");
+	print_line("Options:");
+	print_line("  --benchmark-list                     List the registered benchmarks and exit.");
+	print_line("  --benchmark-filter=<patterns>        Comma-separated wildcard patterns of benchmarks to run (default: *).");
+	print_line("  --benchmark-samples=<count>          Number of timed samples per benchmark (default: 10).");
+	print_line("  --benchmark-min-time=<ms>            Minimum duration of a sample, iterations are scaled to reach it (default: 20).");
+	print_line("  --benchmark-warmup=<ms>              Minimum warmup duration before sampling (default: 100).");
+	print_line("  --benchmark-json=<path>              Write the results to a JSON file.");
+	print_line("  --benchmark-baseline=<path>          Compare the results with a JSON file written by a previous run.");
+	print_line("  --benchmark-max-regression=<pct>     Fail if a median is slower than the baseline by more than this percentage.");
+}
+
+int benchmark_main(const List<String> &p_args) {
+	if (_has_arg(p_args, "--help") || _has_arg(p_args, "-h")) {
+		_print_help();
+		return EXIT_SUCCESS;
+	}
+
+	if (!benchmarks) {
+		print_line("No benchmarks registered.");
+		return EXIT_SUCCESS;
+	}
+
+	BenchmarkRunner::Settings settings;
+	settings.filter = _get_arg_value(p_args, "--benchmark-filter", settings.filter);
+	settings.samples = MAX(1, _get_arg_value(p_args, "--benchmark-samples", itos(settings.samples)).to_int());
+	settings.min_time_usec = MAX(1, _get_arg_value(p_args, "--benchmark-min-time", itos(settings.min_time_usec / 1000)).to_int()) * 1000;
+	settings.warmup_usec = MAX(0, _get_arg_value(p_args, "--benchmark-warmup", itos(settings.warmup_usec / 1000)).to_int()) * 1000;
+	const String json_path = _get_arg_value(p_args, "--benchmark-json");
+	const String baseline_path = _get_arg_value(p_args, "--benchmark-baseline");
+	const double max_regression = _get_arg_value(p_args, "--benchmark-max-regression", "0").to_float();
+
+	if (_has_arg(p_args, "--benchmark-list")) {
+		for (const BenchmarkEntry &entry : *benchmarks) {
+			if (BenchmarkRunner::matches_filter(entry.name, settings.filter)) {
+				print_line(entry.name);
+			}
+		}
+		return EXIT_SUCCESS;
+	}
+
+	HashMap<String, double> baseline;
+	if (!baseline_path.is_empty()) {
+		Dictionary baseline_data = JSON::parse_string(FileAccess::get_file_as_string(baseline_path));
+		ERR_FAIL_COND_V_MSG(baseline_data.is_empty(), EXIT_FAILURE, vformat("Can't read benchmark baseline: '%s'.", baseline_path));
+		Array baseline_results = baseline_data.get("benchmarks", Array());
+		for (const Variant &v : baseline_results) {
+			Dictionary entry = v;
+			if (entry.has("median_ns")) {
+				baseline[entry["name"]] = entry["median_ns"];
+			}
+		}
+	}
+
+	LocalVector<BenchmarkRunner::Result> results;
+	int failed = 0;
+	int regressed = 0;
+	for (const BenchmarkEntry &entry : *benchmarks) {
+		if (!BenchmarkRunner::matches_filter(entry.name, settings.filter)) {
+			continue;
+		}
+
+		BenchmarkRunner::Result result = BenchmarkRunner::run(entry, settings);
+		if (!result.error.is_empty()) {
+			print_line(vformat("%s FAILED: %s", result.name.rpad(60), result.error));
+			failed++;
+			results.push_back(result);
+			continue;
+		}
+
+		const double deviation = result.mean_ns > 0.0 ? result.stddev_ns / result.mean_ns * 100.0 : 0.0;
+		String line = vformat("%s %s/iter ±%s%%  (min %s, max %s, %d iterations x %d samples)", result.name.rpad(60), _format_time(result.median_ns).lpad(12), String::num(deviation, 1), _format_time(result.min_ns), _format_time(result.max_ns), result.iterations, settings.samples);
+		if (result.items_per_second > 0.0) {
+			line += vformat("  %s items/s", String::num(result.items_per_second, 0));
+		}
+		const List<double>::Element *counter_value = result.counter_values.front();
+		for (const String &counter_name : result.counter_names) {
+			line += vformat("  %s %s", String::num(counter_value->get(), 1), counter_name);
+			counter_value = counter_value->next();
+		}
+		if (baseline.has(result.name) && baseline[result.name] > 0.0) {
+			const double change = (result.median_ns - baseline[result.name]) / baseline[result.name] * 100.0;
+			line += vformat("  [%s%s%% vs. baseline]", change >= 0.0 ? "+" : "", String::num(change, 1));
+			if (max_regression > 0.0 && change > max_regression) {
+				regressed++;
+			}
+		}
+		print_line(line);
+		results.push_back(result);
+	}
+
+	if (!json_path.is_empty()) {
+		Dictionary settings_dict;
+		settings_dict["filter"] = settings.filter;
+		settings_dict["samples"] = settings.samples;
+		settings_dict["min_time_ms"] = settings.min_time_usec / 1000;
+		settings_dict["warmup_ms"] = settings.warmup_usec / 1000;
+
+		Array results_array;
+		for (const BenchmarkRunner::Result &result : results) {
+			results_array.push_back(result.to_dict());
+		}
+
+		Dictionary output;
+		output["engine"] = Engine::get_singleton()->get_version_info();
+		output["date"] = Time::get_singleton()->get_datetime_string_from_system(true);
+		output["processor_name"] = OS::get_singleton()->get_processor_name();
+		output["processor_count"] = OS::get_singleton()->get_processor_count();
+		output["settings"] = settings_dict;
+		output["benchmarks"] = results_array;
+
+		Ref<FileAccess> f = FileAccess::open(json_path, FileAccess::WRITE);
+		ERR_FAIL_COND_V_MSG(f.is_null(), EXIT_FAILURE, vformat("Can't open benchmark output file for writing: '%s'.", json_path));
+		f->store_string(JSON::stringify(output, "\t", false, true));
+	}
+
+	if (regressed > 0) {
+		print_line(vformat("%d benchmark(s) regressed by more than %s%% compared to the baseline.", regressed, String::num(max_regression, 1)));
+	}
+
+	return (failed > 0 || regressed > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  benchmark.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/list.h"
+
+// Benchmarks are registered with the `BENCHMARK` macro and run with
+// `godot --test --benchmarks`. Only the loop driven by `keep_running()` is
+// timed, so setup and teardown can live before and after it:
+//
+//     BENCHMARK("[HashMap] Insert") {
+//         HashMap<int, int> map;
+//         int i = 0;
+//         while (p_state.keep_running()) {
+//             map.insert(i++, 0);
+//         }
+//     }
+
+class BenchmarkState {
+	friend class BenchmarkRunner;
+
+	uint64_t iterations = 0;
+	uint64_t remaining = 0;
+	uint64_t start_usec = 0;
+	uint64_t elapsed_usec = 0;
+	uint64_t paused_usec = 0;
+	uint64_t pause_start_usec = 0;
+	uint64_t items_processed = 0;
+	List<String> counter_names;
+	List<double> counter_values;
+	bool started = false;
+	bool finished = false;
+	String error;
+
+	bool _keep_running_slow();
+
+public:
+	// Returns `true` once per iteration; the first call starts the timer and the last one stops it.
+	_FORCE_INLINE_ bool keep_running() {
+		if (likely(remaining > 0 && started)) {
+			remaining--;
+			return true;
+		}
+		return _keep_running_slow();
+	}
+
+	_FORCE_INLINE_ uint64_t get_iterations() const { return iterations; }
+
+	// Excludes the work done between the two calls from the measurement.
+	void pause_timing();
+	void resume_timing();
+
+	// Number of items (elements, bytes, steps, ...) handled in total by this run, to report a throughput.
+	void set_items_processed(uint64_t p_items) { items_processed = p_items; }
+
+	// Reports an extra per-benchmark figure (e.g. bytes per item), averaged over the samples.
+	void set_counter(const String &p_name, double p_value) {
+		counter_names.push_back(p_name);
+		counter_values.push_back(p_value);
+	}
+
+	// Stops the benchmark and reports it as failed. Should be followed by a return.
+	void skip_with_error(const String &p_error) { error = p_error; }
+};
+
+// Prevents the compiler from optimizing away a value that's only computed for the benchmark.
+template <typename T>
+_FORCE_INLINE_ void benchmark_do_not_optimize(const T &p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "m"(p_value) : "memory");
+#else
+	const volatile char *ptr = reinterpret_cast<const volatile char *>(&p_value);
+	(void)*ptr;
+#endif
+}
+
+typedef void (*BenchmarkFunc)(BenchmarkState &p_state);
+int register_benchmark(const char *p_name, BenchmarkFunc p_func);
+
+int benchmark_main(const List<String> &p_args);
+
+#define _BENCHMARK_CONCAT_IMPL(m_a, m_b) m_a##m_b
+#define _BENCHMARK_CONCAT(m_a, m_b) _BENCHMARK_CONCAT_IMPL(m_a, m_b)
+
+#define _BENCHMARK_IMPL(m_name, m_func)                                                                      \
+	static void m_func(BenchmarkState &p_state);                                                             \
+	[[maybe_unused]] static const int _BENCHMARK_CONCAT(m_func, _reg) = register_benchmark(m_name, &m_func); \
+	static void m_func([[maybe_unused]] BenchmarkState &p_state)
+
+#define BENCHMARK(m_name) _BENCHMARK_IMPL(m_name, _BENCHMARK_CONCAT(_benchmark_func_, __COUNTER__))
@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  benchmark_object.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object.h"
+#include "core/templates/local_vector.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkObject {
+
+class SignalCounter : public Object {
+public:
+	int64_t count = 0;
+
+	void on_signal() {
+		count++;
+	}
+
+	void on_signal_with_arg(int p_value) {
+		count += p_value;
+	}
+};
+
+static void _emit_signal(BenchmarkState &p_state, int p_connections, bool p_with_arg) {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("benchmark_signal"));
+	LocalVector<SignalCounter *> counters;
+	for (int i = 0; i < p_connections; i++) {
+		SignalCounter *counter = memnew(SignalCounter);
+		if (p_with_arg) {
+			emitter.connect("benchmark_signal", callable_mp(counter, &SignalCounter::on_signal_with_arg));
+		} else {
+			emitter.connect("benchmark_signal", callable_mp(counter, &SignalCounter::on_signal));
+		}
+		counters.push_back(counter);
+	}
+
+	const StringName signal_name = "benchmark_signal";
+	while (p_state.keep_running()) {
+		if (p_with_arg) {
+			emitter.emit_signal(signal_name, 1);
+		} else {
+			emitter.emit_signal(signal_name);
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * p_connections);
+
+	for (SignalCounter *counter : counters) {
+		memdelete(counter);
+	}
+}
+
+BENCHMARK("[Object] Emit signal to 1 connection") {
+	_emit_signal(p_state, 1, false);
+}
+
+BENCHMARK("[Object] Emit signal to 16 connections") {
+	_emit_signal(p_state, 16, false);
+}
+
+BENCHMARK("[Object] Emit signal with argument to 16 connections") {
+	_emit_signal(p_state, 16, true);
+}
+
+BENCHMARK("[Object] Connect, emit and disconnect") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("benchmark_signal"));
+	SignalCounter counter;
+	const Callable callable = callable_mp(&counter, &SignalCounter::on_signal);
+	const StringName signal_name = "benchmark_signal";
+	while (p_state.keep_running()) {
+		emitter.connect(signal_name, callable);
+		emitter.emit_signal(signal_name);
+		emitter.disconnect(signal_name, callable);
+	}
+}
+
+} // namespace BenchmarkObject
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  benchmark_packed_array_math.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/variant/packed_array_math.h"
+#include "core/variant/variant.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkPackedArrayMath {
+
+static const int SAMPLE_COUNT = 65536;
+
+static PackedFloat32Array _make_samples() {
+	PackedFloat32Array samples;
+	samples.resize(SAMPLE_COUNT);
+	float *w = samples.ptrw();
+	for (int i = 0; i < SAMPLE_COUNT; i++) {
+		w[i] = (i % 100) * 0.01f;
+	}
+	return samples;
+}
+
+static PackedVector3Array _make_points() {
+	PackedVector3Array points;
+	points.resize(SAMPLE_COUNT);
+	Vector3 *w = points.ptrw();
+	for (int i = 0; i < SAMPLE_COUNT; i++) {
+		w[i] = Vector3(i % 10, i % 7, i % 3);
+	}
+	return points;
+}
+
+// Scalar loops in the shape a C++ caller would write them, as a reference for
+// the kernels. They live behind a non-inlined call so the compiler doesn't fold
+// them into the benchmark loop.
+
+static _NO_INLINE_ void _scalar_multiply_add(float *p_dst, int64_t p_count, float p_multiplier, float p_addend) {
+	for (int64_t i = 0; i < p_count; i++) {
+		p_dst[i] = p_dst[i] * p_multiplier + p_addend;
+	}
+}
+
+static _NO_INLINE_ float _scalar_sum(const float *p_src, int64_t p_count) {
+	float r = 0;
+	for (int64_t i = 0; i < p_count; i++) {
+		r += p_src[i];
+	}
+	return r;
+}
+
+BENCHMARK("[PackedArrayMath] Multiply-add 64k floats, scalar loop") {
+	PackedFloat32Array samples = _make_samples();
+	float *w = samples.ptrw();
+	while (p_state.keep_running()) {
+		_scalar_multiply_add(w, SAMPLE_COUNT, 0.999f, 0.001f);
+		benchmark_do_not_optimize(w[0]);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * SAMPLE_COUNT);
+}
+
+BENCHMARK("[PackedArrayMath] Multiply-add 64k floats, kernel") {
+	PackedFloat32Array samples = _make_samples();
+	float *w = samples.ptrw();
+	while (p_state.keep_running()) {
+		PackedArrayMath::multiply_add_scalar(w, SAMPLE_COUNT, 0.999f, 0.001f);
+		benchmark_do_not_optimize(w[0]);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * SAMPLE_COUNT);
+}
+
+BENCHMARK("[PackedArrayMath] Sum 64k floats, scalar loop") {
+	const PackedFloat32Array samples = _make_samples();
+	while (p_state.keep_running()) {
+		float sum = _scalar_sum(samples.ptr(), SAMPLE_COUNT);
+		benchmark_do_not_optimize(sum);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * SAMPLE_COUNT);
+}
+
+BENCHMARK("[PackedArrayMath] Sum 64k floats, kernel") {
+	const PackedFloat32Array samples = _make_samples();
+	while (p_state.keep_running()) {
+		float sum = PackedArrayMath::sum(samples.ptr(), SAMPLE_COUNT);
+		benchmark_do_not_optimize(sum);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * SAMPLE_COUNT);
+}
+
+BENCHMARK("[PackedArrayMath] Transform 64k Vector3") {
+	PackedVector3Array points = _make_points();
+	const Transform3D xform = Transform3D(Basis(Vector3(0, 1, 0), 0.001), Vector3(0.001, 0, 0));
+	Vector3 *w = points.ptrw();
+	while (p_state.keep_running()) {
+		PackedArrayMath::transform(w, SAMPLE_COUNT, xform);
+		benchmark_do_not_optimize(w[0]);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * SAMPLE_COUNT);
+}
+
+BENCHMARK("[PackedArrayMath] Multiply-add 64k floats through Variant call") {
+	Variant samples = _make_samples();
+	const StringName method = "multiply_add_scalar";
+	const Variant multiplier = 0.999;
+	const Variant addend = 0.001;
+	const Variant *args[2] = { &multiplier, &addend };
+	while (p_state.keep_running()) {
+		Callable::CallError ce;
+		Variant ret;
+		samples.callp(method, args, 2, ret, ce);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * SAMPLE_COUNT);
+}
+
+} // namespace BenchmarkPackedArrayMath
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  benchmark_small_block_allocator.h                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/small_block_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkSmallBlockAllocator {
+
+constexpr uint32_t CHURN_ITERATIONS = 200000;
+
+struct ChurnData {
+	bool use_small_block_allocator = false;
+	uint32_t iterations = 0;
+};
+
+// Frees and allocates blocks of random small sizes in random slots.
+static void churn(void *p_userdata) {
+	const ChurnData *data = (const ChurnData *)p_userdata;
+	void *live[256] = {};
+	uint32_t seed = 1;
+	for (uint32_t i = 0; i < data->iterations; i++) {
+		seed = seed * 1103515245 + 12345;
+		uint32_t slot = (seed >> 8) % 256;
+		size_t size = 8 + ((seed >> 16) % SmallBlockAllocator::MAX_SIZE);
+		if (data->use_small_block_allocator) {
+			if (live[slot]) {
+				SmallBlockAllocator::free(live[slot]);
+			}
+			live[slot] = SmallBlockAllocator::alloc(size);
+		} else {
+			::free(live[slot]);
+			live[slot] = malloc(size);
+		}
+	}
+	for (void *block : live) {
+		if (data->use_small_block_allocator) {
+			if (block) {
+				SmallBlockAllocator::free(block);
+			}
+		} else {
+			::free(block);
+		}
+	}
+}
+
+static void run_churn(BenchmarkState &p_state, bool p_use_small_block_allocator, bool p_all_threads) {
+	ChurnData data;
+	data.use_small_block_allocator = p_use_small_block_allocator;
+	data.iterations = CHURN_ITERATIONS;
+
+	const uint32_t thread_count = p_all_threads ? MAX(1, OS::get_singleton()->get_processor_count()) : 1;
+	LocalVector<Thread> threads;
+	threads.resize(thread_count);
+	while (p_state.keep_running()) {
+		for (Thread &thread : threads) {
+			thread.start(churn, &data);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * thread_count * CHURN_ITERATIONS);
+	p_state.set_counter("threads", thread_count);
+}
+
+BENCHMARK("[SmallBlockAllocator] Allocation churn, 1 thread") {
+	run_churn(p_state, true, false);
+}
+
+BENCHMARK("[SmallBlockAllocator] Allocation churn, all threads") {
+	run_churn(p_state, true, true);
+}
+
+BENCHMARK("[SmallBlockAllocator] System allocator churn, 1 thread") {
+	run_churn(p_state, false, false);
+}
+
+BENCHMARK("[SmallBlockAllocator] System allocator churn, all threads") {
+	run_churn(p_state, false, true);
+}
+
+} // namespace BenchmarkSmallBlockAllocator
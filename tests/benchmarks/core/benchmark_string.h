@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  benchmark_string.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/variant/variant.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkString {
+
+BENCHMARK("[String] Append 1k short strings") {
+	while (p_state.keep_running()) {
+		String str;
+		for (int i = 0; i < 1000; i++) {
+			str += "godot";
+		}
+		benchmark_do_not_optimize(str.length());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * 1000);
+}
+
+BENCHMARK("[String] Format with vformat") {
+	int i = 0;
+	while (p_state.keep_running()) {
+		String str = vformat("Node %d at (%.2f, %.2f) named %s", i, i * 0.5, i * 0.25, "player");
+		benchmark_do_not_optimize(str.length());
+		i++;
+	}
+}
+
+BENCHMARK("[String] Split and join a path") {
+	const String path = "res://some/deeply/nested/directory/structure/with/a/file.tscn";
+	while (p_state.keep_running()) {
+		Vector<String> parts = path.split("/");
+		String joined = String("/").join(parts);
+		benchmark_do_not_optimize(joined.length());
+	}
+}
+
+BENCHMARK("[String] UTF-8 round trip") {
+	String str;
+	for (int i = 0; i < 64; i++) {
+		str += U"Gödot ゲーム エンジン ";
+	}
+	while (p_state.keep_running()) {
+		CharString utf8 = str.utf8();
+		String decoded = String::utf8(utf8.get_data(), utf8.length());
+		benchmark_do_not_optimize(decoded.length());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * str.length());
+}
+
+BENCHMARK("[String] Find and replace") {
+	String str;
+	for (int i = 0; i < 100; i++) {
+		str += "The quick brown fox jumps over the lazy dog. ";
+	}
+	while (p_state.keep_running()) {
+		String replaced = str.replace("fox", "cat");
+		benchmark_do_not_optimize(replaced.find("lazy cat"));
+	}
+}
+
+} // namespace BenchmarkString
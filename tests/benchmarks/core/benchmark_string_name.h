@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  benchmark_string_name.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkStringName {
+
+BENCHMARK("[StringName] Intern existing names from String") {
+	LocalVector<String> names;
+	LocalVector<StringName> interned;
+	for (int i = 0; i < 1000; i++) {
+		names.push_back(vformat("benchmark_name_%d", i));
+		interned.push_back(StringName(names[i]));
+	}
+	while (p_state.keep_running()) {
+		for (const String &name : names) {
+			StringName sname(name);
+			benchmark_do_not_optimize(sname.hash());
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * names.size());
+}
+
+BENCHMARK("[StringName] Intern and release new names") {
+	LocalVector<String> names;
+	for (int i = 0; i < 1000; i++) {
+		names.push_back(vformat("benchmark_transient_name_%d", i));
+	}
+	while (p_state.keep_running()) {
+		for (const String &name : names) {
+			StringName sname(name);
+			benchmark_do_not_optimize(sname.hash());
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * names.size());
+}
+
+BENCHMARK("[StringName] Compare") {
+	const StringName a = "position";
+	const StringName b = "rotation";
+	int64_t equal = 0;
+	while (p_state.keep_running()) {
+		equal += (a == b);
+		benchmark_do_not_optimize(equal);
+	}
+}
+
+BENCHMARK("[StringName] Lookup with static C string") {
+	while (p_state.keep_running()) {
+		StringName sname = SNAME("_process");
+		benchmark_do_not_optimize(sname.hash());
+	}
+}
+
+constexpr uint32_t INTERN_NAME_COUNT = 1000;
+
+struct InternData {
+	LocalVector<String> names;
+};
+
+static void intern_names(void *p_userdata) {
+	const InternData *data = (const InternData *)p_userdata;
+	for (const String &name : data->names) {
+		StringName sname(name);
+		benchmark_do_not_optimize(sname.hash());
+	}
+}
+
+// Every thread interns and releases its names, which are either the same on all threads or distinct.
+static void run_interning(BenchmarkState &p_state, bool p_shared_names) {
+	const uint32_t thread_count = MAX(1, OS::get_singleton()->get_processor_count());
+	LocalVector<InternData> data;
+	data.resize(thread_count);
+	for (uint32_t i = 0; i < thread_count; i++) {
+		const String prefix = p_shared_names ? String("benchmark_shared_") : vformat("benchmark_thread_%d_", i);
+		for (uint32_t j = 0; j < INTERN_NAME_COUNT; j++) {
+			data[i].names.push_back(prefix + itos(j));
+		}
+	}
+
+	LocalVector<Thread> threads;
+	threads.resize(thread_count);
+	while (p_state.keep_running()) {
+		for (uint32_t i = 0; i < thread_count; i++) {
+			threads[i].start(intern_names, &data[i]);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * thread_count * INTERN_NAME_COUNT);
+	p_state.set_counter("threads", thread_count);
+}
+
+BENCHMARK("[StringName] Intern distinct names from all threads") {
+	run_interning(p_state, false);
+}
+
+BENCHMARK("[StringName] Intern shared names from all threads") {
+	run_interning(p_state, true);
+}
+
+} // namespace BenchmarkStringName
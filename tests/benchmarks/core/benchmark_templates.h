@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  benchmark_templates.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/vector.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkTemplates {
+
+constexpr int ELEMENT_COUNT = 10000;
+
+BENCHMARK("[HashMap] Insert 10k integer keys") {
+	while (p_state.keep_running()) {
+		HashMap<int, int> map;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			map.insert(i * 7919, i);
+		}
+		benchmark_do_not_optimize(map.size());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * ELEMENT_COUNT);
+}
+
+BENCHMARK("[HashMap] Lookup 10k integer keys") {
+	HashMap<int, int> map;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		map.insert(i * 7919, i);
+	}
+	while (p_state.keep_running()) {
+		int64_t sum = 0;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			sum += map[i * 7919];
+		}
+		benchmark_do_not_optimize(sum);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * ELEMENT_COUNT);
+}
+
+BENCHMARK("[HashMap] Lookup 10k String keys") {
+	LocalVector<String> keys;
+	HashMap<String, int> map;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		keys.push_back(vformat("key_%d", i));
+		map.insert(keys[i], i);
+	}
+	while (p_state.keep_running()) {
+		int64_t sum = 0;
+		for (const String &key : keys) {
+			sum += map[key];
+		}
+		benchmark_do_not_optimize(sum);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * ELEMENT_COUNT);
+}
+
+BENCHMARK("[HashSet] Insert and erase 10k integer keys") {
+	while (p_state.keep_running()) {
+		HashSet<int> set;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			set.insert(i);
+		}
+		for (int i = 0; i < ELEMENT_COUNT; i += 2) {
+			set.erase(i);
+		}
+		benchmark_do_not_optimize(set.size());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * ELEMENT_COUNT);
+}
+
+BENCHMARK("[Vector] Push back 10k integers") {
+	while (p_state.keep_running()) {
+		Vector<int> vector;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			vector.push_back(i);
+		}
+		benchmark_do_not_optimize(vector.size());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * ELEMENT_COUNT);
+}
+
+BENCHMARK("[LocalVector] Push back 10k integers") {
+	while (p_state.keep_running()) {
+		LocalVector<int> vector;
+		for (int i = 0; i < ELEMENT_COUNT; i++) {
+			vector.push_back(i);
+		}
+		benchmark_do_not_optimize(vector.size());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * ELEMENT_COUNT);
+}
+
+BENCHMARK("[Vector] Sort 10k integers") {
+	Vector<int> source;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		source.push_back((i * 7919) % ELEMENT_COUNT);
+	}
+	while (p_state.keep_running()) {
+		p_state.pause_timing();
+		Vector<int> vector = source;
+		vector.ptrw(); // Copy on write outside of the timed section.
+		p_state.resume_timing();
+		vector.sort();
+		benchmark_do_not_optimize(vector[0]);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * ELEMENT_COUNT);
+}
+
+} // namespace BenchmarkTemplates
@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  benchmark_variant.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/variant/array.h"
+#include "core/variant/callable.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/variant.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkVariant {
+
+BENCHMARK("[Variant] Evaluate int addition") {
+	Variant a = 1;
+	Variant b = 2;
+	while (p_state.keep_running()) {
+		bool valid = false;
+		Variant result;
+		Variant::evaluate(Variant::OP_ADD, a, b, result, valid);
+		benchmark_do_not_optimize(result);
+	}
+}
+
+BENCHMARK("[Variant] Validated Vector3 multiplication") {
+	Variant a = Vector3(1, 2, 3);
+	Variant b = 2.5;
+	Variant result = Vector3();
+	Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::OP_MULTIPLY, Variant::VECTOR3, Variant::FLOAT);
+	while (p_state.keep_running()) {
+		evaluator(&a, &b, &result);
+		benchmark_do_not_optimize(result);
+	}
+}
+
+BENCHMARK("[Variant] Construct and destroy String") {
+	const String str = "Some string stored in a Variant";
+	while (p_state.keep_running()) {
+		Variant v = str;
+		benchmark_do_not_optimize(v);
+	}
+}
+
+BENCHMARK("[Variant] Call builtin method") {
+	Variant v = String("Some string stored in a Variant");
+	const StringName method = "length";
+	while (p_state.keep_running()) {
+		Callable::CallError ce;
+		Variant ret;
+		v.callp(method, nullptr, 0, ret, ce);
+		benchmark_do_not_optimize(ret);
+	}
+}
+
+BENCHMARK("[Dictionary] Get and set 1k String keys") {
+	LocalVector<Variant> keys;
+	Dictionary dict;
+	for (int i = 0; i < 1000; i++) {
+		keys.push_back(vformat("key_%d", i));
+		dict[keys[i]] = i;
+	}
+	while (p_state.keep_running()) {
+		for (const Variant &key : keys) {
+			dict[key] = int(dict[key]) + 1;
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * keys.size());
+}
+
+BENCHMARK("[Array] Append 10k Variants") {
+	while (p_state.keep_running()) {
+		Array array;
+		for (int i = 0; i < 10000; i++) {
+			array.push_back(i);
+		}
+		benchmark_do_not_optimize(array.size());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * 10000);
+}
+
+} // namespace BenchmarkVariant
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  benchmark_worker_thread_pool.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkWorkerThreadPool {
+
+constexpr uint32_t TASK_COUNT = 100000;
+constexpr uint32_t GROUP_ELEMENT_COUNT = 1000000;
+
+static void empty_task(void *p_arg) {
+}
+
+static void empty_group_task(void *p_arg, uint32_t p_index) {
+}
+
+static void spawn_tasks(void *p_arg) {
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize((uint32_t)(uintptr_t)p_arg);
+	for (WorkerThreadPool::TaskID &task : tasks) {
+		task = WorkerThreadPool::get_singleton()->add_native_task(empty_task, nullptr, true);
+	}
+	for (WorkerThreadPool::TaskID task : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+}
+
+BENCHMARK("[WorkerThreadPool] 100k fine-grained tasks posted from outside the pool") {
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(TASK_COUNT);
+	while (p_state.keep_running()) {
+		for (WorkerThreadPool::TaskID &task : tasks) {
+			task = WorkerThreadPool::get_singleton()->add_native_task(empty_task, nullptr, true);
+		}
+		for (WorkerThreadPool::TaskID task : tasks) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * TASK_COUNT);
+}
+
+BENCHMARK("[WorkerThreadPool] 100k fine-grained tasks posted from within the pool") {
+	const uint32_t thread_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(thread_count);
+	while (p_state.keep_running()) {
+		for (WorkerThreadPool::TaskID &task : tasks) {
+			task = WorkerThreadPool::get_singleton()->add_native_task(spawn_tasks, (void *)(uintptr_t)(TASK_COUNT / thread_count), true);
+		}
+		for (WorkerThreadPool::TaskID task : tasks) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * (TASK_COUNT / thread_count) * thread_count);
+}
+
+BENCHMARK("[WorkerThreadPool] Group of 1M elements") {
+	while (p_state.keep_running()) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(empty_group_task, nullptr, GROUP_ELEMENT_COUNT, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * GROUP_ELEMENT_COUNT);
+}
+
+} // namespace BenchmarkWorkerThreadPool
@@ -0,0 +1,668 @@
+/**************************************************************************/
+/*  benchmark_physics.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifndef PHYSICS_2D_DISABLED
+#include "servers/physics_server_2d.h"
+#endif // PHYSICS_2D_DISABLED
+#ifndef PHYSICS_3D_DISABLED
+#include "servers/physics_server_3d.h"
+#endif // PHYSICS_3D_DISABLED
+#include "core/config/project_settings.h"
+#include "core/templates/local_vector.h"
+#include "tests/benchmarks/benchmark.h"
+
+namespace BenchmarkPhysics {
+
+constexpr int BODY_GRID_SIZE = 8;
+// Bodies in these grids are far enough apart to never touch, so the step is dominated by integration.
+constexpr int SPARSE_BODY_GRID_SIZE_3D = 20;
+constexpr int SPARSE_BODY_GRID_SIZE_2D = 90;
+constexpr real_t STEP_TIME = 1.0 / 60.0;
+constexpr int QUERY_COUNT = 10000;
+constexpr int SNAPSHOT_STACK_HEIGHT = 10;
+constexpr int SNAPSHOT_SETTLE_STEPS = 30;
+
+#ifndef PHYSICS_3D_DISABLED
+static void step_falling_boxes_3d(BenchmarkState &p_state) {
+	PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 3D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID ground_shape = ps->world_boundary_shape_create();
+	ps->shape_set_data(ground_shape, Plane(Vector3(0, 1, 0), 0));
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_space(ground, space);
+
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> bodies;
+	for (int x = 0; x < BODY_GRID_SIZE; x++) {
+		for (int y = 0; y < BODY_GRID_SIZE; y++) {
+			for (int z = 0; z < BODY_GRID_SIZE; z++) {
+				RID body = ps->body_create();
+				ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+				ps->body_add_shape(body, box_shape);
+				ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 1.1, 1 + y * 1.1, z * 1.1)));
+				ps->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+				ps->body_set_space(body, space);
+				bodies.push_back(body);
+			}
+		}
+	}
+	ps->set_active(true);
+
+	while (p_state.keep_running()) {
+		ps->step(STEP_TIME);
+	}
+	p_state.set_items_processed(p_state.get_iterations());
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(ground);
+	ps->free(box_shape);
+	ps->free(ground_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+BENCHMARK("[Physics3D] Step 512 falling boxes") {
+	step_falling_boxes_3d(p_state);
+}
+
+BENCHMARK("[Physics3D] Step 512 falling boxes with the batched contact solver") {
+	// Only read by Godot Physics when creating the space.
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/use_batched_contact_solver", true);
+	step_falling_boxes_3d(p_state);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/use_batched_contact_solver", false);
+}
+
+BENCHMARK("[Physics3D] Step 8000 separate falling spheres") {
+	PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 3D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID sphere_shape = ps->sphere_shape_create();
+	ps->shape_set_data(sphere_shape, 0.5);
+	LocalVector<RID> bodies;
+	for (int x = 0; x < SPARSE_BODY_GRID_SIZE_3D; x++) {
+		for (int y = 0; y < SPARSE_BODY_GRID_SIZE_3D; y++) {
+			for (int z = 0; z < SPARSE_BODY_GRID_SIZE_3D; z++) {
+				RID body = ps->body_create();
+				ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+				ps->body_add_shape(body, sphere_shape);
+				ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 4, y * 4, z * 4)));
+				ps->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+				ps->body_set_space(body, space);
+				bodies.push_back(body);
+			}
+		}
+	}
+	ps->set_active(true);
+
+	while (p_state.keep_running()) {
+		ps->step(STEP_TIME);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * bodies.size());
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(sphere_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+// Static boxes on a grid, with rays cast diagonally through it so most of them hit.
+static void create_query_scene_3d(PhysicsServer3D *p_ps, RID p_space, RID p_shape, LocalVector<RID> &r_bodies, LocalVector<Vector3> &r_from, LocalVector<Vector3> &r_to) {
+	for (int x = 0; x < BODY_GRID_SIZE; x++) {
+		for (int y = 0; y < BODY_GRID_SIZE; y++) {
+			for (int z = 0; z < BODY_GRID_SIZE; z++) {
+				RID body = p_ps->body_create();
+				p_ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+				p_ps->body_add_shape(body, p_shape);
+				p_ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 3, y * 3, z * 3)));
+				p_ps->body_set_space(body, p_space);
+				r_bodies.push_back(body);
+			}
+		}
+	}
+
+	const real_t extent = BODY_GRID_SIZE * 3;
+	r_from.resize(QUERY_COUNT);
+	r_to.resize(QUERY_COUNT);
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		const real_t u = (i % 100) * extent / 100;
+		const real_t v = (i / 100) * extent / 100;
+		r_from[i] = Vector3(u, -5, v);
+		r_to[i] = Vector3(extent - v, extent + 5, extent - u);
+	}
+}
+
+BENCHMARK("[Physics3D] Intersect 10000 rays one at a time") {
+	PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 3D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(1, 1, 1));
+	LocalVector<RID> bodies;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	create_query_scene_3d(ps, space, box_shape, bodies, from, to);
+
+	PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(space);
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	PhysicsDirectSpaceState3D::RayResult result;
+	while (p_state.keep_running()) {
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			space_state->intersect_ray(parameters, result);
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * QUERY_COUNT);
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(box_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+BENCHMARK("[Physics3D] Intersect 10000 rays in a batch") {
+	PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 3D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(1, 1, 1));
+	LocalVector<RID> bodies;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	create_query_scene_3d(ps, space, box_shape, bodies, from, to);
+
+	PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(space);
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<bool> collided;
+	collided.resize(QUERY_COUNT);
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(QUERY_COUNT);
+	while (p_state.keep_running()) {
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), QUERY_COUNT, collided.ptr(), results.ptr());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * QUERY_COUNT);
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(box_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+BENCHMARK("[Physics3D] Cast 10000 sphere motions in a batch") {
+	PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 3D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(1, 1, 1));
+	LocalVector<RID> bodies;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	create_query_scene_3d(ps, space, box_shape, bodies, from, to);
+
+	RID sphere_shape = ps->sphere_shape_create();
+	ps->shape_set_data(sphere_shape, 0.25);
+	LocalVector<Transform3D> transforms;
+	transforms.resize(QUERY_COUNT);
+	LocalVector<Vector3> motions;
+	motions.resize(QUERY_COUNT);
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		transforms[i] = Transform3D(Basis(), from[i]);
+		motions[i] = to[i] - from[i];
+	}
+
+	PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(space);
+	PhysicsDirectSpaceState3D::ShapeParameters parameters;
+	parameters.shape_rid = sphere_shape;
+	LocalVector<real_t> closest_safe;
+	closest_safe.resize(QUERY_COUNT);
+	LocalVector<real_t> closest_unsafe;
+	closest_unsafe.resize(QUERY_COUNT);
+	while (p_state.keep_running()) {
+		space_state->cast_motions(parameters, transforms.ptr(), motions.ptr(), QUERY_COUNT, closest_safe.ptr(), closest_unsafe.ptr());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * QUERY_COUNT);
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(sphere_shape);
+	ps->free(box_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+// Boxes stacked in columns on the ground, stepped a few times so there are contacts to save.
+static void snapshot_space_3d(BenchmarkState &p_state, int p_body_count, bool p_restore) {
+	PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 3D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID ground_shape = ps->world_boundary_shape_create();
+	ps->shape_set_data(ground_shape, Plane(Vector3(0, 1, 0), 0));
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PhysicsServer3D::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_space(ground, space);
+
+	RID box_shape = ps->box_shape_create();
+	ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	const int columns = Math::ceil(Math::sqrt(double(p_body_count) / SNAPSHOT_STACK_HEIGHT));
+	LocalVector<RID> bodies;
+	for (int i = 0; i < p_body_count; i++) {
+		const int column = i / SNAPSHOT_STACK_HEIGHT;
+		RID body = ps->body_create();
+		ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+		ps->body_add_shape(body, box_shape);
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3((column % columns) * 1.5, 0.5 + (i % SNAPSHOT_STACK_HEIGHT) * 1.01, (column / columns) * 1.5)));
+		ps->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+	ps->set_active(true);
+	for (int i = 0; i < SNAPSHOT_SETTLE_STEPS; i++) {
+		ps->step(STEP_TIME);
+	}
+
+	Vector<uint8_t> snapshot = ps->space_snapshot(space);
+	if (snapshot.is_empty()) {
+		p_state.skip_with_error("The 3D physics server doesn't support space snapshots.");
+	} else if (p_restore) {
+		while (p_state.keep_running()) {
+			ps->space_restore(space, snapshot);
+		}
+		p_state.set_items_processed(p_state.get_iterations() * p_body_count);
+	} else {
+		while (p_state.keep_running()) {
+			snapshot = ps->space_snapshot(space);
+		}
+		p_state.set_items_processed(p_state.get_iterations() * p_body_count);
+	}
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(ground);
+	ps->free(box_shape);
+	ps->free(ground_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+BENCHMARK("[Physics3D] Snapshot a space with 1000 bodies") {
+	snapshot_space_3d(p_state, 1000, false);
+}
+
+BENCHMARK("[Physics3D] Snapshot a space with 10000 bodies") {
+	snapshot_space_3d(p_state, 10000, false);
+}
+
+BENCHMARK("[Physics3D] Restore a space with 1000 bodies") {
+	snapshot_space_3d(p_state, 1000, true);
+}
+
+BENCHMARK("[Physics3D] Restore a space with 10000 bodies") {
+	snapshot_space_3d(p_state, 10000, true);
+}
+#endif // PHYSICS_3D_DISABLED
+
+#ifndef PHYSICS_2D_DISABLED
+BENCHMARK("[Physics2D] Step 512 falling boxes") {
+	PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 2D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID ground_shape = ps->world_boundary_shape_create();
+	Array ground_data = { Vector2(0, -1), 0 };
+	ps->shape_set_data(ground_shape, ground_data);
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PhysicsServer2D::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_space(ground, space);
+
+	RID box_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(box_shape, Vector2(8, 8));
+	LocalVector<RID> bodies;
+	for (int x = 0; x < BODY_GRID_SIZE * 4; x++) {
+		for (int y = 0; y < BODY_GRID_SIZE * 2; y++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, box_shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(x * 17, -10 - y * 17)));
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_CAN_SLEEP, false);
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+	ps->set_active(true);
+
+	while (p_state.keep_running()) {
+		ps->step(STEP_TIME);
+	}
+	p_state.set_items_processed(p_state.get_iterations());
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(ground);
+	ps->free(box_shape);
+	ps->free(ground_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+BENCHMARK("[Physics2D] Step 8100 separate falling circles") {
+	PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 2D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID circle_shape = ps->circle_shape_create();
+	ps->shape_set_data(circle_shape, 8);
+	LocalVector<RID> bodies;
+	for (int x = 0; x < SPARSE_BODY_GRID_SIZE_2D; x++) {
+		for (int y = 0; y < SPARSE_BODY_GRID_SIZE_2D; y++) {
+			RID body = ps->body_create();
+			ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+			ps->body_add_shape(body, circle_shape);
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(x * 64, -y * 64)));
+			ps->body_set_state(body, PhysicsServer2D::BODY_STATE_CAN_SLEEP, false);
+			ps->body_set_space(body, space);
+			bodies.push_back(body);
+		}
+	}
+	ps->set_active(true);
+
+	while (p_state.keep_running()) {
+		ps->step(STEP_TIME);
+	}
+	p_state.set_items_processed(p_state.get_iterations() * bodies.size());
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(circle_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+// Static boxes on a grid, with rays cast diagonally through it so most of them hit.
+static void create_query_scene_2d(PhysicsServer2D *p_ps, RID p_space, RID p_shape, LocalVector<RID> &r_bodies, LocalVector<Vector2> &r_from, LocalVector<Vector2> &r_to) {
+	for (int x = 0; x < BODY_GRID_SIZE * 8; x++) {
+		for (int y = 0; y < BODY_GRID_SIZE * 8; y++) {
+			RID body = p_ps->body_create();
+			p_ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_STATIC);
+			p_ps->body_add_shape(body, p_shape);
+			p_ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(x * 48, y * 48)));
+			p_ps->body_set_space(body, p_space);
+			r_bodies.push_back(body);
+		}
+	}
+
+	const real_t extent = BODY_GRID_SIZE * 8 * 48;
+	r_from.resize(QUERY_COUNT);
+	r_to.resize(QUERY_COUNT);
+	for (int i = 0; i < QUERY_COUNT; i++) {
+		const real_t u = (i % 100) * extent / 100;
+		const real_t v = (i / 100) * extent / 100;
+		r_from[i] = Vector2(u, -100);
+		r_to[i] = Vector2(extent - v, extent + 100);
+	}
+}
+
+BENCHMARK("[Physics2D] Intersect 10000 rays one at a time") {
+	PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 2D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID box_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(box_shape, Vector2(16, 16));
+	LocalVector<RID> bodies;
+	LocalVector<Vector2> from;
+	LocalVector<Vector2> to;
+	create_query_scene_2d(ps, space, box_shape, bodies, from, to);
+
+	PhysicsDirectSpaceState2D *space_state = ps->space_get_direct_state(space);
+	PhysicsDirectSpaceState2D::RayParameters parameters;
+	PhysicsDirectSpaceState2D::RayResult result;
+	while (p_state.keep_running()) {
+		for (int i = 0; i < QUERY_COUNT; i++) {
+			parameters.from = from[i];
+			parameters.to = to[i];
+			space_state->intersect_ray(parameters, result);
+		}
+	}
+	p_state.set_items_processed(p_state.get_iterations() * QUERY_COUNT);
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(box_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+BENCHMARK("[Physics2D] Intersect 10000 rays in a batch") {
+	PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 2D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID box_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(box_shape, Vector2(16, 16));
+	LocalVector<RID> bodies;
+	LocalVector<Vector2> from;
+	LocalVector<Vector2> to;
+	create_query_scene_2d(ps, space, box_shape, bodies, from, to);
+
+	PhysicsDirectSpaceState2D *space_state = ps->space_get_direct_state(space);
+	PhysicsDirectSpaceState2D::RayParameters parameters;
+	LocalVector<bool> collided;
+	collided.resize(QUERY_COUNT);
+	LocalVector<PhysicsDirectSpaceState2D::RayResult> results;
+	results.resize(QUERY_COUNT);
+	while (p_state.keep_running()) {
+		space_state->intersect_rays(parameters, from.ptr(), to.ptr(), QUERY_COUNT, collided.ptr(), results.ptr());
+	}
+	p_state.set_items_processed(p_state.get_iterations() * QUERY_COUNT);
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(box_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+// Boxes stacked in columns on the ground, stepped a few times so there are contacts to save.
+static void snapshot_space_2d(BenchmarkState &p_state, int p_body_count, bool p_restore) {
+	PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_default_server();
+	if (!ps) {
+		p_state.skip_with_error("No 2D physics server available.");
+		return;
+	}
+	ps->init();
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+
+	RID ground_shape = ps->world_boundary_shape_create();
+	Array ground_data = { Vector2(0, -1), 0 };
+	ps->shape_set_data(ground_shape, ground_data);
+	RID ground = ps->body_create();
+	ps->body_set_mode(ground, PhysicsServer2D::BODY_MODE_STATIC);
+	ps->body_add_shape(ground, ground_shape);
+	ps->body_set_space(ground, space);
+
+	RID box_shape = ps->rectangle_shape_create();
+	ps->shape_set_data(box_shape, Vector2(8, 8));
+	LocalVector<RID> bodies;
+	for (int i = 0; i < p_body_count; i++) {
+		RID body = ps->body_create();
+		ps->body_set_mode(body, PhysicsServer2D::BODY_MODE_RIGID);
+		ps->body_add_shape(body, box_shape);
+		ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2((i / SNAPSHOT_STACK_HEIGHT) * 24, -8 - (i % SNAPSHOT_STACK_HEIGHT) * 16.2)));
+		ps->body_set_space(body, space);
+		bodies.push_back(body);
+	}
+	ps->set_active(true);
+	for (int i = 0; i < SNAPSHOT_SETTLE_STEPS; i++) {
+		ps->step(STEP_TIME);
+	}
+
+	Vector<uint8_t> snapshot = ps->space_snapshot(space);
+	if (snapshot.is_empty()) {
+		p_state.skip_with_error("The 2D physics server doesn't support space snapshots.");
+	} else if (p_restore) {
+		while (p_state.keep_running()) {
+			ps->space_restore(space, snapshot);
+		}
+		p_state.set_items_processed(p_state.get_iterations() * p_body_count);
+	} else {
+		while (p_state.keep_running()) {
+			snapshot = ps->space_snapshot(space);
+		}
+		p_state.set_items_processed(p_state.get_iterations() * p_body_count);
+	}
+
+	for (const RID &body : bodies) {
+		ps->free(body);
+	}
+	ps->free(ground);
+	ps->free(box_shape);
+	ps->free(ground_shape);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+BENCHMARK("[Physics2D] Snapshot a space with 1000 bodies") {
+	snapshot_space_2d(p_state, 1000, false);
+}
+
+BENCHMARK("[Physics2D] Snapshot a space with 10000 bodies") {
+	snapshot_space_2d(p_state, 10000, false);
+}
+
+BENCHMARK("[Physics2D] Restore a space with 1000 bodies") {
+	snapshot_space_2d(p_state, 1000, true);
+}
+
+BENCHMARK("[Physics2D] Restore a space with 10000 bodies") {
+	snapshot_space_2d(p_state, 10000, true);
+}
+#endif // PHYSICS_2D_DISABLED
+
+} // namespace BenchmarkPhysics
@@ -0,0 +1,98 @@
+/**************************************************************************/
+/*  test_frame_benchmark.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/debugger/frame_benchmark.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameBenchmark {
+
+TEST_CASE("[FrameBenchmark] Percentiles per subsystem") {
+	{
+		FrameBenchmark::Scope scope(FrameBenchmark::CATEGORY_SCRIPTS);
+	}
+	CHECK_FALSE(FrameBenchmark::is_active());
+
+	for (int i = 1; i <= 100; i++) {
+		FrameBenchmark::begin_frame();
+		CHECK(FrameBenchmark::is_active());
+		FrameBenchmark::add_time(FrameBenchmark::CATEGORY_PHYSICS, i * 10);
+		FrameBenchmark::end_frame();
+	}
+	FrameBenchmark::stop();
+	FrameBenchmark::add_time(FrameBenchmark::CATEGORY_PHYSICS, 1000000);
+
+	CHECK(FrameBenchmark::get_frame_count() == 100);
+
+	const Dictionary results = FrameBenchmark::get_results();
+	CHECK(results.has("frame"));
+	CHECK(results.has("culling"));
+
+	const Dictionary physics = results["physics"];
+	CHECK(int64_t(physics["p50_usec"]) == 500);
+	CHECK(int64_t(physics["p90_usec"]) == 900);
+	CHECK(int64_t(physics["p99_usec"]) == 990);
+	CHECK(int64_t(physics["max_usec"]) == 1000);
+	CHECK(int64_t(physics["total_usec"]) == 50500);
+	CHECK(double(physics["mean_usec"]) == doctest::Approx(505.0));
+
+	const Dictionary scripts = results["scripts"];
+	CHECK(int64_t(scripts["max_usec"]) == 0);
+
+	FrameBenchmark::clear();
+	CHECK(FrameBenchmark::get_frame_count() == 0);
+}
+
+TEST_CASE("[FrameBenchmark] Nested scopes count once") {
+	FrameBenchmark::begin_frame();
+	{
+		FrameBenchmark::Scope outer(FrameBenchmark::CATEGORY_SCRIPTS);
+		{
+			FrameBenchmark::Scope inner(FrameBenchmark::CATEGORY_SCRIPTS);
+			OS::get_singleton()->delay_usec(2000);
+		}
+		OS::get_singleton()->delay_usec(2000);
+	}
+	FrameBenchmark::end_frame();
+	FrameBenchmark::stop();
+
+	const Dictionary results = FrameBenchmark::get_results();
+	const Dictionary scripts = results["scripts"];
+	const Dictionary frame = results["frame"];
+	CHECK(int64_t(scripts["total_usec"]) >= 4000);
+	CHECK(int64_t(scripts["total_usec"]) <= int64_t(frame["total_usec"]));
+
+	FrameBenchmark::clear();
+}
+
+} // namespace TestFrameBenchmark
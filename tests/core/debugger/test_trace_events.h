@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  test_trace_events.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/debugger/trace_events.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestTraceEvents {
+
+TEST_CASE("[TraceEvents] Zones are written as Chrome trace events") {
+	{
+		TraceEvents::Zone zone("before_capture");
+	}
+
+	TraceEvents::begin_capture();
+	CHECK(TraceEvents::is_capturing());
+	{
+		TraceEvents::Zone outer("outer_zone");
+		{
+			TraceEvents::Zone inner("inner \"zone\"");
+			OS::get_singleton()->delay_usec(1000);
+		}
+	}
+	Thread thread;
+	thread.start([](void *) {
+		TraceEvents::Zone zone("thread_zone");
+	},
+			nullptr);
+	thread.wait_to_finish();
+	TraceEvents::end_capture();
+	CHECK_FALSE(TraceEvents::is_capturing());
+
+	{
+		TraceEvents::Zone zone("after_capture");
+	}
+
+	const String path = TestUtils::get_temp_path("trace_events.json");
+	REQUIRE(TraceEvents::save_json(path) == OK);
+
+	const Dictionary trace = JSON::parse_string(FileAccess::get_file_as_string(path));
+	const Array events = trace["traceEvents"];
+
+	HashMap<String, Dictionary> zones;
+	int thread_names = 0;
+	for (const Variant &event_variant : events) {
+		const Dictionary event = event_variant;
+		if (event["ph"] == "M") {
+			thread_names++;
+		} else {
+			CHECK(event["ph"] == "X");
+			zones[event["name"]] = event;
+		}
+	}
+
+	CHECK(thread_names == 2);
+	CHECK(zones.size() == 3);
+	REQUIRE(zones.has("outer_zone"));
+	REQUIRE(zones.has("inner \"zone\""));
+	CHECK(zones.has("thread_zone"));
+
+	const Dictionary &outer = zones["outer_zone"];
+	const Dictionary &inner = zones["inner \"zone\""];
+	CHECK(outer["tid"] == inner["tid"]);
+	CHECK(int64_t(inner["dur"]) >= 1000);
+	CHECK(int64_t(outer["ts"]) <= int64_t(inner["ts"]));
+	CHECK(int64_t(outer["ts"]) + int64_t(outer["dur"]) >= int64_t(inner["ts"]) + int64_t(inner["dur"]));
+}
+
+} // namespace TestTraceEvents
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -220,4 +222,130 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Mapped data") {
+	const String file_path = TestUtils::get_temp_path("file_access_mapped_data.bin");
+
+	Vector<uint8_t> contents;
+	contents.resize(100000);
+	for (int i = 0; i < contents.size(); i++) {
+		contents.write[i] = uint8_t(i * 7);
+	}
+	{
+		Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(fw.is_valid());
+		fw->store_buffer(contents);
+		CHECK(fw->get_mapped_data().is_empty()); // Only files opened for reading can be mapped.
+	}
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(10);
+
+	const Span<uint8_t> data = f->get_mapped_data();
+	if (data.is_empty()) {
+		MESSAGE("Memory-mapped files are not supported on this platform.");
+	} else {
+		REQUIRE(data.size() == uint64_t(contents.size()));
+		CHECK(memcmp(data.ptr(), contents.ptr(), contents.size()) == 0);
+	}
+
+	// Reads must behave the same, whether they are served from the mapping or not.
+	CHECK(f->get_position() == 10);
+	CHECK(f->get_length() == uint64_t(contents.size()));
+	CHECK(f->get_8() == contents[10]);
+	f->seek_end(-1);
+	CHECK(f->get_8() == contents[contents.size() - 1]);
+	CHECK(!f->eof_reached());
+	uint8_t extra = 0;
+	CHECK(f->get_buffer(&extra, 1) == 0);
+	CHECK(f->eof_reached());
+	CHECK(f->get_error() == ERR_FILE_EOF);
+	f->seek(0);
+	CHECK(!f->eof_reached());
+	CHECK(f->get_buffer(contents.size()) == contents);
+
+	f->close();
+	DirAccess::remove_file_or_error(file_path);
+}
+
+static void check_pack_file_reads(Ref<FileAccess> p_file, const Vector<uint8_t> &p_contents) {
+	REQUIRE(p_file.is_valid());
+	CHECK(p_file->get_length() == uint64_t(p_contents.size()));
+
+	const Span<uint8_t> data = p_file->get_mapped_data();
+	if (!data.is_empty()) {
+		// The slice must cover the file, and only the file.
+		REQUIRE(data.size() == uint64_t(p_contents.size()));
+		CHECK(memcmp(data.ptr(), p_contents.ptr(), p_contents.size()) == 0);
+	}
+
+	CHECK(p_file->get_buffer(p_contents.size()) == p_contents);
+	CHECK(!p_file->eof_reached());
+
+	// Reads at the end of the slice stop there.
+	p_file->seek_end(-2);
+	uint8_t tail[4] = {};
+	CHECK(p_file->get_buffer(tail, 4) == 2);
+	CHECK(tail[0] == p_contents[p_contents.size() - 2]);
+	CHECK(tail[1] == p_contents[p_contents.size() - 1]);
+	CHECK(p_file->eof_reached());
+	CHECK(p_file->get_buffer(tail, 1) == 0);
+
+	p_file->seek(5);
+	CHECK(!p_file->eof_reached());
+	CHECK(p_file->get_8() == p_contents[5]);
+}
+
+TEST_CASE("[FileAccess] Mapped data of files in a pack") {
+	const String base_path = TestUtils::get_temp_path("file_access_pack_mapped_data");
+	DirAccess::make_dir_recursive_absolute(base_path);
+
+	Vector<uint8_t> contents;
+	contents.resize(50000);
+	for (int i = 0; i < contents.size(); i++) {
+		contents.write[i] = uint8_t((i * 13) ^ (i >> 8));
+	}
+	const String source_path = base_path.path_join("data.bin");
+	{
+		Ref<FileAccess> fw = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(fw.is_valid());
+		fw->store_buffer(contents);
+	}
+	const String pck_path = base_path.path_join("mapped.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(pck_path) == OK);
+		// Another file in the pack, so slices don't just start at the first file.
+		CHECK(pck_packer.add_file("padding.bin", source_path) == OK);
+		CHECK(pck_packer.add_file("data.bin", source_path) == OK);
+		CHECK(pck_packer.flush() == OK);
+	}
+
+	PackedData packed_data;
+	REQUIRE(packed_data.add_pack(pck_path, true, 0) == OK);
+	check_pack_file_reads(packed_data.try_open_path("res://data.bin"), contents);
+
+	// Without a mapping of the pack, the file is read from the pack file instead.
+	Vector<uint8_t> pack_contents = FileAccess::get_file_as_bytes(pck_path);
+	PackedData::PackedFile pf;
+	pf.pack = pck_path;
+	pf.offset = 0;
+	pf.size = contents.size();
+	pf.encrypted = false;
+	pf.bundle = false;
+	for (int i = pack_contents.size() - contents.size(); i > 0; i--) {
+		if (memcmp(pack_contents.ptr() + i, contents.ptr(), contents.size()) == 0) {
+			pf.offset = i; // Both files hold the same bytes, either one will do.
+			break;
+		}
+	}
+	REQUIRE(pf.offset > 0);
+	Ref<FileAccess> unmapped_file = memnew(FileAccessPack("res://data.bin", pf));
+	CHECK(unmapped_file->get_mapped_data().is_empty());
+	check_pack_file_reads(unmapped_file, contents);
+
+	DirAccess::remove_file_or_error(pck_path);
+	DirAccess::remove_file_or_error(source_path);
+}
+
 } // namespace TestFileAccess
@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 
@@ -116,4 +118,150 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Pack and load compressed files through the index") {
+	const String base_path = TestUtils::get_temp_path("pck_packer_compressed");
+	DirAccess::make_dir_recursive_absolute(base_path);
+
+	// Larger than a compression block, so reads have to cross block boundaries.
+	Vector<uint8_t> large_data;
+	large_data.resize(PACK_COMPRESSION_BLOCK_SIZE * 3 + 1234);
+	for (int i = 0; i < large_data.size(); i++) {
+		large_data.write[i] = uint8_t((i / 7) % 251);
+	}
+	const String large_source = base_path.path_join("large.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(large_source, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(large_data);
+	}
+	const String text_source = base_path.path_join("text.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(text_source, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("Hello PCK");
+	}
+
+	const String base_pck_path = base_path.path_join("base.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(base_pck_path) == OK);
+		CHECK(pck_packer.add_file("kept.txt", text_source) == OK);
+		CHECK(pck_packer.add_file("removed.txt", text_source) == OK);
+		CHECK(pck_packer.flush() == OK);
+	}
+
+	const String patch_pck_path = base_path.path_join("patch.pck");
+	{
+		PCKPacker pck_packer;
+		pck_packer.set_compression_enabled(true);
+		REQUIRE(pck_packer.pck_start(patch_pck_path) == OK);
+		CHECK(pck_packer.add_file("data/large.bin", large_source) == OK);
+		CHECK(pck_packer.add_file("data/text.txt", text_source) == OK);
+		CHECK(pck_packer.add_file_removal("removed.txt") == OK);
+		CHECK(pck_packer.flush() == OK);
+
+		Ref<FileAccess> f = FileAccess::open(patch_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK_MESSAGE(
+				f->get_length() < large_data.size() / 4,
+				"Compressible files should be stored compressed.");
+	}
+
+	PackedData packed_data;
+	REQUIRE(packed_data.add_pack(base_pck_path, true, 0) == OK);
+	REQUIRE(packed_data.add_pack(patch_pck_path, true, 0) == OK);
+
+	CHECK(packed_data.has_path("res://kept.txt"));
+	CHECK(packed_data.has_path("res://data/large.bin"));
+	CHECK_MESSAGE(
+			!packed_data.has_path("res://removed.txt"),
+			"Files removed by a later pack shouldn't be found.");
+
+	HashSet<String> paths = packed_data.get_file_paths();
+	CHECK(paths.has("res://data/large.bin"));
+	CHECK(paths.has("res://data/text.txt"));
+	CHECK(!paths.has("res://removed.txt"));
+
+	Ref<FileAccess> text_file = packed_data.try_open_path("res://data/text.txt");
+	REQUIRE(text_file.is_valid());
+	CHECK(text_file->get_as_utf8_string() == "Hello PCK");
+
+	Ref<FileAccess> large_file = packed_data.try_open_path("res://data/large.bin");
+	REQUIRE(large_file.is_valid());
+	CHECK(large_file->get_length() == uint64_t(large_data.size()));
+	CHECK(large_file->get_buffer(large_data.size()) == large_data);
+
+	// Read across a block boundary after seeking backwards.
+	const uint64_t seek_pos = PACK_COMPRESSION_BLOCK_SIZE * 2 - 100;
+	large_file->seek(seek_pos);
+	Vector<uint8_t> slice = large_file->get_buffer(200);
+	REQUIRE(slice.size() == 200);
+	bool slice_matches = true;
+	for (int i = 0; i < slice.size(); i++) {
+		slice_matches = slice_matches && slice[i] == large_data[seek_pos + i];
+	}
+	CHECK(slice_matches);
+	CHECK(large_file->get_8() == large_data[seek_pos + 200]);
+}
+TEST_CASE("[PCKPacker] Format version and index validation") {
+	const String base_path = TestUtils::get_temp_path("pck_packer_version");
+	DirAccess::make_dir_recursive_absolute(base_path);
+	const String text_source = base_path.path_join("text.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(text_source, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("Hello PCK, Hello PCK, Hello PCK, Hello PCK");
+	}
+
+	const String v3_pck_path = base_path.path_join("v3.pck");
+	{
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(v3_pck_path) == OK);
+		CHECK(pck_packer.add_file("text.txt", text_source) == OK);
+		CHECK(pck_packer.flush() == OK);
+	}
+	const String v4_pck_path = base_path.path_join("v4.pck");
+	{
+		PCKPacker pck_packer;
+		pck_packer.set_compression_enabled(true);
+		REQUIRE(pck_packer.pck_start(v4_pck_path) == OK);
+		CHECK(pck_packer.add_file("text.txt", text_source) == OK);
+		CHECK(pck_packer.flush() == OK);
+	}
+
+	Vector<uint8_t> v3_data = FileAccess::get_file_as_bytes(v3_pck_path);
+	REQUIRE(v3_data.size() > 48);
+	CHECK_MESSAGE(decode_uint32(v3_data.ptr() + 4) == PACK_FORMAT_VERSION_V3, "Packs without compression should stay readable by V3 readers.");
+	Vector<uint8_t> v4_data = FileAccess::get_file_as_bytes(v4_pck_path);
+	REQUIRE(v4_data.size() > 48);
+	CHECK(decode_uint32(v4_data.ptr() + 4) == PACK_FORMAT_VERSION_V4);
+
+	{
+		PackedData packed_data;
+		REQUIRE(packed_data.add_pack(v3_pck_path, true, 0) == OK);
+		REQUIRE(packed_data.add_pack(v4_pck_path, true, 0) == OK);
+		Ref<FileAccess> text_file = packed_data.try_open_path("res://text.txt");
+		REQUIRE(text_file.is_valid());
+		CHECK(text_file->get_as_utf8_string() == "Hello PCK, Hello PCK, Hello PCK, Hello PCK");
+	}
+
+	// An index claiming more entries than the pack can hold must be rejected before it's read.
+	const uint64_t index_offset = decode_uint64(v4_data.ptr() + 40);
+	REQUIRE(index_offset + 8 <= uint64_t(v4_data.size()));
+	encode_uint32(0x7FFFFFFF, v4_data.ptrw() + index_offset);
+	const String corrupt_pck_path = base_path.path_join("corrupt.pck");
+	{
+		Ref<FileAccess> f = FileAccess::open(corrupt_pck_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(v4_data);
+	}
+	{
+		PackedData packed_data;
+		ERR_PRINT_OFF;
+		CHECK(packed_data.add_pack(corrupt_pck_path, true, 0) != OK);
+		ERR_PRINT_ON;
+		CHECK(!packed_data.has_path("res://text.txt"));
+	}
+}
 } // namespace TestPCKPacker
@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct TestItem {
+	int id = 0;
+};
+
+template <typename T>
+class TestPairTestFunction {
+public:
+	static bool user_pair_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+template <typename T>
+class TestCullTestFunction {
+public:
+	static bool user_cull_check(const T *p_a, const T *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<TestItem, 1, true, 128, TestPairTestFunction<TestItem>, TestCullTestFunction<TestItem>> TestBVHManager;
+
+// Each event is (paired, id A, id B), with paired 0 for an unpair.
+static void *pair_callback(void *p_self, uint32_t p_A, TestItem *p_item_A, int p_subindex_A, uint32_t p_B, TestItem *p_item_B, int p_subindex_B) {
+	static_cast<Vector<Vector3i> *>(p_self)->push_back(Vector3i(1, p_item_A->id, p_item_B->id));
+	return nullptr;
+}
+
+static void unpair_callback(void *p_self, uint32_t p_A, TestItem *p_item_A, int p_subindex_A, uint32_t p_B, TestItem *p_item_B, int p_subindex_B, void *p_pair_data) {
+	static_cast<Vector<Vector3i> *>(p_self)->push_back(Vector3i(0, p_item_A->id, p_item_B->id));
+}
+
+static Vector<Vector3i> run_pairing(bool p_threaded) {
+	const int item_count = 1000;
+	const real_t extent = 30;
+
+	Vector<Vector3i> events;
+	LocalVector<TestItem> items;
+	items.resize(item_count);
+	LocalVector<BVHHandle> handles;
+	handles.resize(item_count);
+
+	TestBVHManager bvh;
+	bvh.params_set_threaded_pairing(p_threaded);
+	bvh.set_pair_callback(pair_callback, &events);
+	bvh.set_unpair_callback(unpair_callback, &events);
+
+	RandomPCG rng(1234);
+	for (int i = 0; i < item_count; i++) {
+		items[i].id = i;
+		Vector3 position(rng.random((real_t)0.0, extent), rng.random((real_t)0.0, extent), rng.random((real_t)0.0, extent));
+		handles[i] = bvh.create(&items[i], true, 0, 1, AABB(position, Vector3(1.5, 1.5, 1.5)));
+	}
+	bvh.update();
+
+	for (int i = 0; i < item_count; i++) {
+		Vector3 position(rng.random((real_t)0.0, extent), rng.random((real_t)0.0, extent), rng.random((real_t)0.0, extent));
+		bvh.move(handles[i], AABB(position, Vector3(1.5, 1.5, 1.5)));
+	}
+	bvh.update();
+
+	for (int i = 0; i < item_count; i++) {
+		bvh.erase(handles[i]);
+	}
+
+	return events;
+}
+
+TEST_CASE("[BVH] Threaded pairing matches single threaded pairing") {
+	const Vector<Vector3i> events = run_pairing(false);
+	const Vector<Vector3i> threaded_events = run_pairing(true);
+
+	CHECK_MESSAGE(events.size() > 0, "The test scene should generate pairs.");
+	CHECK_MESSAGE(threaded_events == events, "Pair and unpair callbacks should be made in the same order.");
+}
+
+} // namespace TestBVH
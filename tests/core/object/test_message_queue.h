@@ -0,0 +1,203 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/message_queue.h"
+#include "core/object/object.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class DeferredReceiver : public Object {
+public:
+	CallQueue *queue = nullptr;
+	LocalVector<int> values;
+
+	void record(int p_value) {
+		values.push_back(p_value);
+	}
+
+	void record_and_push(int p_value) {
+		values.push_back(p_value);
+		queue->push_callable(callable_mp(this, &DeferredReceiver::record), -p_value);
+	}
+};
+
+constexpr int THREAD_COUNT = 4;
+constexpr int CALLS_PER_THREAD = 1000;
+
+struct ProducerData {
+	CallQueue *queue = nullptr;
+	DeferredReceiver *receiver = nullptr;
+	int index = 0;
+};
+
+static void produce_calls(void *p_userdata) {
+	ProducerData *data = static_cast<ProducerData *>(p_userdata);
+	for (int i = 0; i < CALLS_PER_THREAD; i++) {
+		data->queue->push_callable(callable_mp(data->receiver, &DeferredReceiver::record), (data->index + 1) * CALLS_PER_THREAD * 10 + i);
+	}
+}
+
+TEST_CASE("[CallQueue] Push and flush from the same thread") {
+	CallQueue queue;
+	DeferredReceiver receiver;
+	receiver.queue = &queue;
+
+	CHECK_FALSE(queue.has_messages());
+	for (int i = 0; i < 10; i++) {
+		queue.push_callable(callable_mp(&receiver, &DeferredReceiver::record), i);
+	}
+	CHECK(queue.has_messages());
+
+	queue.flush();
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(receiver.values.size() == 10);
+	for (int i = 0; i < 10; i++) {
+		CHECK(receiver.values[i] == i);
+	}
+	CHECK(queue.get_stats().last_flush_messages == 10);
+	CHECK(queue.get_stats().thread_lanes == 0);
+}
+
+TEST_CASE("[CallQueue] Calls pushed while flushing are handled in the same flush") {
+	CallQueue queue;
+	DeferredReceiver receiver;
+	receiver.queue = &queue;
+
+	queue.push_callable(callable_mp(&receiver, &DeferredReceiver::record_and_push), 1);
+	queue.flush();
+
+	REQUIRE(receiver.values.size() == 2);
+	CHECK(receiver.values[0] == 1);
+	CHECK(receiver.values[1] == -1);
+	CHECK(queue.get_stats().last_flush_messages == 2);
+}
+
+TEST_CASE("[CallQueue] Thread lanes") {
+	CallQueue queue;
+	queue.set_thread_lanes_enabled(true);
+	DeferredReceiver receiver;
+	receiver.queue = &queue;
+
+	queue.push_callable(callable_mp(&receiver, &DeferredReceiver::record), 0);
+
+	Thread threads[THREAD_COUNT];
+	ProducerData data[THREAD_COUNT];
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		data[i].queue = &queue;
+		data[i].receiver = &receiver;
+		data[i].index = i;
+		threads[i].start(produce_calls, &data[i]);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	// Threads that don't overlap in time may share a lane.
+	CHECK(queue.has_messages());
+	CHECK(queue.get_stats().thread_lanes >= 1);
+	CHECK(queue.get_stats().thread_lanes <= THREAD_COUNT);
+
+	queue.flush();
+	CHECK_FALSE(queue.has_messages());
+	CHECK(queue.get_stats().last_flush_messages == THREAD_COUNT * CALLS_PER_THREAD + 1);
+	REQUIRE(receiver.values.size() == THREAD_COUNT * CALLS_PER_THREAD + 1);
+	CHECK_MESSAGE(receiver.values[0] == 0, "Calls pushed from the flushing thread should be handled first.");
+
+	// Each thread's calls must keep their order, and come in one block per lane.
+	bool ordered = true;
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		const int lane_start = 1 + i * CALLS_PER_THREAD;
+		const int thread_base = receiver.values[lane_start] - receiver.values[lane_start] % (CALLS_PER_THREAD * 10);
+		for (int j = 0; j < CALLS_PER_THREAD; j++) {
+			ordered = ordered && receiver.values[lane_start + j] == thread_base + j;
+		}
+	}
+	CHECK(ordered);
+
+	// Lanes are kept for later pushes, and pages are reused.
+	queue.push_callable(callable_mp(&receiver, &DeferredReceiver::record), 0);
+	queue.flush();
+	CHECK(queue.get_stats().last_flush_messages == 1);
+	CHECK(queue.get_stats().max_flush_messages == THREAD_COUNT * CALLS_PER_THREAD + 1);
+}
+
+TEST_CASE("[CallQueue] Thread lanes are reused after their threads exit") {
+	CallQueue queue;
+	queue.set_thread_lanes_enabled(true);
+	DeferredReceiver receiver;
+	receiver.queue = &queue;
+
+	// More threads than there can be lanes, started in batches and never flushed in between,
+	// so later batches push into the lanes still holding the calls of the earlier ones.
+	constexpr int BATCH_COUNT = 25;
+	constexpr int TOTAL_THREADS = BATCH_COUNT * THREAD_COUNT;
+	static_assert(TOTAL_THREADS > 64);
+
+	for (int batch = 0; batch < BATCH_COUNT; batch++) {
+		Thread threads[THREAD_COUNT];
+		ProducerData data[THREAD_COUNT];
+		for (int i = 0; i < THREAD_COUNT; i++) {
+			data[i].queue = &queue;
+			data[i].receiver = &receiver;
+			data[i].index = batch * THREAD_COUNT + i;
+			threads[i].start(produce_calls, &data[i]);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+	}
+
+	CHECK(queue.get_stats().thread_lanes >= 1);
+	CHECK(queue.get_stats().thread_lanes <= THREAD_COUNT);
+
+	queue.flush();
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(receiver.values.size() == TOTAL_THREADS * CALLS_PER_THREAD);
+
+	// No call is lost, and each thread's calls keep their order.
+	LocalVector<int> next_call;
+	next_call.resize_initialized(TOTAL_THREADS);
+	bool ordered = true;
+	for (int value : receiver.values) {
+		const int thread_index = value / (CALLS_PER_THREAD * 10) - 1;
+		ordered = ordered && thread_index >= 0 && thread_index < TOTAL_THREADS && value % (CALLS_PER_THREAD * 10) == next_call[thread_index];
+		if (ordered) {
+			next_call[thread_index]++;
+		}
+	}
+	CHECK(ordered);
+}
+
+} // namespace TestMessageQueue
@@ -455,6 +455,83 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class SignalReceiverObject : public Object {
+public:
+	Object *emitter = nullptr;
+	SignalReceiverObject *other = nullptr;
+	int calls = 0;
+
+	void on_signal() {
+		calls++;
+	}
+
+	void on_signal_connect_other() {
+		calls++;
+		emitter->connect("my_custom_signal", callable_mp(other, &SignalReceiverObject::on_signal));
+	}
+
+	void on_signal_disconnect_other() {
+		calls++;
+		emitter->disconnect("my_custom_signal", callable_mp(other, &SignalReceiverObject::on_signal));
+	}
+};
+
+TEST_CASE("[Object] Connecting and disconnecting while emitting signals") {
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal"));
+
+	SignalReceiverObject first;
+	SignalReceiverObject second;
+	first.emitter = &object;
+	first.other = &second;
+
+	SUBCASE("Connecting during emission should only affect later emissions") {
+		object.connect("my_custom_signal", callable_mp(&first, &SignalReceiverObject::on_signal_connect_other), Object::CONNECT_ONE_SHOT);
+
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 1);
+		CHECK(second.calls == 0);
+		CHECK(object.is_connected("my_custom_signal", callable_mp(&second, &SignalReceiverObject::on_signal)));
+
+		object.emit_signal("my_custom_signal");
+		CHECK_MESSAGE(first.calls == 1, "One-shot connections should only be called once.");
+		CHECK(second.calls == 1);
+	}
+
+	SUBCASE("Disconnecting during emission should affect later emissions") {
+		object.connect("my_custom_signal", callable_mp(&first, &SignalReceiverObject::on_signal_disconnect_other));
+		object.connect("my_custom_signal", callable_mp(&second, &SignalReceiverObject::on_signal));
+
+		object.emit_signal("my_custom_signal");
+		CHECK(first.calls == 1);
+		CHECK_FALSE(object.is_connected("my_custom_signal", callable_mp(&second, &SignalReceiverObject::on_signal)));
+
+		const int second_calls = second.calls;
+		ERR_PRINT_OFF;
+		object.emit_signal("my_custom_signal");
+		ERR_PRINT_ON;
+		CHECK(first.calls == 2);
+		CHECK(second.calls == second_calls);
+	}
+
+	SUBCASE("Repeated emissions should call every connection once each time") {
+		SignalReceiverObject receivers[16];
+		for (SignalReceiverObject &receiver : receivers) {
+			object.connect("my_custom_signal", callable_mp(&receiver, &SignalReceiverObject::on_signal));
+		}
+		for (int i = 0; i < 10; i++) {
+			object.emit_signal("my_custom_signal");
+		}
+		object.disconnect("my_custom_signal", callable_mp(&receivers[0], &SignalReceiverObject::on_signal));
+		object.emit_signal("my_custom_signal");
+
+		CHECK(receivers[0].calls == 10);
+		for (int i = 1; i < 16; i++) {
+			CHECK(receivers[i].calls == 11);
+		}
+	}
+}
+
 class NotificationObjectSuperclass : public Object {
 	GDCLASS(NotificationObjectSuperclass, Object);
 
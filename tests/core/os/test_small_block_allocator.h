@@ -0,0 +1,130 @@
+/**************************************************************************/
+/*  test_small_block_allocator.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/small_block_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSmallBlockAllocator {
+
+TEST_CASE("[SmallBlockAllocator] Allocation and freeing") {
+	CHECK(SmallBlockAllocator::alloc(SmallBlockAllocator::MAX_SIZE + 1) == nullptr);
+
+	LocalVector<void *> blocks;
+	for (size_t size = 1; size <= SmallBlockAllocator::MAX_SIZE; size++) {
+		void *block = SmallBlockAllocator::alloc(size);
+		REQUIRE(block != nullptr);
+		CHECK(SmallBlockAllocator::owns(block));
+		CHECK(SmallBlockAllocator::get_block_size(block) >= size);
+		CHECK(((uintptr_t)block % 16) == 0);
+		memset(block, 0xAB, size);
+		blocks.push_back(block);
+	}
+	for (void *block : blocks) {
+		SmallBlockAllocator::free(block);
+	}
+
+	void *system_block = malloc(32);
+	CHECK_FALSE(SmallBlockAllocator::owns(system_block));
+	::free(system_block);
+}
+
+TEST_CASE("[SmallBlockAllocator] Size classes") {
+	uint32_t prev_size = 0;
+	for (uint32_t i = 0; i < SmallBlockAllocator::SIZE_CLASS_COUNT; i++) {
+		uint32_t size = SmallBlockAllocator::get_size_class_block_size(i);
+		CHECK(size > prev_size);
+		CHECK((size % 16) == 0);
+		prev_size = size;
+	}
+	CHECK(prev_size == SmallBlockAllocator::MAX_SIZE);
+}
+
+static void free_blocks(void *p_userdata) {
+	LocalVector<void *> *blocks = (LocalVector<void *> *)p_userdata;
+	for (void *block : *blocks) {
+		SmallBlockAllocator::free(block);
+	}
+}
+
+static void alloc_blocks(void *p_userdata) {
+	LocalVector<void *> *blocks = (LocalVector<void *> *)p_userdata;
+	for (void *&block : *blocks) {
+		block = SmallBlockAllocator::alloc(64);
+	}
+}
+
+TEST_CASE("[SmallBlockAllocator] Freeing from other threads") {
+	SmallBlockAllocator::SizeClassStats stats_before[SmallBlockAllocator::SIZE_CLASS_COUNT];
+	SmallBlockAllocator::get_stats(stats_before);
+	const uint32_t size_class = 3; // 64 bytes.
+	REQUIRE(stats_before[size_class].block_size == 64);
+
+	LocalVector<void *> blocks;
+	blocks.resize(10000);
+	alloc_blocks(&blocks);
+	for (void *block : blocks) {
+		REQUIRE(block != nullptr);
+	}
+
+	SmallBlockAllocator::SizeClassStats stats[SmallBlockAllocator::SIZE_CLASS_COUNT];
+	SmallBlockAllocator::get_stats(stats);
+	CHECK(stats[size_class].blocks_used >= stats_before[size_class].blocks_used + blocks.size());
+	CHECK(stats[size_class].blocks_reserved >= stats[size_class].blocks_used);
+
+	Thread thread;
+	thread.start(free_blocks, &blocks);
+	thread.wait_to_finish();
+
+	SmallBlockAllocator::get_stats(stats);
+	CHECK(stats[size_class].remote_frees >= stats_before[size_class].remote_frees + blocks.size());
+
+	// The freed blocks must be reusable by the owning thread.
+	alloc_blocks(&blocks);
+	for (void *block : blocks) {
+		REQUIRE(block != nullptr);
+		SmallBlockAllocator::free(block);
+	}
+
+	// Blocks allocated by a thread that has exited can still be freed.
+	thread.start(alloc_blocks, &blocks);
+	thread.wait_to_finish();
+	for (void *block : blocks) {
+		REQUIRE(block != nullptr);
+		CHECK(SmallBlockAllocator::owns(block));
+		SmallBlockAllocator::free(block);
+	}
+}
+
+} // namespace TestSmallBlockAllocator
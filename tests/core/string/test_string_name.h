@@ -0,0 +1,131 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = "test_string_name_interning_other";
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+	CHECK(String(a) == "test_string_name_interning");
+	CHECK(StringName().is_empty());
+	CHECK(StringName("") == StringName());
+}
+
+TEST_CASE("[StringName] Releasing the last reference") {
+	const String name = "test_string_name_released";
+	{
+		StringName a = name;
+		StringName b = a;
+		a = StringName();
+		CHECK(b == name);
+	}
+	// Interning the same name again must give a valid entry, not the released one.
+	const StringName c = name;
+	CHECK(c == name);
+	CHECK(c.length() == name.length());
+}
+
+struct InternData {
+	uint32_t thread_index = 0;
+	uint32_t name_count = 0;
+	uint32_t iterations = 0;
+	bool shared_names = false;
+	LocalVector<StringName> results;
+};
+
+static void intern_names(void *p_userdata) {
+	InternData *data = (InternData *)p_userdata;
+	const String prefix = data->shared_names ? String("shared_") : vformat("thread_%d_", data->thread_index);
+	LocalVector<String> names;
+	names.resize(data->name_count);
+	for (uint32_t i = 0; i < data->name_count; i++) {
+		names[i] = prefix + itos(i);
+	}
+	data->results.resize(data->name_count);
+	for (uint32_t i = 0; i < data->iterations; i++) {
+		for (uint32_t j = 0; j < data->name_count; j++) {
+			// Alternate between creating the only reference and a second one,
+			// so both the insertion and the release paths are exercised.
+			StringName sname = names[j];
+			if ((i + j) % 2) {
+				data->results[j] = sname;
+			} else {
+				data->results[j] = StringName();
+			}
+		}
+	}
+	for (uint32_t j = 0; j < data->name_count; j++) {
+		data->results[j] = names[j];
+	}
+}
+
+static void run_interning(uint32_t p_thread_count, uint32_t p_name_count, uint32_t p_iterations, bool p_shared_names, LocalVector<InternData> &r_data) {
+	r_data.resize(p_thread_count);
+	LocalVector<Thread> threads;
+	threads.resize(p_thread_count);
+	for (uint32_t i = 0; i < p_thread_count; i++) {
+		r_data[i].thread_index = i;
+		r_data[i].name_count = p_name_count;
+		r_data[i].iterations = p_iterations;
+		r_data[i].shared_names = p_shared_names;
+		threads[i].start(intern_names, &r_data[i]);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+}
+
+TEST_CASE("[StringName] Interning from multiple threads") {
+	LocalVector<InternData> data;
+	run_interning(4, 200, 50, true, data);
+
+	for (uint32_t j = 0; j < 200; j++) {
+		const StringName expected = "shared_" + itos(j);
+		for (const InternData &thread_data : data) {
+			CHECK(thread_data.results[j] == expected);
+		}
+	}
+}
+
+} // namespace TestStringName
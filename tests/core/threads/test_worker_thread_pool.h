@@ -172,4 +172,156 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_nested_leaf_test(void *p_arg) {
+	counter[(uintptr_t)p_arg].increment();
+}
+
+static void static_nested_test(void *p_arg) {
+	// Posted from a pool thread, so these go to its local queue and may be stolen by others.
+	// Waiting on them is collaborative, so this can't starve even with a single pool thread.
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(counter.size());
+	for (uint32_t i = 0; i < tasks.size(); i++) {
+		tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf_test, (void *)(uintptr_t)i, true);
+	}
+	for (WorkerThreadPool::TaskID task : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 10.0f));
+		const int nested = 1 + Math::rand() % 8;
+
+		counter.clear();
+		counter.resize(count);
+
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		for (int i = 0; i < nested; i++) {
+			tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_nested_test, nullptr, true));
+		}
+		for (WorkerThreadPool::TaskID task : tasks) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		}
+
+		bool all_run_expected = true;
+		for (int i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run_expected &= counter[i].get() == nested;
+		}
+		CHECK(all_run_expected);
+	}
+}
+
+static LocalVector<uint32_t> run_order;
+static SafeNumeric<uint32_t> run_sequence;
+
+static void static_ordered_test(void *p_arg) {
+	run_order[(uintptr_t)p_arg] = run_sequence.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Dependent tasks run after their dependencies") {
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const int count = 2 + Math::rand() % 64;
+
+		run_order.clear();
+		run_order.resize(count);
+		run_sequence.set(0);
+
+		// Build a random DAG where every task depends on some of the ones created before it.
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		LocalVector<LocalVector<int>> dependencies;
+		tasks.resize(count);
+		dependencies.resize(count);
+		for (int i = 0; i < count; i++) {
+			LocalVector<WorkerThreadPool::TaskID> dependency_ids;
+			for (int j = 0; j < i; j++) {
+				if (Math::rand() % 4 == 0) {
+					dependencies[i].push_back(j);
+					dependency_ids.push_back(tasks[j]);
+				}
+			}
+			tasks[i] = WorkerThreadPool::get_singleton()->add_native_dependent_task(static_ordered_test, (void *)(uintptr_t)i, dependency_ids, Math::rand() % 2);
+		}
+		for (int i = count - 1; i >= 0; i--) {
+			CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]) == OK);
+		}
+
+		bool all_ordered = true;
+		for (int i = 0; i < count; i++) {
+			all_ordered &= run_order[i] != 0;
+			for (int dependency : dependencies[i]) {
+				//Reduce number of check messages
+				all_ordered &= run_order[dependency] < run_order[i];
+			}
+		}
+		CHECK(all_ordered);
+	}
+}
+
+static void static_fan_in_test(void *p_arg) {
+	int total = 0;
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		total += counter[i].get();
+	}
+	*(int *)p_arg = total;
+}
+
+TEST_CASE("[WorkerThreadPool] Dependent task waits for group tasks") {
+	const int count = 1000;
+	counter.clear();
+	counter.resize(count);
+
+	WorkerThreadPool::GroupID group1 = WorkerThreadPool::get_singleton()->add_native_group_task(static_group_test, (void *)0, count, -1, true);
+	WorkerThreadPool::GroupID group2 = WorkerThreadPool::get_singleton()->add_native_group_task(static_group_test, (void *)0, count, -1, false);
+	int total = 0;
+	WorkerThreadPool::TaskID dependencies[] = { group1, group2 };
+	WorkerThreadPool::TaskID fan_in = WorkerThreadPool::get_singleton()->add_native_dependent_task(static_fan_in_test, &total, dependencies, true);
+
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(fan_in) == OK);
+	CHECK_MESSAGE(total == count * 2, "The dependent task should see the work of both groups done.");
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group1);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group2);
+
+	// Depending on tasks already awaited just runs.
+	total = 0;
+	fan_in = WorkerThreadPool::get_singleton()->add_native_dependent_task(static_fan_in_test, &total, dependencies, true);
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(fan_in) == OK);
+	CHECK(total == count * 2);
+}
+
+TEST_CASE("[WorkerThreadPool] Cancelling tasks") {
+	exit.clear();
+	counter.clear();
+	counter.resize(1);
+
+	// Keeps the dependencies pending until cancellation is done.
+	WorkerThreadPool::TaskID blocker = WorkerThreadPool::get_singleton()->add_native_task(static_busy_task, nullptr, true);
+	WorkerThreadPool::TaskID blocker_ids[] = { blocker };
+
+	WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_dependent_task(static_test, (void *)0, blocker_ids, true);
+	WorkerThreadPool::TaskID first_ids[] = { first };
+	WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_dependent_task(static_test, (void *)0, first_ids, true);
+	WorkerThreadPool::TaskID unrelated = WorkerThreadPool::get_singleton()->add_native_dependent_task(static_test, (void *)0, blocker_ids, true);
+
+	CHECK(WorkerThreadPool::get_singleton()->cancel_task(first));
+	exit.set();
+
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(blocker) == OK);
+	CHECK_MESSAGE(WorkerThreadPool::get_singleton()->wait_for_task_completion(first) == ERR_SKIP, "Cancelled task should report it didn't run.");
+	CHECK_MESSAGE(WorkerThreadPool::get_singleton()->wait_for_task_completion(second) == ERR_SKIP, "Cancellation should propagate to dependent tasks.");
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(unrelated) == OK);
+	// Only the unrelated task ran (static_test adds 1 + 2 to the counter).
+	CHECK(counter[0].get() == 3);
+
+	WorkerThreadPool::TaskID done = WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)0, true);
+	while (!WorkerThreadPool::get_singleton()->is_task_completed(done)) {
+		OS::get_singleton()->delay_usec(1);
+	}
+	CHECK_FALSE_MESSAGE(WorkerThreadPool::get_singleton()->cancel_task(done), "Completed tasks can't be cancelled.");
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(done) == OK);
+}
+
 } // namespace TestWorkerThreadPool
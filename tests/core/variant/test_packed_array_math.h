@@ -0,0 +1,193 @@
+/**************************************************************************/
+/*  test_packed_array_math.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/variant/packed_array_math.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedArrayMath {
+
+// Sizes around the register widths, so both the vector loops and the scalar
+// remainders get exercised.
+static const int64_t test_sizes[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 33 };
+
+template <typename T>
+static Vector<T> make_values(int64_t p_size, T p_scale, T p_offset) {
+	Vector<T> values;
+	values.resize(p_size);
+	T *w = values.ptrw();
+	for (int64_t i = 0; i < p_size; i++) {
+		w[i] = T((i * 7) % 11) * p_scale + p_offset;
+	}
+	return values;
+}
+
+template <typename T>
+static void test_element_wise_kernels() {
+	for (int64_t size : test_sizes) {
+		const Vector<T> a = make_values<T>(size, 0.5, -2);
+		const Vector<T> b = make_values<T>(size, -0.25, 1);
+		const Vector<T> c = make_values<T>(size, 2, 0.125);
+
+		Vector<T> r = a;
+		PackedArrayMath::add_scalar(r.ptrw(), size, T(1.5));
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(r[i] == doctest::Approx(a[i] + T(1.5)));
+		}
+
+		r = a;
+		PackedArrayMath::multiply_add_scalar(r.ptrw(), size, T(3), T(-1));
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(r[i] == doctest::Approx(a[i] * T(3) - T(1)));
+		}
+
+		r = a;
+		PackedArrayMath::multiply_add_array(r.ptrw(), b.ptr(), c.ptr(), size);
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(r[i] == doctest::Approx(a[i] * b[i] + c[i]));
+		}
+
+		r = a;
+		PackedArrayMath::clamp(r.ptrw(), size, T(-1), T(1));
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(r[i] == CLAMP(a[i], T(-1), T(1)));
+		}
+
+		r = a;
+		PackedArrayMath::lerp(r.ptrw(), c.ptr(), size, T(0.25));
+		for (int64_t i = 0; i < size; i++) {
+			CHECK(r[i] == doctest::Approx(Math::lerp(a[i], c[i], T(0.25))));
+		}
+	}
+}
+
+template <typename T>
+static void test_reductions() {
+	for (int64_t size : test_sizes) {
+		const Vector<T> a = make_values<T>(size, 0.5, -2);
+		const Vector<T> b = make_values<T>(size, -0.25, 1);
+
+		T sum = 0;
+		T dot = 0;
+		T min = size ? a[0] : 0;
+		T max = size ? a[0] : 0;
+		for (int64_t i = 0; i < size; i++) {
+			sum += a[i];
+			dot += a[i] * b[i];
+			min = MIN(min, a[i]);
+			max = MAX(max, a[i]);
+		}
+
+		CHECK(PackedArrayMath::sum(a.ptr(), size) == doctest::Approx(sum));
+		CHECK(PackedArrayMath::dot(a.ptr(), b.ptr(), size) == doctest::Approx(dot));
+		CHECK(PackedArrayMath::min(a.ptr(), size) == min);
+		CHECK(PackedArrayMath::max(a.ptr(), size) == max);
+	}
+}
+
+TEST_CASE("[PackedArrayMath] Element-wise float kernels") {
+	test_element_wise_kernels<float>();
+}
+
+TEST_CASE("[PackedArrayMath] Element-wise double kernels") {
+	test_element_wise_kernels<double>();
+}
+
+TEST_CASE("[PackedArrayMath] Float and double reductions") {
+	test_reductions<float>();
+	test_reductions<double>();
+}
+
+TEST_CASE("[PackedArrayMath] Vector3 kernels") {
+	PackedVector3Array points = { Vector3(1, 2, 3), Vector3(-4, 0, 0.5), Vector3(0, 0, 0), Vector3(2, -1, 8), Vector3(3, 3, -3) };
+	const Transform3D xform = Transform3D(Basis(Vector3(0, 1, 0), Math::PI / 3).scaled(Vector3(2, 1, 0.5)), Vector3(1, -2, 3));
+
+	PackedVector3Array transformed = points;
+	PackedArrayMath::transform(transformed.ptrw(), transformed.size(), xform);
+	for (int64_t i = 0; i < points.size(); i++) {
+		CHECK(transformed[i].is_equal_approx(xform.xform(points[i])));
+	}
+
+	PackedVector3Array normalized = points;
+	PackedArrayMath::normalize(normalized.ptrw(), normalized.size());
+	for (int64_t i = 0; i < points.size(); i++) {
+		CHECK(normalized[i].is_equal_approx(points[i].normalized()));
+	}
+
+	PackedVector3Array clamped = points;
+	PackedArrayMath::clamp(clamped.ptrw(), clamped.size(), Vector3(-1, -1, 0), Vector3(2, 2, 4));
+	for (int64_t i = 0; i < points.size(); i++) {
+		CHECK(clamped[i] == points[i].clamp(Vector3(-1, -1, 0), Vector3(2, 2, 4)));
+	}
+
+	PackedVector3Array scaled = points;
+	PackedArrayMath::multiply_scalar(scaled.ptrw(), scaled.size(), 2);
+	PackedArrayMath::add_vector(scaled.ptrw(), scaled.size(), Vector3(0, 1, 0));
+	for (int64_t i = 0; i < points.size(); i++) {
+		CHECK(scaled[i] == points[i] * 2 + Vector3(0, 1, 0));
+	}
+
+	CHECK(PackedArrayMath::sum(points.ptr(), points.size()).is_equal_approx(Vector3(2, 4, 8.5)));
+	CHECK(PackedArrayMath::min(points.ptr(), points.size()) == Vector3(-4, -1, -3));
+	CHECK(PackedArrayMath::max(points.ptr(), points.size()) == Vector3(3, 3, 8));
+	CHECK(PackedArrayMath::min(points.ptr(), 0) == Vector3());
+}
+
+TEST_CASE("[PackedArrayMath] Bound packed array methods") {
+	Variant floats = PackedFloat32Array({ 1, 2, 3, 4, 5 });
+	floats.call("multiply_add_scalar", 2, 1);
+	CHECK(PackedFloat32Array(floats) == PackedFloat32Array({ 3, 5, 7, 9, 11 }));
+	floats.call("clamp", 4, 10);
+	CHECK(PackedFloat32Array(floats) == PackedFloat32Array({ 4, 5, 7, 9, 10 }));
+	CHECK(double(floats.call("sum")) == doctest::Approx(35));
+	CHECK(double(floats.call("min")) == 4);
+	CHECK(double(floats.call("max")) == 10);
+
+	Variant doubles = PackedFloat64Array({ 1, 2, 3 });
+	doubles.call("add_array", PackedFloat64Array({ 0.5, 0.5, 0.5 }));
+	CHECK(PackedFloat64Array(doubles) == PackedFloat64Array({ 1.5, 2.5, 3.5 }));
+	CHECK(double(doubles.call("dot", PackedFloat64Array({ 2, 0, 1 }))) == doctest::Approx(6.5));
+
+	ERR_PRINT_OFF;
+	doubles.call("add_array", PackedFloat64Array({ 1 }));
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(PackedFloat64Array(doubles) == PackedFloat64Array({ 1.5, 2.5, 3.5 }), "Mismatched sizes should leave the array untouched.");
+
+	Variant points = PackedVector3Array({ Vector3(3, 0, 4), Vector3(0, 2, 0) });
+	CHECK(PackedFloat32Array(points.call("lengths")) == PackedFloat32Array({ 5, 2 }));
+	points.call("transform", Transform3D(Basis(), Vector3(1, 1, 1)));
+	CHECK(PackedVector3Array(points) == PackedVector3Array({ Vector3(4, 1, 5), Vector3(1, 3, 1) }));
+	CHECK(PackedFloat32Array(points.call("dot", Vector3(0, 1, 0))) == PackedFloat32Array({ 1, 3 }));
+}
+
+} // namespace TestPackedArrayMath
@@ -0,0 +1,464 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+constexpr real_t STEP_TIME = 1.0 / 60.0;
+
+struct TestScene {
+	RID space;
+	LocalVector<RID> bodies;
+};
+
+struct BodyState {
+	Transform2D transform;
+	Vector2 linear_velocity;
+	real_t angular_velocity = 0.0;
+	bool sleeping = false;
+};
+
+struct TestShapes {
+	RID ground;
+	RID box;
+	RID circle;
+};
+
+// Godot Physics is tested directly, whatever the project's default server is.
+static PhysicsServer2D *create_godot_physics_server() {
+	PhysicsServer2D *ps = PhysicsServer2DManager::get_singleton()->new_server("GodotPhysics2D");
+	if (ps) {
+		ps->init();
+	}
+	return ps;
+}
+
+static void free_server(PhysicsServer2D *p_ps) {
+	p_ps->finish();
+	memdelete(p_ps);
+}
+
+static TestShapes create_shapes(PhysicsServer2D *p_ps) {
+	TestShapes shapes;
+	shapes.ground = p_ps->world_boundary_shape_create();
+	Array ground_data = { Vector2(0, -1), 0 };
+	p_ps->shape_set_data(shapes.ground, ground_data);
+	shapes.box = p_ps->rectangle_shape_create();
+	p_ps->shape_set_data(shapes.box, Vector2(16, 16));
+	shapes.circle = p_ps->circle_shape_create();
+	p_ps->shape_set_data(shapes.circle, 16);
+	return shapes;
+}
+
+static void free_shapes(PhysicsServer2D *p_ps, const TestShapes &p_shapes) {
+	p_ps->free(p_shapes.ground);
+	p_ps->free(p_shapes.box);
+	p_ps->free(p_shapes.circle);
+}
+
+static RID add_body(PhysicsServer2D *p_ps, TestScene &r_scene, PhysicsServer2D::BodyMode p_mode, RID p_shape, const Vector2 &p_position, bool p_can_sleep) {
+	RID body = p_ps->body_create();
+	p_ps->body_set_mode(body, p_mode);
+	p_ps->body_add_shape(body, p_shape);
+	p_ps->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, p_position));
+	p_ps->body_set_state(body, PhysicsServer2D::BODY_STATE_CAN_SLEEP, p_can_sleep);
+	p_ps->body_set_space(body, r_scene.space);
+	r_scene.bodies.push_back(body);
+	return body;
+}
+
+// Columns of stacked boxes on a static floor, next to a bouncing circle and a box sliding along the floor.
+// The boxes start resting on each other, so they have contacts from the first step.
+static TestScene create_scene(PhysicsServer2D *p_ps, const TestShapes &p_shapes, int p_columns, int p_stack_height, bool p_can_sleep) {
+	TestScene scene;
+	scene.space = p_ps->space_create();
+	p_ps->space_set_active(scene.space, true);
+
+	RID ground = add_body(p_ps, scene, PhysicsServer2D::BODY_MODE_STATIC, p_shapes.ground, Vector2(), p_can_sleep);
+	p_ps->body_set_param(ground, PhysicsServer2D::BODY_PARAM_FRICTION, 0.5);
+
+	for (int x = 0; x < p_columns; x++) {
+		for (int y = 0; y < p_stack_height; y++) {
+			add_body(p_ps, scene, PhysicsServer2D::BODY_MODE_RIGID, p_shapes.box, Vector2(x * 64, -16 - y * 32), p_can_sleep);
+		}
+	}
+
+	RID circle = add_body(p_ps, scene, PhysicsServer2D::BODY_MODE_RIGID, p_shapes.circle, Vector2(-128, -96), p_can_sleep);
+	p_ps->body_set_param(circle, PhysicsServer2D::BODY_PARAM_BOUNCE, 0.8);
+
+	RID slider = add_body(p_ps, scene, PhysicsServer2D::BODY_MODE_RIGID, p_shapes.box, Vector2(-512, -16), p_can_sleep);
+	p_ps->body_set_param(slider, PhysicsServer2D::BODY_PARAM_FRICTION, 0.5);
+	p_ps->body_set_state(slider, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY, Vector2(192, 0));
+
+	return scene;
+}
+
+static void free_scene(PhysicsServer2D *p_ps, const TestScene &p_scene) {
+	for (const RID &body : p_scene.bodies) {
+		p_ps->free(body);
+	}
+	p_ps->free(p_scene.space);
+}
+
+static void step(PhysicsServer2D *p_ps, int p_steps) {
+	for (int i = 0; i < p_steps; i++) {
+		p_ps->step(STEP_TIME);
+	}
+}
+
+static void get_body_states(PhysicsServer2D *p_ps, const TestScene &p_scene, LocalVector<BodyState> &r_states) {
+	r_states.resize(p_scene.bodies.size());
+	for (uint32_t i = 0; i < p_scene.bodies.size(); i++) {
+		r_states[i].transform = p_ps->body_get_state(p_scene.bodies[i], PhysicsServer2D::BODY_STATE_TRANSFORM);
+		r_states[i].linear_velocity = p_ps->body_get_state(p_scene.bodies[i], PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		r_states[i].angular_velocity = p_ps->body_get_state(p_scene.bodies[i], PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY);
+		r_states[i].sleeping = p_ps->body_get_state(p_scene.bodies[i], PhysicsServer2D::BODY_STATE_SLEEPING);
+	}
+}
+
+static void check_body_states_equal(const LocalVector<BodyState> &p_states, const LocalVector<BodyState> &p_expected) {
+	REQUIRE(p_states.size() == p_expected.size());
+	for (uint32_t i = 0; i < p_states.size(); i++) {
+		CHECK(p_states[i].transform == p_expected[i].transform);
+		CHECK(p_states[i].linear_velocity == p_expected[i].linear_velocity);
+		CHECK(p_states[i].angular_velocity == p_expected[i].angular_velocity);
+		CHECK(p_states[i].sleeping == p_expected[i].sleeping);
+	}
+}
+
+struct ContactState {
+	uint32_t body = 0;
+	Vector2 local_position;
+	Vector2 collider_position;
+	Vector2 impulse;
+};
+
+// Reported contacts carry the positions and accumulated impulses of the body pairs that found them.
+static void enable_contact_reports(PhysicsServer2D *p_ps, const TestScene &p_scene) {
+	for (const RID &body : p_scene.bodies) {
+		// Static bodies would get contacts from all islands at once.
+		if (p_ps->body_get_mode(body) != PhysicsServer2D::BODY_MODE_STATIC) {
+			p_ps->body_set_max_contacts_reported(body, 8);
+		}
+	}
+}
+
+static void get_contact_states(PhysicsServer2D *p_ps, const TestScene &p_scene, LocalVector<ContactState> &r_contacts) {
+	r_contacts.clear();
+	for (uint32_t i = 0; i < p_scene.bodies.size(); i++) {
+		PhysicsDirectBodyState2D *state = p_ps->body_get_direct_state(p_scene.bodies[i]);
+		REQUIRE(state);
+		for (int j = 0; j < state->get_contact_count(); j++) {
+			ContactState contact;
+			contact.body = i;
+			contact.local_position = state->get_contact_local_position(j);
+			contact.collider_position = state->get_contact_collider_position(j);
+			contact.impulse = state->get_contact_impulse(j);
+			r_contacts.push_back(contact);
+		}
+	}
+}
+
+static void check_contact_states_equal(const LocalVector<ContactState> &p_contacts, const LocalVector<ContactState> &p_expected) {
+	REQUIRE(p_contacts.size() == p_expected.size());
+	for (uint32_t i = 0; i < p_contacts.size(); i++) {
+		CHECK(p_contacts[i].body == p_expected[i].body);
+		CHECK(p_contacts[i].local_position == p_expected[i].local_position);
+		CHECK(p_contacts[i].collider_position == p_expected[i].collider_position);
+		CHECK(p_contacts[i].impulse == p_expected[i].impulse);
+	}
+}
+
+TEST_CASE("[PhysicsServer2D] Stepping with worker threads matches a single-threaded step") {
+	PhysicsServer2D *ps = create_godot_physics_server();
+	REQUIRE(ps);
+	TestShapes shapes = create_shapes(ps);
+	ps->set_active(true);
+
+	LocalVector<BodyState> threaded_states;
+	TestScene scene = create_scene(ps, shapes, 24, 6, true);
+	step(ps, 120);
+	get_body_states(ps, scene, threaded_states);
+	free_scene(ps, scene);
+
+	// With a single pool thread, group tasks process their elements one after another, in order.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(1);
+
+	LocalVector<BodyState> serial_states;
+	scene = create_scene(ps, shapes, 24, 6, true);
+	step(ps, 120);
+	get_body_states(ps, scene, serial_states);
+	free_scene(ps, scene);
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+
+	check_body_states_equal(threaded_states, serial_states);
+
+	free_shapes(ps, shapes);
+	free_server(ps);
+}
+
+TEST_CASE("[PhysicsServer2D] Batched queries match single queries") {
+	PhysicsServer2D *ps = create_godot_physics_server();
+	REQUIRE(ps);
+	TestShapes shapes = create_shapes(ps);
+
+	// Godot Physics culls at most this many shapes for each query.
+	constexpr int CULL_MAX = 2048;
+
+	// A grid of boxes on alternating collision layers, next to a pile of more overlapping boxes than a query can cull.
+	TestScene scene;
+	scene.space = ps->space_create();
+	ps->space_set_active(scene.space, true);
+	for (int x = 0; x < 12; x++) {
+		for (int y = 0; y < 12; y++) {
+			RID body = add_body(ps, scene, PhysicsServer2D::BODY_MODE_STATIC, shapes.box, Vector2(x * 64, y * 64), true);
+			ps->body_set_collision_layer(body, (x + y) % 2 ? 1 : 2);
+		}
+	}
+	for (int i = 0; i < CULL_MAX + 100; i++) {
+		add_body(ps, scene, PhysicsServer2D::BODY_MODE_STATIC, shapes.box, Vector2(2000 + (i % 10) * 2, 0), true);
+	}
+
+	LocalVector<Vector2> from;
+	LocalVector<Vector2> to;
+	LocalVector<Transform2D> transforms;
+	LocalVector<Vector2> motions;
+	for (int i = 0; i < 64; i++) {
+		const real_t u = (i % 8) * 100 - 40;
+		const real_t v = (i / 8) * 100 - 40;
+		from.push_back(Vector2(u, -100));
+		to.push_back(Vector2(700 - v, 800));
+		transforms.push_back(Transform2D(0, Vector2(u, v)));
+		motions.push_back(Vector2(v - u, 96));
+	}
+	from.push_back(Vector2(2010, -100));
+	to.push_back(Vector2(2010, 100));
+	transforms.push_back(Transform2D(0, Vector2(2010, 0)));
+	motions.push_back(Vector2(0, 96));
+	const int count = from.size();
+
+	HashSet<RID> exclude;
+	for (uint32_t i = 0; i < scene.bodies.size(); i += 3) {
+		exclude.insert(scene.bodies[i]);
+	}
+
+	PhysicsDirectSpaceState2D *space_state = ps->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	// Queries are checked with the default filter, a collision mask and an exclude list.
+	for (int filter = 0; filter < 3; filter++) {
+		PhysicsDirectSpaceState2D::RayParameters ray_parameters;
+		PhysicsDirectSpaceState2D::ShapeParameters shape_parameters;
+		shape_parameters.shape_rid = shapes.box;
+		if (filter == 1) {
+			ray_parameters.collision_mask = 2;
+			shape_parameters.collision_mask = 2;
+		} else if (filter == 2) {
+			ray_parameters.exclude = exclude;
+			shape_parameters.exclude = exclude;
+		}
+
+		LocalVector<bool> collided;
+		LocalVector<PhysicsDirectSpaceState2D::RayResult> ray_results;
+		collided.resize(count);
+		ray_results.resize(count);
+		space_state->intersect_rays(ray_parameters, from.ptr(), to.ptr(), count, collided.ptr(), ray_results.ptr());
+
+		int ray_hits = 0;
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState2D::RayParameters single_parameters = ray_parameters;
+			single_parameters.from = from[i];
+			single_parameters.to = to[i];
+			PhysicsDirectSpaceState2D::RayResult expected;
+			const bool expected_collided = space_state->intersect_ray(single_parameters, expected);
+			CHECK(collided[i] == expected_collided);
+			if (!expected_collided) {
+				continue;
+			}
+			ray_hits++;
+			CHECK(ray_results[i].position == expected.position);
+			CHECK(ray_results[i].normal == expected.normal);
+			CHECK(ray_results[i].rid == expected.rid);
+			CHECK(ray_results[i].collider_id == expected.collider_id);
+			CHECK(ray_results[i].shape == expected.shape);
+			if (filter == 1) {
+				CHECK((ps->body_get_collision_layer(ray_results[i].rid) & 2) != 0);
+			} else if (filter == 2) {
+				CHECK_FALSE(exclude.has(ray_results[i].rid));
+			}
+		}
+		CHECK(ray_hits > 0);
+
+		// Large enough to never limit the results, so every culled shape is checked.
+		const int result_max = CULL_MAX + 100;
+		LocalVector<PhysicsDirectSpaceState2D::ShapeResult> shape_results;
+		LocalVector<int> result_counts;
+		shape_results.resize(count * result_max);
+		result_counts.resize(count);
+		space_state->intersect_shapes(shape_parameters, transforms.ptr(), count, shape_results.ptr(), result_max, result_counts.ptr());
+
+		LocalVector<PhysicsDirectSpaceState2D::ShapeResult> expected_shape_results;
+		expected_shape_results.resize(result_max);
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState2D::ShapeParameters single_parameters = shape_parameters;
+			single_parameters.transform = transforms[i];
+			const int expected_count = space_state->intersect_shape(single_parameters, expected_shape_results.ptr(), result_max);
+			REQUIRE(result_counts[i] == expected_count);
+			for (int j = 0; j < expected_count; j++) {
+				const PhysicsDirectSpaceState2D::ShapeResult &result = shape_results[i * result_max + j];
+				CHECK(result.rid == expected_shape_results[j].rid);
+				CHECK(result.collider_id == expected_shape_results[j].collider_id);
+				CHECK(result.shape == expected_shape_results[j].shape);
+			}
+		}
+		if (filter == 0) {
+			// The pile query is limited by the cull, not by result_max.
+			CHECK(result_counts[count - 1] == CULL_MAX);
+		}
+
+		LocalVector<real_t> closest_safe;
+		LocalVector<real_t> closest_unsafe;
+		closest_safe.resize(count);
+		closest_unsafe.resize(count);
+		space_state->cast_motions(shape_parameters, transforms.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+		int blocked_motions = 0;
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState2D::ShapeParameters single_parameters = shape_parameters;
+			single_parameters.transform = transforms[i];
+			single_parameters.motion = motions[i];
+			real_t expected_safe = 1.0;
+			real_t expected_unsafe = 1.0;
+			space_state->cast_motion(single_parameters, expected_safe, expected_unsafe);
+			CHECK(closest_safe[i] == expected_safe);
+			CHECK(closest_unsafe[i] == expected_unsafe);
+			if (expected_unsafe < 1) {
+				blocked_motions++;
+			}
+		}
+		CHECK(blocked_motions > 0);
+	}
+
+	free_scene(ps, scene);
+	free_shapes(ps, shapes);
+	free_server(ps);
+}
+
+TEST_CASE("[PhysicsServer2D] Restoring a snapshot replays the same steps") {
+	PhysicsServer2D *ps = create_godot_physics_server();
+	REQUIRE(ps);
+	TestShapes shapes = create_shapes(ps);
+	TestScene scene = create_scene(ps, shapes, 2, 4, true);
+	enable_contact_reports(ps, scene);
+	ps->set_active(true);
+
+	// The snapshot is taken before the circle lands and before anything can fall asleep.
+	constexpr int STEPS_BEFORE_SNAPSHOT = 15;
+	constexpr int STEPS_AFTER_SNAPSHOT = 60;
+
+	step(ps, STEPS_BEFORE_SNAPSHOT);
+	LocalVector<BodyState> snapshot_states;
+	get_body_states(ps, scene, snapshot_states);
+	const Vector<uint8_t> snapshot = ps->space_snapshot(scene.space);
+	REQUIRE(!snapshot.is_empty());
+
+	step(ps, STEPS_AFTER_SNAPSHOT);
+	LocalVector<BodyState> expected_states;
+	get_body_states(ps, scene, expected_states);
+	LocalVector<ContactState> expected_contacts;
+	get_contact_states(ps, scene, expected_contacts);
+	CHECK(!expected_contacts.is_empty());
+
+	SUBCASE("Stepping again gives the same bodies and contacts") {
+		ps->space_restore(scene.space, snapshot);
+		LocalVector<BodyState> states;
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, snapshot_states);
+
+		step(ps, STEPS_AFTER_SNAPSHOT);
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, expected_states);
+		LocalVector<ContactState> contacts;
+		get_contact_states(ps, scene, contacts);
+		check_contact_states_equal(contacts, expected_contacts);
+	}
+
+	SUBCASE("Restoring fails without changes after adding a body") {
+		add_body(ps, scene, PhysicsServer2D::BODY_MODE_RIGID, shapes.box, Vector2(640, -16), true);
+		LocalVector<BodyState> states_before;
+		get_body_states(ps, scene, states_before);
+
+		ERR_PRINT_OFF;
+		ps->space_restore(scene.space, snapshot);
+		ERR_PRINT_ON;
+
+		LocalVector<BodyState> states;
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, states_before);
+
+		// Restoring works again once the space has the same bodies.
+		ps->free(scene.bodies[scene.bodies.size() - 1]);
+		scene.bodies.resize(scene.bodies.size() - 1);
+		ps->space_restore(scene.space, snapshot);
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, snapshot_states);
+	}
+
+	SUBCASE("Restoring fails without changes after removing a body") {
+		ps->free(scene.bodies[scene.bodies.size() - 1]);
+		scene.bodies.resize(scene.bodies.size() - 1);
+		LocalVector<BodyState> states_before;
+		get_body_states(ps, scene, states_before);
+
+		ERR_PRINT_OFF;
+		ps->space_restore(scene.space, snapshot);
+		ERR_PRINT_ON;
+
+		LocalVector<BodyState> states;
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, states_before);
+	}
+
+	free_scene(ps, scene);
+	free_shapes(ps, shapes);
+	free_server(ps);
+}
+
+} // namespace TestPhysicsServer2D
@@ -0,0 +1,528 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+constexpr real_t STEP_TIME = 1.0 / 60.0;
+
+struct TestScene {
+	RID space;
+	LocalVector<RID> bodies;
+};
+
+struct BodyState {
+	Transform3D transform;
+	Vector3 linear_velocity;
+	Vector3 angular_velocity;
+	bool sleeping = false;
+};
+
+struct TestShapes {
+	RID ground;
+	RID box;
+	RID sphere;
+};
+
+// Godot Physics is tested directly, whatever the project's default server is.
+static PhysicsServer3D *create_godot_physics_server() {
+	PhysicsServer3D *ps = PhysicsServer3DManager::get_singleton()->new_server("GodotPhysics3D");
+	if (ps) {
+		ps->init();
+	}
+	return ps;
+}
+
+static void free_server(PhysicsServer3D *p_ps) {
+	p_ps->finish();
+	memdelete(p_ps);
+}
+
+static TestShapes create_shapes(PhysicsServer3D *p_ps) {
+	TestShapes shapes;
+	shapes.ground = p_ps->world_boundary_shape_create();
+	p_ps->shape_set_data(shapes.ground, Plane(Vector3(0, 1, 0), 0));
+	shapes.box = p_ps->box_shape_create();
+	p_ps->shape_set_data(shapes.box, Vector3(0.5, 0.5, 0.5));
+	shapes.sphere = p_ps->sphere_shape_create();
+	p_ps->shape_set_data(shapes.sphere, 0.5);
+	return shapes;
+}
+
+static void free_shapes(PhysicsServer3D *p_ps, const TestShapes &p_shapes) {
+	p_ps->free(p_shapes.ground);
+	p_ps->free(p_shapes.box);
+	p_ps->free(p_shapes.sphere);
+}
+
+static RID add_body(PhysicsServer3D *p_ps, TestScene &r_scene, PhysicsServer3D::BodyMode p_mode, RID p_shape, const Vector3 &p_position, bool p_can_sleep) {
+	RID body = p_ps->body_create();
+	p_ps->body_set_mode(body, p_mode);
+	p_ps->body_add_shape(body, p_shape);
+	p_ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	p_ps->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, p_can_sleep);
+	p_ps->body_set_space(body, r_scene.space);
+	r_scene.bodies.push_back(body);
+	return body;
+}
+
+// Columns of stacked boxes on a static floor, next to a bouncing sphere and a box sliding along the floor.
+// The boxes start resting on each other, so they have contacts from the first step.
+static TestScene create_scene(PhysicsServer3D *p_ps, const TestShapes &p_shapes, int p_columns, int p_stack_height, bool p_can_sleep) {
+	TestScene scene;
+	scene.space = p_ps->space_create();
+	p_ps->space_set_active(scene.space, true);
+
+	RID ground = add_body(p_ps, scene, PhysicsServer3D::BODY_MODE_STATIC, p_shapes.ground, Vector3(), p_can_sleep);
+	p_ps->body_set_param(ground, PhysicsServer3D::BODY_PARAM_FRICTION, 0.5);
+
+	for (int x = 0; x < p_columns; x++) {
+		for (int z = 0; z < p_columns; z++) {
+			for (int y = 0; y < p_stack_height; y++) {
+				add_body(p_ps, scene, PhysicsServer3D::BODY_MODE_RIGID, p_shapes.box, Vector3(x * 2, 0.5 + y, z * 2), p_can_sleep);
+			}
+		}
+	}
+
+	RID sphere = add_body(p_ps, scene, PhysicsServer3D::BODY_MODE_RIGID, p_shapes.sphere, Vector3(-4, 3, 0), p_can_sleep);
+	p_ps->body_set_param(sphere, PhysicsServer3D::BODY_PARAM_BOUNCE, 0.8);
+
+	RID slider = add_body(p_ps, scene, PhysicsServer3D::BODY_MODE_RIGID, p_shapes.box, Vector3(-4, 0.5, 4), p_can_sleep);
+	p_ps->body_set_param(slider, PhysicsServer3D::BODY_PARAM_FRICTION, 0.5);
+	p_ps->body_set_state(slider, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(6, 0, 0));
+
+	return scene;
+}
+
+static void free_scene(PhysicsServer3D *p_ps, const TestScene &p_scene) {
+	for (const RID &body : p_scene.bodies) {
+		p_ps->free(body);
+	}
+	p_ps->free(p_scene.space);
+}
+
+static void step(PhysicsServer3D *p_ps, int p_steps) {
+	for (int i = 0; i < p_steps; i++) {
+		p_ps->step(STEP_TIME);
+	}
+}
+
+static void get_body_states(PhysicsServer3D *p_ps, const TestScene &p_scene, LocalVector<BodyState> &r_states) {
+	r_states.resize(p_scene.bodies.size());
+	for (uint32_t i = 0; i < p_scene.bodies.size(); i++) {
+		r_states[i].transform = p_ps->body_get_state(p_scene.bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		r_states[i].linear_velocity = p_ps->body_get_state(p_scene.bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		r_states[i].angular_velocity = p_ps->body_get_state(p_scene.bodies[i], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+		r_states[i].sleeping = p_ps->body_get_state(p_scene.bodies[i], PhysicsServer3D::BODY_STATE_SLEEPING);
+	}
+}
+
+static void check_body_states_equal(const LocalVector<BodyState> &p_states, const LocalVector<BodyState> &p_expected) {
+	REQUIRE(p_states.size() == p_expected.size());
+	for (uint32_t i = 0; i < p_states.size(); i++) {
+		CHECK(p_states[i].transform == p_expected[i].transform);
+		CHECK(p_states[i].linear_velocity == p_expected[i].linear_velocity);
+		CHECK(p_states[i].angular_velocity == p_expected[i].angular_velocity);
+		CHECK(p_states[i].sleeping == p_expected[i].sleeping);
+	}
+}
+
+struct ContactState {
+	uint32_t body = 0;
+	Vector3 local_position;
+	Vector3 collider_position;
+	Vector3 impulse;
+};
+
+// Reported contacts carry the positions and accumulated impulses of the body pairs that found them.
+static void enable_contact_reports(PhysicsServer3D *p_ps, const TestScene &p_scene) {
+	for (const RID &body : p_scene.bodies) {
+		// Static bodies would get contacts from all islands at once.
+		if (p_ps->body_get_mode(body) != PhysicsServer3D::BODY_MODE_STATIC) {
+			p_ps->body_set_max_contacts_reported(body, 8);
+		}
+	}
+}
+
+static void get_contact_states(PhysicsServer3D *p_ps, const TestScene &p_scene, LocalVector<ContactState> &r_contacts) {
+	r_contacts.clear();
+	for (uint32_t i = 0; i < p_scene.bodies.size(); i++) {
+		PhysicsDirectBodyState3D *state = p_ps->body_get_direct_state(p_scene.bodies[i]);
+		REQUIRE(state);
+		for (int j = 0; j < state->get_contact_count(); j++) {
+			ContactState contact;
+			contact.body = i;
+			contact.local_position = state->get_contact_local_position(j);
+			contact.collider_position = state->get_contact_collider_position(j);
+			contact.impulse = state->get_contact_impulse(j);
+			r_contacts.push_back(contact);
+		}
+	}
+}
+
+static void check_contact_states_equal(const LocalVector<ContactState> &p_contacts, const LocalVector<ContactState> &p_expected) {
+	REQUIRE(p_contacts.size() == p_expected.size());
+	for (uint32_t i = 0; i < p_contacts.size(); i++) {
+		CHECK(p_contacts[i].body == p_expected[i].body);
+		CHECK(p_contacts[i].local_position == p_expected[i].local_position);
+		CHECK(p_contacts[i].collider_position == p_expected[i].collider_position);
+		CHECK(p_contacts[i].impulse == p_expected[i].impulse);
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] Batched contact solver matches the per-pair solver") {
+	PhysicsServer3D *ps = create_godot_physics_server();
+	REQUIRE(ps);
+	TestShapes shapes = create_shapes(ps);
+
+	// Only read by Godot Physics when creating the space.
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/use_batched_contact_solver", true);
+	TestScene batched = create_scene(ps, shapes, 2, 4, false);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/use_batched_contact_solver", false);
+	TestScene per_pair = create_scene(ps, shapes, 2, 4, false);
+	ps->set_active(true);
+
+	// Contacts are solved in a different order, so results are only expected to be close.
+	constexpr real_t POSITION_TOLERANCE = 0.01;
+	constexpr real_t VELOCITY_TOLERANCE = 0.05;
+
+	const RID sphere = batched.bodies[batched.bodies.size() - 2];
+	const RID slider = batched.bodies[batched.bodies.size() - 1];
+	bool sphere_bounced = false;
+
+	for (int i = 1; i <= 60; i++) {
+		step(ps, 1);
+		const Vector3 sphere_velocity = ps->body_get_state(sphere, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		sphere_bounced = sphere_bounced || sphere_velocity.y > 1;
+		if (i % 15 != 0) {
+			continue;
+		}
+
+		for (uint32_t j = 0; j < batched.bodies.size(); j++) {
+			const Transform3D batched_transform = ps->body_get_state(batched.bodies[j], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			const Transform3D per_pair_transform = ps->body_get_state(per_pair.bodies[j], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK(batched_transform.origin.distance_to(per_pair_transform.origin) < POSITION_TOLERANCE);
+			for (int axis = 0; axis < 3; axis++) {
+				CHECK(batched_transform.basis.get_column(axis).distance_to(per_pair_transform.basis.get_column(axis)) < POSITION_TOLERANCE);
+			}
+
+			const Vector3 batched_linear_velocity = ps->body_get_state(batched.bodies[j], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+			const Vector3 per_pair_linear_velocity = ps->body_get_state(per_pair.bodies[j], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+			CHECK(batched_linear_velocity.distance_to(per_pair_linear_velocity) < VELOCITY_TOLERANCE);
+			const Vector3 batched_angular_velocity = ps->body_get_state(batched.bodies[j], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+			const Vector3 per_pair_angular_velocity = ps->body_get_state(per_pair.bodies[j], PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY);
+			CHECK(batched_angular_velocity.distance_to(per_pair_angular_velocity) < VELOCITY_TOLERANCE);
+		}
+	}
+
+	// Make sure the scene exercised resting stacks, restitution and friction.
+	const Transform3D stack_top_transform = ps->body_get_state(batched.bodies[4], PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK(Math::abs(stack_top_transform.origin.y - 3.5) < 0.1);
+	CHECK(sphere_bounced);
+	const Vector3 slider_velocity = ps->body_get_state(slider, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+	CHECK(slider_velocity.x > 0);
+	CHECK(slider_velocity.x < 6);
+
+	free_scene(ps, batched);
+	free_scene(ps, per_pair);
+	free_shapes(ps, shapes);
+	free_server(ps);
+}
+
+TEST_CASE("[PhysicsServer3D] Stepping with worker threads matches a single-threaded step") {
+	PhysicsServer3D *ps = create_godot_physics_server();
+	REQUIRE(ps);
+	TestShapes shapes = create_shapes(ps);
+	ps->set_active(true);
+
+	LocalVector<BodyState> threaded_states;
+	TestScene scene = create_scene(ps, shapes, 6, 4, true);
+	step(ps, 120);
+	get_body_states(ps, scene, threaded_states);
+	free_scene(ps, scene);
+
+	// With a single pool thread, group tasks process their elements one after another, in order.
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init(1);
+
+	LocalVector<BodyState> serial_states;
+	scene = create_scene(ps, shapes, 6, 4, true);
+	step(ps, 120);
+	get_body_states(ps, scene, serial_states);
+	free_scene(ps, scene);
+
+	WorkerThreadPool::get_singleton()->finish();
+	WorkerThreadPool::get_singleton()->init();
+
+	check_body_states_equal(threaded_states, serial_states);
+
+	free_shapes(ps, shapes);
+	free_server(ps);
+}
+
+TEST_CASE("[PhysicsServer3D] Batched queries match single queries") {
+	PhysicsServer3D *ps = create_godot_physics_server();
+	REQUIRE(ps);
+	TestShapes shapes = create_shapes(ps);
+
+	// Godot Physics culls at most this many shapes for each query.
+	constexpr int CULL_MAX = 2048;
+
+	// A grid of boxes on alternating collision layers, next to a pile of more overlapping boxes than a query can cull.
+	TestScene scene;
+	scene.space = ps->space_create();
+	ps->space_set_active(scene.space, true);
+	for (int x = 0; x < 6; x++) {
+		for (int y = 0; y < 6; y++) {
+			for (int z = 0; z < 6; z++) {
+				RID body = add_body(ps, scene, PhysicsServer3D::BODY_MODE_STATIC, shapes.box, Vector3(x * 2, y * 2, z * 2), true);
+				ps->body_set_collision_layer(body, (x + y + z) % 2 ? 1 : 2);
+			}
+		}
+	}
+	for (int i = 0; i < CULL_MAX + 100; i++) {
+		add_body(ps, scene, PhysicsServer3D::BODY_MODE_STATIC, shapes.box, Vector3(20 + (i % 10) * 0.1, 0, 0), true);
+	}
+
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	LocalVector<Transform3D> transforms;
+	LocalVector<Vector3> motions;
+	for (int i = 0; i < 64; i++) {
+		const real_t u = (i % 8) * 1.5 - 1;
+		const real_t v = (i / 8) * 1.5 - 1;
+		from.push_back(Vector3(u, -3, v));
+		to.push_back(Vector3(11 - v, 13, 11 - u));
+		transforms.push_back(Transform3D(Basis(), Vector3(u, v, u + v)));
+		motions.push_back(Vector3(v - u, 3, -2));
+	}
+	from.push_back(Vector3(20.5, 5, 0));
+	to.push_back(Vector3(20.5, -5, 0));
+	transforms.push_back(Transform3D(Basis(), Vector3(20.5, 0, 0)));
+	motions.push_back(Vector3(0, 3, 0));
+	const int count = from.size();
+
+	HashSet<RID> exclude;
+	for (uint32_t i = 0; i < scene.bodies.size(); i += 3) {
+		exclude.insert(scene.bodies[i]);
+	}
+
+	PhysicsDirectSpaceState3D *space_state = ps->space_get_direct_state(scene.space);
+	REQUIRE(space_state);
+
+	// Queries are checked with the default filter, a collision mask and an exclude list.
+	for (int filter = 0; filter < 3; filter++) {
+		PhysicsDirectSpaceState3D::RayParameters ray_parameters;
+		PhysicsDirectSpaceState3D::ShapeParameters shape_parameters;
+		shape_parameters.shape_rid = shapes.box;
+		if (filter == 1) {
+			ray_parameters.collision_mask = 2;
+			shape_parameters.collision_mask = 2;
+		} else if (filter == 2) {
+			ray_parameters.exclude = exclude;
+			shape_parameters.exclude = exclude;
+		}
+
+		LocalVector<bool> collided;
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> ray_results;
+		collided.resize(count);
+		ray_results.resize(count);
+		space_state->intersect_rays(ray_parameters, from.ptr(), to.ptr(), count, collided.ptr(), ray_results.ptr());
+
+		int ray_hits = 0;
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState3D::RayParameters single_parameters = ray_parameters;
+			single_parameters.from = from[i];
+			single_parameters.to = to[i];
+			PhysicsDirectSpaceState3D::RayResult expected;
+			const bool expected_collided = space_state->intersect_ray(single_parameters, expected);
+			CHECK(collided[i] == expected_collided);
+			if (!expected_collided) {
+				continue;
+			}
+			ray_hits++;
+			CHECK(ray_results[i].position == expected.position);
+			CHECK(ray_results[i].normal == expected.normal);
+			CHECK(ray_results[i].rid == expected.rid);
+			CHECK(ray_results[i].collider_id == expected.collider_id);
+			CHECK(ray_results[i].shape == expected.shape);
+			CHECK(ray_results[i].face_index == expected.face_index);
+			if (filter == 1) {
+				CHECK((ps->body_get_collision_layer(ray_results[i].rid) & 2) != 0);
+			} else if (filter == 2) {
+				CHECK_FALSE(exclude.has(ray_results[i].rid));
+			}
+		}
+		CHECK(ray_hits > 0);
+
+		// Large enough to never limit the results, so every culled shape is checked.
+		const int result_max = CULL_MAX + 100;
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> shape_results;
+		LocalVector<int> result_counts;
+		shape_results.resize(count * result_max);
+		result_counts.resize(count);
+		space_state->intersect_shapes(shape_parameters, transforms.ptr(), count, shape_results.ptr(), result_max, result_counts.ptr());
+
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> expected_shape_results;
+		expected_shape_results.resize(result_max);
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState3D::ShapeParameters single_parameters = shape_parameters;
+			single_parameters.transform = transforms[i];
+			const int expected_count = space_state->intersect_shape(single_parameters, expected_shape_results.ptr(), result_max);
+			REQUIRE(result_counts[i] == expected_count);
+			for (int j = 0; j < expected_count; j++) {
+				const PhysicsDirectSpaceState3D::ShapeResult &result = shape_results[i * result_max + j];
+				CHECK(result.rid == expected_shape_results[j].rid);
+				CHECK(result.collider_id == expected_shape_results[j].collider_id);
+				CHECK(result.shape == expected_shape_results[j].shape);
+			}
+		}
+		if (filter == 0) {
+			// The pile query is limited by the cull, not by result_max.
+			CHECK(result_counts[count - 1] == CULL_MAX);
+		}
+
+		LocalVector<real_t> closest_safe;
+		LocalVector<real_t> closest_unsafe;
+		closest_safe.resize(count);
+		closest_unsafe.resize(count);
+		space_state->cast_motions(shape_parameters, transforms.ptr(), motions.ptr(), count, closest_safe.ptr(), closest_unsafe.ptr());
+
+		int blocked_motions = 0;
+		for (int i = 0; i < count; i++) {
+			PhysicsDirectSpaceState3D::ShapeParameters single_parameters = shape_parameters;
+			single_parameters.transform = transforms[i];
+			single_parameters.motion = motions[i];
+			real_t expected_safe = 1.0;
+			real_t expected_unsafe = 1.0;
+			space_state->cast_motion(single_parameters, expected_safe, expected_unsafe);
+			CHECK(closest_safe[i] == expected_safe);
+			CHECK(closest_unsafe[i] == expected_unsafe);
+			if (expected_unsafe < 1) {
+				blocked_motions++;
+			}
+		}
+		CHECK(blocked_motions > 0);
+	}
+
+	free_scene(ps, scene);
+	free_shapes(ps, shapes);
+	free_server(ps);
+}
+
+TEST_CASE("[PhysicsServer3D] Restoring a snapshot replays the same steps") {
+	PhysicsServer3D *ps = create_godot_physics_server();
+	REQUIRE(ps);
+	TestShapes shapes = create_shapes(ps);
+	TestScene scene = create_scene(ps, shapes, 2, 4, true);
+	enable_contact_reports(ps, scene);
+	ps->set_active(true);
+
+	// The snapshot is taken before the sphere lands and before anything can fall asleep.
+	constexpr int STEPS_BEFORE_SNAPSHOT = 20;
+	constexpr int STEPS_AFTER_SNAPSHOT = 60;
+
+	step(ps, STEPS_BEFORE_SNAPSHOT);
+	LocalVector<BodyState> snapshot_states;
+	get_body_states(ps, scene, snapshot_states);
+	const Vector<uint8_t> snapshot = ps->space_snapshot(scene.space);
+	REQUIRE(!snapshot.is_empty());
+
+	step(ps, STEPS_AFTER_SNAPSHOT);
+	LocalVector<BodyState> expected_states;
+	get_body_states(ps, scene, expected_states);
+	LocalVector<ContactState> expected_contacts;
+	get_contact_states(ps, scene, expected_contacts);
+	CHECK(!expected_contacts.is_empty());
+
+	SUBCASE("Stepping again gives the same bodies and contacts") {
+		ps->space_restore(scene.space, snapshot);
+		LocalVector<BodyState> states;
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, snapshot_states);
+
+		step(ps, STEPS_AFTER_SNAPSHOT);
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, expected_states);
+		LocalVector<ContactState> contacts;
+		get_contact_states(ps, scene, contacts);
+		check_contact_states_equal(contacts, expected_contacts);
+	}
+
+	SUBCASE("Restoring fails without changes after adding a body") {
+		add_body(ps, scene, PhysicsServer3D::BODY_MODE_RIGID, shapes.box, Vector3(20, 0.5, 20), true);
+		LocalVector<BodyState> states_before;
+		get_body_states(ps, scene, states_before);
+
+		ERR_PRINT_OFF;
+		ps->space_restore(scene.space, snapshot);
+		ERR_PRINT_ON;
+
+		LocalVector<BodyState> states;
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, states_before);
+
+		// Restoring works again once the space has the same bodies.
+		ps->free(scene.bodies[scene.bodies.size() - 1]);
+		scene.bodies.resize(scene.bodies.size() - 1);
+		ps->space_restore(scene.space, snapshot);
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, snapshot_states);
+	}
+
+	SUBCASE("Restoring fails without changes after removing a body") {
+		ps->free(scene.bodies[scene.bodies.size() - 1]);
+		scene.bodies.resize(scene.bodies.size() - 1);
+		LocalVector<BodyState> states_before;
+		get_body_states(ps, scene, states_before);
+
+		ERR_PRINT_OFF;
+		ps->space_restore(scene.space, snapshot);
+		ERR_PRINT_ON;
+
+		LocalVector<BodyState> states;
+		get_body_states(ps, scene, states);
+		check_body_states_equal(states, states_before);
+	}
+
+	free_scene(ps, scene);
+	free_shapes(ps, shapes);
+	free_server(ps);
+}
+
+} // namespace TestPhysicsServer3D
@@ -40,6 +40,8 @@
 #endif // TOOLS_ENABLED
 
 #include "tests/core/config/test_project_settings.h"
+#include "tests/core/debugger/test_frame_benchmark.h"
+#include "tests/core/debugger/test_trace_events.h"
 #include "tests/core/input/test_input_event.h"
 #include "tests/core/input/test_input_event_key.h"
 #include "tests/core/input/test_input_event_mouse.h"
@@ -66,6 +68,7 @@
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bvh.h"
 #include "tests/core/math/test_color.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
@@ -86,13 +89,16 @@
 #include "tests/core/math/test_vector4.h"
 #include "tests/core/math/test_vector4i.h"
 #include "tests/core/object/test_class_db.h"
+#include "tests/core/object/test_message_queue.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
 #include "tests/core/os/test_os.h"
+#include "tests/core/os/test_small_block_allocator.h"
 #include "tests/core/string/test_fuzzy_search.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_a_hash_map.h"
@@ -116,6 +122,7 @@
 #include "tests/core/variant/test_array.h"
 #include "tests/core/variant/test_callable.h"
 #include "tests/core/variant/test_dictionary.h"
+#include "tests/core/variant/test_packed_array_math.h"
 #include "tests/core/variant/test_variant.h"
 #include "tests/core/variant/test_variant_utility.h"
 #include "tests/scene/test_animation.h"
@@ -199,11 +206,23 @@
 #include "tests/servers/test_navigation_server_3d.h"
 #endif // MODULE_NAVIGATION_3D_ENABLED
 
+#ifdef MODULE_GODOT_PHYSICS_2D_ENABLED
+#include "tests/servers/test_physics_server_2d.h"
+#endif // MODULE_GODOT_PHYSICS_2D_ENABLED
+
+#ifdef MODULE_GODOT_PHYSICS_3D_ENABLED
+#include "tests/servers/test_physics_server_3d.h"
+#endif // MODULE_GODOT_PHYSICS_3D_ENABLED
+
 #include "modules/modules_tests.gen.h"
 
 #include "tests/display_server_mock.h"
 #include "tests/test_macros.h"
 
+#ifdef BENCHMARKS_ENABLED
+#include "tests/benchmarks/benchmark.h"
+#endif // BENCHMARKS_ENABLED
+
 #include "scene/theme/theme_db.h"
 
 #ifndef NAVIGATION_2D_DISABLED
@@ -245,6 +264,12 @@ int test_main(int argc, char *argv[]) {
 		ERR_FAIL_COND_V_MSG(da->erase_contents_recursive() != OK, 0, "Failed to delete files");
 	}
 
+#ifdef BENCHMARKS_ENABLED
+	if (args.find("--benchmarks")) {
+		return benchmark_main(args);
+	}
+#endif // BENCHMARKS_ENABLED
+
 	// Run custom test tools.
 	if (test_commands) {
 		for (const KeyValue<String, TestFunc> &E : (*test_commands)) {